@@ -6,6 +6,7 @@ import operator
 
 from python import utils
 from . import fstrips
+from . import tuple_file
 from . import util
 from .static import DataElement
 from .templates import tplManager
@@ -13,10 +14,11 @@ from .templates import tplManager
 
 class ProblemRepresentation(object):
 
-    def __init__(self, index, translation_dir, debug):
+    def __init__(self, index, translation_dir, debug, binary=False):
         self.index = index
         self.translation_dir = translation_dir
         self.debug = debug
+        self.binary = binary  # Whether to also store the static data and groundings in binary format
 
     def generate(self):
 
@@ -57,6 +59,10 @@ class ProblemRepresentation(object):
             assert isinstance(elem, DataElement)
             serialized = elem.serialize_data(self.index.objects.data)
             self.dump_data(elem.name, serialized)
+            if self.binary:
+                self.dump_binary_data(elem.name, [(elem.row_width(), elem.serialize_rows(self.index.objects.data))])
+            else:
+                self.rm_data(elem.name, ext='bin')
 
     def get_method_factories(self):
         return tplManager.get('factories').substitute(
@@ -142,6 +148,12 @@ class ProblemRepresentation(object):
             for l in data:
                 f.write(str(l) + '\n')
 
+    def dump_binary_data(self, name, sections, subdir=None):
+        """ Store the given integer tables in the binary format, which the planner prefers over the text one """
+        basedir, filename = self._compute_filenames(name, 'bin', subdir)
+        utils.mkdirp(basedir)
+        tuple_file.write(filename, sections)
+
     def rm_data(self, name, ext='data', subdir=None):
         basedir, filename = self._compute_filenames(name, ext, subdir)
         utils.silentremove(filename)
@@ -229,9 +241,11 @@ class ProblemRepresentation(object):
 
         if all_groundings is None:  # No groundings available
             self.rm_data(groundings_filename)
+            self.rm_data(groundings_filename, ext='bin')
             return
 
         data = []
+        sections = []  # For the binary format, one section per action schema
 
         # Order matters! The groundings of each action schema are provided in consecutive blocks, one grounding per line
         for i, action in enumerate(schemas, 0):
@@ -244,5 +258,10 @@ class ProblemRepresentation(object):
 
             for grounding in sorted(action_groundings):  # IMPORTANT to output the groundings in lexicographical order
                 data.append(','.join(map(str, grounding)))
+            sections.append((len(action['signature']), sorted(action_groundings)))
 
         self.dump_data(groundings_filename, data)
+        if self.binary:
+            self.dump_binary_data(groundings_filename, sections)
+        else:
+            self.rm_data(groundings_filename, ext='bin')
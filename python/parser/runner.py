@@ -33,6 +33,8 @@ def parse_arguments(args):
 
     parser.add_argument("--driver", help='The solver driver (controller) to be used.', default=None)
     parser.add_argument("--options", help='The solver extra options', default="")
+    parser.add_argument("--binary", action='store_true', help='Store the static data and the action groundings also in '
+                                                              'a binary format, which is much faster to load.')
     parser.add_argument("--asp", action='store_true', help='(Experimental) Use the ASP-based parser+grounder '
                                                            '(strict ADL, without numerics etc.).')
 
@@ -216,7 +218,7 @@ def run(args):
 
     # Generate the appropriate problem representation from our task, store it, and (if necessary) compile
     # the C++ generated code to obtain a binary tailored to the particular instance
-    representation = ProblemRepresentation(fs_task, out_dir, args.edebug or args.debug)
+    representation = ProblemRepresentation(fs_task, out_dir, args.edebug or args.debug, args.binary)
     representation.generate()
     use_vanilla = not representation.requires_compilation()
 
@@ -46,6 +46,14 @@ class DataElement:
     def serialize_data(self, symbols):
         raise RuntimeError("Method must be subclassed")
 
+    def row_width(self):
+        """ The number of integers each element of the extension is serialized into """
+        raise RuntimeError("Method must be subclassed")
+
+    def serialize_rows(self, symbols):
+        """ The serialized data as rows of integers, as required by the binary data format """
+        return [[int(x) for x in line.split(',')] for line in self.serialize_data(symbols)]
+
 
 class StaticProcedure(object):
     def __init__(self, name):
@@ -64,6 +72,9 @@ class Arity0Element(DataElement):
     def serialize_data(self, symbols):
         return [serialize_symbol(self.elems[()], symbols)]  # We simply print the only element
 
+    def row_width(self):
+        return 1
+
 
 class UnaryMap(DataElement):
     ARITY = 1
@@ -79,6 +90,9 @@ class UnaryMap(DataElement):
     def serialize_data(self, symbols):
         return [serialize_tuple(k + (v,), symbols) for k, v in self.elems.items()]
 
+    def row_width(self):
+        return self.ARITY + 1
+
     def validate(self, elem, value):
         if len(elem) != self.ARITY:
             raise RuntimeError("Wrong type or number of arguments for data element {}: {}({}) = {}".format(
@@ -112,6 +126,9 @@ class UnarySet(DataElement):
     def serialize_data(self, symbols):
         return [serialize_tuple(elem, symbols) for elem in self.elems]
 
+    def row_width(self):
+        return self.ARITY
+
     def validate(self, elem):
         if len(elem) != self.ARITY:
             raise RuntimeError("Wrong type or number of arguments for data element {}: {}({})".format(
@@ -132,6 +149,9 @@ class ZeroarySet(UnarySet):
     def serialize_data(self, symbols):
         return [serialize_symbol(self.elems[()], symbols)]  # We simply print the only element
 
+    def row_width(self):
+        return 1
+
 
 class BinarySet(UnarySet):
     ARITY = 2
@@ -0,0 +1,37 @@
+"""
+    Serialization of integer tables into the binary, memory-mappable format read by the planner
+    (see class TupleFile in src/utils/tuple_file.hxx).
+"""
+import array
+import struct
+import sys
+
+MAGIC = b'FSTUPLE1'
+FILE_HEADER = struct.Struct('<8sII')  # magic, number of sections, padding
+SECTION_HEADER = struct.Struct('<IIQQ')  # width, padding, number of rows, offset of the data
+
+
+def write(filename, sections):
+    """ Write the given sections to the given file. Each section is a pair (width, rows), where each row
+    is a sequence of exactly 'width' integers """
+    offset = FILE_HEADER.size + len(sections) * SECTION_HEADER.size
+    headers, payloads = [], []
+    for width, rows in sections:
+        data = array.array('i')
+        for row in rows:
+            if len(row) != width:
+                raise RuntimeError("Wrong row width in tuple file section: expected {}, got {}".format(width, len(row)))
+            data.extend(row)
+        if sys.byteorder != 'little':
+            data.byteswap()
+
+        headers.append(SECTION_HEADER.pack(width, 0, len(rows), offset))
+        payloads.append(data.tobytes())
+        offset += len(payloads[-1])
+
+    with open(filename, 'wb') as f:
+        f.write(FILE_HEADER.pack(MAGIC, len(sections), 0))
+        for header in headers:
+            f.write(header)
+        for payload in payloads:
+            f.write(payload)
@@ -73,6 +73,10 @@ public:
 	//! Generates the ground action actually represented by this lifted ID
 	GroundAction* generate() const;
 	
+	//! The (partially grounded) action and the binding of the parameters that it leaves unbound
+	const PartiallyGroundedAction* get_action() const { return _action; }
+	const Binding& get_binding() const { return _binding; }
+	
 	//! Prints a representation of the object to the given stream.
 	std::ostream& print(std::ostream& os) const;
 
@@ -0,0 +1,50 @@
+
+#include <actions/compiled_effects.hxx>
+#include <actions/actions.hxx>
+#include <languages/fstrips/language.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+namespace fs0 {
+
+CompiledEffects::CompiledEffects(const GroundAction& action) :
+	_variables(), _values(), _interpreted(), _positions()
+{
+	for (const fs::ActionEffect* effect:action.getEffects()) {
+		auto variable = dynamic_cast<const fs::StateVariable*>(effect->lhs());
+		auto constant = dynamic_cast<const fs::Constant*>(effect->rhs());
+
+		if (variable && constant && effect->condition()->is_tautology()) {
+			_variables.push_back(variable->getValue());
+			_values.push_back(constant->getValue());
+		} else {
+			_interpreted.push_back(effect);
+			_positions.push_back(_variables.size());
+		}
+	}
+}
+
+void
+CompiledEffects::apply(const State& state, State& successor) const {
+	if (_interpreted.empty()) {
+		successor.apply_inplace(state, _variables.data(), _values.data(), _variables.size());
+		return;
+	}
+
+	// All the effects need to be evaluated on the original state before any atom is written into the successor,
+	// which might be the very same state.
+	static thread_local std::vector<Atom> atoms;
+	atoms.clear();
+	unsigned j = 0;
+	for (unsigned i = 0; i < _interpreted.size(); ++i) {
+		for (; j < _positions[i]; ++j) atoms.push_back(Atom(_variables[j], _values[j]));
+
+		const fs::ActionEffect* effect = _interpreted[i];
+		if (effect->applicable(state)) atoms.push_back(effect->apply(state));
+	}
+	for (; j < _variables.size(); ++j) atoms.push_back(Atom(_variables[j], _values[j]));
+
+	successor.apply_inplace(state, atoms);
+}
+
+} // namespaces
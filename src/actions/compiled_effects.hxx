@@ -0,0 +1,48 @@
+
+#pragma once
+
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class ActionEffect; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class State;
+class GroundAction;
+
+//! The effects of a ground action compiled into a table, so that the action can be applied without interpreting
+//! the terms of each effect. Unconditional effects X := c, by far the most common ones (e.g. all STRIPS add and delete
+//! effects), are stored as flat arrays of variables and values. All other effects (conditional effects, or effects
+//! whose left- or right-hand side is not a state variable or a constant) are split out and interpreted as usual.
+//! Applying the table is equivalent to computing all the atoms produced by the effects on the given state, in the
+//! order in which the effects are declared, and accumulating them into a copy of the state.
+class CompiledEffects {
+public:
+	CompiledEffects(const GroundAction& action);
+
+	CompiledEffects(const CompiledEffects&) = default;
+	CompiledEffects& operator=(const CompiledEffects&) = default;
+
+	//! Overwrite 'successor', which might be 'state' itself, with the state that results from applying the action on 'state',
+	//! reusing the memory of 'successor'. The method can be called concurrently from several threads.
+	void apply(const State& state, State& successor) const;
+
+	//! Whether all effects have been compiled, i.e. there are no effects that need to be interpreted
+	bool is_constant() const { return _interpreted.empty(); }
+
+	std::size_t size() const { return _variables.size() + _interpreted.size(); }
+
+protected:
+	//! The variable and value of each of the compiled effects, in order
+	std::vector<VariableIdx> _variables;
+	std::vector<ObjectIdx> _values;
+
+	//! The effects that need to be interpreted, and, for each of them, the number of compiled effects that precede it
+	std::vector<const fs::ActionEffect*> _interpreted;
+	std::vector<unsigned> _positions;
+};
+
+} // namespaces
@@ -1,4 +1,7 @@
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 
 #include <lapkt/tools/logging.hxx>
@@ -6,12 +9,15 @@
 #include <problem_info.hxx>
 #include <actions/grounding.hxx>
 #include <actions/actions.hxx>
+#include <actions/reachability.hxx>
 #include <utils/printers/binding.hxx>
 #include <utils/printers/actions.hxx>
 #include <utils/config.hxx>
 #include <utils/binding_iterator.hxx>
 #include <utils/utils.hxx>
 #include <utils/loader.hxx>
+#include <utils/tuple_file.hxx>
+#include <utils/thread_pool.hxx>
 #include <languages/fstrips/language.hxx>
 #include <languages/fstrips/operations.hxx>
 #include <utils/printers/actions.hxx>
@@ -19,7 +25,15 @@
 
 namespace fs0 {
 
-	
+//! Schemas with fewer bindings than this are grounded sequentially even if several grounding threads are available
+static const unsigned long PARALLEL_GROUNDING_MIN_BINDINGS = 10000;
+
+//! The min. number of bindings grounded as a single parallel task
+static const unsigned long PARALLEL_GROUNDING_MIN_CHUNK = 1024;
+
+//! Serializes the logging done while grounding, which might happen on several threads
+static std::mutex _grounding_log_mutex;
+
 std::vector<const fs::ActionEffect*>
 _bind_effects(const ActionData& action_data, const Binding& binding, const ProblemInfo& info) {
 	std::vector<const fs::ActionEffect*> effects;
@@ -30,6 +44,7 @@ _bind_effects(const ActionData& action_data, const Binding& binding, const Probl
 	}
 	
 	if (effects.empty()) {
+		std::lock_guard<std::mutex> lock(_grounding_log_mutex);
 		LPT_INFO("cout", "WARNING - " <<  action_data << " with binding " << binding << " has no applicable effects");
 	}
 	return effects;
@@ -53,26 +68,35 @@ _partial_binding(const ActionData& action_data, const Binding& binding, const Pr
 }
 
 
-//! Process the action schema with a given parameter binding and return the corresponding GroundAction
-//! A nullptr is returned if the action is detected to be statically non-applicable	
-GroundAction*
-_full_binding(unsigned id, const ActionData& action_data, const Binding& binding, const ProblemInfo& info, bool bind_effects) {
+//! Bind the precondition and, if requested, the effects of the action schema with the given (full) parameter binding,
+//! returning false if the resulting ground action is detected to be statically non-applicable
+bool
+_bind_schema(const ActionData& action_data, const Binding& binding, const ProblemInfo& info, bool bind_effects,
+             const fs::Formula*& precondition, std::vector<const fs::ActionEffect*>& effects) {
 	assert(binding.is_complete()); // Grounding only possible for full bindings
-	const fs::Formula* precondition = fs::bind(*action_data.getPrecondition(), binding, info);
+	precondition = fs::bind(*action_data.getPrecondition(), binding, info);
 	if (precondition->is_contradiction()) {
 		delete precondition;
-		return nullptr;
+		return false;
 	}
 	
-	std::vector<const fs::ActionEffect*> effects;
 	if (bind_effects) {
 		effects = _bind_effects(action_data, binding, info);
 		if (effects.empty()) {
 			delete precondition;
-			return nullptr;
+			return false;
 		}
 	}
-	
+	return true;
+}
+
+//! Process the action schema with a given parameter binding and return the corresponding GroundAction
+//! A nullptr is returned if the action is detected to be statically non-applicable	
+GroundAction*
+_full_binding(unsigned id, const ActionData& action_data, const Binding& binding, const ProblemInfo& info, bool bind_effects) {
+	const fs::Formula* precondition = nullptr;
+	std::vector<const fs::ActionEffect*> effects;
+	if (!_bind_schema(action_data, binding, info, bind_effects, precondition, effects)) return nullptr;
 	return new GroundAction(id, action_data, binding, precondition, effects);
 }
 
@@ -106,12 +130,56 @@ ActionGrounder::fully_lifted(const std::vector<const ActionData*>& action_data,
 }
 
 
-//! Loads a set of ground action from the given data directory, if they exist, or else returns an empty vector
+//! Loads the ground actions from the binary, memory-mapped groundings file, which has one section per action schema,
+//! with one row with the parameters of each grounding. Groundings not deemed reachable by the given analysis, if any, are skipped.
+std::vector<const GroundAction*>
+_loadBinaryGroundActions(const std::string& filename, const ProblemInfo& info, const std::vector<const ActionData*>& action_data, const RelaxedReachability* reachability) {
+	std::vector<const GroundAction*> grounded;
+	LPT_INFO("cout", "Loading the list of reachable ground actions from \"" << filename << "\"");
+	
+	utils::TupleFile file(filename);
+	if (file.num_sections() != action_data.size()) {
+		throw std::runtime_error("The number of action schemas in the groundings file does not match that in the problem description");
+	}
+	
+	unsigned id = 0;
+	for (unsigned schema_id = 0; schema_id < action_data.size(); ++schema_id) {
+		const ActionData* current = action_data[schema_id];
+		const utils::TupleFile::Section& section = file.section(schema_id);
+		if (current->getSignature().size() != section.width()) {
+			throw std::runtime_error("Wrong number of action parameters");
+		}
+		
+		std::size_t groundings = 0;
+		for (std::size_t i = 0; i < section.rows(); ++i) {
+			ValueTuple values(section.row(i), section.row(i) + section.width());
+			if (reachability && !reachability->reachable_binding(schema_id, values)) continue;
+			++groundings;
+			if (section.width() == 0) {
+				id = _ground(id, current, Binding::EMPTY_BINDING, info, grounded, true);
+			} else {
+				id = _ground(id, current, Binding(std::move(values)), info, grounded, true);
+			}
+		}
+		LPT_INFO("cout", "Action schema \"" << current->getName() << "\" results in " << groundings << " grounded actions");
+	}
+	
+	LPT_INFO("cout", "Grounding process stats:\t" << grounded.size() << " grounded actions");
+	return grounded;
+}
+
+//! Loads a set of ground action from the given data directory, if they exist, or else returns an empty vector.
+//! The binary groundings file is preferred over the text one, if the preprocessor generated it.
 std::vector<const GroundAction*>
-_loadGroundActionsIfAvailable(const ProblemInfo& info, const std::vector<const ActionData*>& action_data) {
+_loadGroundActionsIfAvailable(const ProblemInfo& info, const std::vector<const ActionData*>& action_data, const RelaxedReachability* reachability) {
 	std::vector<const GroundAction*> grounded;
 	if (action_data.empty()) return grounded;
 	
+	std::string binary_filename = info.getDataDir() + "/groundings.bin";
+	if (utils::TupleFile::exists(binary_filename)) {
+		return _loadBinaryGroundActions(binary_filename, info, action_data, reachability);
+	}
+	
 	std::string filename = info.getDataDir() + "/groundings.data";
 	std::ifstream is(filename);
 	
@@ -149,6 +217,7 @@ _loadGroundActionsIfAvailable(const ProblemInfo& info, const std::vector<const A
 			throw std::runtime_error("Wrong number of action parameters");
 		}
 		
+		if (reachability && !reachability->reachable_binding(schema_id, deserialized)) continue;
 		
 		if (deserialized.empty()) {
 			LPT_INFO("cout", "Grounding action schema '" << current->getName() << "' with no binding");
@@ -165,12 +234,78 @@ _loadGroundActionsIfAvailable(const ProblemInfo& info, const std::vector<const A
 	return grounded;
 }
 
+//! Grounds the given action schema on several threads. The space of bindings of the schema is split into chunks
+//! of consecutive bindings, in the same (lexicographical) order in which a binding_iterator enumerates them, and
+//! each chunk is bound independently. The bound actions of the chunks are then turned into ground actions in chunk
+//! order, hence the resulting actions and their IDs are exactly those of a sequential grounding.
+unsigned
+_ground_in_parallel(unsigned id, const ActionData* data, unsigned long num_bindings, const ProblemInfo& info, std::vector<const GroundAction*>& grounded, bool bind_effects, utils::ThreadPool& pool) {
+	struct BoundSchema {
+		Binding binding;
+		const fs::Formula* precondition;
+		std::vector<const fs::ActionEffect*> effects;
+	};
+	
+	const Signature& signature = data->getSignature();
+	std::vector<const ObjectIdxVector*> values;
+	for (TypeIdx type:signature) values.push_back(&info.getTypeObjects(type));
+	
+	// Several chunks per thread, so that the load gets balanced even if bindings have very different costs
+	const unsigned long chunk_size = std::max<unsigned long>(PARALLEL_GROUNDING_MIN_CHUNK, (num_bindings + 16 * pool.size() - 1) / (16 * pool.size()));
+	const std::size_t num_chunks = (num_bindings + chunk_size - 1) / chunk_size;
+	std::vector<std::vector<BoundSchema>> bound(num_chunks);
+	
+	pool.parallel_for(num_chunks, [&](std::size_t chunk) {
+		const unsigned long begin = chunk * chunk_size, end = std::min(num_bindings, begin + chunk_size);
+		
+		// Decode the position of the first binding of the chunk on each of the parameter domains
+		std::vector<std::size_t> positions(signature.size());
+		unsigned long rest = begin;
+		for (std::size_t i = signature.size(); i-- > 0;) {
+			positions[i] = rest % values[i]->size();
+			rest /= values[i]->size();
+		}
+		
+		ValueTuple tuple(signature.size());
+		for (unsigned long b = begin; b < end; ++b) {
+			for (std::size_t i = 0; i < signature.size(); ++i) tuple[i] = (*values[i])[positions[i]];
+			
+			Binding binding(tuple);
+			const fs::Formula* precondition = nullptr;
+			std::vector<const fs::ActionEffect*> effects;
+			if (_bind_schema(*data, binding, info, bind_effects, precondition, effects)) {
+				bound[chunk].push_back(BoundSchema{std::move(binding), precondition, std::move(effects)});
+			}
+			
+			// Advance to the next binding, the last parameter varying fastest
+			for (std::size_t i = signature.size(); i-- > 0;) {
+				if (++positions[i] < values[i]->size()) break;
+				positions[i] = 0;
+			}
+		}
+	});
+	
+	for (const auto& chunk:bound) {
+		for (const BoundSchema& action:chunk) {
+			grounded.push_back(new GroundAction(id++, *data, action.binding, action.precondition, action.effects));
+		}
+	}
+	return id;
+}
+
 std::vector<const GroundAction*>
-_ground_all_elements(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool bind_effects) {
+_ground_all_elements(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool bind_effects, unsigned threads) {
 	std::vector<const GroundAction*> grounded;
 	
 	unsigned total_num_bindings = 0;
 	
+	if (threads == 0) throw std::runtime_error("The number of grounding threads needs to be positive");
+	std::unique_ptr<utils::ThreadPool> pool;
+	if (threads > 1) {
+		LPT_INFO("cout", "Grounding action schemas on " << threads << " threads");
+		pool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(threads));
+	}
+	
 	unsigned id = 0;
 	for (const ActionData* data:action_data) {
 		unsigned grounded_0 = grounded.size();
@@ -201,6 +336,16 @@ _ground_all_elements(const std::vector<const ActionData*>& action_data, const Pr
 			LPT_INFO("cout", "WARNING - The number of ground elements is too high: " << num_bindings);
 		}
 		
+		// Overflowing binding spaces are left to the binding iterator
+		if (pool && num_bindings >= PARALLEL_GROUNDING_MIN_BINDINGS && num_bindings <= ActionGrounder::MAX_GROUND_ACTIONS) {
+			id = _ground_in_parallel(id, data, num_bindings, info, grounded, bind_effects, *pool);
+			total_num_bindings += num_bindings;
+			std::cout << std::endl;
+			LPT_INFO("cout", "Schema \"" << print::action_data_name(*data) << "\" results in " << grounded.size() - grounded_0 << " grounded elements");
+			LPT_INFO("cout", "");
+			continue;
+		}
+		
 // 		float onepercent = ((float)num_bindings / 100);
 // 		int progress = 0;
 // 		unsigned i = 0;
@@ -231,12 +376,42 @@ _ground_all_elements(const std::vector<const ActionData*>& action_data, const Pr
 
 std::vector<const GroundAction*>
 ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info) {
-	std::vector<const GroundAction*> grounded = _loadGroundActionsIfAvailable(info, action_data);
+	int threads = Config::instance().getOption<int>("grounding.threads", 1);
+	if (threads <= 0) throw std::runtime_error("The number of grounding threads needs to be positive");
+	return fully_ground(action_data, info, threads);
+}
+
+std::vector<const GroundAction*>
+ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, unsigned threads) {
+	std::vector<const GroundAction*> grounded = _loadGroundActionsIfAvailable(info, action_data, nullptr);
 	if (!grounded.empty()) { // A previous grounding was found, return it
 		return grounded;
 	}
 	
-	return _ground_all_elements(action_data, info, true);
+	return _ground_all_elements(action_data, info, true, threads);
+}
+
+std::vector<const GroundAction*>
+ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, const RelaxedReachability& reachability) {
+	std::vector<const GroundAction*> grounded = _loadGroundActionsIfAvailable(info, action_data, &reachability);
+	if (!grounded.empty()) {
+		return grounded;
+	}
+	
+	unsigned id = 0;
+	for (unsigned i = 0; i < action_data.size(); ++i) {
+		const ActionData* data = action_data[i];
+		unsigned grounded_0 = grounded.size();
+		for (const ValueTuple& binding:reachability.bindings(i)) {
+			id = _ground(id, data, binding.empty() ? Binding::EMPTY_BINDING : Binding(binding), info, grounded, true);
+		}
+		LPT_INFO("cout", "Schema \"" << print::action_data_name(*data) << "\" results in " << grounded.size() - grounded_0 << " grounded elements out of "
+		                 << reachability.bindings(i).size() << " reachable bindings");
+	}
+	
+	LPT_INFO("cout", "Grounding stats:\n\t* " << grounded.size() << " grounded elements (relaxed-reachable only)");
+	LPT_DEBUG("grounding", "All ground actions " << std::endl << print::actions(grounded));
+	return grounded;
 }
 
 
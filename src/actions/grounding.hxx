@@ -15,6 +15,7 @@ class ActionBase;
 class GroundAction;
 class Binding;
 class PartiallyGroundedAction;
+class RelaxedReachability;
 
 //! This exception is thrown whenever a variable cannot be resolved
 class TooManyGroundActionsError : public std::runtime_error {
@@ -38,8 +39,17 @@ public:
 	//! Generate fully-lifted actions from the action schema data
 	static std::vector<const PartiallyGroundedAction*> fully_lifted(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
 	
+	//! Ground all the action schemas, on the number of threads given by the 'grounding.threads' option
 	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
 	
+	//! Ground all the action schemas on the given number of threads. Schemas with many bindings are split among the threads,
+	//! but the resulting ground actions, and their IDs, are the same regardless of the number of threads.
+	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, unsigned threads);
+	
+	//! Ground only those bindings of the action schemas that the given reachability analysis deems reachable, in the same
+	//! order as a full grounding. If the preprocessor already generated the groundings, these are filtered by the analysis.
+	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, const RelaxedReachability& reachability);
+	
 	static const std::vector<const fs::ActionEffect*> compile_nested_fluents_away(const fs::ActionEffect* effect, const ProblemInfo& info);
 	
 	//! Helper to ground a schema with a single binding. Returns the expected next action ID, which might be the same
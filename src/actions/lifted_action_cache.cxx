@@ -0,0 +1,111 @@
+
+#include <actions/lifted_action_cache.hxx>
+#include <actions/actions.hxx>
+#include <constraints/gecode/handlers/lifted_action_csp.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/operations/basic.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <lapkt/tools/logging.hxx>
+
+#include <gecode/search.hh>
+
+namespace fs0 { namespace gecode {
+
+LiftedActionCache::LiftedActionCache(const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, unsigned max_entries) :
+	_handlers(handlers), _max_entries(max_entries), _relevant(), _caches(handlers.size()), _projection(), _hits(0), _misses(0)
+{
+	for (const auto& handler:_handlers) {
+		_relevant.push_back(relevant_variables(*handler));
+		LPT_DEBUG("main", "CSP solutions of action schema " << handler->get_action() << " cached on the projection of states onto " << _relevant.back().size() << " state variables");
+	}
+}
+
+LiftedActionCache::~LiftedActionCache() {
+	LPT_INFO("main", "Lifted action CSP solution cache: " << _hits << " hits, " << _misses << " misses");
+}
+
+LiftedActionCache::SolutionSetPtr
+LiftedActionCache::solutions(unsigned i, const State& state) {
+	const std::vector<VariableIdx>& relevant = _relevant[i];
+	_projection.clear();
+	for (VariableIdx variable:relevant) _projection.push_back(state.getValue(variable));
+
+	CacheT& cache = _caches[i];
+	auto it = cache.find(_projection);
+	if (it != cache.end()) {
+		++_hits;
+		return it->second;
+	}
+
+	++_misses;
+	if (cache.size() >= _max_entries) {
+		LPT_DEBUG("main", "Emptying the full CSP solution cache of action schema " << _handlers[i]->get_action());
+		cache.clear();
+	}
+	auto solutions = std::make_shared<const SolutionSet>(compute_solutions(*_handlers[i], state));
+	cache.insert(std::make_pair(_projection, solutions));
+	return solutions;
+}
+
+LiftedActionCache::SolutionSet
+LiftedActionCache::compute_solutions(const LiftedActionCSP& handler, const State& state) {
+	SolutionSet solutions;
+	GecodeCSP* csp = handler.instantiate(state);
+	if (!csp || !csp->checkConsistency()) { // The CSP is not even locally consistent
+		delete csp;
+		return solutions;
+	}
+
+	Gecode::DFS<GecodeCSP> engine(csp);
+	delete csp;
+	while (GecodeCSP* solution = engine.next()) {
+		std::unique_ptr<LiftedActionID> action(handler.get_lifted_action_id(solution));
+		solutions.push_back(std::move(*action));
+		delete solution;
+	}
+	return solutions;
+}
+
+std::vector<VariableIdx>
+LiftedActionCache::relevant_variables(const LiftedActionCSP& handler) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+
+	// The CSP models the precondition and the effects of the schema except for the root symbol of the effect LHS,
+	// which only determines the state variable being affected
+	std::vector<const fs::Term*> terms = fs::all_terms(*handler.get_precondition());
+	for (const fs::ActionEffect* effect:handler.get_effects()) {
+		if (auto lhs = dynamic_cast<const fs::NestedTerm*>(effect->lhs())) {
+			for (const fs::Term* subterm:lhs->getSubterms()) {
+				auto subterms = fs::all_terms(*subterm);
+				terms.insert(terms.end(), subterms.begin(), subterms.end());
+			}
+		}
+		auto rhs = fs::all_terms(*effect->rhs());
+		terms.insert(terms.end(), rhs.begin(), rhs.end());
+	}
+
+	bool uses_axioms = false;
+	for (const fs::Formula* formula:fs::all_formulae(*handler.get_precondition())) {
+		uses_axioms = uses_axioms || dynamic_cast<const fs::AxiomaticFormula*>(formula) || dynamic_cast<const fs::AxiomaticAtom*>(formula);
+	}
+
+	std::vector<bool> relevant(info.getNumVariables(), false);
+	for (const fs::Term* term:terms) {
+		if (auto variable = dynamic_cast<const fs::StateVariable*>(term)) {
+			relevant[variable->getValue()] = true;
+		} else if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(term)) {
+			for (VariableIdx variable:info.resolveStateVariable(nested->getSymbolId())) relevant[variable] = true;
+		} else if (dynamic_cast<const fs::AxiomaticTerm*>(term) || dynamic_cast<const fs::AxiomaticTermWrapper*>(term)) {
+			uses_axioms = true;
+		}
+	}
+
+	std::vector<VariableIdx> variables;
+	for (VariableIdx variable = 0; variable < relevant.size(); ++variable) {
+		if (uses_axioms || relevant[variable]) variables.push_back(variable);
+	}
+	return variables;
+}
+
+} } // namespaces
@@ -0,0 +1,73 @@
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <fs_types.hxx>
+#include <actions/action_id.hxx>
+
+namespace fs0 { class State; }
+
+namespace fs0 { namespace gecode {
+
+class LiftedActionCSP;
+
+//! A cache of the solutions of the action CSPs of a set of lifted-action handlers.
+//! The set of solutions of the CSP of an action schema on a given state depends only on the values that the state gives
+//! to the state variables that the CSP mentions, i.e. to those appearing in the precondition of the schema or in the
+//! (relevant parts of the) effects. The cache thus stores, for each handler, the full list of solutions of its CSP
+//! keyed on the projection of the state onto those variables, so that the Gecode search is only run on states with a
+//! projection not seen before. Schemas that use axioms, whose value might depend on any state variable, are keyed on
+//! the whole state.
+//! The cache is not reentrant.
+class LiftedActionCache {
+public:
+	using SolutionSet = std::vector<LiftedActionID>;
+	using SolutionSetPtr = std::shared_ptr<const SolutionSet>;
+
+	//! 'max_entries' is the max. number of projections whose solutions are cached for each handler.
+	//! When the cache of some handler is full, it is emptied altogether.
+	LiftedActionCache(const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, unsigned max_entries);
+	~LiftedActionCache();
+
+	LiftedActionCache(const LiftedActionCache&) = delete;
+	LiftedActionCache& operator=(const LiftedActionCache&) = delete;
+
+	//! Returns all the solutions of the CSP of the i-th handler on the given state.
+	//! The returned set remains valid even if the cache is emptied afterwards.
+	SolutionSetPtr solutions(unsigned i, const State& state);
+
+	unsigned long hits() const { return _hits; }
+	unsigned long misses() const { return _misses; }
+
+protected:
+	using CacheT = std::unordered_map<ValueTuple, SolutionSetPtr, boost::hash<ValueTuple>>;
+
+	const std::vector<std::shared_ptr<LiftedActionCSP>> _handlers;
+
+	const unsigned _max_entries;
+
+	//! '_relevant[i]' contains the state variables onto which states are projected for the i-th handler
+	std::vector<std::vector<VariableIdx>> _relevant;
+
+	//! '_caches[i]' maps state projections to the solutions of the i-th handler
+	std::vector<CacheT> _caches;
+
+	//! A buffer to compute state projections without memory allocations
+	ValueTuple _projection;
+
+	unsigned long _hits;
+	unsigned long _misses;
+
+	//! Run the Gecode search to obtain all the solutions of the CSP of the given handler on the given state
+	static SolutionSet compute_solutions(const LiftedActionCSP& handler, const State& state);
+
+	//! Returns the state variables that the CSP of the given handler depends on
+	static std::vector<VariableIdx> relevant_variables(const LiftedActionCSP& handler);
+};
+
+} } // namespaces
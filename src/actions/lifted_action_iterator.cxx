@@ -4,22 +4,27 @@
 #include <actions/action_id.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <languages/fstrips/formulae.hxx>
-#include <applicability/action_managers.hxx>
+#include <actions/lifted_action_view.hxx>
+#include <atom.hxx>
 
 namespace fs0 { namespace gecode {
 
-LiftedActionIterator::LiftedActionIterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints) :
-	_handlers(handlers), _state(state), _state_constraints(state_constraints)
+LiftedActionIterator::LiftedActionIterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, LiftedActionCache* cache) :
+	_handlers(handlers), _state(state), _state_constraints(state_constraints), _cache(cache)
 {}
 
-LiftedActionIterator::Iterator::Iterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, unsigned currentIdx) :
+LiftedActionIterator::Iterator::Iterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, LiftedActionCache* cache, unsigned currentIdx) :
 	_handlers(handlers),
 	_state(state),
 	_current_handler_idx(currentIdx),
 	_engine(nullptr),
 	_csp(nullptr),
 	_action(nullptr),
-	_state_constraints(state_constraints)
+	_state_constraints(state_constraints),
+	_cache(cache),
+	_solutions(),
+	_next_solution(0),
+	_current(nullptr)
 {
 	advance();
 }
@@ -40,8 +45,11 @@ void LiftedActionIterator::Iterator::advance() {
 		
 		// Else, we need to check whether the application of the action that results from the CSP solution violates any state constraint
 		// TODO - A better way to do this would be to integrate state constraints into the CSP
-		std::unique_ptr<const GroundAction> ground(_action->generate());
-		State next(_state, NaiveApplicabilityManager::computeEffects(_state, *ground));
+		static thread_local LiftedActionView view;
+		static thread_local std::vector<Atom> atoms;
+		view.set(*_current);
+		view.effects(_state, atoms);
+		State next(_state, atoms);
 		if (_state_constraints->interpret(next)) { // The application of the action would violate the state constraints
 			return;
 		}
@@ -50,6 +58,8 @@ void LiftedActionIterator::Iterator::advance() {
 
 
 bool LiftedActionIterator::Iterator::next_solution() {
+	if (_cache) return next_cached_solution();
+	
 	for (;_current_handler_idx < _handlers.size(); ++_current_handler_idx) {
 		LiftedActionCSP& handler = *_handlers[_current_handler_idx];
 		
@@ -81,10 +91,30 @@ bool LiftedActionIterator::Iterator::next_solution() {
 		
 		if (_action) delete _action;
 		_action = handler.get_lifted_action_id(solution);
+		_current = _action;
 		delete solution;
 		break;
 	}
 	
 	return _current_handler_idx != _handlers.size();
 }
+
+bool LiftedActionIterator::Iterator::next_cached_solution() {
+	for (;_current_handler_idx < _handlers.size(); ++_current_handler_idx) {
+		if (!_solutions) {
+			_solutions = _cache->solutions(_current_handler_idx, _state);
+			_next_solution = 0;
+		}
+		
+		if (_next_solution == _solutions->size()) {
+			_solutions.reset();
+			continue;
+		}
+		
+		_current = &(*_solutions)[_next_solution++];
+		break;
+	}
+	
+	return _current_handler_idx != _handlers.size();
+}
 }} // namespaces
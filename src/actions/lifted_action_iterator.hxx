@@ -5,6 +5,8 @@
 
 #include <gecode/driver.hh>
 
+#include <actions/lifted_action_cache.hxx>
+
 namespace fs0 {
 class State;
 class LiftedActionID;
@@ -21,6 +23,8 @@ class LiftedActionCSP;
 //! An iterator that models action schema applicability as an action CSP.
 //! The iterator receives an (ordered) set of lifted-action CSP handlers, and upon iteration
 //! returns, chainedly, each of the lifted-action IDs that are applicable.
+//! If a cache of CSP solutions is given, the solutions of each handler are retrieved from it,
+//! otherwise they are computed lazily by a Gecode search.
 class LiftedActionIterator {
 protected:
 	const std::vector<std::shared_ptr<LiftedActionCSP>>& _handlers;
@@ -29,8 +33,10 @@ protected:
 	
 	const fs::Formula* _state_constraints;
 	
+	LiftedActionCache* _cache;
+	
 public:
-	LiftedActionIterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints);
+	LiftedActionIterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, LiftedActionCache* cache = nullptr);
 	
 	class Iterator {
 		friend class LiftedActionIterator;
@@ -41,7 +47,7 @@ public:
 		~Iterator();
 		
 	protected:
-		Iterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, unsigned currentIdx);
+		Iterator(const State& state, const std::vector<std::shared_ptr<LiftedActionCSP>>& handlers, const fs::Formula* state_constraints, LiftedActionCache* cache, unsigned currentIdx);
 
 		const std::vector<std::shared_ptr<LiftedActionCSP>>& _handlers;
 		
@@ -53,15 +59,28 @@ public:
 		
 		GecodeCSP* _csp;
 		
+		//! The last solution found by the Gecode search, if not using a cache
 		LiftedActionID* _action;
 		
 		//! The state constraints
 		const fs::Formula* _state_constraints;
 		
+		LiftedActionCache* _cache;
+		
+		//! The solutions of the current handler, if using a cache, and the index of the next one
+		LiftedActionCache::SolutionSetPtr _solutions;
+		unsigned _next_solution;
+		
+		//! The current action
+		const LiftedActionID* _current;
+		
 		void advance();
 		
 		//! Returns true iff a new solution has actually been found
 		bool next_solution();
+		
+		//! Same as 'next_solution', but retrieving the solutions of each handler from the cache
+		bool next_cached_solution();
 
 	public:
 		const Iterator& operator++() {
@@ -70,15 +89,15 @@ public:
 		}
 		const Iterator operator++(int) {Iterator tmp(*this); operator++(); return tmp;}
 
-		const LiftedActionID& operator*() const { return *_action; }
+		const LiftedActionID& operator*() const { return *_current; }
 		
 		//! This is not really true... but will work for the purpose of comparing with the end iterator.
 		bool operator==(const Iterator &other) const { return _current_handler_idx == other._current_handler_idx; }
 		bool operator!=(const Iterator &other) const { return !(this->operator==(other)); }
 	};
 	
-	Iterator begin() const { return Iterator(_state, _handlers, _state_constraints, 0); }
-	Iterator end() const { return Iterator(_state,_handlers, _state_constraints, _handlers.size()); }
+	Iterator begin() const { return Iterator(_state, _handlers, _state_constraints, _cache, 0); }
+	Iterator end() const { return Iterator(_state,_handlers, _state_constraints, _cache, _handlers.size()); }
 };
 
 
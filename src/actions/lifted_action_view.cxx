@@ -0,0 +1,44 @@
+
+#include <actions/lifted_action_view.hxx>
+#include <actions/action_id.hxx>
+#include <actions/actions.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/operations/interpretation.hxx>
+#include <state.hxx>
+#include <atom.hxx>
+
+namespace fs0 {
+
+void
+LiftedActionView::set(const LiftedActionID& action) {
+	_action = action.get_action();
+	_parameters = _action->getBinding(); // Reuses the memory of the buffer
+	_parameters.merge_with(action.get_binding());
+	assert(_parameters.is_complete());
+}
+
+bool
+LiftedActionView::applicable(const State& state) {
+	reset_binding();
+	return _action->getPrecondition()->interpret(state, _binding);
+}
+
+void
+LiftedActionView::effects(const State& state, std::vector<Atom>& atoms) {
+	atoms.clear();
+	for (const fs::ActionEffect* effect:_action->getEffects()) {
+		reset_binding();
+		if (!effect->condition()->interpret(state, _binding)) continue;
+
+		VariableIdx variable;
+		try {
+			variable = fs::interpret_variable(*effect->lhs(), state, _binding);
+		} catch (const std::out_of_range& e) {
+			// The LHS does not resolve to a state variable, which means that the effect would have been pruned when grounding the action
+			continue;
+		}
+		atoms.push_back(Atom(variable, effect->rhs()->interpret(state, _binding)));
+	}
+}
+
+} // namespaces
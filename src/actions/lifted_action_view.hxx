@@ -0,0 +1,50 @@
+
+#pragma once
+
+#include <vector>
+
+#include <fs_types.hxx>
+#include <utils/binding.hxx>
+
+namespace fs0 {
+
+class State;
+class Atom;
+class LiftedActionID;
+class PartiallyGroundedAction;
+
+//! A view of the ground action that a lifted action ID stands for, i.e. of a (partially grounded) action schema
+//! under a full binding of its parameters. The precondition and effects of the schema are interpreted directly under
+//! the binding, hence the view can be checked for applicability and applied without generating (and allocating)
+//! the corresponding GroundAction. The binding is kept in a buffer that is reused whenever the view is pointed
+//! to a different action, so that a single view can be used for all the actions of a search.
+class LiftedActionView {
+public:
+	LiftedActionView() : _action(nullptr), _binding() {}
+
+	LiftedActionView(const LiftedActionView&) = default;
+	LiftedActionView& operator=(const LiftedActionView&) = default;
+
+	//! Point the view to the given action
+	void set(const LiftedActionID& action);
+
+	//! Whether the precondition of the action holds in the given state
+	bool applicable(const State& state);
+
+	//! Overwrite 'atoms' with the atoms produced by the effects of the action on the given state, in the order in which
+	//! the effects are declared. Effects whose left-hand side does not resolve to a state variable are ignored, as when grounding.
+	void effects(const State& state, std::vector<Atom>& atoms);
+
+protected:
+	//! The action the view currently points to
+	const PartiallyGroundedAction* _action;
+
+	//! The full binding of the action parameters. Interpreting quantified formulas binds further variables, which
+	//! is why the buffer is restored from '_parameters' before any formula is interpreted.
+	Binding _binding;
+	Binding _parameters;
+
+	void reset_binding() { _binding = _parameters; }
+};
+
+} // namespaces
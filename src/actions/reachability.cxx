@@ -0,0 +1,471 @@
+
+#include <algorithm>
+#include <limits>
+
+#include <lapkt/tools/logging.hxx>
+
+#include <actions/reachability.hxx>
+#include <actions/actions.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+#include <languages/fstrips/language.hxx>
+
+
+namespace fs0 {
+
+const unsigned long RelaxedReachability::MAX_ATOM_COMBINATIONS;
+
+//! An empty assignment under which to interpret static terms
+static const PartialAssignment NO_ASSIGNMENT;
+
+//! Returns true iff the given term contains no fluent symbol, i.e. its value depends only on the binding of the parameters
+//! of the schema, in which case 'level' is updated with the number of parameters that need to be bound to interpret it
+static bool _is_static_term(const fs::Term& term, unsigned arity, unsigned& level) {
+	if (auto variable = dynamic_cast<const fs::BoundVariable*>(&term)) {
+		if (variable->getVariableId() >= arity) return false; // A variable bound by some quantifier
+		level = std::max(level, variable->getVariableId() + 1);
+		return true;
+	}
+
+	if (dynamic_cast<const fs::Constant*>(&term)) return true;
+	if (dynamic_cast<const fs::AxiomaticTermWrapper*>(&term) || dynamic_cast<const fs::AxiomaticTerm*>(&term)) return false;
+
+	if (auto nested = dynamic_cast<const fs::StaticHeadedNestedTerm*>(&term)) {
+		for (const fs::Term* subterm:nested->getSubterms()) {
+			if (!_is_static_term(*subterm, arity, level)) return false;
+		}
+		return true;
+	}
+	return false; // Fluent-headed terms and state variables
+}
+
+//! A term that is either static or fluent but with static arguments, i.e. a term that can be resolved to a state variable
+//! once the parameters that appear on it are bound
+struct ResolvableTerm {
+	const fs::Term* term; // The term itself or, for fluent terms, the arguments of its head
+	bool fluent;
+	unsigned symbol;
+	VariableIdx variable; // The state variable, if it is the same for any binding, or INVALID_VARIABLE otherwise
+	std::vector<const fs::Term*> arguments;
+
+	static const VariableIdx INVALID_VARIABLE = std::numeric_limits<VariableIdx>::max();
+
+	//! Analyze the given term, returning false if it is neither static nor fluent with static arguments
+	bool analyze(const fs::Term& subterm, unsigned arity, unsigned& level, const ProblemInfo& info) {
+		term = &subterm;
+		fluent = false;
+		variable = INVALID_VARIABLE;
+		if (_is_static_term(subterm, arity, level)) return true;
+
+		fluent = true;
+		if (auto statevar = dynamic_cast<const fs::StateVariable*>(&subterm)) {
+			variable = statevar->getValue();
+			symbol = info.getVariableData(variable).first;
+			return true;
+		}
+
+		if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(&subterm)) {
+			symbol = nested->getSymbolId();
+			arguments = nested->getSubterms();
+			for (const fs::Term* argument:arguments) {
+				if (!_is_static_term(*argument, arity, level)) return false;
+			}
+			return true;
+		}
+		return false;
+	}
+
+	//! The state variable of a fluent term under the given binding. Throws std::out_of_range if there is no such state variable
+	VariableIdx resolve(const Binding& binding, ValueTuple& buffer, const ProblemInfo& info) const {
+		assert(fluent);
+		if (variable != INVALID_VARIABLE) return variable;
+		buffer.resize(arguments.size());
+		for (unsigned i = 0; i < arguments.size(); ++i) buffer[i] = arguments[i]->interpret(NO_ASSIGNMENT, binding);
+		return info.resolveStateVariable(symbol, buffer);
+	}
+};
+
+const VariableIdx ResolvableTerm::INVALID_VARIABLE;
+
+
+//! An atomic formula all whose subterms are resolvable terms
+class RelaxedReachability::CompiledAtom {
+public:
+	const fs::AtomicFormula* formula;
+	std::vector<ResolvableTerm> subterms;
+
+	//! The number of parameters that need to be bound to evaluate the atom
+	unsigned level;
+
+	//! Whether the atom is of the form X = t, with X a fluent term and t a static term
+	bool equality;
+
+	//! Scratch buffers
+	mutable ValueTuple values;
+	mutable ValueTuple arguments;
+	mutable std::vector<VariableIdx> variables;
+	std::vector<unsigned> fluent_positions;
+
+	//! Analyze the given formula, returning false if it is not an atom that can be evaluated in the relaxation
+	bool analyze(const fs::Formula& element, unsigned arity, const ProblemInfo& info) {
+		formula = dynamic_cast<const fs::AtomicFormula*>(&element);
+		if (!formula || dynamic_cast<const fs::AxiomaticFormula*>(formula)) return false;
+
+		level = 0;
+		subterms.resize(formula->getSubterms().size());
+		for (unsigned i = 0; i < subterms.size(); ++i) {
+			if (!subterms[i].analyze(*formula->getSubterms()[i], arity, level, info)) return false;
+			if (subterms[i].fluent) fluent_positions.push_back(i);
+		}
+		values.resize(subterms.size());
+		variables.resize(fluent_positions.size());
+		equality = dynamic_cast<const fs::EQAtomicFormula*>(formula) && subterms.size() == 2 && fluent_positions.size() == 1;
+		return true;
+	}
+};
+
+//! An action effect whose head and value can be resolved, at least partially
+class RelaxedReachability::CompiledEffect {
+public:
+	ResolvableTerm lhs;
+
+	//! Whether the head of the effect could not be resolved to a single state variable, in which case the effect
+	//! is assumed to affect all the state variables derived from the symbol of the head
+	bool wildcard;
+	bool wildcard_applied;
+
+	//! The value of the effect, if it is a static term, or null otherwise, in which case the effect reaches all values of the head
+	const fs::Term* rhs;
+
+	//! The (atoms of the) condition of the effect, if any
+	std::vector<CompiledAtom> condition;
+
+	mutable ValueTuple arguments;
+};
+
+struct RelaxedReachability::CompiledSchema {
+	std::vector<const ObjectIdxVector*> domains;
+
+	//! The atoms of the precondition that can be evaluated once the first 'i' parameters have been bound
+	std::vector<std::vector<CompiledAtom>> atoms;
+
+	std::vector<CompiledEffect> effects;
+
+	//! The fluent symbols on which the evaluation of the precondition and of the effects depends
+	std::vector<unsigned> symbols;
+
+	bool enumerated;
+	unsigned last_enumeration;
+};
+
+
+RelaxedReachability::RelaxedReachability(const std::vector<const ActionData*>& schemas, const ProblemInfo& info) :
+	_info(info),
+	_schemas(schemas),
+	_compiled(),
+	_type_positions(),
+	_type_offsets(),
+	_atom_offsets(),
+	_reached(),
+	_num_reachable_atoms(0),
+	_symbol_updates(info.getNumLogicalSymbols(), 0),
+	_bindings(schemas.size()),
+	_iterations(0),
+	_examined(0)
+{
+	// Index the objects of each type by their position within the type
+	for (const ObjectIdxVector& objects:info.getTypeObjects()) {
+		ObjectIdx min = objects.empty() ? 0 : *std::min_element(objects.begin(), objects.end());
+		ObjectIdx max = objects.empty() ? -1 : *std::max_element(objects.begin(), objects.end());
+		std::vector<int> positions(max - min + 1, -1);
+		for (unsigned i = 0; i < objects.size(); ++i) positions[objects[i] - min] = i;
+		_type_positions.push_back(std::move(positions));
+		_type_offsets.push_back(min);
+	}
+
+	unsigned num_atoms = 0;
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		_atom_offsets.push_back(num_atoms);
+		num_atoms += info.getVariableObjects(variable).size();
+	}
+	_reached.resize(num_atoms, false);
+
+	for (const ActionData* data:schemas) {
+		const Signature& signature = data->getSignature();
+		unsigned arity = signature.size();
+		CompiledSchema* schema = new CompiledSchema();
+		_compiled.push_back(schema);
+		schema->enumerated = false;
+		schema->last_enumeration = 0;
+		schema->atoms.resize(arity + 1);
+		for (TypeIdx type:signature) schema->domains.push_back(&info.getTypeObjects(type));
+
+		// Only the top-level conjuncts of the precondition are analyzed, anything else is assumed to hold
+		const fs::Formula* precondition = data->getPrecondition();
+		std::vector<const fs::Formula*> conjuncts{precondition};
+		if (auto conjunction = dynamic_cast<const fs::Conjunction*>(precondition)) conjuncts = conjunction->getSubformulae();
+
+		for (const fs::Formula* conjunct:conjuncts) {
+			CompiledAtom atom;
+			if (!atom.analyze(*conjunct, arity, info)) continue;
+			for (const ResolvableTerm& subterm:atom.subterms) {
+				if (subterm.fluent) schema->symbols.push_back(subterm.symbol);
+			}
+			schema->atoms[atom.level].push_back(std::move(atom));
+		}
+
+		for (const fs::ActionEffect* effect:data->getEffects()) {
+			CompiledEffect compiled;
+			compiled.wildcard_applied = false;
+			unsigned level = 0;
+			compiled.wildcard = !compiled.lhs.analyze(*effect->lhs(), arity, level, info) || !compiled.lhs.fluent;
+			if (compiled.wildcard) {
+				auto head = dynamic_cast<const fs::FluentHeadedNestedTerm*>(effect->lhs());
+				if (!head) throw std::runtime_error("Unsupported action effect head: the head of an effect needs to be a fluent term");
+				compiled.lhs.symbol = head->getSymbolId();
+			}
+			compiled.rhs = _is_static_term(*effect->rhs(), arity, level) ? effect->rhs() : nullptr;
+
+			std::vector<const fs::Formula*> condition{effect->condition()};
+			if (auto conjunction = dynamic_cast<const fs::Conjunction*>(effect->condition())) condition = conjunction->getSubformulae();
+			for (const fs::Formula* conjunct:condition) {
+				CompiledAtom atom;
+				if (!atom.analyze(*conjunct, arity, info)) continue;
+				for (const ResolvableTerm& subterm:atom.subterms) {
+					if (subterm.fluent) schema->symbols.push_back(subterm.symbol);
+				}
+				compiled.condition.push_back(std::move(atom));
+			}
+
+			// The fluent symbols read by the head (other than its own symbol) and by the value of the effect
+			for (const fs::Term* term:effect->all_terms()) {
+				if (term == effect->lhs()) continue;
+				if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(term)) schema->symbols.push_back(nested->getSymbolId());
+				if (auto variable = dynamic_cast<const fs::StateVariable*>(term)) schema->symbols.push_back(info.getVariableData(variable->getValue()).first);
+			}
+			schema->effects.push_back(std::move(compiled));
+		}
+		std::sort(schema->symbols.begin(), schema->symbols.end());
+		schema->symbols.erase(std::unique(schema->symbols.begin(), schema->symbols.end()), schema->symbols.end());
+	}
+}
+
+RelaxedReachability::~RelaxedReachability() {
+	for (CompiledSchema* schema:_compiled) delete schema;
+}
+
+int
+RelaxedReachability::atom_index(VariableIdx variable, ObjectIdx value) const {
+	TypeIdx type = _info.getVariableType(variable);
+	const std::vector<int>& positions = _type_positions[type];
+	long offset = static_cast<long>(value) - _type_offsets[type];
+	if (offset < 0 || offset >= static_cast<long>(positions.size()) || positions[offset] < 0) return -1;
+	return _atom_offsets[variable] + positions[offset];
+}
+
+bool
+RelaxedReachability::reachable(VariableIdx variable, ObjectIdx value) const {
+	int index = atom_index(variable, value);
+	return index >= 0 && _reached[index];
+}
+
+bool
+RelaxedReachability::reach(VariableIdx variable, ObjectIdx value) {
+	int index = atom_index(variable, value);
+	if (index < 0 || _reached[index]) return false;
+	_reached[index] = true;
+	++_num_reachable_atoms;
+	_symbol_updates[_info.getVariableData(variable).first] = _iterations;
+	return true;
+}
+
+void
+RelaxedReachability::reach_all(VariableIdx variable) {
+	for (ObjectIdx value:_info.getVariableObjects(variable)) reach(variable, value);
+}
+
+void
+RelaxedReachability::add_all_atoms(unsigned symbol) {
+	for (VariableIdx variable:_info.resolveStateVariable(symbol)) reach_all(variable);
+}
+
+void
+RelaxedReachability::compute(const State& state) {
+	for (VariableIdx variable = 0; variable < _info.getNumVariables(); ++variable) {
+		reach(variable, state.getValue(variable));
+	}
+
+	// Schemas get enumerated again only when some symbol on which their precondition or effects depend got new atoms,
+	// either in the previous iteration or in the current one after the schema was enumerated.
+	unsigned reached = 0;
+	do {
+		reached = _num_reachable_atoms;
+		++_iterations;
+		for (unsigned i = 0; i < _compiled.size(); ++i) {
+			const CompiledSchema& schema = *_compiled[i];
+			bool outdated = !schema.enumerated;
+			for (unsigned symbol:schema.symbols) {
+				outdated = outdated || _symbol_updates[symbol] >= schema.last_enumeration;
+			}
+			if (outdated) enumerate(i);
+		}
+	} while (_num_reachable_atoms != reached);
+
+	LPT_INFO("cout", "Relaxed reachability: " << _num_reachable_atoms << " / " << _reached.size() << " atoms and "
+	                 << num_reachable_bindings() << " action groundings reachable after " << _iterations << " iterations ("
+	                 << _examined << " bindings examined)");
+}
+
+void
+RelaxedReachability::enumerate(unsigned i) {
+	CompiledSchema& schema = *_compiled[i];
+	schema.enumerated = true;
+	schema.last_enumeration = _iterations;
+
+	std::vector<ValueTuple> found;
+	Binding binding(schema.domains.size());
+	for (const CompiledAtom& atom:schema.atoms[0]) {
+		if (!satisfiable(atom, binding)) {
+			_bindings[i].clear();
+			return;
+		}
+	}
+	enumerate(schema, 0, binding, found);
+	_bindings[i] = std::move(found);
+}
+
+void
+RelaxedReachability::enumerate(CompiledSchema& schema, unsigned parameter, Binding& binding, std::vector<ValueTuple>& found) {
+	if (parameter == schema.domains.size()) {
+		found.push_back(binding.get_full_binding());
+		for (CompiledEffect& effect:schema.effects) apply(effect, binding);
+		return;
+	}
+
+	const std::vector<CompiledAtom>& atoms = schema.atoms[parameter + 1];
+	for (ObjectIdx value:*schema.domains[parameter]) {
+		binding.set(parameter, value);
+		++_examined;
+
+		bool satisfied = true;
+		for (const CompiledAtom& atom:atoms) {
+			if (!satisfiable(atom, binding)) {
+				satisfied = false;
+				break;
+			}
+		}
+		if (satisfied) enumerate(schema, parameter + 1, binding, found);
+	}
+}
+
+bool
+RelaxedReachability::satisfiable(const CompiledAtom& atom, const Binding& binding) const {
+	try {
+		for (unsigned i = 0; i < atom.subterms.size(); ++i) {
+			const ResolvableTerm& subterm = atom.subterms[i];
+			if (!subterm.fluent) atom.values[i] = subterm.term->interpret(NO_ASSIGNMENT, binding);
+		}
+		for (unsigned j = 0; j < atom.fluent_positions.size(); ++j) {
+			atom.variables[j] = atom.subterms[atom.fluent_positions[j]].resolve(binding, atom.arguments, _info);
+		}
+	} catch (const std::out_of_range& e) { // A static function undefined on the given arguments, or a state variable that does not exist
+		return false;
+	}
+
+	if (atom.fluent_positions.empty()) return atom.formula->_satisfied(atom.values);
+
+	if (atom.equality) return reachable(atom.variables[0], atom.values[1 - atom.fluent_positions[0]]);
+
+	if (atom.fluent_positions.size() == 1) {
+		const unsigned position = atom.fluent_positions[0];
+		for (ObjectIdx value:_info.getVariableObjects(atom.variables[0])) {
+			if (!reachable(atom.variables[0], value)) continue;
+			atom.values[position] = value;
+			if (atom.formula->_satisfied(atom.values)) return true;
+		}
+		return false;
+	}
+
+	// Otherwise, check whether any combination of reachable values of the fluent subterms satisfies the atom
+	std::vector<std::vector<ObjectIdx>> candidates;
+	unsigned long combinations = 1;
+	for (VariableIdx variable:atom.variables) {
+		candidates.emplace_back();
+		for (ObjectIdx value:_info.getVariableObjects(variable)) {
+			if (reachable(variable, value)) candidates.back().push_back(value);
+		}
+		combinations *= candidates.back().size();
+		if (combinations == 0) return false;
+		if (combinations > MAX_ATOM_COMBINATIONS) return true;
+	}
+
+	std::vector<unsigned> positions(candidates.size(), 0);
+	while (true) {
+		for (unsigned j = 0; j < candidates.size(); ++j) atom.values[atom.fluent_positions[j]] = candidates[j][positions[j]];
+		if (atom.formula->_satisfied(atom.values)) return true;
+
+		unsigned j = candidates.size();
+		while (j-- > 0) {
+			if (++positions[j] < candidates[j].size()) break;
+			positions[j] = 0;
+		}
+		if (j == std::numeric_limits<unsigned>::max()) return false;
+	}
+}
+
+void
+RelaxedReachability::apply(CompiledEffect& effect, const Binding& binding) {
+	for (const CompiledAtom& atom:effect.condition) {
+		if (!satisfiable(atom, binding)) return;
+	}
+
+	if (effect.wildcard) {
+		if (!effect.wildcard_applied) {
+			effect.wildcard_applied = true;
+			add_all_atoms(effect.lhs.symbol);
+		}
+		return;
+	}
+
+	try {
+		VariableIdx variable = effect.lhs.resolve(binding, effect.arguments, _info);
+		if (effect.rhs) reach(variable, effect.rhs->interpret(NO_ASSIGNMENT, binding));
+		else reach_all(variable);
+	} catch (const std::out_of_range& e) {
+		// The effect is not applicable with the given binding
+	}
+}
+
+unsigned long
+RelaxedReachability::num_reachable_bindings() const {
+	unsigned long total = 0;
+	for (const auto& bindings:_bindings) total += bindings.size();
+	return total;
+}
+
+bool
+RelaxedReachability::reachable_binding(unsigned schema, const ValueTuple& binding) const {
+	const Signature& signature = _schemas.at(schema)->getSignature();
+	if (binding.size() != signature.size()) return false;
+
+	// Bindings are sorted by the positions of their values within the objects of the types of the parameters
+	auto position = [this, &signature](const ValueTuple& values, unsigned i) {
+		long offset = static_cast<long>(values[i]) - _type_offsets[signature[i]];
+		const std::vector<int>& positions = _type_positions[signature[i]];
+		return (offset < 0 || offset >= static_cast<long>(positions.size())) ? -1 : positions[offset];
+	};
+	auto less = [&position](const ValueTuple& lhs, const ValueTuple& rhs) {
+		for (unsigned i = 0; i < lhs.size(); ++i) {
+			int l = position(lhs, i), r = position(rhs, i);
+			if (l != r) return l < r;
+		}
+		return false;
+	};
+
+	const std::vector<ValueTuple>& bindings = _bindings.at(schema);
+	auto it = std::lower_bound(bindings.begin(), bindings.end(), binding, less);
+	return it != bindings.end() && *it == binding;
+}
+
+} // namespaces
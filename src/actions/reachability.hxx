@@ -0,0 +1,115 @@
+
+#pragma once
+
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { namespace language { namespace fstrips { class Term; class AtomicFormula; class Formula; class ActionEffect; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+class ProblemInfo;
+class ActionData;
+class Binding;
+class State;
+
+//! A delete-relaxed reachability analysis of the atoms and the action groundings of a problem, performed directly
+//! on the lifted action schemas. Starting from the atoms of some state, the analysis repeatedly enumerates the bindings
+//! of each schema whose preconditions are (relaxed-)satisfiable with the atoms reached so far, and adds the atoms that
+//! their effects produce, until a fixpoint is reached. Bindings are enumerated by backtracking over the parameters of the
+//! schema, in order, checking each atom of the precondition as soon as all the parameters it mentions are bound, hence
+//! (as in a Datalog join) bindings that violate a static or unreachable atom are pruned without ever being fully expanded.
+//!
+//! The analysis over-approximates the set of reachable atoms and actions: any atom that is not reachable according
+//! to it will never hold in a state reachable from the initial state. To keep it simple, whatever cannot be analyzed
+//! precisely is over-approximated: precondition conjuncts other than atoms made of static terms and of fluent terms
+//! with static arguments are assumed to hold, and effects whose head or value cannot be resolved to a state variable
+//! or a value reach all the possible values of all the state variables they might affect.
+class RelaxedReachability {
+public:
+	//! Groundings that need to check more value combinations than this to evaluate an atom with several fluent terms
+	//! simply assume that the atom holds
+	static const unsigned long MAX_ATOM_COMBINATIONS = 10000;
+
+	RelaxedReachability(const std::vector<const ActionData*>& schemas, const ProblemInfo& info);
+	~RelaxedReachability();
+	RelaxedReachability(const RelaxedReachability&) = delete;
+	RelaxedReachability& operator=(const RelaxedReachability&) = delete;
+
+	//! Run the analysis from the given state. Must be called exactly once.
+	void compute(const State& state);
+
+	//! Mark as reachable all the atoms of all the state variables derived from the given (fluent) symbol
+	void add_all_atoms(unsigned symbol);
+
+	//! Whether the atom <variable, value> is reachable
+	bool reachable(VariableIdx variable, ObjectIdx value) const;
+
+	//! The reachable bindings of the i-th action schema, in the same order in which a binding_iterator enumerates them
+	const std::vector<ValueTuple>& bindings(unsigned schema) const { return _bindings.at(schema); }
+
+	//! Whether the given binding of the i-th action schema is reachable
+	bool reachable_binding(unsigned schema, const ValueTuple& binding) const;
+
+	unsigned num_reachable_atoms() const { return _num_reachable_atoms; }
+	unsigned num_atoms() const { return _reached.size(); }
+	unsigned long num_reachable_bindings() const;
+
+	//! The number of fixpoint iterations and of (possibly partial) bindings examined by the analysis
+	unsigned num_iterations() const { return _iterations; }
+	unsigned long num_examined_bindings() const { return _examined; }
+
+protected:
+	class CompiledAtom;
+	class CompiledEffect;
+	struct CompiledSchema;
+
+	const ProblemInfo& _info;
+
+	const std::vector<const ActionData*> _schemas;
+
+	std::vector<CompiledSchema*> _compiled;
+
+	//! For each type, the position of each of its objects among the objects of the type, indexed by the object
+	//! minus '_type_offsets[type]', or -1 if the object does not belong to the type
+	std::vector<std::vector<int>> _type_positions;
+	std::vector<ObjectIdx> _type_offsets;
+
+	//! The index into '_reached' of the first atom of each variable, i.e. of the atom with the first object of the variable type
+	std::vector<unsigned> _atom_offsets;
+
+	//! Whether each atom has been reached
+	std::vector<bool> _reached;
+	unsigned _num_reachable_atoms;
+
+	//! The iteration at which each symbol last got some new atom, so that the schemas that depend on the symbol get re-enumerated
+	std::vector<unsigned> _symbol_updates;
+
+	//! The reachable bindings of each schema
+	std::vector<std::vector<ValueTuple>> _bindings;
+
+	unsigned _iterations;
+	unsigned long _examined;
+
+	//! Reach the given atom, if it is a valid one. Returns true iff it had not been reached before.
+	bool reach(VariableIdx variable, ObjectIdx value);
+
+	//! Reach all the atoms of the given variable
+	void reach_all(VariableIdx variable);
+
+	//! The index of the given atom into '_reached', or -1 if the value does not belong to the domain of the variable
+	int atom_index(VariableIdx variable, ObjectIdx value) const;
+
+	//! Enumerate all the bindings of the given schema with relaxed-satisfiable preconditions, applying their effects
+	void enumerate(unsigned schema);
+	void enumerate(CompiledSchema& schema, unsigned parameter, Binding& binding, std::vector<ValueTuple>& found);
+
+	//! Whether the given atom might hold in some relaxed state, given a binding of all the parameters that appear on it
+	bool satisfiable(const CompiledAtom& atom, const Binding& binding) const;
+
+	void apply(CompiledEffect& effect, const Binding& binding);
+};
+
+} // namespaces
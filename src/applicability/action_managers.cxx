@@ -7,6 +7,7 @@
 #include <utils/system.hxx>
 
 #include <applicability/action_managers.hxx>
+#include <applicability/compiled_formula.hxx>
 #include <actions/actions.hxx>
 #include <state.hxx>
 #include <problem_info.hxx>
@@ -70,8 +71,8 @@ bool NaiveApplicabilityManager::checkAtomsWithinBounds(const std::vector<Atom>&
 
 
 
-SmartActionManager::SmartActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx, const BasicApplicabilityAnalyzer& analyzer) :
-	Base(actions, state_constraints),
+SmartActionManager::SmartActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx, const BasicApplicabilityAnalyzer& analyzer, const StateAtomIndexer* indexer) :
+	Base(actions, state_constraints, indexer),
 	_tuple_idx(tuple_idx),
 	_vars_affected_by_actions(),
 	_vars_relevant_to_constraints(),
@@ -235,7 +236,7 @@ BasicApplicabilityAnalyzer::build(bool build_applicable_index) {
 // 				std::cout << "Precondition: " << *eq << std::endl;
 				ObjectIdx value = _extract_constant_val(neq->lhs(), neq->rhs());
 				for (ObjectIdx v2:values) {
-					if (v2 != value) {
+					if (v2 != value && _tuple_idx.is_indexed(relevant, v2)) {
 						AtomIdx tup = _tuple_idx.to_index(relevant, v2);
 						if (build_applicable_index) {
 							_applicable[tup].push_back(i);
@@ -252,6 +253,7 @@ BasicApplicabilityAnalyzer::build(bool build_applicable_index) {
 				if (referenced.find(var) != referenced.end()) continue;
 
 				for (ObjectIdx val:info.getVariableObjects(var)) {
+					if (!_tuple_idx.is_indexed(var, val)) continue; // e.g. unreachable atoms
 					AtomIdx tup = _tuple_idx.to_index(var, val);
 					_applicable[tup].push_back(i);
 				}
@@ -345,21 +347,35 @@ _process_state_constraints(const fs::Formula* state_constraints) {
 }
 
 
-NaiveActionManager::NaiveActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints) :
+NaiveActionManager::NaiveActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const StateAtomIndexer* indexer) :
 	_actions(actions),
 	_state_constraints(_process_state_constraints(state_constraints)),
-	_all_actions_whitelist(_build_all_actions_whitelist(actions.size()))
-{}
+	_all_actions_whitelist(_build_all_actions_whitelist(actions.size())),
+	_compiled_preconditions()
+{
+	if (!indexer) return;
+	
+	unsigned compiled = 0;
+	_compiled_preconditions.reserve(actions.size());
+	for (const GroundAction* action:actions) {
+		assert(action->getId() == _compiled_preconditions.size());
+		_compiled_preconditions.push_back(std::shared_ptr<const CompiledFormula>(CompiledFormula::compile(action->getPrecondition(), *indexer)));
+		if (_compiled_preconditions.back()) ++compiled;
+	}
+	LPT_INFO("cout", "Compiled the preconditions of " << compiled << " out of " << actions.size() << " ground actions");
+}
 
 bool
 NaiveActionManager::applicable(const State& state, const GroundAction& action) const {
-	if (!NaiveApplicabilityManager::checkFormulaHolds(action.getPrecondition(), state)) return false;
+	const CompiledFormula* compiled = _compiled_preconditions.empty() ? nullptr : _compiled_preconditions[action.getId()].get();
+	if (compiled ? !compiled->satisfied(state) : !NaiveApplicabilityManager::checkFormulaHolds(action.getPrecondition(), state)) return false;
 
-	NaiveApplicabilityManager::computeEffects(state, action, _effects_cache);
-	if (!NaiveApplicabilityManager::checkAtomsWithinBounds(_effects_cache)) return false; // TODO - THIS SHOULD BE OPTIMIZED
+	static thread_local std::vector<Atom> effects;
+	NaiveApplicabilityManager::computeEffects(state, action, effects);
+	if (!NaiveApplicabilityManager::checkAtomsWithinBounds(effects)) return false; // TODO - THIS SHOULD BE OPTIMIZED
 
 	if (!_state_constraints.empty()) { // If we have no constraints, we can spare the cost of further checks
-		State next(state, _effects_cache);
+		State next(state, effects);
 		return check_constraints(action.getId(), next);
 	}
 	return true;
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_set>
 
 #include <fs_types.hxx>
@@ -14,6 +15,8 @@ class State;
 class GroundAction;
 class Atom;
 class AtomIndex;
+class StateAtomIndexer;
+class CompiledFormula;
 
 
 //! A simple manager that only checks applicability of actions in a non-relaxed setting.
@@ -87,7 +90,8 @@ public:
 	using Base = ActionManagerI;
 	using ApplicableSet = typename Base::ApplicableSet;
 
-	NaiveActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints);
+	//! If an indexer is given, action preconditions are compiled (where possible) for states indexed by it
+	NaiveActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const StateAtomIndexer* indexer = nullptr);
 	~NaiveActionManager() = default;
 
 	//! Return the set of all actions applicable in a given state
@@ -108,10 +112,11 @@ protected:
 	//! A list <0,1, ..., num_actions>
 	const std::vector<ActionIdx> _all_actions_whitelist;
 	
-	//! Optimization - A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
-	
+	//! The compiled precondition of each action, indexed by action ID, or null if it cannot be compiled.
+	//! Empty if no indexer was given on construction.
+	std::vector<std::shared_ptr<const CompiledFormula>> _compiled_preconditions;
 	
+
 protected:
 	//! Check whether any state constraint is violated in the given state, knowing the last-applied action
 	virtual bool check_constraints(unsigned applied_action_id, const State& state) const;
@@ -125,7 +130,7 @@ public:
 	using Base = NaiveActionManager;
 	using ApplicableSet = typename Base::ApplicableSet;
 
-	SmartActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx, const BasicApplicabilityAnalyzer& analyzer);
+	SmartActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx, const BasicApplicabilityAnalyzer& analyzer, const StateAtomIndexer* indexer = nullptr);
 	~SmartActionManager() = default;
 	SmartActionManager(const SmartActionManager&) = default;
 
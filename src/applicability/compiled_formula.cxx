@@ -0,0 +1,179 @@
+
+#include <applicability/compiled_formula.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <problem_info.hxx>
+
+
+namespace fs0 {
+
+CompiledFormula*
+CompiledFormula::compile(const fs::Formula* formula, const StateAtomIndexer& indexer) {
+	CompiledFormula* compiled = new CompiledFormula(indexer);
+	if (!compiled->compile_formula(formula)) {
+		delete compiled;
+		return nullptr;
+	}
+	return compiled;
+}
+
+CompiledFormula::Instruction&
+CompiledFormula::emit(OpCode op) {
+	_program.push_back(Instruction{op, 0, 0, 0, 0, StateAtomIndexer::Location{StateAtomIndexer::Location::Storage::Int, 0}});
+	return _program.back();
+}
+
+bool
+CompiledFormula::compile_formula(const fs::Formula* formula) {
+	if (formula->is_tautology()) return true;
+
+	if (formula->is_contradiction()) {
+		emit(OpCode::Fail);
+		return true;
+	}
+
+	if (auto conjunction = dynamic_cast<const fs::Conjunction*>(formula)) {
+		for (const fs::Formula* conjunct:conjunction->getSubformulae()) {
+			if (!compile_formula(conjunct)) return false;
+		}
+		return true;
+	}
+
+	auto atom = dynamic_cast<const fs::RelationalFormula*>(formula);
+	if (!atom) return false;
+
+	auto symbol = atom->symbol();
+
+	// Atoms X=c and X!=c are checked with a single instruction
+	auto variable = dynamic_cast<const fs::StateVariable*>(atom->lhs());
+	auto constant = dynamic_cast<const fs::Constant*>(atom->rhs());
+	if (variable && constant && (symbol == fs::RelationalFormula::Symbol::EQ || symbol == fs::RelationalFormula::Symbol::NEQ)) {
+		Instruction& check = emit(symbol == fs::RelationalFormula::Symbol::EQ ? OpCode::VariableEQ : OpCode::VariableNEQ);
+		check.location = _indexer.locate(variable->getValue());
+		check.value = constant->getValue();
+		return true;
+	}
+
+	unsigned lhs = 0, rhs = 0;
+	if (!compile_term(atom->lhs(), lhs) || !compile_term(atom->rhs(), rhs)) return false;
+
+	OpCode op = OpCode::Fail;
+	switch (symbol) {
+		case fs::RelationalFormula::Symbol::EQ: op = OpCode::EQ; break;
+		case fs::RelationalFormula::Symbol::NEQ: op = OpCode::NEQ; break;
+		case fs::RelationalFormula::Symbol::LT: op = OpCode::LT; break;
+		case fs::RelationalFormula::Symbol::LEQ: op = OpCode::LEQ; break;
+		case fs::RelationalFormula::Symbol::GT: op = OpCode::GT; break;
+		case fs::RelationalFormula::Symbol::GEQ: op = OpCode::GEQ; break;
+	}
+	Instruction& check = emit(op);
+	check.lhs = lhs;
+	check.rhs = rhs;
+	return true;
+}
+
+bool
+CompiledFormula::compile_term(const fs::Term* term, unsigned& reg) {
+	if (auto constant = dynamic_cast<const fs::Constant*>(term)) {
+		Instruction& load = emit(OpCode::Constant);
+		load.dst = reg = _num_registers++;
+		load.value = constant->getValue();
+		return true;
+	}
+
+	if (auto variable = dynamic_cast<const fs::StateVariable*>(term)) {
+		Instruction& load = emit(OpCode::Variable);
+		load.dst = reg = _num_registers++;
+		load.location = _indexer.locate(variable->getValue());
+		return true;
+	}
+
+	if (auto arithmetic = dynamic_cast<const fs::ArithmeticTerm*>(term)) {
+		OpCode op;
+		if (dynamic_cast<const fs::AdditionTerm*>(term)) op = OpCode::Add;
+		else if (dynamic_cast<const fs::SubtractionTerm*>(term)) op = OpCode::Sub;
+		else if (dynamic_cast<const fs::MultiplicationTerm*>(term)) op = OpCode::Mul;
+		else return false;
+
+		const auto& subterms = arithmetic->getSubterms();
+		unsigned lhs = 0, rhs = 0;
+		if (!compile_term(subterms[0], lhs) || !compile_term(subterms[1], rhs)) return false;
+		Instruction& operation = emit(op);
+		operation.dst = reg = _num_registers++;
+		operation.lhs = lhs;
+		operation.rhs = rhs;
+		return true;
+	}
+
+	if (auto function = dynamic_cast<const fs::UserDefinedStaticTerm*>(term)) {
+		const auto& subterms = function->getSubterms();
+		std::vector<unsigned> arguments(subterms.size());
+		for (unsigned i = 0; i < subterms.size(); ++i) {
+			if (!compile_term(subterms[i], arguments[i])) return false;
+		}
+
+		Instruction& call = emit(OpCode::Static);
+		call.dst = reg = _num_registers++;
+		call.lhs = _arguments.size();
+		call.rhs = arguments.size();
+		call.value = _functions.size();
+		_arguments.insert(_arguments.end(), arguments.begin(), arguments.end());
+		const SymbolData& data = ProblemInfo::getInstance().getSymbolData(function->getSymbolId());
+		_functions.push_back(&data.getFunction());
+		_tables.push_back(data.getTable());
+		return true;
+	}
+
+	return false;
+}
+
+bool
+CompiledFormula::satisfied(const State& state) const {
+	fs::InterpretationBuffer buffer(_num_registers);
+	ObjectIdxVector& registers = buffer.get();
+
+	for (const Instruction& instruction:_program) {
+		switch (instruction.op) {
+			case OpCode::Constant:
+				registers[instruction.dst] = instruction.value;
+				break;
+			case OpCode::Variable:
+				registers[instruction.dst] = _indexer.get(state, instruction.location);
+				break;
+			case OpCode::Add:
+				registers[instruction.dst] = registers[instruction.lhs] + registers[instruction.rhs];
+				break;
+			case OpCode::Sub:
+				registers[instruction.dst] = registers[instruction.lhs] - registers[instruction.rhs];
+				break;
+			case OpCode::Mul:
+				registers[instruction.dst] = registers[instruction.lhs] * registers[instruction.rhs];
+				break;
+			case OpCode::Static: {
+				fs::InterpretationBuffer arguments(instruction.rhs);
+				ObjectIdxVector& values = arguments.get();
+				for (unsigned i = 0; i < instruction.rhs; ++i) values[i] = registers[_arguments[instruction.lhs + i]];
+				const utils::StaticTable* table = _tables[instruction.value];
+				registers[instruction.dst] = table ? table->value(values.data(), instruction.rhs) : (*_functions[instruction.value])(values);
+				break;
+			}
+			case OpCode::EQ: if (!(registers[instruction.lhs] == registers[instruction.rhs])) return false; break;
+			case OpCode::NEQ: if (!(registers[instruction.lhs] != registers[instruction.rhs])) return false; break;
+			case OpCode::LT: if (!(registers[instruction.lhs] < registers[instruction.rhs])) return false; break;
+			case OpCode::LEQ: if (!(registers[instruction.lhs] <= registers[instruction.rhs])) return false; break;
+			case OpCode::GT: if (!(registers[instruction.lhs] > registers[instruction.rhs])) return false; break;
+			case OpCode::GEQ: if (!(registers[instruction.lhs] >= registers[instruction.rhs])) return false; break;
+			case OpCode::VariableEQ:
+				if (_indexer.get(state, instruction.location) != instruction.value) return false;
+				break;
+			case OpCode::VariableNEQ:
+				if (_indexer.get(state, instruction.location) == instruction.value) return false;
+				break;
+			case OpCode::Fail:
+				return false;
+		}
+	}
+	return true;
+}
+
+} // namespaces
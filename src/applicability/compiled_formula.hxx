@@ -0,0 +1,89 @@
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <fs_types.hxx>
+#include <state.hxx>
+
+namespace fs0 { namespace utils { class StaticTable; }}
+namespace fs0 { namespace language { namespace fstrips { class Formula; class Term; }}}
+namespace fs = fs0::language::fstrips;
+
+namespace fs0 {
+
+//! A ground formula compiled into a flat program, so that its satisfaction on a state can be checked
+//! without walking the tree of (virtual) formula and term nodes. The program is a sequence of instructions
+//! operating on an array of registers, one per compiled subterm: first the subterms of each atom are
+//! evaluated into their registers, then the atom is checked, and the evaluation stops with a negative
+//! result as soon as some atom does not hold. Atoms of the form X=c and X!=c, by far the most common ones,
+//! take a single instruction. State variables are resolved into their location in the state storage at
+//! compilation time, hence a compiled formula can only be evaluated on states indexed by the same indexer.
+//! Only conjunctions of relational atoms over state variables, constants, arithmetic terms and static
+//! symbols can be compiled; formulae with any other construct (quantifiers, disjunctions, nested fluents,
+//! externally-defined or axiomatic atoms, etc.) need to be interpreted as usual.
+class CompiledFormula {
+public:
+	//! Compile the given formula for states indexed by the given indexer, returning null if it cannot be compiled
+	static CompiledFormula* compile(const fs::Formula* formula, const StateAtomIndexer& indexer);
+
+	CompiledFormula(const CompiledFormula&) = default;
+	CompiledFormula& operator=(const CompiledFormula&) = delete;
+
+	//! Returns true iff the formula is satisfied in the given state
+	bool satisfied(const State& state) const;
+
+	//! The number of instructions of the program
+	std::size_t size() const { return _program.size(); }
+
+protected:
+	enum class OpCode : unsigned char {
+		Constant,     // r[dst] = value
+		Variable,     // r[dst] = s[location]
+		Add,          // r[dst] = r[lhs] + r[rhs]
+		Sub,          // r[dst] = r[lhs] - r[rhs]
+		Mul,          // r[dst] = r[lhs] * r[rhs]
+		Static,       // r[dst] = functions[value](r[args[lhs]], ..., r[args[lhs + rhs - 1]]), through tables[value] if not null
+		EQ, NEQ, LT, LEQ, GT, GEQ, // Fail unless r[lhs] <op> r[rhs]
+		VariableEQ,   // Fail unless s[location] == value
+		VariableNEQ,  // Fail unless s[location] != value
+		Fail
+	};
+
+	struct Instruction {
+		OpCode op;
+		unsigned dst;
+		unsigned lhs;
+		unsigned rhs;
+		ObjectIdx value;
+		StateAtomIndexer::Location location;
+	};
+
+	CompiledFormula(const StateAtomIndexer& indexer) : _indexer(indexer), _program(), _num_registers(0), _arguments(), _functions(), _tables() {}
+
+	//! Append to the program the instructions that check the given formula, returning false if it cannot be compiled
+	bool compile_formula(const fs::Formula* formula);
+
+	//! Append to the program the instructions that evaluate the given term into a new register, whose index
+	//! is left in 'reg'; returns false if the term cannot be compiled
+	bool compile_term(const fs::Term* term, unsigned& reg);
+
+	Instruction& emit(OpCode op);
+
+	const StateAtomIndexer& _indexer;
+
+	std::vector<Instruction> _program;
+
+	//! The number of registers the program needs
+	unsigned _num_registers;
+
+	//! The registers holding the arguments of each static function call, contiguously
+	std::vector<unsigned> _arguments;
+
+	//! The static functions called by the program, and the tables implementing them, where available
+	std::vector<const Function*> _functions;
+	std::vector<const utils::StaticTable*> _tables;
+};
+
+} // namespaces
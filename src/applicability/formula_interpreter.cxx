@@ -1,5 +1,6 @@
 
 #include <applicability/formula_interpreter.hxx>
+#include <applicability/compiled_formula.hxx>
 #include <languages/fstrips/language.hxx>
 #include <languages/fstrips/operations.hxx>
 #include <utils/utils.hxx>
@@ -8,7 +9,7 @@
 
 namespace fs0 {
 
-FormulaInterpreter* FormulaInterpreter::create(const fs::Formula* formula, const AtomIndex& tuple_index) {
+FormulaInterpreter* FormulaInterpreter::create(const fs::Formula* formula, const AtomIndex& tuple_index, const StateAtomIndexer& indexer) {
 	// If there is some quantified variable in the formula, we will use a CSP-based interpreter
 	auto existential_formulae = Utils::filter_by_type<const fs::ExistentiallyQuantifiedFormula*>(fs::all_formulae(*formula));
 	if (!existential_formulae.empty()) {
@@ -16,10 +17,15 @@ FormulaInterpreter* FormulaInterpreter::create(const fs::Formula* formula, const
 		// TODO - Note that we are cloning the formula here because otherwise the destructor of the interpreter will attempt to
 		// delete it, but the ownership does actually not belong to him.
 		return new CSPFormulaInterpreter(formula->clone(), tuple_index);
-	} else {
-		LPT_INFO("main", "Created a direct sat. manager for formula: " << *formula);
-		return new DirectFormulaInterpreter(formula);
 	}
+	
+	if (const CompiledFormula* compiled = CompiledFormula::compile(formula, indexer)) {
+		LPT_INFO("main", "Created a compiled sat. manager (" << compiled->size() << " instructions) for formula: " << *formula);
+		return new CompiledFormulaInterpreter(formula, compiled);
+	}
+	
+	LPT_INFO("main", "Created a direct sat. manager for formula: " << *formula);
+	return new DirectFormulaInterpreter(formula);
 }
 
 FormulaInterpreter::FormulaInterpreter(const fs::Formula* formula) :
@@ -39,6 +45,24 @@ bool DirectFormulaInterpreter::satisfied(const State& state) const {
 	return _formula->interpret(state);
 }
 
+CompiledFormulaInterpreter::CompiledFormulaInterpreter(const fs::Formula* formula, const CompiledFormula* compiled) :
+	FormulaInterpreter(formula),
+	_compiled(compiled)
+{}
+
+CompiledFormulaInterpreter::~CompiledFormulaInterpreter() {
+	delete _compiled;
+}
+
+CompiledFormulaInterpreter::CompiledFormulaInterpreter(const CompiledFormulaInterpreter& other) :
+	FormulaInterpreter(other),
+	_compiled(new CompiledFormula(*other._compiled))
+{}
+
+bool CompiledFormulaInterpreter::satisfied(const State& state) const {
+	return _compiled->satisfied(state);
+}
+
 CSPFormulaInterpreter::CSPFormulaInterpreter(const fs::Formula* formula, const AtomIndex& tuple_index) :
 	FormulaInterpreter(formula),
 	// Note that we don't need any of the optimizations, since we will be instantiating the CSP on a state, not a RPG layer
@@ -3,7 +3,7 @@
 
 #include <memory>
 
-namespace fs0 { class AtomIndex; }
+namespace fs0 { class AtomIndex; class StateAtomIndexer; class CompiledFormula; }
 namespace fs0 { namespace language { namespace fstrips { class Formula; }}}
 namespace fs = fs0::language::fstrips;
 
@@ -16,8 +16,9 @@ class State;
 //! A base interface for a formula satisfiability manager
 class FormulaInterpreter {
 public:
-	//! Factory method - return a formula satisfiability manager appropriate to the given formula
-	static FormulaInterpreter* create(const fs::Formula* formula, const AtomIndex& tuple_index);
+	//! Factory method - return a formula satisfiability manager appropriate to the given formula,
+	//! to be checked on states indexed by the given indexer
+	static FormulaInterpreter* create(const fs::Formula* formula, const AtomIndex& tuple_index, const StateAtomIndexer& indexer);
 	
 	FormulaInterpreter(const fs::Formula* formula);
 	virtual ~FormulaInterpreter();
@@ -49,6 +50,24 @@ public:
 };
 
 
+//! A satisfiability manager that checks the formula through its compiled form (see CompiledFormula)
+class CompiledFormulaInterpreter : public FormulaInterpreter {
+public:
+	//! Takes ownership of the given compiled form of the formula
+	CompiledFormulaInterpreter(const fs::Formula* formula, const CompiledFormula* compiled);
+	~CompiledFormulaInterpreter();
+	CompiledFormulaInterpreter(const CompiledFormulaInterpreter&);
+
+	CompiledFormulaInterpreter* clone() const { return new CompiledFormulaInterpreter(*this); }
+
+	//! Returns true if the formula represented by the current object is satisfied in the given state
+	bool satisfied(const State& state) const;
+
+protected:
+	const CompiledFormula* _compiled;
+};
+
+
 //! A satisfiability manager that models formula satisfaction as a CSP in order to determine whether a given formula is satisfiable or not.
 class CSPFormulaInterpreter : public FormulaInterpreter {
 public:
@@ -70,6 +70,7 @@ GecodeApplicabilityAnalyzer::build(bool build_applicable_index) {
 			if (all_relevant.find(var) != all_relevant.end()) continue;
 			
 			for (ObjectIdx val:info.getVariableObjects(var)) {
+				if (!_tuple_idx.is_indexed(var, val)) continue;
 				AtomIdx tup = _tuple_idx.to_index(var, val);
 				_applicable[tup].push_back(i);
 				potentially_applicable.insert(i);
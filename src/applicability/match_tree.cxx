@@ -207,6 +207,134 @@ namespace fs0 {
         }
     }
 
+    FlatMatchTree::FlatMatchTree(const BaseNode& root, const std::vector<std::unordered_set<AtomIdx>>& rev_app_index, const AtomIndex& tuple_index) {
+		compile(root);
+
+		// Index the (variable, value) conditions of each action precondition, and the actions relevant to each variable
+		_condition_offsets.reserve(rev_app_index.size() + 1);
+		for (ActionIdx action = 0; action < rev_app_index.size(); ++action) {
+			_condition_offsets.push_back(_conditions.size());
+			for (AtomIdx atom_idx:rev_app_index[action]) {
+				const Atom& atom = tuple_index.to_atom(atom_idx);
+				_conditions.push_back(std::make_pair(atom.getVariable(), atom.getValue()));
+			}
+			std::sort(_conditions.begin() + _condition_offsets.back(), _conditions.end());
+
+			for (unsigned j = _condition_offsets.back(); j < _conditions.size(); ++j) {
+				VariableIdx variable = _conditions[j].first;
+				if (j > _condition_offsets.back() && _conditions[j-1].first == variable) continue;
+				if (variable >= _variable_actions.size()) _variable_actions.resize(variable + 1);
+				_variable_actions[variable].push_back(action);
+			}
+		}
+		_condition_offsets.push_back(_conditions.size());
+	}
+
+    unsigned FlatMatchTree::compile(const BaseNode& node) {
+		if (dynamic_cast<const EmptyNode*>(&node)) return NONE;
+
+		// Nodes are added in depth-first order, the parent before its children
+		unsigned position = _nodes.size();
+		_nodes.push_back(Node{NONE, (unsigned) _items.size(), 0, {NONE, NONE}, NONE});
+
+		if (const LeafNode* leaf = dynamic_cast<const LeafNode*>(&node)) {
+			_items.insert(_items.end(), leaf->_applicable_items.begin(), leaf->_applicable_items.end());
+			_nodes[position].items_end = _items.size();
+			return position;
+		}
+
+		const SwitchNode& sw = dynamic_cast<const SwitchNode&>(node);
+		if (sw._children.size() > 2) throw std::runtime_error("Match Tree only ready for propositional domains yet");
+		_items.insert(_items.end(), sw._immediate_items.begin(), sw._immediate_items.end());
+		_nodes[position].items_end = _items.size();
+		_nodes[position].pivot = sw._pivot;
+
+		// '_nodes' might get reallocated during the recursive calls, hence we cannot hold a reference to the node
+		for (unsigned i = 0; i < sw._children.size(); ++i) {
+			unsigned child = compile(*sw._children[i]);
+			_nodes[position].children[i] = child;
+		}
+		unsigned default_child = compile(*sw._default_child);
+		_nodes[position].default_child = default_child;
+		return position;
+	}
+
+    void FlatMatchTree::generate_applicable_items(const State& s, std::vector<ActionIdx>& actions) const {
+		if (_nodes.empty()) return;
+
+		// The stack of nodes yet to be visited
+		static thread_local std::vector<unsigned> open;
+		open.clear();
+		open.push_back(0);
+
+		while (!open.empty()) {
+			const Node& node = _nodes[open.back()];
+			open.pop_back();
+
+			actions.insert(actions.end(), _items.begin() + node.items_begin, _items.begin() + node.items_end);
+			if (node.pivot == NONE) continue;
+
+			ObjectIdx val = s.getValue(node.pivot);
+			assert((val == 0 || val == 1) && "Match Tree not yet prepared for multivalued variables");
+
+			// Pushing the default child first ensures that it is visited after the child matching the pivot value,
+			// as in the pointer-based tree
+			if (node.default_child != NONE) open.push_back(node.default_child);
+			if (node.children[val] != NONE) open.push_back(node.children[val]);
+		}
+	}
+
+    void FlatMatchTree::generate_applicable_items(const State& s, const std::vector<ActionIdx>& parent_actions, const std::vector<Atom>& effects, std::vector<ActionIdx>& actions) const {
+		// The variables affected by the effects, and the actions that need to be re-checked
+		static thread_local std::vector<bool> affected;
+		static thread_local std::vector<ActionIdx> candidates;
+		if (affected.size() < _variable_actions.size()) affected.resize(_variable_actions.size(), false);
+
+		actions.clear();
+		candidates.clear();
+		for (const Atom& atom:effects) {
+			VariableIdx variable = atom.getVariable();
+			if (variable >= _variable_actions.size() || affected[variable]) continue; // No action depends on the variable
+			affected[variable] = true;
+			candidates.insert(candidates.end(), _variable_actions[variable].begin(), _variable_actions[variable].end());
+		}
+
+		// The actions applicable in the parent remain so unless their precondition depends on some affected variable
+		for (ActionIdx action:parent_actions) {
+			bool relevant = false;
+			for (unsigned j = _condition_offsets[action], end = _condition_offsets[action+1]; j < end && !relevant; ++j) {
+				relevant = affected[_conditions[j].first];
+			}
+			if (!relevant) actions.push_back(action);
+		}
+
+		// Whereas all actions whose precondition depends on some affected variable need to be checked
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+		for (ActionIdx action:candidates) {
+			if (holds(action, s)) actions.push_back(action);
+		}
+
+		for (const Atom& atom:effects) {
+			if (atom.getVariable() < affected.size()) affected[atom.getVariable()] = false;
+		}
+	}
+
+    bool FlatMatchTree::holds(ActionIdx action, const State& s) const {
+		// The precondition holds iff each variable it refers to takes one of the values listed for it
+		for (unsigned j = _condition_offsets[action], end = _condition_offsets[action+1]; j < end;) {
+			VariableIdx variable = _conditions[j].first;
+			ObjectIdx value = s.getValue(variable);
+			bool satisfied = false;
+			for (; j < end && _conditions[j].first == variable; ++j) {
+				satisfied = satisfied || (_conditions[j].second == value);
+			}
+			if (!satisfied) return false;
+		}
+		return true;
+	}
+
+
     void
     MatchTreeActionManager::check_match_tree_can_be_used(const ProblemInfo& info) {
 		for (unsigned var = 0; var < info.getNumVariables(); ++var) {
@@ -221,10 +349,12 @@ namespace fs0 {
 
     MatchTreeActionManager::MatchTreeActionManager( const std::vector<const GroundAction*>& actions,
                                                     const fs::Formula* state_constraints,
-                                                    const AtomIndex& tuple_idx)
+                                                    const AtomIndex& tuple_idx,
+                                                    bool flat)
         : NaiveActionManager(actions, state_constraints),
         _tuple_idx(tuple_idx),
-        _tree(nullptr)
+        _tree(nullptr),
+        _flat()
     {
 		const ProblemInfo& info = ProblemInfo::getInstance();
 
@@ -263,6 +393,13 @@ namespace fs0 {
 		LPT_INFO("cout", "\tSWITCH: " << sw);
 		LPT_INFO("cout", "\tLEAF: " << leaf);
 		LPT_INFO("cout", "\tEMPTY: " << empty);
+
+		if (flat) {
+			_flat = FlatMatchTree(*_tree, analyzer.getRevApplicable(), _tuple_idx);
+			delete _tree;
+			_tree = nullptr;
+			LPT_INFO("cout", "Match Tree compiled into a flat tree with " << _flat.count_nodes() << " non-empty nodes");
+		}
     }
 
 
@@ -299,9 +436,19 @@ namespace fs0 {
 
     std::vector<ActionIdx> MatchTreeActionManager::compute_whitelist(const State& state) const {
     	std::vector<ActionIdx> result;
-        _tree->generate_applicable_items( state, _tuple_idx, result );
+    	if (_tree) _tree->generate_applicable_items( state, _tuple_idx, result );
+    	else _flat.generate_applicable_items( state, result );
     	return result;
     }
 
+    void MatchTreeActionManager::compute_whitelist(const State& state, const std::vector<ActionIdx>& parent_whitelist, const std::vector<Atom>& effects, std::vector<ActionIdx>& whitelist) const {
+		if (_tree) { // The pointer-based tree does not support incremental computation
+			whitelist.clear();
+			_tree->generate_applicable_items( state, _tuple_idx, whitelist );
+		} else {
+			_flat.generate_applicable_items( state, parent_whitelist, effects, whitelist );
+		}
+    }
+
 
 }
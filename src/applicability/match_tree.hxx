@@ -23,12 +23,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <limits>
 #include <unordered_set>
 #include <fs_types.hxx>
 #include <applicability/action_managers.hxx>
 
 
-namespace fs0 {	class ProblemInfo; class MatchTreeActionManager;}
+namespace fs0 {	class ProblemInfo; class MatchTreeActionManager; class FlatMatchTree; class Atom; }
 
 namespace fs0 { namespace language { namespace fstrips { class Formula; class AtomicFormula; } }}
 namespace fs = fs0::language::fstrips;
@@ -78,6 +79,8 @@ public:
 
 
     class SwitchNode : public BaseNode {
+    	friend class FlatMatchTree;
+
     	VariableIdx _pivot;
     	std::vector<ActionIdx> _immediate_items;
     	std::vector<BaseNode*> _children;
@@ -98,6 +101,8 @@ public:
 
 
     class LeafNode : public BaseNode {
+    	friend class FlatMatchTree;
+
     	std::vector<ActionIdx> _applicable_items;
     public:
     	LeafNode(std::vector<ActionIdx>&& actions) : _applicable_items(std::move(actions)) {}
@@ -120,6 +125,66 @@ public:
 
 
 
+    //! A compiled match tree, where all nodes are stored contiguously, in depth-first order, and refer to their
+    //! children by their position. The tree is traversed iteratively, without any virtual call, and yields the same
+    //! actions in the same order as the pointer-based tree it is compiled from.
+    //! It can also compute the actions applicable in a state incrementally, from those applicable in its parent.
+    class FlatMatchTree {
+    public:
+    	FlatMatchTree() = default;
+    	FlatMatchTree(const BaseNode& root, const std::vector<std::unordered_set<AtomIdx>>& rev_app_index, const AtomIndex& tuple_index);
+
+    	//! Append to 'actions' all the actions whose precondition holds in the given state
+    	void generate_applicable_items(const State& s, std::vector<ActionIdx>& actions) const;
+
+    	//! Write into 'actions' all the actions whose precondition holds in the given state, given all the actions
+    	//! whose precondition holds in the parent state (as computed by the tree), and the atoms produced by the action
+    	//! that leads from the parent to the given state. Only the actions whose precondition makes reference to some
+    	//! variable affected by those atoms are re-checked. The result contains the same actions as the non-incremental
+    	//! traversal, but not necessarily in the same order.
+    	void generate_applicable_items(const State& s, const std::vector<ActionIdx>& parent_actions, const std::vector<Atom>& effects, std::vector<ActionIdx>& actions) const;
+
+    	unsigned count() const { return _items.size(); }
+    	unsigned count_nodes() const { return _nodes.size(); }
+
+    protected:
+    	static const unsigned NONE = std::numeric_limits<unsigned>::max();
+
+    	struct Node {
+    		//! The variable on which the node switches, or NONE if the node is a leaf
+    		VariableIdx pivot;
+
+    		//! The range of '_items' with the actions of the node
+    		unsigned items_begin;
+    		unsigned items_end;
+
+    		//! The position of the child for each (binary) value of the pivot, and of the default child, or NONE for empty children
+    		unsigned children[2];
+    		unsigned default_child;
+    	};
+
+    	std::vector<Node> _nodes;
+
+    	//! The actions of all nodes, contiguously
+    	std::vector<ActionIdx> _items;
+
+    	//! The precondition of the i-th action requires, for each variable in the range
+    	//! [_condition_offsets[i], _condition_offsets[i+1]) of '_conditions', that its value is one of the values listed
+    	//! for it there. Entries are sorted by variable.
+    	std::vector<std::pair<VariableIdx, ObjectIdx>> _conditions;
+    	std::vector<unsigned> _condition_offsets;
+
+    	//! The actions whose precondition makes reference to each state variable
+    	std::vector<std::vector<ActionIdx>> _variable_actions;
+
+    	//! Add the given node and all its descendants to the tree, returning its position, or NONE for empty nodes
+    	unsigned compile(const BaseNode& node);
+
+    	//! Whether the precondition of the given action holds in the given state
+    	bool holds(ActionIdx action, const State& s) const;
+    };
+
+
     //! Match tree data structure from PRP ( https://bitbucket.org/haz/planner-for-relevant-policies )
     //! Ported to FS by Miquel Ramirez, on December 2016
 
@@ -130,14 +195,19 @@ public:
         friend class LeafNode;
         friend class EmptyNode;
 
-    	MatchTreeActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx);
+    	//! If 'flat' is true, the tree is compiled into a FlatMatchTree, and the pointer-based tree discarded
+    	MatchTreeActionManager(const std::vector<const GroundAction*>& actions, const fs::Formula* state_constraints, const AtomIndex& tuple_idx, bool flat = true);
     	virtual ~MatchTreeActionManager() { if (_tree) delete _tree; };
     	MatchTreeActionManager(const MatchTreeActionManager&) = default;
 
 		//! By definition, the match tree whitelist contains all the applicable actions
 		bool whitelist_guarantees_applicability() const override { return true; }
 
-		unsigned count() { return _tree->count(); }
+		unsigned count() { return _tree ? _tree->count() : _flat.count(); }
+
+		//! Write into 'whitelist' the actions applicable in the given state, incrementally from the actions applicable in its
+		//! parent state and the atoms produced by the action that led from the parent to the state (see FlatMatchTree)
+		void compute_whitelist(const State& state, const std::vector<ActionIdx>& parent_whitelist, const std::vector<Atom>& effects, std::vector<ActionIdx>& whitelist) const;
 		
 		static void check_match_tree_can_be_used(const ProblemInfo& info);
 
@@ -146,9 +216,11 @@ public:
 		//! The tuple index of the problem
 		const AtomIndex& _tuple_idx;
 
-		//!
+		//! The pointer-based tree, or null if it has been compiled into '_flat'
         BaseNode::ptr   _tree;
 
+		FlatMatchTree   _flat;
+
 	protected:
 		std::vector<ActionIdx> compute_whitelist(const State& state) const override;
 		
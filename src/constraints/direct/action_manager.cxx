@@ -1,4 +1,6 @@
 
+#include <algorithm>
+
 #include <constraints/direct/action_manager.hxx>
 #include <heuristics/relaxed_plan/rpg_data.hxx>
 #include <constraints/direct/translators/translator.hxx>
@@ -10,7 +12,6 @@
 #include <languages/fstrips/language.hxx>
 #include <languages/fstrips/operations.hxx>
 #include <relaxed_state.hxx>
-#include <actions/action_id.hxx>
 #include <actions/actions.hxx>
 
 
@@ -103,24 +104,44 @@ DirectActionManager::extractAllRelevant() const {
 
 void
 DirectActionManager::process(unsigned int actionIdx, const fs0::RelaxedState& layer, fs0::RPGData& rpg) const {
-	// We compute the projection of the current relaxed state to the variables relevant to the action
-	// Note that this _clones_ the actual domains, since we will next modify (prune) them.
-	DomainMap actionProjection = Projections::projectCopy(layer, _allRelevant);
-	
-	if (checkPreconditionApplicability(actionProjection)) { // Check with local consistency
-		processEffects(actionIdx, actionProjection, rpg);
+	if (checkPreconditionApplicability(layer)) { // Check with local consistency
+		processEffects(actionIdx, layer, rpg);
 	}
 }
 
 
 bool
-DirectActionManager::checkPreconditionApplicability(const DomainMap& domains) const {
-	FilteringOutput o = _handler.filter(domains);
-	return o != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(domains);
+DirectActionManager::checkPreconditionApplicability(const RelaxedState& layer) const {
+	const VariableIdxVector& constrained = _handler.getAllRelevantVariables();
+	
+	if (!_handler.supportsBitsets()) {
+		// We filter a (cloned) set-based projection of the layer, and leave the result in the bitset projection
+		DomainMap domains = Projections::projectCopy(layer, constrained);
+		FilteringOutput o = _handler.filter(domains);
+		if (o == FilteringOutput::Failure || !DirectCSPHandler::checkConsistency(domains)) return false;
+		_projection.resize(constrained.size());
+		for (unsigned i = 0; i < constrained.size(); ++i) {
+			_projection[i] = layer.getLayout().at(constrained[i]).encode(*domains.at(constrained[i]));
+		}
+		return true;
+	}
+	
+	// Note that this _copies_ the actual domains, since we will next modify (prune) them.
+	Projections::project(layer, constrained, _projection);
+	FilteringOutput o = _handler.filter(_projection);
+	return o != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(_projection);
+}
+
+const BitsetDomain&
+DirectActionManager::getDomain(const RelaxedState& layer, VariableIdx variable) const {
+	const VariableIdxVector& constrained = _handler.getAllRelevantVariables();
+	auto it = std::lower_bound(constrained.begin(), constrained.end(), variable);
+	if (it == constrained.end() || *it != variable) return layer.getDomain(variable); // The variable is not constrained by the precondition
+	return _projection[it - constrained.begin()];
 }
 
 void
-DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionProjection, RPGData& rpg) const {
+DirectActionManager::processEffects(unsigned actionIdx, const RelaxedState& layer, RPGData& rpg) const {
 	for (const DirectEffect* effect:_effects) {
 		const VariableIdxVector& effectScope = effect->getScope();
 
@@ -128,29 +149,30 @@ DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionP
 		if(effectScope.size() == 0) {  // No need to pass any point.
 			assert(effect->applicable()); // The effect is assumed to be applicable - non-applicable 0-ary effects make no sense and are detected before the search.
 			Atom atom = effect->apply();
-			auto hint = rpg.getInsertionHint(atom);
+			AtomIdx index = rpg.index(atom);
 
-			if (hint.first) {
-				LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields " << (hint.first ? "new" : "repeated") << " atom " << atom);
-				Atom::vctrp support = std::make_shared<Atom::vctr>();
-				completeAtomSupport(_scope, actionProjection, effectScope, support);
-				rpg.add(atom, get_action_id(actionIdx), support, hint.second);
+			if (!rpg.reached(index)) {
+				LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields new atom " << atom);
+				std::vector<AtomIdx>& support = rpg.add(atom, index, _action);
+				completeAtomSupport(_scope, layer, effectScope, rpg, support);
 			}
 		}
 
 		/***** Unary Effects *****/
 		else if(effectScope.size() == 1) {
-			for (ObjectIdx value:*(actionProjection.at(effectScope[0]))) { // Add to the RPG for every allowed value of the relevant variable
+			const VariableLayout& layout = layer.getLayout().at(effectScope[0]);
+			const BitsetDomain& domain = getDomain(layer, effectScope[0]);
+			for (auto bit = domain.find_first(); bit != BitsetDomain::npos; bit = domain.find_next(bit)) { // Add to the RPG for every allowed value of the relevant variable
+				ObjectIdx value = layout.value(bit);
 				if (!effect->applicable(value)) continue;
 				Atom atom = effect->apply(value);
-				auto hint = rpg.getInsertionHint(atom);
-
-				if (hint.first) {
-					LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields " << (hint.first ? "new" : "repeated") << " atom " << atom);
-					Atom::vctrp support = std::make_shared<Atom::vctr>();
-					support->push_back(Atom(effectScope[0], value));// Just insert the only value
-					completeAtomSupport(_scope, actionProjection, effectScope, support);
-					rpg.add(atom, get_action_id(actionIdx), support, hint.second);
+				AtomIdx index = rpg.index(atom);
+
+				if (!rpg.reached(index)) {
+					LPT_EDEBUG("heuristic", "Processing effect \"" << *effect << "\" yields new atom " << atom);
+					std::vector<AtomIdx>& support = rpg.add(atom, index, _action);
+					support.push_back(rpg.index(Atom(effectScope[0], value)));// Just insert the only value
+					completeAtomSupport(_scope, layer, effectScope, rpg, support);
 				}
 			}
 		}
@@ -161,11 +183,11 @@ DirectActionManager::processEffects(unsigned actionIdx, const DomainMap& actionP
 }
 
 void
-DirectActionManager::completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, Atom::vctrp support) const {
+DirectActionManager::completeAtomSupport(const VariableIdxVector& actionScope, const RelaxedState& layer, const VariableIdxVector& effectScope, const RPGData& rpg, std::vector<AtomIdx>& support) const {
 	for (VariableIdx variable:actionScope) {
 		if (effectScope.empty() || variable != effectScope[0]) { // (We know that the effect scope has at most one variable)
-			ObjectIdx value = *(actionProjection.at(variable)->cbegin());
-			support->push_back(Atom(variable, value));
+			ObjectIdx value = layer.getLayout().at(variable).value(getDomain(layer, variable).find_first());
+			support.push_back(rpg.index(Atom(variable, value)));
 		}
 	}
 }
@@ -177,9 +199,4 @@ DirectActionManager::print(std::ostream& os) const {
 	return os;
 }
 
-const ActionID*
-DirectActionManager::get_action_id(unsigned action_idx) const {
-	return new PlainActionID(&_action);
-}
-
 } // namespaces
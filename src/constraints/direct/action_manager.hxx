@@ -33,12 +33,13 @@ public:
 
 	void process(unsigned actionIdx, const RelaxedState& layer, RPGData& rpg) const;
 
-	//!
-	bool checkPreconditionApplicability(const DomainMap& domains) const;
+	//! Returns true iff the action is applicable on the given layer as far as local consistency goes, in which case
+	//! the domains pruned by the precondition are left in '_projection'
+	bool checkPreconditionApplicability(const RelaxedState& layer) const;
 
 protected:
 	//!
-	void processEffects(unsigned actionIdx, const DomainMap& actionProjection, RPGData& rpg) const;
+	void processEffects(unsigned actionIdx, const RelaxedState& layer, RPGData& rpg) const;
 	
 	//! The action being managed
 	const GroundAction& _action;
@@ -56,14 +57,20 @@ protected:
 	
 	const DirectCSPHandler _handler;
 	
+	//! The domains of the variables relevant to the precondition, in the order of '_handler.getAllRelevantVariables()',
+	//! pruned by the last applicability check. They are kept only to reuse their storage, which, as with the domains
+	//! cached by constraints, makes a manager usable by a single thread.
+	mutable std::vector<BitsetDomain> _projection;
+	
+	//! The domain of the given variable on the given layer, as pruned by the last applicability check
+	const BitsetDomain& getDomain(const RelaxedState& layer, VariableIdx variable) const;
+	
 	//!
-	void completeAtomSupport(const VariableIdxVector& actionScope, const DomainMap& actionProjection, const VariableIdxVector& effectScope, std::shared_ptr<std::vector<Atom>> support) const;
+	void completeAtomSupport(const VariableIdxVector& actionScope, const RelaxedState& layer, const VariableIdxVector& effectScope, const RPGData& rpg, std::vector<AtomIdx>& support) const;
 	
 	//! Extracts all the (direct) state variables that are relevant to the action
 	VariableIdxVector extractAllRelevant() const;
 	
-	const ActionID* get_action_id(unsigned action_idx) const;
-	
 	friend std::ostream& operator<<(std::ostream &os, const DirectActionManager& o) { return o.print(os); }
 	std::ostream& print(std::ostream& os) const;
 };
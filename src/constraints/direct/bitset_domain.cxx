@@ -0,0 +1,54 @@
+
+#include <cassert>
+
+#include <constraints/direct/bitset_domain.hxx>
+#include <problem_info.hxx>
+
+namespace fs0 {
+
+VariableLayout::VariableLayout(const ObjectIdxVector& values) :
+	_size(values.size()), _contiguous(true), _first(values.empty() ? 0 : values[0]), _values(), _positions()
+{
+	for (unsigned i = 0; i < values.size(); ++i) {
+		if (values[i] != _first + (ObjectIdx) i) _contiguous = false;
+	}
+	if (_contiguous) return;
+
+	_values = values;
+	for (unsigned i = 0; i < values.size(); ++i) _positions.insert(std::make_pair(values[i], i));
+}
+
+BitsetDomain VariableLayout::singleton(ObjectIdx value) const {
+	BitsetDomain domain(_size);
+	assert(position(value) < _size);
+	domain.set(position(value));
+	return domain;
+}
+
+BitsetDomain VariableLayout::encode(const Domain& domain) const {
+	BitsetDomain encoded(_size);
+	for (ObjectIdx value:domain) {
+		unsigned i = position(value);
+		if (i < _size) encoded.set(i);
+	}
+	return encoded;
+}
+
+Domain VariableLayout::decode(const BitsetDomain& domain) const {
+	assert(domain.size() == _size);
+	Domain decoded;
+	decoded.reserve(domain.count());
+	for (auto i = domain.find_first(); i != BitsetDomain::npos; i = domain.find_next(i)) {
+		decoded.insert(decoded.cend(), value(i)); // Ordered insertion whenever the values of the variable are sorted
+	}
+	return decoded;
+}
+
+DomainLayout::DomainLayout(const ProblemInfo& info) {
+	_layouts.reserve(info.getNumVariables());
+	for (VariableIdx variable = 0; variable < info.getNumVariables(); ++variable) {
+		_layouts.push_back(VariableLayout(info.getVariableObjects(variable)));
+	}
+}
+
+} // namespaces
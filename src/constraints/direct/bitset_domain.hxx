@@ -0,0 +1,71 @@
+
+#pragma once
+
+#include <fs_types.hxx>
+#include <boost/container/flat_map.hpp>
+#include <boost/dynamic_bitset.hpp>
+
+
+namespace fs0 {
+
+class ProblemInfo;
+
+//! A bitset domain of a state variable has one bit per value of the variable, as laid out by a VariableLayout,
+//! and holds the values whose bit is set.
+using BitsetDomain = boost::dynamic_bitset<>;
+
+/**
+ * The layout of the values of a state variable onto the bits of a BitsetDomain: the i-th value of the variable,
+ * in the order given by ProblemInfo::getVariableObjects, is held by the i-th bit.
+ * Ranges of contiguous values, e.g. those of bounded integer types, are laid out without any lookup table.
+ */
+class VariableLayout {
+public:
+	explicit VariableLayout(const ObjectIdxVector& values);
+
+	//! The number of values of the variable, i.e. the number of bits of its domains
+	unsigned size() const { return _size; }
+
+	//! The value held by the given bit
+	ObjectIdx value(unsigned position) const { return _contiguous ? _first + position : _values[position]; }
+
+	//! The bit that holds the given value, or 'size()' if the value is not a value of the variable
+	unsigned position(ObjectIdx value) const {
+		if (_contiguous) return (value >= _first && value < _first + (ObjectIdx) _size) ? value - _first : _size;
+		auto it = _positions.find(value);
+		return (it == _positions.end()) ? _size : it->second;
+	}
+
+	//! An empty domain of the variable, and one with the only given value
+	BitsetDomain empty() const { return BitsetDomain(_size); }
+	BitsetDomain singleton(ObjectIdx value) const;
+
+	//! Translations from and into the set-based domains
+	BitsetDomain encode(const Domain& domain) const;
+	Domain decode(const BitsetDomain& domain) const;
+
+protected:
+	unsigned _size;
+
+	//! Whether the values are the range [_first, _first + _size), in which case no lookup table is kept
+	bool _contiguous;
+	ObjectIdx _first;
+
+	ObjectIdxVector _values;
+	boost::container::flat_map<ObjectIdx, unsigned> _positions;
+};
+
+//! The layouts of all the state variables of a problem
+class DomainLayout {
+public:
+	explicit DomainLayout(const ProblemInfo& info);
+
+	const VariableLayout& at(VariableIdx variable) const { return _layouts.at(variable); }
+
+	unsigned getNumVariables() const { return _layouts.size(); }
+
+protected:
+	std::vector<VariableLayout> _layouts;
+};
+
+} // namespaces
@@ -11,7 +11,9 @@
 namespace fs0 {
 
 CompiledUnaryConstraint::CompiledUnaryConstraint(const VariableIdxVector& scope, const std::vector<int>& parameters, ExtensionT&& extension) : 
-	UnaryDirectConstraint(scope, parameters), _extension(extension)
+	UnaryDirectConstraint(scope, parameters),
+	_layout(ProblemInfo::getInstance().getVariableObjects(scope[0])),
+	_mask(mask(_layout, extension))
 {}
 
 CompiledUnaryConstraint::CompiledUnaryConstraint(const UnaryDirectConstraint& constraint) :
@@ -45,8 +47,18 @@ CompiledUnaryConstraint::ExtensionT CompiledUnaryConstraint::_compile(const Unar
 	return ExtensionT(ordered.begin(), ordered.end());
 }
 
+BitsetDomain CompiledUnaryConstraint::mask(const VariableLayout& layout, const ExtensionT& extension) {
+	BitsetDomain mask = layout.empty();
+	for (ObjectIdx value:extension) {
+		assert(layout.position(value) < layout.size());
+		mask.set(layout.position(value));
+	}
+	return mask;
+}
+
 bool CompiledUnaryConstraint::isSatisfied(ObjectIdx o) const {
-	return std::binary_search(_extension.begin(), _extension.end(), o); // TODO - Change for a O(1) lookup in a std::unordered_set ?
+	unsigned position = _layout.position(o);
+	return position < _layout.size() && _mask.test(position);
 }
 
 FilteringOutput CompiledUnaryConstraint::filter(const DomainMap& domains) const {
@@ -56,7 +68,9 @@ FilteringOutput CompiledUnaryConstraint::filter(const DomainMap& domains) const
 	Domain& domain = *(projection[0]);
 	Domain new_domain;
 
-	std::set_intersection(domain.begin(), domain.end(), _extension.begin(), _extension.end(), std::inserter(new_domain, new_domain.end()));
+	for (ObjectIdx value:domain) {
+		if (isSatisfied(value)) new_domain.insert(new_domain.cend(), value); // We insert on the end of the container, as it is already sorted.
+	}
 	
 	if (new_domain.size() == domain.size()) return FilteringOutput::Unpruned;
 	if (new_domain.size() == 0) return FilteringOutput::Failure;
@@ -66,34 +80,48 @@ FilteringOutput CompiledUnaryConstraint::filter(const DomainMap& domains) const
 	return FilteringOutput::Pruned;
 }
 
+FilteringOutput CompiledUnaryConstraint::filter(BitsetDomain& domain) const {
+	assert(domain.size() == _mask.size());
+	if (domain.is_subset_of(_mask)) return FilteringOutput::Unpruned;
+	domain &= _mask;
+	return domain.none() ? FilteringOutput::Failure : FilteringOutput::Pruned;
+}
+
 std::ostream& CompiledUnaryConstraint::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "CompiledUnaryConstraint[" << info.getVariableName(_scope[0]) << "] = {";
-	for (const auto& elem:_extension) {
-		os << elem;
+	for (auto i = _mask.find_first(); i != BitsetDomain::npos; i = _mask.find_next(i)) {
+		os << _layout.value(i);
 	}
 	os << "}";
 	return os;
 }
 
 CompiledBinaryConstraint::CompiledBinaryConstraint(const BinaryDirectConstraint& constraint, const ProblemInfo& problemInfo) :
-	CompiledBinaryConstraint(constraint.getScope(), constraint.getParameters(), compile(constraint))
+	CompiledBinaryConstraint(constraint.getScope(), constraint.getParameters(), [&constraint](ObjectIdx x, ObjectIdx y){ return constraint.isSatisfied(x, y); })
 {}
 
 CompiledBinaryConstraint::CompiledBinaryConstraint(const VariableIdxVector& scope, const std::vector<int>& parameters, const CompiledBinaryConstraint::TupleExtension& extension) 
-	: BinaryDirectConstraint(scope, parameters), _extension1(index(extension, 0)),  _extension2(index(extension, 1))
+	: CompiledBinaryConstraint(scope, parameters, [&extension](ObjectIdx x, ObjectIdx y){ return extension.find(std::make_tuple(x, y)) != extension.end(); })
 {}
 
 CompiledBinaryConstraint::CompiledBinaryConstraint(const VariableIdxVector& scope, const CompiledBinaryConstraint::Tester& tester) 
-	: CompiledBinaryConstraint(scope, {}, compile(scope, tester))
+	: CompiledBinaryConstraint(scope, {}, tester)
+{}
+
+CompiledBinaryConstraint::CompiledBinaryConstraint(const VariableIdxVector& scope, const std::vector<int>& parameters, const CompiledBinaryConstraint::Tester& tester)
+	: BinaryDirectConstraint(scope, parameters),
+	  _layout1(ProblemInfo::getInstance().getVariableObjects(scope[0])),
+	  _layout2(ProblemInfo::getInstance().getVariableObjects(scope[1])),
+	  _extension1(index(_layout1, _layout2, 0, tester)),
+	  _extension2(index(_layout2, _layout1, 1, tester))
 {}
 
 
 bool CompiledBinaryConstraint::isSatisfied(ObjectIdx o1, ObjectIdx o2) const {
-	auto iter = _extension1.find(o1);
-	assert(iter != _extension1.end());
-	const ObjectIdxVector& D_y = iter->second; // iter->second contains all the elements y of the domain of the second variable such that <x, y> satisfies the constraint
-	return std::binary_search(D_y.begin(), D_y.end(), o2); // TODO - Change for a O(1) lookup in a std::unordered_set ?
+	unsigned x = _layout1.position(o1), y = _layout2.position(o2);
+	assert(x < _layout1.size());
+	return y < _layout2.size() && _extension1[x].test(y);
 }
 
 CompiledBinaryConstraint::TupleExtension CompiledBinaryConstraint::compile(const VariableIdxVector& scope, const CompiledBinaryConstraint::Tester& tester) {
@@ -113,23 +141,17 @@ CompiledBinaryConstraint::TupleExtension CompiledBinaryConstraint::compile(const
 }
 
 
-CompiledBinaryConstraint::ExtensionT CompiledBinaryConstraint::index(const CompiledBinaryConstraint::TupleExtension& extension, unsigned variable) {
+CompiledBinaryConstraint::ExtensionT CompiledBinaryConstraint::index(const VariableLayout& layout, const VariableLayout& other, unsigned variable, const CompiledBinaryConstraint::Tester& tester) {
 	assert(variable == 0 || variable == 1);
-	std::map<ObjectIdx, std::set<ObjectIdx>> values;
-	
-	// We perform two passes to make sure that elements are sorted, although depending on the compilation flags this is unnecessary
-	
-	for (const auto& tuple:extension) {
-		ObjectIdx x = (variable == 0) ? std::get<0>(tuple) : std::get<1>(tuple);
-		ObjectIdx y = (variable == 0) ? std::get<1>(tuple) : std::get<0>(tuple);
-		values[x].insert(y);
-	}
-
-	ExtensionT res;
-	for (const auto& element:values) {
-		res.insert(std::make_pair(element.first, ObjectIdxVector(element.second.begin(), element.second.end()) ));
+	ExtensionT supports(layout.size(), other.empty());
+	for (unsigned x = 0; x < layout.size(); ++x) {
+		for (unsigned y = 0; y < other.size(); ++y) {
+			// We need to invoke the tester with the values in the right order
+			bool satisfied = (variable == 0) ? tester(layout.value(x), other.value(y)) : tester(other.value(y), layout.value(x));
+			if (satisfied) supports[x].set(y);
+		}
 	}
-	return res;
+	return supports;
 }
 
 
@@ -137,17 +159,18 @@ FilteringOutput CompiledBinaryConstraint::filter(unsigned variable) const {
 	assert(projection.size() == 2);
 	assert(variable == 0 || variable == 1);
 	unsigned other = (variable == 0) ? 1 : 0;
-	const ExtensionT& extension_map = (variable == 0) ? _extension1 : _extension2;
+	const ExtensionT& supports = (variable == 0) ? _extension1 : _extension2;
+	const VariableLayout& layout = (variable == 0) ? _layout1 : _layout2;
+	const VariableLayout& other_layout = (variable == 0) ? _layout2 : _layout1;
 	
 	Domain& domain = *(projection[variable]);
-	Domain& other_domain = *(projection[other]);
+	BitsetDomain other_domain = other_layout.encode(*(projection[other]));
 	Domain new_domain;
 	
 	for (ObjectIdx x:domain) {
-		auto iter = extension_map.find(x);
-		assert(iter != extension_map.end());
-		const auto& D_y = iter->second; // iter->second contains all the elements y of the domain of the second variable such that <x, y> satisfies the constraint
-		if (!Utils::empty_intersection(other_domain.begin(), other_domain.end(), D_y.begin(), D_y.end())) {
+		unsigned position = layout.position(x);
+		assert(position < layout.size());
+		if (supports[position].intersects(other_domain)) {
 			new_domain.insert(new_domain.cend(), x); //  x is an arc-consistent value. We will insert on the end of the container, as it is already sorted.
 		}
 	}
@@ -159,24 +182,42 @@ FilteringOutput CompiledBinaryConstraint::filter(unsigned variable) const {
 	return FilteringOutput::Pruned;
 }
 
+FilteringOutput CompiledBinaryConstraint::filter(unsigned variable, BitsetDomain& domain, const BitsetDomain& other) const {
+	assert(variable == 0 || variable == 1);
+	const ExtensionT& supports = (variable == 0) ? _extension1 : _extension2;
+	assert(domain.size() == supports.size());
+	
+	bool pruned = false;
+	for (auto x = domain.find_first(); x != BitsetDomain::npos; x = domain.find_next(x)) {
+		if (!supports[x].intersects(other)) {
+			domain.reset(x);
+			pruned = true;
+		}
+	}
+	if (!pruned) return FilteringOutput::Unpruned;
+	return domain.none() ? FilteringOutput::Failure : FilteringOutput::Pruned;
+}
+
 std::ostream& CompiledBinaryConstraint::print(std::ostream& os) const {
 	os << "CompiledBinaryConstraint[" << print::container(print::Helper::name_variables(_scope)) << "] = {" << std::endl;
 	os << "First view: " << std::endl;
-	for (const auto& elem:_extension1) {
-		os << "\t" << elem.first << ": [";
-		for (const auto& elem2:elem.second) {
-			os << elem2 << ", ";
+	for (unsigned x = 0; x < _extension1.size(); ++x) {
+		os << "\t" << _layout1.value(x) << ": [";
+		const BitsetDomain& support = _extension1[x];
+		for (auto y = support.find_first(); y != BitsetDomain::npos; y = support.find_next(y)) {
+			os << _layout2.value(y) << ", ";
 		}
 		os << "]" << std::endl;
 	}
 	
 	os << "Second view: " << std::endl;
-	for (const auto& elem:_extension2) {
-	os << "\t" << elem.first << ": [";
-	for (const auto& elem2:elem.second) {
-		os << elem2 << ", ";
-	}
-	os << "]" << std::endl;
+	for (unsigned y = 0; y < _extension2.size(); ++y) {
+		os << "\t" << _layout2.value(y) << ": [";
+		const BitsetDomain& support = _extension2[y];
+		for (auto x = support.find_first(); x != BitsetDomain::npos; x = support.find_next(x)) {
+			os << _layout1.value(x) << ", ";
+		}
+		os << "]" << std::endl;
 	}
 	os << "}";
 	return os;
@@ -1,13 +1,13 @@
 
 #pragma once
 
-#include <unordered_map>
 #include <set>
 #include <functional>
 #include <boost/container/flat_map.hpp>
 
 #include <constraints/direct/constraint.hxx>
 #include <constraints/direct/effect.hxx>
+#include <constraints/direct/bitset_domain.hxx>
 
 
 namespace fs0 { namespace language { namespace fstrips { class Term; } } }
@@ -20,8 +20,10 @@ protected:
 	typedef ObjectIdx ElementT;
 	typedef std::vector<ElementT> ExtensionT;
 	
-	//! Precondition: the vector is sorted.
-	const ExtensionT _extension;
+	const VariableLayout _layout;
+	
+	//! The values that satisfy the constraint, as a mask over the domain of the variable
+	const BitsetDomain _mask;
 
 	//! Protected constructor to be used from the other constructor
 	CompiledUnaryConstraint(const VariableIdxVector& scope, const std::vector<int>& parameters, ExtensionT&& extension);
@@ -42,6 +44,9 @@ public:
 	//! Filters from a new set of domains.
 	FilteringOutput filter(const DomainMap& domains) const override;
 	
+	//! Filters the given bitset domain of the variable by intersecting it with the mask of the constraint
+	FilteringOutput filter(BitsetDomain& domain) const;
+	
 	//! Compiled constraints cannot be compiled again!
 	DirectConstraint* compile(const ProblemInfo& info) const override { return nullptr; }
 	
@@ -60,6 +65,8 @@ protected:
 	static ExtensionT _compile(const UnaryDirectConstraint& constraint);
 	
 	static ExtensionT _compile(const VariableIdxVector& scope, const Tester& tester);
+	
+	static BitsetDomain mask(const VariableLayout& layout, const ExtensionT& extension);
 };
 
 
@@ -70,11 +77,14 @@ public:
 	typedef std::function<bool (ObjectIdx, ObjectIdx)> Tester;
 	
 protected:
-	// For a binary constraint with scope <X, Y>, the extension is a map mapping each possible x \in D_X to an ordered 
-	// vector containing all y \in D_Y s.t. <x, y> satisfies the constraint.
-	typedef std::unordered_map<ObjectIdx, std::vector<ObjectIdx>> ExtensionT;
+	// For a binary constraint with scope <X, Y>, the extension holds, for the i-th value x of X, the mask over the domain of Y
+	// with all y \in D_Y s.t. <x, y> satisfies the constraint, i.e. the support of x.
+	typedef std::vector<BitsetDomain> ExtensionT;
 	
-	//! Precondition: the vector is sorted.
+	const VariableLayout _layout1;
+	const VariableLayout _layout2;
+	
+	//! The supports of the values of X, and those of the values of Y
 	const ExtensionT _extension1;
 	const ExtensionT _extension2;
 	
@@ -89,18 +99,25 @@ public:
 	
 	CompiledBinaryConstraint(const VariableIdxVector& scope, const CompiledBinaryConstraint::Tester& tester);
 	
+	CompiledBinaryConstraint(const VariableIdxVector& scope, const std::vector<int>& parameters, const CompiledBinaryConstraint::Tester& tester);
+	
 	~CompiledBinaryConstraint() {};
 
 	bool isSatisfied(ObjectIdx o1, ObjectIdx o2) const override;
 	
 	FilteringOutput filter(unsigned variable) const override;
 	
+	//! Arc-reduces the bitset domain of the given variable (0 or 1) with respect to the domain of the other one:
+	//! a value is kept iff its support intersects the other domain, which is checked one machine word at a time.
+	FilteringOutput filter(unsigned variable, BitsetDomain& domain, const BitsetDomain& other) const;
+	
 	//! Compiled constraints cannot be compiled again!
 	DirectConstraint* compile(const ProblemInfo& info) const override { return nullptr; }
 	
 	static TupleExtension compile(const VariableIdxVector& scope, const CompiledBinaryConstraint::Tester& tester);
 	
-	static ExtensionT index(const CompiledBinaryConstraint::TupleExtension& extension, unsigned variable);
+	//! Returns the supports of all values of the given variable (0 or 1) of the scope
+	static ExtensionT index(const VariableLayout& layout, const VariableLayout& other, unsigned variable, const CompiledBinaryConstraint::Tester& tester);
 	
 	//! Returns a set with all tuples for the given scope that satisfy the the given state
 // 	static std::map<ObjectIdx, std::set<ObjectIdx>> compile(const VariableIdxVector& scope, const Tester& tester);
@@ -1,16 +1,24 @@
 
+#include <algorithm>
+#include <numeric>
 
 #include <constraints/direct/csp_handler.hxx>
 #include <constraints/direct/constraint.hxx>
+#include <constraints/direct/compiled.hxx>
+#include <problem_info.hxx>
 
 namespace fs0 {
 
+//! Binary constraints are compiled for bitset filtering only if their supports take no more bits than this
+const unsigned long MAX_COMPILED_SUPPORT_BITS = 1 << 24;
 
 DirectCSPHandler::DirectCSPHandler(const std::vector<DirectConstraint*>& constraints)
-	: _constraints(constraints), _relevant(indexRelevantVariables(constraints)) {
+	: _constraints(constraints), _relevant(indexRelevantVariables(constraints)), _bitset_filtering(false) {
 	initialize();
 }
 
+DirectCSPHandler::~DirectCSPHandler() = default;
+
 //! Precompute some of the structures that we'll need later on.
 void DirectCSPHandler::initialize() {
 	// Index the different constraints by arity
@@ -18,6 +26,56 @@ void DirectCSPHandler::initialize() {
 
 	// Initialize the worklist
 	initializeAC3Worklist(binary_constraints, AC3Worklist);
+	
+	indexBitsetConstraints();
+}
+
+void DirectCSPHandler::indexBitsetConstraints() {
+	if (!n_ary_constraints.empty()) return; // Global constraints filter only set-based domains
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	
+	_bitset_watchers.resize(_relevant.size());
+	for (const DirectConstraint* ctr:unary_constraints) {
+		auto compiled = dynamic_cast<const CompiledUnaryConstraint*>(ctr);
+		if (!compiled) {
+			auto unary = dynamic_cast<const UnaryDirectConstraint*>(ctr);
+			if (!unary) return discardBitsetConstraints();
+			compiled = new CompiledUnaryConstraint(*unary);
+			_compiled.push_back(std::unique_ptr<const DirectConstraint>(compiled));
+		}
+		bitset_unary_constraints.push_back(std::make_pair(compiled, position(ctr->getScope()[0])));
+	}
+	
+	for (const DirectConstraint* ctr:binary_constraints) {
+		const VariableIdxVector& scope = ctr->getScope();
+		auto compiled = dynamic_cast<const CompiledBinaryConstraint*>(ctr);
+		if (!compiled) {
+			auto binary = dynamic_cast<const BinaryDirectConstraint*>(ctr);
+			unsigned long num_bits = 2ul * info.getVariableObjects(scope[0]).size() * info.getVariableObjects(scope[1]).size();
+			if (!binary || num_bits > MAX_COMPILED_SUPPORT_BITS) return discardBitsetConstraints();
+			compiled = new CompiledBinaryConstraint(*binary, info);
+			_compiled.push_back(std::unique_ptr<const DirectConstraint>(compiled));
+		}
+		unsigned x = position(scope[0]), y = position(scope[1]);
+		unsigned arc = 2 * bitset_binary_constraints.size();
+		bitset_binary_constraints.push_back(std::make_tuple(compiled, x, y));
+		_bitset_watchers[x].push_back(arc + 1); // When X is pruned, Y needs to be revised, and vice versa
+		_bitset_watchers[y].push_back(arc);
+	}
+	_bitset_filtering = true;
+}
+
+void DirectCSPHandler::discardBitsetConstraints() {
+	_compiled.clear();
+	bitset_unary_constraints.clear();
+	bitset_binary_constraints.clear();
+	_bitset_watchers.clear();
+}
+
+unsigned DirectCSPHandler::position(VariableIdx variable) const {
+	auto it = std::lower_bound(_relevant.begin(), _relevant.end(), variable);
+	assert(it != _relevant.end() && *it == variable);
+	return it - _relevant.begin();
 }
 
 //! Indexes pointers to the constraints in three different vectors: unary, binary and n-ary constraints.
@@ -99,6 +157,50 @@ FilteringOutput DirectCSPHandler::filter(const DomainMap& domains) const {
 }
 
 
+FilteringOutput DirectCSPHandler::filter(std::vector<BitsetDomain>& domains) const {
+	assert(_bitset_filtering);
+	assert(domains.size() == _relevant.size());
+	
+	FilteringOutput result = FilteringOutput::Unpruned;
+	for (const auto& unary:bitset_unary_constraints) {
+		FilteringOutput o = unary.first->filter(domains[unary.second]);
+		if (o == FilteringOutput::Failure) return o;
+		if (o == FilteringOutput::Pruned) result = o;
+	}
+	if (bitset_binary_constraints.empty()) return result;
+	
+	// AC3, with a FIFO worklist initially containing all arcs, none of which is ever queued twice.
+	// The buffers are reused across calls, and kept per thread, as the handler can be shared by several threads.
+	static thread_local std::vector<unsigned> worklist;
+	static thread_local std::vector<bool> queued;
+	unsigned num_arcs = 2 * bitset_binary_constraints.size();
+	worklist.resize(num_arcs);
+	std::iota(worklist.begin(), worklist.end(), 0);
+	queued.assign(num_arcs, true);
+	
+	for (unsigned next = 0; next < worklist.size(); ++next) {
+		unsigned arc = worklist[next];
+		queued[arc] = false;
+		
+		const auto& binary = bitset_binary_constraints[arc / 2];
+		unsigned side = arc % 2;
+		unsigned variable = (side == 0) ? std::get<1>(binary) : std::get<2>(binary);
+		unsigned other = (side == 0) ? std::get<2>(binary) : std::get<1>(binary);
+		
+		FilteringOutput o = std::get<0>(binary)->filter(side, domains[variable], domains[other]);
+		if (o == FilteringOutput::Failure) return o;
+		if (o == FilteringOutput::Unpruned) continue;
+		
+		result = FilteringOutput::Pruned;
+		for (unsigned related:_bitset_watchers[variable]) {
+			if (related / 2 == arc / 2 || queued[related]) continue; // No need to revise the constraint we just used.
+			queued[related] = true;
+			worklist.push_back(related);
+		}
+	}
+	return result;
+}
+
 void DirectCSPHandler::emptyConstraintDomains(const std::vector<DirectConstraint*>& constraints) const {
 	for (DirectConstraint* constraint:constraints) {
 		constraint->emptyDomains();
@@ -188,6 +290,13 @@ bool DirectCSPHandler::checkConsistency(const DomainMap& domains) {
 }
 
 
+bool DirectCSPHandler::checkConsistency(const std::vector<BitsetDomain>& domains) {
+	for (const auto& domain:domains) {
+		if (domain.none()) return false;
+	}
+	return true;
+}
+
 //! We select an arbitrary arc, indeed the first according to the order between pairs of procedure IDs and variable IDs.
 //! and remove it from the worklist
 DirectCSPHandler::Arc DirectCSPHandler::select(ArcSet& worklist) const {
@@ -1,12 +1,18 @@
 
 #pragma once
 
+#include <memory>
+#include <tuple>
+
 #include <fs_types.hxx>
 #include <constraints/filtering.hxx>
+#include <constraints/direct/bitset_domain.hxx>
 
 namespace fs0 {
 
 class DirectConstraint;
+class CompiledUnaryConstraint;
+class CompiledBinaryConstraint;
 
 //! A DirectCSPHandler manages CSP built with DirectConstraints
 class DirectCSPHandler {
@@ -30,11 +36,24 @@ protected:
 	std::vector<DirectConstraint*> n_ary_constraints;
 	
 	VariableIdxVector _relevant;
+	
+	//! The compiled versions of the unary and binary constraints, used to filter bitset domains, along with the positions
+	//! in '_relevant' of the variables of their scope. Those that were not compiled yet are compiled (and owned) here.
+	std::vector<std::unique_ptr<const DirectConstraint>> _compiled;
+	std::vector<std::pair<const CompiledUnaryConstraint*, unsigned>> bitset_unary_constraints;
+	std::vector<std::tuple<const CompiledBinaryConstraint*, unsigned, unsigned>> bitset_binary_constraints;
+	
+	//! The arcs to revise when the domain of each relevant variable gets pruned, where arc 2*i + j stands for the j-th
+	//! variable of the i-th binary constraint
+	std::vector<std::vector<unsigned>> _bitset_watchers;
+	
+	//! Whether all constraints could be compiled, hence bitset domains can be filtered
+	bool _bitset_filtering;
 
 public:
 	//! Constructs a manager handling the given set of constraints
 	DirectCSPHandler(const std::vector<DirectConstraint*>& constraints);
-	~DirectCSPHandler() {}
+	~DirectCSPHandler();
 	
 	//! Precompute some of the structures that we'll need later on.
 	void initialize();
@@ -50,12 +69,20 @@ public:
 	//! Filter the domains with all the constraints
 	FilteringOutput filter(const DomainMap& domains) const;
 	
+	//! Returns true iff bitset domains can be filtered, which requires the constraints to be at most binary
+	bool supportsBitsets() const { return _bitset_filtering; }
+	
+	//! Filter with all the constraints the given bitset domains, those of the relevant variables in the order
+	//! of 'getAllRelevantVariables()'. Binary constraints are propagated through AC3.
+	FilteringOutput filter(std::vector<BitsetDomain>& domains) const;
+	
 	//!
 	void loadConstraintDomains(const DomainMap& domains, const std::vector<DirectConstraint*>& constraints) const;
 	void emptyConstraintDomains(const std::vector<DirectConstraint*>& constraints) const;
 	
 	//! Return true iff all variable domain are non-empty
 	static bool checkConsistency(const DomainMap& domains);
+	static bool checkConsistency(const std::vector<BitsetDomain>& domains);
 
 	//! Static (node-consistent) filtering of the given unary constraints
 	static FilteringOutput unaryFiltering(const std::vector<DirectConstraint*>& constraints, const DomainMap& domains);
@@ -68,6 +95,15 @@ protected:
 	//! Helper to index all the variables that are relevant to any of the given constraints
 	static VariableIdxVector indexRelevantVariables(const std::vector<DirectConstraint*>& constraints);
 	
+	//! Compiles the unary and binary constraints for the filtering of bitset domains, if possible
+	void indexBitsetConstraints();
+	
+	//! Discards the constraints compiled by 'indexBitsetConstraints' if not all of them could be
+	void discardBitsetConstraints();
+	
+	//! The position of the given variable in '_relevant'
+	unsigned position(VariableIdx variable) const;
+	
 	//! Simply filter out the domains that do not satisfy each of the unary constraints
 	FilteringOutput unaryFiltering(const DomainMap& domains) const;
 	
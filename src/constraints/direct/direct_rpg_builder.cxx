@@ -51,12 +51,28 @@ DirectRPGBuilder::~DirectRPGBuilder() {
 
 FilteringOutput DirectRPGBuilder::pruneUsingStateConstraints(RelaxedState& state) const {
 	if (_stateConstraints.empty()) return FilteringOutput::Unpruned;
-	DomainMap domains = Projections::project(state, _stateConstraintsHandler.getAllRelevantVariables());  // This does NOT copy the domains
-	return _stateConstraintsHandler.filter(domains);
+	DomainMap domains = Projections::projectCopy(state, _stateConstraintsHandler.getAllRelevantVariables());  // This makes a copy of the domain.
+	FilteringOutput o = _stateConstraintsHandler.filter(domains);
+	if (o == FilteringOutput::Pruned) {
+		for (const auto& domain:domains) state.setValues(domain.first, *domain.second); // Write the pruned domains back into the state
+	}
+	return o;
 }
 
 bool DirectRPGBuilder::isGoal(const State& seed, const RelaxedState& state, std::vector<Atom>& causes) const {
 	assert(causes.empty());
+	
+	if (_goalConstraintsHandler.supportsBitsets()) {
+		std::vector<BitsetDomain> domains;
+		Projections::project(state, _goalConstraintsHandler.getAllRelevantVariables(), domains);  // This makes a copy of the domain.
+		if (!checkGoal(domains)) return false;
+		
+		std::vector<bool> set(domains.size(), false); // Variables that have been already set.
+		std::vector<BitsetDomain> clone(domains);
+		extractGoalCauses(seed, state.getLayout(), domains, clone, causes, set, 0);
+		return true;
+	}
+	
 	DomainMap domains = Projections::projectCopy(state, _goalConstraintsHandler.getAllRelevantVariables());  // This makes a copy of the domain.
 	if (!checkGoal(domains)) return false;
 	
@@ -70,6 +86,11 @@ bool DirectRPGBuilder::isGoal(const State& seed, const RelaxedState& state, std:
 }
 
 bool DirectRPGBuilder::isGoal(const RelaxedState& state) const {
+	if (_goalConstraintsHandler.supportsBitsets()) {
+		std::vector<BitsetDomain> domains;
+		Projections::project(state, _goalConstraintsHandler.getAllRelevantVariables(), domains);  // This makes a copy of the domain.
+		return checkGoal(domains);
+	}
 	DomainMap domains = Projections::projectCopy(state, _goalConstraintsHandler.getAllRelevantVariables());  // This makes a copy of the domain.
 	return checkGoal(domains);
 }
@@ -79,6 +100,11 @@ bool DirectRPGBuilder::checkGoal(const DomainMap& domains) const {
 	return o != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(domains);
 }
 
+bool DirectRPGBuilder::checkGoal(std::vector<BitsetDomain>& domains) const {
+	FilteringOutput o = _goalConstraintsHandler.filter(domains);
+	return o != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(domains);
+}
+
 //! Note that here we can guarantee that we'll always insert different atoms in `causes`, since all the inserted atoms have a different variable
 void DirectRPGBuilder::extractGoalCauses(const State& seed, const DomainMap& domains, const DomainMap& clone, std::vector<Atom>& causes, std::vector<bool>& set, unsigned num_set) const {
 	
@@ -143,6 +169,68 @@ void DirectRPGBuilder::extractGoalCausesArbitrarily(const State& seed, const Dom
 	}
 }
 
+void DirectRPGBuilder::extractGoalCauses(const State& seed, const DomainLayout& layout, std::vector<BitsetDomain>& domains, const std::vector<BitsetDomain>& clone, std::vector<Atom>& causes, std::vector<bool>& set, unsigned num_set) const {
+	const VariableIdxVector& relevant = _goalConstraintsHandler.getAllRelevantVariables();
+	
+	// 0. Base case
+	if (num_set == domains.size()) return;
+	
+	// 1. Select the variable with smallest domain that has not yet been set a value.
+	unsigned selected = domains.size();
+	std::size_t min_domain_size = std::numeric_limits<std::size_t>::max();
+	for (unsigned i = 0; i < domains.size(); ++i) {
+		if (set[i]) continue;
+		std::size_t size = domains[i].count();
+		if (size < min_domain_size) {
+			selected = i;
+			min_domain_size = size;
+		}
+	}
+	assert(selected < domains.size());
+	
+	VariableIdx selected_var = relevant[selected];
+	const VariableLayout& var_layout = layout.at(selected_var);
+	BitsetDomain& selected_dom = domains[selected];
+	
+	// 3. If the value that the variable had in the seed state is available, select it, otherwise select an arbitrary value
+	unsigned selected_value = var_layout.position(seed.getValue(selected_var));
+	if (selected_value == var_layout.size() || !selected_dom.test(selected_value)) {
+		selected_value = selected_dom.find_first(); // We simply select an arbitrary value.
+		causes.push_back(Atom(selected_var, var_layout.value(selected_value))); // We only insert the fact if it wasn't true on the seed state.
+	}
+	set[selected] = true; // Tag the variable as already selected
+	
+	// 4 . Propagate the restrictions forward.
+	// 4.1 Prune the domain.
+	selected_dom.reset();
+	selected_dom.set(selected_value);
+	
+	// 4.2 Apply the constraints again
+	if (!checkGoal(domains)) {
+		// If the selection made the domains inconsistent, instead of backtracking we simply
+		// select arbitrary domains from the original domain set.
+		extractGoalCausesArbitrarily(seed, layout, clone, causes, set);
+	} else{
+		// Otherwise we keep propagating
+		extractGoalCauses(seed, layout, domains, clone, causes, set, num_set+1);
+	}
+}
+
+void DirectRPGBuilder::extractGoalCausesArbitrarily(const State& seed, const DomainLayout& layout, const std::vector<BitsetDomain>& domains, std::vector<Atom>& causes, std::vector<bool>& set) const {
+	const VariableIdxVector& relevant = _goalConstraintsHandler.getAllRelevantVariables();
+	for (unsigned i = 0; i < domains.size(); ++i) {
+		if (set[i]) continue;
+		set[i] = true;
+		
+		VariableIdx variable = relevant[i];
+		const VariableLayout& var_layout = layout.at(variable);
+		unsigned seed_value = var_layout.position(seed.getValue(variable));
+		if (seed_value == var_layout.size() || !domains[i].test(seed_value)) {  // If the original value makes the situation a goal, then we don't need to add anything for this variable.
+			causes.push_back(Atom(variable, var_layout.value(domains[i].find_first()))); // Otherwise we simply select an arbitrary value.
+		}
+	}
+}
+
 std::ostream& DirectRPGBuilder::print(std::ostream& os) const {
 	os << "[Basic Goal Constraint Manager]";
 	return os;
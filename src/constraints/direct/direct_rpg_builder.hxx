@@ -50,12 +50,19 @@ protected:
 	
 	//! Returns true iff the given domains are not inconsistent when filtering them with all the goal constraints.
 	bool checkGoal(const DomainMap& domains) const;
+	bool checkGoal(std::vector<BitsetDomain>& domains) const;
 	
 	//! Extract the supporters of the goal from the pruned domains and add them to the set of goal causes.
 	//! If any pruned domain is empty, return false, as it means we have an inconsistency.
 	void extractGoalCauses(const State& seed, const DomainMap& domains, const DomainMap& clone, std::vector<Atom>& causes, std::vector<bool>& set, unsigned num_set) const;
 
 	void extractGoalCausesArbitrarily(const State& seed, const DomainMap& domains, std::vector<Atom>& causes, std::vector<bool>& set) const;
+	
+	//! Bitset versions of the above, where the domains are those of the variables relevant to the goal constraints,
+	//! in the order of their handler, and 'set' is indexed by the same positions
+	void extractGoalCauses(const State& seed, const DomainLayout& layout, std::vector<BitsetDomain>& domains, const std::vector<BitsetDomain>& clone, std::vector<Atom>& causes, std::vector<bool>& set, unsigned num_set) const;
+	
+	void extractGoalCausesArbitrarily(const State& seed, const DomainLayout& layout, const std::vector<BitsetDomain>& domains, std::vector<Atom>& causes, std::vector<bool>& set) const;
 };
 
 
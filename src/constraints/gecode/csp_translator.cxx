@@ -184,10 +184,29 @@ void CSPTranslator::updateStateVariableDomains(GecodeCSP& csp, const State& stat
 	for (const auto& it:_input_state_variables) {
 		VariableIdx variable = it.first;
 		const Gecode::IntVar& csp_variable = csp._intvars[it.second];
-		Gecode::rel(csp, csp_variable,  Gecode::IRT_EQ, state.getValue(variable));
+		ObjectIdx value = state.getValue(variable);
+		if (csp_variable.assigned() && csp_variable.val() == value) continue; // No need to post anything
+		Gecode::rel(csp, csp_variable,  Gecode::IRT_EQ, value);
 	}
 }
 
+bool CSPTranslator::admits(const GecodeCSP& csp, const RPGIndex& graph) const {
+	const std::vector<Gecode::IntSet>& domains = graph.get_domains();
+	for (const auto& it:_input_state_variables) {
+		Gecode::IntVarRanges current(csp._intvars[it.second]);
+		Gecode::IntSetRanges allowed(domains.at(it.first));
+		if (Gecode::Iter::Ranges::disjoint(current, allowed)) return false;
+	}
+	return true;
+}
+
+bool CSPTranslator::admits(const GecodeCSP& csp, const State& state) const {
+	for (const auto& it:_input_state_variables) {
+		if (!csp._intvars[it.second].in(state.getValue(it.first))) return false;
+	}
+	return true;
+}
+
 PartialAssignment CSPTranslator::buildAssignment(GecodeCSP& solution) const {
 	PartialAssignment assignment;
 	for (const auto& it:_input_state_variables) {
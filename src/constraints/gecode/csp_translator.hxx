@@ -89,6 +89,11 @@ public:
 	void updateStateVariableDomains(GecodeCSP& csp, const RPGIndex& graph) const;
 	void updateStateVariableDomains(GecodeCSP& csp, const std::vector<Gecode::IntSet>& domains) const;
 	void updateStateVariableDomains(GecodeCSP& csp, const State& state) const;
+	
+	//! Returns false if some input state variable can take, according to the given layer or state, no value within its
+	//! domain in the given CSP, in which case updating the domains of the CSP would make it fail.
+	bool admits(const GecodeCSP& csp, const RPGIndex& graph) const;
+	bool admits(const GecodeCSP& csp, const State& state) const;
 
 	const unsigned resolveInputVariableIndex(VariableIdx variable) const {
 		const auto& it = _input_state_variables.find(variable);
@@ -1,5 +1,6 @@
 
 #include <constraints/gecode/gecode_csp.hxx>
+#include <constraints/gecode/utils/csp_stats.hxx>
 
 
 namespace fs0 { namespace gecode {
@@ -23,7 +24,24 @@ Gecode::Space* GecodeCSP::copy( bool share ) { return new GecodeCSP( share, *thi
 
 
 bool GecodeCSP::checkConsistency() {
-	return status() != Gecode::SpaceStatus::SS_FAILED;
+	auto start = CSPStats::ClockT::now();
+	bool consistent = status() != Gecode::SpaceStatus::SS_FAILED;
+	CSPStats::instance().propagated(start);
+	return consistent;
+}
+
+GecodeCSP* GecodeCSP::clone_csp() const {
+	auto start = CSPStats::ClockT::now();
+	GecodeCSP* clone = static_cast<GecodeCSP*>(this->clone());
+	CSPStats::instance().cloned(start);
+	return clone;
+}
+
+GecodeCSP* GecodeCSP::clone_detached() const {
+	auto start = CSPStats::ClockT::now();
+	GecodeCSP* clone = static_cast<GecodeCSP*>(this->clone(false));
+	CSPStats::instance().cloned(start);
+	return clone;
 }
 
 //! Prints a representation of a CSP. Mostly for debugging purposes
@@ -28,7 +28,16 @@ public:
 	//! get an idea of what is being "actually" copied
 	virtual Gecode::Space* copy(bool share);
 
+	//! Propagate all constraints, and return false iff the space fails
 	bool checkConsistency();
+	
+	//! Returns a clone of the (stable) space. Unlike Gecode's 'clone', accounts for the cloning in the thread's CSP statistics.
+	GecodeCSP* clone_csp() const;
+	
+	//! Returns a clone of the (stable) space that shares no data (e.g. tuple sets) with any other space.
+	//! Gecode does not synchronize the reference counts of the data shared among spaces, hence a space can be cloned,
+	//! propagated or deleted while other threads work on other spaces only if they share no data with each other.
+	GecodeCSP* clone_detached() const;
 
 	//! Prints a representation of a CSP. Mostly for debugging purposes
 	friend std::ostream& operator<<(std::ostream &os, const GecodeCSP&  csp) { return csp.print(os); }
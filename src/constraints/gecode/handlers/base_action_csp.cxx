@@ -239,6 +239,10 @@ void BaseActionCSP::simple_atom_processing(GecodeCSP* solution, RPGIndex& graph,
 	// std::vector<AtomIdx> support = Supports::extract_support(solution, _translator, _tuple_indexes, _necessary_tuples);
 	
 	std::vector<AtomIdx> support = extract_support_from_solution(solution, effect_idx, assignment, binding);
+	add_to_graph(graph, tuple, solution, std::move(support));
+}
+
+void BaseActionCSP::add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const {
 	graph.add(tuple, get_action_id(solution), std::move(support));
 }
 
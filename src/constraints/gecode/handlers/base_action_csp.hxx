@@ -99,6 +99,10 @@ protected:
 	
 	//! Return the ActionID that corresponds to the current action / action schema, for some given solution
 	virtual const ActionID* get_action_id(const GecodeCSP* solution) const = 0;
+
+	//! Add the given tuple to the graph, reached through the action that corresponds to the given solution with the given
+	//! support. By default, through a new ActionID; ground actions are better added by reference, for the graph to intern their IDs
+	virtual void add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const;
 	
 	//! Return the action binding that corresponds to the given solution - by default, return an empty binding
 	virtual Binding build_binding_from_solution(const GecodeCSP* solution) const;
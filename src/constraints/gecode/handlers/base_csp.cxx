@@ -5,6 +5,7 @@
 #include <languages/fstrips/operations.hxx>
 #include <constraints/gecode/handlers/base_csp.hxx>
 #include <constraints/gecode/helper.hxx>
+#include <constraints/gecode/utils/csp_stats.hxx>
 #include <heuristics/relaxed_plan/rpg_data.hxx>
 #include <lapkt/tools/logging.hxx>
 #include <constraints/registry.hxx>
@@ -58,14 +59,33 @@ BaseCSP::registerFormulaConstraints(const fs::AtomicFormula* formula, CSPTransla
 	component_translator->registerConstraints(formula, translator);
 }
 
-//! A helper
+//! A helper. Cloning the base CSP is the most costly part of the instantiation, hence we first check,
+//! on the base CSP itself, whether the layer would trivially make the CSP fail, in which case no clone is needed.
+//! If a lock is given, the base CSP is only accessed while holding it, and its clone is detached from it.
 template <typename T>
 GecodeCSP*
 _instantiate(const GecodeCSP& csp,
 						   const CSPTranslator& translator,
 						   const std::vector<ExtensionalConstraint>& extensional_constraints,
-						   const T& layer) {
-	GecodeCSP* clone = static_cast<GecodeCSP*>(csp.clone());
+						   const T& layer,
+						   std::mutex* lock = nullptr) {
+	GecodeCSP* clone = nullptr;
+	{
+		std::unique_lock<std::mutex> guard;
+		if (lock) guard = std::unique_lock<std::mutex>(*lock);
+		
+		bool fails = !translator.admits(csp, layer);
+		for (unsigned i = 0; i < extensional_constraints.size() && !fails; ++i) {
+			fails = extensional_constraints[i].trivially_fails(layer);
+		}
+		if (fails) {
+			CSPStats::instance().clone_avoided();
+			return nullptr;
+		}
+		
+		clone = lock ? csp.clone_detached() : csp.clone_csp();
+	}
+	
 	translator.updateStateVariableDomains(*clone, layer);
 	for (const ExtensionalConstraint& constraint:extensional_constraints) {
 		if (!constraint.update(*clone, translator, layer)) {
@@ -95,6 +115,15 @@ BaseCSP::instantiate(const RPGIndex& graph) const {
 	return csp;
 }
 
+GecodeCSP*
+BaseCSP::instantiate_detached(const RPGIndex& graph) const {
+	if (_failed) return nullptr;
+	GecodeCSP* csp = _instantiate(*_base_csp, _translator, _extensional_constraints, graph, &_base_lock);
+	if (!csp) return csp;
+	post_novelty_constraint(*csp, graph);
+	return csp;
+}
+
 GecodeCSP*
 BaseCSP::instantiate(const State& state) const {
 	if (_failed) return nullptr;
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -35,6 +36,12 @@ public:
 	GecodeCSP* instantiate(const State& state) const;
 	GecodeCSP* instantiate_wo_novelty(const RPGIndex& graph) const;
 	
+	//! Like 'instantiate', but returns a CSP that shares no data with the base CSP. If the graph is itself detached
+	//! (see RPGIndex::detached), the CSP thus shares no data with any space of other threads, and can be propagated,
+	//! searched and deleted while other threads work with CSPs of this or other handlers. Only the cloning of the
+	//! base CSP, which Gecode does not allow on a same space from several threads at once, is serialized.
+	GecodeCSP* instantiate_detached(const RPGIndex& graph) const;
+	
 	void update_csp(std::unique_ptr<GecodeCSP>&& csp);
 	
 	const CSPTranslator& getTranslator() const { return _translator; }
@@ -55,6 +62,9 @@ protected:
 	//! The base Gecode CSP
 	std::unique_ptr<GecodeCSP> _base_csp;
 	
+	//! The lock that guards the base CSP while it is being cloned by 'instantiate_detached'
+	mutable std::mutex _base_lock;
+	
 	//! Whether the underlying CSP gecode space has already been detected as failed.
 	bool _failed;
 	
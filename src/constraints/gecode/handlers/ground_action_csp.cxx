@@ -5,6 +5,7 @@
 #include <lapkt/tools/logging.hxx>
 #include <actions/actions.hxx>
 #include <actions/action_id.hxx>
+#include <heuristics/relaxed_plan/rpg_index.hxx>
 #include <gecode/search.hh>
 
 
@@ -51,6 +52,10 @@ const ActionID* GroundActionCSP::get_action_id(const GecodeCSP* solution) const
 	return new PlainActionID(&_action);
 }
 
+void GroundActionCSP::add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const {
+	graph.add(tuple, _action, std::move(support));
+}
+
 void GroundActionCSP::log() const {
 	LPT_EDEBUG("heuristic", "Processing action: " << _action);
 }
@@ -58,7 +63,7 @@ void GroundActionCSP::log() const {
 GecodeCSP* 
 GroundActionCSP::post(VariableIdx variable, ObjectIdx value) const {
 	if (_failed) return nullptr;
-	GecodeCSP* clone = static_cast<GecodeCSP*>(_base_csp->clone());
+	GecodeCSP* clone = _base_csp->clone_csp();
 	const auto& csp_var = _translator.resolveInputStateVariable(*clone, variable);
 	
 	Gecode::rel(*clone, csp_var,  Gecode::IRT_EQ, value);
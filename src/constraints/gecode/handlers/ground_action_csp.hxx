@@ -44,6 +44,8 @@ protected:
 	std::vector<const fs::ActionEffect*> _add_effects;
 
 	const ActionID* get_action_id(const GecodeCSP* solution) const override;
+
+	void add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const override;
 	
 	//! Log some handler-related into
 	virtual void log() const override;
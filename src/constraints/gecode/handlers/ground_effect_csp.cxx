@@ -58,6 +58,10 @@ const ActionID* GroundEffectCSP::get_action_id(const GecodeCSP* solution) const
 	return new PlainActionID(&_action);
 }
 
+void GroundEffectCSP::add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const {
+	graph.add(tuple, _action, std::move(support));
+}
+
 GecodeCSP* GroundEffectCSP::preinstantiate(const RPGIndex& rpg) const {
 	GecodeCSP* csp = instantiate(rpg);
 	if (!csp) return nullptr;
@@ -74,7 +78,7 @@ GecodeCSP* GroundEffectCSP::preinstantiate(const RPGIndex& rpg) const {
 bool GroundEffectCSP::find_atom_support(AtomIdx tuple, const Atom& atom, const State& seed, GecodeCSP& layer_csp, RPGIndex& rpg) const {
 	log();
 	
-	std::unique_ptr<GecodeCSP> csp = std::unique_ptr<GecodeCSP>(static_cast<GecodeCSP*>(layer_csp.clone()));
+	std::unique_ptr<GecodeCSP> csp = std::unique_ptr<GecodeCSP>(layer_csp.clone_csp());
 	
 	post(*csp, atom);
 
@@ -106,7 +110,7 @@ bool GroundEffectCSP::solve(AtomIdx tuple, gecode::GecodeCSP* csp, RPGIndex& gra
 	
 	// Otherwise, the value is actually new - we extract the actual support from the solution
 	std::vector<AtomIdx> support = Supports::extract_support(solution, _translator, _tuple_indexes, _necessary_tuples);
-	graph.add(tuple, get_action_id(solution), std::move(support));
+	add_to_graph(graph, tuple, solution, std::move(support));
 
 	delete solution;
 	return true;
@@ -54,6 +54,8 @@ protected:
 	
 	const ActionID* get_action_id(const GecodeCSP* solution) const override;
 
+	void add_to_graph(RPGIndex& graph, AtomIdx tuple, const GecodeCSP* solution, std::vector<AtomIdx>&& support) const override;
+
 	//! Index the CSP variables corresponding the the effect LHS.
 	std::vector<unsigned> index_lhs_subterms();
 	
@@ -11,8 +11,11 @@
 #include <utils/printers/actions.hxx>
 #include <lapkt/tools/logging.hxx>
 #include <heuristics/relaxed_plan/rpg_index.hxx>
+#include <constraints/gecode/helper.hxx>
 #include <gecode/search.hh>
 
+#include <unordered_set>
+
 namespace fs0 { namespace gecode {
 
 
@@ -183,7 +186,7 @@ LiftedEffectCSP::seek_novel_tuples(RPGIndex& rpg) const {
 			LPT_EDEBUG("heuristic", "The effect CSP cannot produce any new tuple");
 		}
 		else {
-			Gecode::DFS<GecodeCSP> engine(csp);
+			Gecode::DFS<GecodeCSP> engine(csp, Helper::rpg_search_options());
 			unsigned num_solutions = 0;
 			while (GecodeCSP* solution = engine.next()) {
 		// 		LPT_EDEBUG("heuristic", std::endl << "Processing action CSP solution #"<< num_solutions + 1 << ": " << print::csp(_translator, *solution))
@@ -197,6 +200,28 @@ LiftedEffectCSP::seek_novel_tuples(RPGIndex& rpg) const {
 	}
 }
 
+void
+LiftedEffectCSP::collect_novel_tuples(const RPGIndex& rpg, std::vector<NovelTuple>& tuples) const {
+	GecodeCSP* csp = instantiate_detached(rpg);
+	if (!csp) return;
+	if (!csp->checkConsistency()) {
+		delete csp;
+		return;
+	}
+	
+	std::unordered_set<AtomIdx> found;
+	Gecode::DFS<GecodeCSP> engine(csp, Helper::rpg_search_options());
+	while (GecodeCSP* solution = engine.next()) {
+		AtomIdx tuple_idx = compute_reached_tuple(solution);
+		if (!rpg.reached(tuple_idx) && found.insert(tuple_idx).second) {
+			std::vector<AtomIdx> support = Supports::extract_support(solution, _translator, _tuple_indexes, _necessary_tuples);
+			tuples.push_back(std::make_tuple(tuple_idx, get_action_id(solution), std::move(support)));
+		}
+		delete solution;
+	}
+	delete csp;
+}
+
 AtomIdx
 LiftedEffectCSP::compute_reached_tuple(const GecodeCSP* solution) const {
 	AtomIdx tuple_idx = _achievable_tuple_idx;
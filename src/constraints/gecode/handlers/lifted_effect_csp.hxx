@@ -16,6 +16,9 @@ class RPGIndex;
 //! A CSP modeling and solving the effect of an action effect on a certain RPG layer
 class LiftedEffectCSP : public LiftedActionCSP {
 public:
+	//! A tuple reached by the effect, along with the action that reaches it and the tuples that support the action
+	using NovelTuple = std::tuple<AtomIdx, const ActionID*, std::vector<AtomIdx>>;
+	
 	//! Factory method
 	static std::vector<std::unique_ptr<LiftedEffectCSP>> create_smart(const std::vector<const PartiallyGroundedAction*>& schemata, const AtomIndex& tuple_index, bool approximate, bool novelty);
 	
@@ -38,6 +41,12 @@ public:
 	
 	void seek_novel_tuples(RPGIndex& rpg) const;
 	
+	//! Like 'seek_novel_tuples', but appends the tuples not yet reached in the given RPG to 'tuples', in the order in which
+	//! they are found, instead of adding them to the RPG. The caller takes ownership of the action IDs.
+	//! Can be invoked concurrently on different handlers, as long as each thread uses its own detached copy of the
+	//! RPG index (see RPGIndex::detached), since the search then runs on a space that shares no data with any other.
+	void collect_novel_tuples(const RPGIndex& rpg, std::vector<NovelTuple>& tuples) const;
+	
 	AtomIdx get_achievable_tuple() const { return _achievable_tuple_idx; }
 	
 	//! Raises an exception if the given effect is not valid for this type of effect handler, i.e. because it has nested fluents on the effect head.
@@ -10,6 +10,7 @@
 #include <utils/printers/actions.hxx>
 #include <lapkt/tools/logging.hxx>
 #include <heuristics/relaxed_plan/rpg_index.hxx>
+#include <constraints/gecode/helper.hxx>
 #include <gecode/search.hh>
 
 namespace fs0 { namespace gecode {
@@ -88,7 +89,7 @@ LiftedEffectUnreachedCSP::get_precondition() const {
 bool LiftedEffectUnreachedCSP::find_atom_support(AtomIdx tuple, const Atom& atom, const State& seed, GecodeCSP& layer_csp, RPGIndex& rpg) const {
 	log();
 	
-	std::unique_ptr<GecodeCSP> csp = std::unique_ptr<GecodeCSP>(static_cast<GecodeCSP*>(layer_csp.clone()));
+	std::unique_ptr<GecodeCSP> csp = std::unique_ptr<GecodeCSP>(layer_csp.clone_csp());
 	
 	post_atom(*csp, atom);
 
@@ -108,7 +109,7 @@ bool LiftedEffectUnreachedCSP::find_atom_support(AtomIdx tuple, const Atom& atom
 
 bool LiftedEffectUnreachedCSP::solve_for_tuple(AtomIdx tuple, gecode::GecodeCSP* csp, RPGIndex& graph) const {
 	// We just want to search for one solution and extract the support from it
-	Gecode::DFS<GecodeCSP> engine(csp);
+	Gecode::DFS<GecodeCSP> engine(csp, Helper::rpg_search_options());
 	GecodeCSP* solution = engine.next();
 	if (!solution) return false; // The CSP has no solution at all
 	
@@ -125,6 +126,21 @@ bool LiftedEffectUnreachedCSP::solve_for_tuple(AtomIdx tuple, gecode::GecodeCSP*
 	return true;
 }
 
+bool LiftedEffectUnreachedCSP::collect_atom_support(const Atom& atom, GecodeCSP& layer_csp, const ActionID*& action, std::vector<AtomIdx>& support) const {
+	log();
+	
+	std::unique_ptr<GecodeCSP> csp = std::unique_ptr<GecodeCSP>(layer_csp.clone_csp());
+	post_atom(*csp, atom);
+	if (!csp->checkConsistency()) return false;
+	
+	Gecode::DFS<GecodeCSP> engine(csp.get(), Helper::rpg_search_options());
+	std::unique_ptr<GecodeCSP> solution(engine.next());
+	if (!solution) return false;
+	
+	action = get_action_id(solution.get());
+	support = Supports::extract_support(solution.get(), _translator, _tuple_indexes, _necessary_tuples);
+	return true;
+}
 
 void LiftedEffectUnreachedCSP::post_atom(GecodeCSP& csp, const Atom& atom) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
@@ -174,6 +190,18 @@ GecodeCSP* LiftedEffectUnreachedCSP::preinstantiate(const RPGIndex& rpg) const {
 	return csp;
 }
 
+GecodeCSP* LiftedEffectUnreachedCSP::preinstantiate_detached(const RPGIndex& rpg) const {
+	GecodeCSP* csp = instantiate_detached(rpg);
+	if (!csp) return nullptr;
+	
+	if (!csp->checkConsistency()) {
+		delete csp;
+		return nullptr;
+	}
+	
+	return csp;
+}
+
 
 
 
@@ -65,6 +65,15 @@ public:
 	
 	//! Find whether this effect can support the atom 'tuple' = 'atom' in the RPG layer given by layer_csp
 	bool find_atom_support(AtomIdx tuple, const Atom& atom, const State& seed, GecodeCSP& layer_csp, RPGIndex& rpg) const;
+	
+	//! Like 'preinstantiate', but on a CSP that shares no data with the base CSP (see BaseCSP::instantiate_detached).
+	//! If the given RPG is a detached copy (see RPGIndex::detached), the CSP can then be used by the calling thread
+	//! while other threads work with CSPs of this or other handlers.
+	GecodeCSP* preinstantiate_detached(const RPGIndex& rpg) const;
+	
+	//! Like 'find_atom_support', but instead of adding the atom to the RPG, returns in 'action' and 'support' the action
+	//! that supports it and the tuples that support the action. The caller takes ownership of the action ID.
+	bool collect_atom_support(const Atom& atom, GecodeCSP& layer_csp, const ActionID*& action, std::vector<AtomIdx>& support) const;
 };
 
 
@@ -7,6 +7,7 @@
 #include <constraints/gecode/csp_translator.hxx>
 #include <constraints/gecode/gecode_csp.hxx>
 #include <constraints/gecode/utils/term_list_iterator.hxx>
+#include <utils/config.hxx>
 
 
 namespace fs0 { namespace gecode {
@@ -48,8 +49,15 @@ Gecode::IntVar Helper::createVariable(Gecode::Space& csp, TypeIdx typeId) {
 }
 
 void Helper::constrainCSPVariable(GecodeCSP& csp, const Gecode::IntVar& variable, const Gecode::IntSet& domain) {
+	// If the domain of the variable is already contained in the given domain, e.g. because the variable has already
+	// reached all of its values in the RPG, the restriction is a no-op, and we spare posting it.
+	Gecode::IntVarRanges current(variable);
+	Gecode::IntSetRanges allowed(domain);
+	if (Gecode::Iter::Ranges::subset(current, allowed)) return;
+	
 	if (domain.size() ==  static_cast<unsigned>(domain.max() - domain.min()) + 1) { // A micro-optimization
 		Gecode::dom(csp, variable, domain.min(), domain.max());
+		return;
 	}
 	Gecode::dom(csp, variable, domain);
 }
@@ -117,4 +125,15 @@ int Helper::value_selector(const Gecode::Space& home, Gecode::IntVar x, int csp_
 	return static_cast<const GecodeCSP&>(home).select_value(x, csp_var_idx);
 }
 
+const Gecode::Search::Options& Helper::rpg_search_options() {
+	static const Gecode::Search::Options options = [](){
+		int threads = Config::instance().getOption<int>("rpg.gecode_threads", 1);
+		if (threads <= 0) throw std::runtime_error("The number of Gecode search threads needs to be positive");
+		Gecode::Search::Options options;
+		options.threads = threads;
+		return options;
+	}();
+	return options;
+}
+
 } } // namespaces
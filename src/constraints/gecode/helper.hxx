@@ -4,6 +4,7 @@
 
 #include <fs_types.hxx>
 #include <gecode/int.hh>
+#include <gecode/search.hh>
 
 namespace fs0 { namespace language { namespace fstrips { class AtomicFormula; class StaticHeadedNestedTerm; } } }
 namespace fs = fs0::language::fstrips;
@@ -49,6 +50,10 @@ public:
 	
 	//! A helper method to install our desired value-selection brancher
 	static int value_selector(const Gecode::Space& home, Gecode::IntVar x, int csp_var_idx);
+	
+	//! The options of the search engines that solve the effect CSPs of the RPG-based heuristics. If option
+	//! 'rpg.gecode_threads' is greater than one, the engines search in parallel on that number of threads.
+	static const Gecode::Search::Options& rpg_search_options();
 };
 
 } } // namespaces
\ No newline at end of file
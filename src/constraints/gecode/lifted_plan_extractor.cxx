@@ -14,47 +14,39 @@ namespace fs0 { namespace gecode {
 
 	
 LiftedPlanExtractor::LiftedPlanExtractor(const RPGIndex& graph, const AtomIndex& tuple_index) :
-	_graph(graph), processed(), pending(), perLayerSupporters(graph.getNumLayers()), _tuple_index(tuple_index)
+	_graph(graph), pending(), _size(0), _tuple_index(tuple_index)
 {}
 
 
 long LiftedPlanExtractor::computeRelaxedPlanCost(const std::vector<AtomIdx>& goal_support, std::vector<Atom>& relevant) {
-	enqueueTuples(goal_support);
+	_graph.getSupports().clear_marks();
+	pending.assign(goal_support.cbegin(), goal_support.cend());
 	
+	// The order in which tuples are processed does not matter, so we simply use the vector as a stack
 	while (!pending.empty()) {
-		AtomIdx tuple = pending.front();
+		AtomIdx tuple = pending.back();
+		pending.pop_back();
 		processTuple(tuple, relevant);
-		pending.pop();
 	}
 	
 	return buildRelaxedPlan();
 }
 
-void LiftedPlanExtractor::enqueueTuples(const std::vector<AtomIdx>& tuples) {
-	for(const auto& tuple:tuples) {
-		pending.push(tuple);
-	}
-}
-
 void LiftedPlanExtractor::processTuple(AtomIdx tuple, std::vector<Atom>& relevant) {
-	const Atom& atom = _tuple_index.to_atom(tuple);
-	if (_graph.getSeed().contains(atom)) return; // The atom was already on the seed state, thus has empty support.
-	if (processed.find(tuple) != processed.end()) return; // The atom has already been processed
+	const RPGSupportTable& supports = _graph.getSupports();
+	unsigned layer_idx = supports.layer(tuple);
+	if (layer_idx == 0) return; // The atom was already on the seed state, thus has empty support.
+	if (!supports.mark_processed(tuple)) return; // The atom has already been processed
 	
-	const RPGIndex::TupleSupport& support = _graph.getTupleSupport(tuple);
-	
-	const ActionID* action_id = std::get<1>(support);
-	assert(action_id);
-	unsigned layer_idx = std::get<0>(support);
-// 	std::cout << "Inserting: " << *action_id << " on layer #" << std::get<0>(support) << ", support size: " << std::get<2>(support).size() << std::endl;
-	perLayerSupporters[layer_idx].insert(action_id);
-	enqueueTuples(std::get<2>(support)); // Push the full support of the atom
-	processed.insert(tuple); // Tag the atom as processed.
+	assert(supports.action(tuple));
+	++_size;
+	const std::vector<AtomIdx>& support = supports.support(tuple);
+	pending.insert(pending.end(), support.cbegin(), support.cend()); // Push the full support of the atom
 	
 	// We store all those atoms that have been identified as supports of some action of the relaxed plan
 	// and are on the first layer of the RPG
 	if (layer_idx == 1) {
-		relevant.push_back(atom);
+		relevant.push_back(_tuple_index.to_atom(tuple));
 	}
 }
 
@@ -62,16 +54,17 @@ void LiftedPlanExtractor::processTuple(AtomIdx tuple, std::vector<Atom>& relevan
 long LiftedPlanExtractor::buildRelaxedPlan() {
 #ifndef DEBUG
 	// In production mode, we simply count the number of actions in the plan, but prefer not to build the actual plan.
-	unsigned size = 0;
-	for (const auto& supporters:perLayerSupporters) {
-		size += supporters.size();
-	}
-	return (long) size;
+	return (long) _size;
 #endif
 
-	// In debug mode, we build the relaxed plan by flattening the supporters at each layer, so that we can log the actual plan.
+	// In debug mode, we build the relaxed plan by flattening the supporters of the processed tuples at each layer, so that we can log the actual plan.
+	const RPGSupportTable& supports = _graph.getSupports();
+	std::vector<plan_t> per_layer(_graph.getNumLayers());
+	for (AtomIdx tuple:supports.reached_atoms()) {
+		if (supports.processed(tuple)) per_layer[supports.layer(tuple)].push_back(supports.action(tuple));
+	}
 	plan_t plan;
-	for (const auto& supporters:perLayerSupporters) {
+	for (const auto& supporters:per_layer) {
 		plan.insert(plan.end(), supporters.cbegin(), supporters.cend());
 	}
 
@@ -2,8 +2,6 @@
 #pragma once
 
 #include <vector>
-#include <queue>
-#include <unordered_set>
 
 #include <fs_types.hxx>
 
@@ -17,15 +15,19 @@ class RPGIndex;
  * In an LiftedPlanExtractor, a relaxed plan is simply composed of a list of actions,
  * not making any distinction with respect to the values of variables relevant for the action effects
  * under which the action is undertaken.
+ * Processed tuples are marked on the (bitset) marks of the support table of the graph. As the graph holds a distinct
+ * action object for every reached tuple, the supporters of distinct tuples are always distinct, and the plan simply
+ * has one action per processed tuple not in the seed state.
  */
 class LiftedPlanExtractor {
 protected:
 	const RPGIndex& _graph;
 	
-	std::set<AtomIdx> processed;
-	std::queue<AtomIdx> pending;
+	//! The tuples still to be processed
+	std::vector<AtomIdx> pending;
 	
-	std::vector<std::unordered_set<const ActionID*>> perLayerSupporters;
+	//! The number of actions of the relaxed plan
+	unsigned _size;
 	
 	const AtomIndex& _tuple_index;
 
@@ -44,9 +46,6 @@ public:
 	long computeRelaxedPlanCost(const std::vector<AtomIdx>& goal_support, std::vector<Atom>& relevant);
 	
 protected:
-	//! Put all the atoms in a given vector of atoms in the queue to be processed.
-	void enqueueTuples(const std::vector<AtomIdx>& tuples);
-
 	//! Process a single atom by seeking its supports left-to-right in the RPG and enqueuing them to be further processed
 	void processTuple(AtomIdx tuple, std::vector<Atom>& relevant);
 	
@@ -0,0 +1,74 @@
+
+#pragma once
+
+#include <chrono>
+
+namespace fs0 { namespace gecode {
+
+//! Statistics on the work done with Gecode spaces by the CSP handlers: how many spaces are cloned and propagated,
+//! and how much (wall-clock) time this takes. The statistics are kept separately for each thread, so that each
+//! search, e.g. each of the drivers in a portfolio, reports only the work done by its own thread.
+//! Work that a search hands over to the threads of a pool is credited back to the search thread (see 'collect').
+class CSPStats {
+public:
+	using ClockT = std::chrono::steady_clock;
+
+	//! The statistics of the current thread
+	static CSPStats& instance() {
+		static thread_local CSPStats stats;
+		return stats;
+	}
+
+	//! Runs 'task' and returns the statistics of the work that it does on the current thread, which are taken out of
+	//! the statistics of the thread, e.g. so that the worker of a thread pool can hand them over to the thread that
+	//! awaits the task, which should then 'merge' them into its own
+	template <typename TaskT>
+	static CSPStats collect(const TaskT& task) {
+		CSPStats& stats = instance();
+		const CSPStats before = stats;
+		task();
+		CSPStats work = stats;
+		work._clones -= before._clones;
+		work._clones_avoided -= before._clones_avoided;
+		work._propagations -= before._propagations;
+		work._clone_time -= before._clone_time;
+		work._propagation_time -= before._propagation_time;
+		stats = before;
+		return work;
+	}
+
+	//! Empty statistics, e.g. to hold those of some task
+	CSPStats() : _clones(0), _clones_avoided(0), _propagations(0), _clone_time(0), _propagation_time(0) {}
+
+	//! Adds the given statistics to these ones
+	void merge(const CSPStats& other) {
+		_clones += other._clones;
+		_clones_avoided += other._clones_avoided;
+		_propagations += other._propagations;
+		_clone_time += other._clone_time;
+		_propagation_time += other._propagation_time;
+	}
+
+	void cloned(const ClockT::time_point& start) { ++_clones; _clone_time += ClockT::now() - start; }
+	void propagated(const ClockT::time_point& start) { ++_propagations; _propagation_time += ClockT::now() - start; }
+
+	//! A CSP has been detected as unsatisfiable before cloning the base space
+	void clone_avoided() { ++_clones_avoided; }
+
+	unsigned long clones() const { return _clones; }
+	unsigned long clones_avoided() const { return _clones_avoided; }
+	unsigned long propagations() const { return _propagations; }
+
+	//! The time spent cloning and propagating spaces, in seconds
+	double clone_time() const { return std::chrono::duration<double>(_clone_time).count(); }
+	double propagation_time() const { return std::chrono::duration<double>(_propagation_time).count(); }
+
+protected:
+	unsigned long _clones;
+	unsigned long _clones_avoided;
+	unsigned long _propagations;
+	ClockT::duration _clone_time;
+	ClockT::duration _propagation_time;
+};
+
+} } // namespaces
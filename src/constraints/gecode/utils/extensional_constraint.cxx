@@ -50,6 +50,16 @@ bool ExtensionalConstraint::update(GecodeCSP& csp, const CSPTranslator& translat
 	}
 }
 
+bool ExtensionalConstraint::trivially_fails(const State& state) const {
+	// Computing the extension of an n-ary symbol on a state is costly, hence we only check 0-ary predicates
+	return _variable_idx >= 0 && state.getValue(_variable_idx) != 1;
+}
+
+bool ExtensionalConstraint::trivially_fails(const RPGIndex& layer) const {
+	if (_variable_idx >= 0) return !layer.is_true(_variable_idx);
+	return layer.get_extension(_term->getSymbolId()).tuples() == 0;
+}
+
 bool ExtensionalConstraint::update(GecodeCSP& csp, const CSPTranslator& translator, const Gecode::TupleSet& extension) const {
 	// Check whether the extension contains no tuples, then the CSP is unsolvable
     assert( extension.finalized() );
@@ -34,6 +34,11 @@ public:
 	bool update(GecodeCSP& csp, const CSPTranslator& translator, const State& state) const;
 	bool update(GecodeCSP& csp, const CSPTranslator& translator, const RPGIndex& layer) const;
 	
+	//! Whether the constraint is trivially unsatisfiable on the given state or layer, e.g. because the extension of
+	//! its symbol is empty, which can be checked before cloning any CSP
+	bool trivially_fails(const State& state) const;
+	bool trivially_fails(const RPGIndex& layer) const;
+	
 	//! Prints a representation of the state to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const ExtensionalConstraint&  o) { return o.print(os); }
 	std::ostream& print(std::ostream& os) const;
@@ -39,8 +39,7 @@ int TupleMinHMaxValueSelector::select_state_variable_value(VariableIdx variable,
 	
 	for (; values(); ++values) {
 		int value = values.val();
-		const auto& support = _bookkeeping->getTupleSupport(_tuple_index->to_index(variable, value));
-		unsigned layer = std::get<0>(support); // The RPG layer on which this value was first achieved for this variable
+		unsigned layer = _bookkeeping->getLayer(_tuple_index->to_index(variable, value)); // The RPG layer on which this value was first achieved for this variable
 
 		if (layer == 0) return value; // If we found a seed-state value, no need to search anymore
 		if (layer < smallest_layer) {
@@ -69,11 +68,12 @@ int TupleMinHMaxValueSelector::select_existential_variable_value(const std::vect
 			assert(it != map.end());
 			
 			AtomIdx tuple = it->second;
-			if (!_bookkeeping->reached(tuple)) {
+			if (!_bookkeeping->reached(tuple)) { // The value is not reachable through this tuple
 				hmax_sum = std::numeric_limits<unsigned>::max();
+				break;
 			}
 			
-			hmax_sum += std::get<0>(_bookkeeping->getTupleSupport(tuple)); // The RPG layer on which this value was first achieved for this variable
+			hmax_sum += _bookkeeping->getLayer(tuple); // The RPG layer on which this value was first achieved for this variable
 		}
 		
 		if (hmax_sum < best_hmax_sum) {
@@ -7,12 +7,14 @@
 #include <heuristics/relaxed_plan/relaxed_plan_extractor.hxx>
 #include <relaxed_state.hxx>
 #include <applicability/formula_interpreter.hxx>
+#include <problem_info.hxx>
 
 
 namespace fs0 {
 
 DirectCRPG::DirectCRPG(const Problem& problem, std::vector<std::unique_ptr<DirectActionManager>>&& managers, std::shared_ptr<DirectRPGBuilder> builder) :
-	_problem(problem), _managers(std::move(managers)), all_whitelist(_managers.size()), _builder(builder), _last_extractor(nullptr)
+	_problem(problem), _managers(std::move(managers)), all_whitelist(_managers.size()), _builder(builder),
+	_atom_index(ProblemInfo::getInstance(), true), _layout(ProblemInfo::getInstance()), _supports(_atom_index.size()), _last_extractor(nullptr)
 {
 	LPT_DEBUG("heuristic", "Relaxed Plan heuristic initialized with builder: " << std::endl << *_builder);
 	std::iota(all_whitelist.begin(), all_whitelist.end(), 0); // Fill in whe vector with values 0, 1, 2, 3 ...
@@ -27,8 +29,8 @@ long DirectCRPG::evaluate(const State& seed, const std::vector<ActionIdx>& white
 	
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
-	RelaxedState relaxed(seed);
-	RPGData bookkeeping(seed);
+	RelaxedState relaxed(_layout, seed);
+	RPGData bookkeeping(seed, _atom_index, _supports);
 	
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 	
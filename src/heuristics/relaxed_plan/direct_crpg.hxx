@@ -4,6 +4,9 @@
 #include <fs_types.hxx>
 #include <constraints/direct/direct_rpg_builder.hxx>
 #include <constraints/direct/action_manager.hxx>
+#include <constraints/direct/bitset_domain.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
+#include <utils/atom_index.hxx>
 #include "relaxed_plan_extractor.hxx"
 
 namespace fs0 {
@@ -38,7 +41,7 @@ public:
 	//! To be subclassed in other RPG-based heuristics such as h_max
 	virtual long computeHeuristic(const State& seed, const RelaxedState& state, const RPGData& bookkeeping);
 	
-	const std::unordered_set<Atom>& get_relevant() const { 
+	const std::vector<Atom>& get_relevant() const { 
 		assert(_last_extractor);
 		return _last_extractor->get_relevant();
 	}
@@ -56,6 +59,15 @@ protected:
 	//! The RPG building helper
 	const std::shared_ptr<DirectRPGBuilder> _builder;
 	
+	//! An index of all atoms, negated ones included, as the RPG tracks all values of all state variables
+	AtomIndex _atom_index;
+	
+	//! The layout of the bitset domains of the relaxed states of the RPG
+	DomainLayout _layout;
+	
+	//! The book-keeping of the supports of the RPG, reused across evaluations
+	RPGSupportTable _supports;
+	
 	std::unique_ptr<BaseRelaxedPlanExtractor<RPGData>> _last_extractor;
 };
 
@@ -20,7 +20,8 @@ GecodeCRPG::GecodeCRPG(const Problem& problem, const fs::Formula* goal_formula,
 	_tuple_index(problem.get_tuple_index()),
 	_managers(std::move(managers)),
 	_extension_handler(extension_handler),
-	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(fs::conjunction(*goal_formula, *state_constraints), _tuple_index, false)))
+	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(fs::conjunction(*goal_formula, *state_constraints), _tuple_index, false))),
+	_supports(_tuple_index.size())
 {
 	LPT_DEBUG("heuristic", "Standard CRPG heuristic initialized");
 }
@@ -31,7 +32,7 @@ long GecodeCRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
 	
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _supports);
 	
 	if (Config::instance().useMinHMaxGoalValueSelector()) {
 		_goal_handler->init_value_selector(&graph);
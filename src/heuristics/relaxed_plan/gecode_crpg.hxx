@@ -3,6 +3,7 @@
 
 #include <fs_types.hxx>
 #include <constraints/gecode/extensions.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
 
 namespace fs0 { class Problem; class State; class RPGData; }
 
@@ -48,6 +49,9 @@ protected:
 	ExtensionHandler _extension_handler;
 	
 	std::unique_ptr<FormulaCSP> _goal_handler;
+	
+	//! The book-keeping of the supports of the RPG, reused across evaluations
+	RPGSupportTable _supports;
 };
 
 //! The h_max version
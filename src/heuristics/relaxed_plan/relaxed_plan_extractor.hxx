@@ -3,12 +3,12 @@
 
 #include <vector>
 #include <algorithm>
-#include <queue>
-#include <unordered_set>
+#include <set>
 
 #include <state.hxx>
 #include <problem.hxx>
 #include <heuristics/relaxed_plan/rpg_data.hxx>
+#include <utils/atom_index.hxx>
 #include <utils/utils.hxx>
 #include <utils/printers/printers.hxx>
 #include <utils/printers/actions.hxx>
@@ -52,6 +52,9 @@ public:
  * A Relaxed Plan extractor. This class is used to perform plan extraction from
  * an already existing RPG data structure. Two different subclasses exist differing
  * in the way in which the repeated application of the same actions is treated.
+ * Processed and relevant atoms are marked on the (bitset) marks of the support table of the RPG.
+ * The relaxed plan has one action per processed atom not in the seed state, even if the support table of the RPG
+ * interns the IDs of ground actions, i.e. even if the supporters of distinct atoms are the same ActionID object.
  */
 template <typename RPGBookkeeping>
 class BaseRelaxedPlanExtractor {
@@ -61,9 +64,14 @@ protected:
 	//! The book-keeping RPG data.
 	const RPGBookkeeping& _data;
 	
-	std::unordered_set<Atom> processed;
-	std::queue<Atom> pending;
-	std::unordered_set<Atom> _relevant;
+	//! The atoms still to be processed
+	std::vector<AtomIdx> pending;
+	
+	//! The atoms that support some action of the relaxed plan
+	std::vector<Atom> _relevant;
+	
+	//! The number of actions of the relaxed plan
+	unsigned _size;
 
 public:
 	
@@ -72,7 +80,7 @@ public:
  	 * @param data The data structure representing the planning graph
 	 */
 	BaseRelaxedPlanExtractor(const State& seed, const RPGBookkeeping& data) :
-		_seed(seed), _data(data), processed(), pending()
+		_seed(seed), _data(data), pending(), _relevant(), _size(0)
 	{}
 	
 	virtual ~BaseRelaxedPlanExtractor() {}
@@ -85,43 +93,44 @@ public:
 	 * @param goalAtoms The atoms that allowed the planning graph to reach a goal state.
 	 */
 	long computeRelaxedPlanCost(const std::vector<Atom>& goalAtoms) {
-		enqueueAtoms(goalAtoms);
+		_data.getSupports().clear_marks();
+		for (const Atom& atom:goalAtoms) pending.push_back(_data.index(atom));
 		
+		// The order in which atoms are processed does not matter, so we simply use the vector as a stack
 		while (!pending.empty()) {
-			const Atom& atom = pending.front();
+			AtomIdx atom = pending.back();
+			pending.pop_back();
 			processAtom(atom);
-			pending.pop();
 		}
 		
 		return buildRelaxedPlan();
 	}
 	
-	const std::unordered_set<Atom>& get_relevant() const { return _relevant; }
+	const std::vector<Atom>& get_relevant() const { return _relevant; }
 
 protected:
-	//! Put all the atoms in a given vector of atoms in the queue to be processed.
-	inline void enqueueAtoms(const std::vector<Atom>& atoms) { for(auto& atom:atoms) pending.push(atom); }
-	
-	inline void mark_as_relevant(const std::vector<Atom>& atoms) { for(auto& atom:atoms) _relevant.insert(atom); }
+	inline void mark_as_relevant(const std::vector<AtomIdx>& atoms) {
+		const RPGSupportTable& supports = _data.getSupports();
+		for (AtomIdx atom:atoms) {
+			if (supports.mark_relevant(atom)) _relevant.push_back(_data.getAtomIndex().to_atom(atom));
+		}
+	}
 
 	//! Process a single atom by seeking its supports left-to-right in the RPG and enqueuing them to be further processed
-	void processAtom(const Atom& atom) {
-		if (_seed.contains(atom)) return; // The atom was already on the seed state, thus has empty support.
-		if (processed.find(atom) != processed.end()) return; // The atom has already been processed
-		
-		const typename RPGBookkeeping::AtomSupport& support = _data.getAtomSupport(atom);
+	void processAtom(AtomIdx atom) {
+		if (_seed.contains(_data.getAtomIndex().to_atom(atom))) return; // The atom was already on the seed state, thus has empty support.
+		const RPGSupportTable& supports = _data.getSupports();
+		if (!supports.mark_processed(atom)) return; // The atom has already been processed
 		
-		const ActionID* action_id = std::get<1>(support);
+		const ActionID* action_id = supports.action(atom);
 		_unused(action_id);
 		assert(action_id);
-		registerPlanAction(support);
-		enqueueAtoms(*(std::get<2>(support))); // Push the full support of the atom
-		mark_as_relevant(*(std::get<2>(support)));
-		processed.insert(atom); // Tag the atom as processed.
+		++_size;
+		const std::vector<AtomIdx>& support = supports.support(atom);
+		pending.insert(pending.end(), support.cbegin(), support.cend()); // Push the full support of the atom
+		mark_as_relevant(support);
 	}
 	
-	virtual void registerPlanAction(const typename RPGBookkeeping::AtomSupport& support) = 0;
-	
 	virtual long buildRelaxedPlan() = 0;
 };
 
@@ -135,29 +144,32 @@ protected:
  */
 template <typename RPGBookkeeping>
 class SupportedRelaxedPlanExtractor : public BaseRelaxedPlanExtractor<RPGBookkeeping> {
-protected:
-	std::set<SupportedAction> supporters;
-
 public:
 	/**
 	 * @param seed The original, non-relaxed state.
  	 * @param data The data structure representing the planning graph
 	 */
 	SupportedRelaxedPlanExtractor(const State& seed, const RPGBookkeeping& data) :
-		BaseRelaxedPlanExtractor<RPGBookkeeping>(seed, data), supporters()
+		BaseRelaxedPlanExtractor<RPGBookkeeping>(seed, data)
 	{}
 
 protected:
-
-	
-	void registerPlanAction(const typename RPGBookkeeping::AtomSupport& support) {
-		// Push the action along the full support of the particular atom
-		supporters.insert(SupportedAction(std::get<1>(support), std::get<2>(support)));
-	}
-	
 	long buildRelaxedPlan() {
-		LPT_EDEBUG("relaxed-plan" , "Relaxed plan (" << supporters.size() << ") for state: " <<  std::endl << this->_seed << std::endl << "\t" << print::supported_plan(supporters) << std::endl);
-		return (long) supporters.size();
+#ifndef DEBUG
+		return (long) this->_size;
+#endif
+		// In debug mode, we build the actual plan, with each action along the full support of the particular atom it achieves,
+		// which is only logged: an action that achieves several atoms with the same support is listed once, but counted for each
+		const RPGSupportTable& supports = this->_data.getSupports();
+		std::set<SupportedAction> supporters;
+		for (AtomIdx atom:supports.reached_atoms()) {
+			if (!supports.processed(atom)) continue;
+			Atom::vctrp support = std::make_shared<Atom::vctr>();
+			for (AtomIdx supporter:supports.support(atom)) support->push_back(this->_data.getAtomIndex().to_atom(supporter));
+			supporters.insert(SupportedAction(supports.action(atom), support));
+		}
+		LPT_EDEBUG("relaxed-plan" , "Relaxed plan (" << this->_size << ") for state: " <<  std::endl << this->_seed << std::endl << "\t" << print::supported_plan(supporters) << std::endl);
+		return (long) this->_size;
 	}
 };
 
@@ -168,38 +180,30 @@ protected:
  */
 template <typename RPGBookkeeping>
 class PropositionalRelaxedPlanExtractor : public BaseRelaxedPlanExtractor<RPGBookkeeping> {
-protected:
-		std::vector<std::unordered_set<const ActionID*>> perLayerSupporters;
-
 public:
 	/**
 	 * @param seed The original, non-relaxed state.
  	 * @param data The data structure representing the planning graph
 	 */
 	PropositionalRelaxedPlanExtractor(const State& seed, const RPGBookkeeping& data) :
-		BaseRelaxedPlanExtractor<RPGBookkeeping>(seed, data), perLayerSupporters(data.getNumLayers())
+		BaseRelaxedPlanExtractor<RPGBookkeeping>(seed, data)
 	{}
 
 protected:
-
-	void registerPlanAction(const typename RPGBookkeeping::AtomSupport& support) {
-		// We ignore the particular atom support and take only into account the action
-		perLayerSupporters[std::get<0>(support)].insert(std::get<1>(support));
-	}
-	
 	long buildRelaxedPlan() {
 #ifndef DEBUG
 		// In production mode, we simply count the number of actions in the plan, but prefer not to build the actual plan.
-		unsigned size = 0;
-		for (const auto& supporters:perLayerSupporters) {
-			size += supporters.size();
-		}
-		return (long) size;
+		return (long) this->_size;
 #endif
 
 		// In debug mode, we build the relaxed plan by flattening the supporters at each layer, so that we can log the actual plan.
+		const RPGSupportTable& supports = this->_data.getSupports();
+		std::vector<plan_t> per_layer(this->_data.getNumLayers());
+		for (AtomIdx atom:supports.reached_atoms()) {
+			if (supports.processed(atom)) per_layer[supports.layer(atom)].push_back(supports.action(atom));
+		}
 		plan_t plan;
-		for (const auto& supporters:perLayerSupporters) {
+		for (const auto& supporters:per_layer) {
 			plan.insert(plan.end(), supporters.cbegin(), supporters.cend());
 		}
 
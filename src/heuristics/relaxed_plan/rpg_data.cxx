@@ -5,15 +5,19 @@
 #include <actions/actions.hxx>
 #include <actions/action_id.hxx>
 #include <problem_info.hxx>
+#include <utils/atom_index.hxx>
 
 namespace fs0 {
 
-RPGData::RPGData(const State& seed, bool ignore_negated) :
+RPGData::RPGData(const State& seed, const AtomIndex& index, RPGSupportTable& supports, bool ignore_negated) :
 	_novel(seed.numAtoms()),
 	_num_novel(0),
 	_current_layer(0),
-	_effects()
+	_index(index),
+	_supports(supports)
 {
+	assert(_supports.size() == _index.size());
+	_supports.clear();
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	
 	// Initially we insert the seed state atoms
@@ -24,83 +28,59 @@ RPGData::RPGData(const State& seed, bool ignore_negated) :
 			continue; // If requested, we ignore negated predicative atoms.
 		}
 		
-		_effects.insert(std::make_pair(Atom(variable, value),
-						createAtomSupport(nullptr, std::make_shared<std::vector<Atom>>())));
+		_supports.add(_index.to_index(variable, value), _current_layer, nullptr);
 	}
 	LPT_EDEBUG("heuristic", "RPG Layer #" << getCurrentLayerIdx() << ": " << *this);
 	advanceLayer();
 }
 
-RPGData::~RPGData() {
-	// delete all the pointers to action IDs, which belong to this container
-	for (auto& effect:_effects) {
-		const ActionID* action_id = std::get<1>(effect.second);
-		delete action_id;
-	}
-}
-
 void RPGData::advanceLayer() {
 	_num_novel= 0;
-	_novel = std::vector<std::vector<ObjectIdx>>(_novel.size()); // completely clear the vector of novel atoms
+	for (auto& values:_novel) values.clear(); // Clear the vectors of novel atoms, but keep their capacity
 	++_current_layer;
 }
 
-RPGData::AtomSupport RPGData::createAtomSupport(const ActionID* action, Atom::vctrp support) const {
-	return std::make_tuple(_current_layer, action, support);
+AtomIdx RPGData::index(const Atom& atom) const {
+	return _index.to_index(atom.getVariable(), atom.getValue());
 }
 
-const RPGData::AtomSupport& RPGData::getAtomSupport(const Atom& atom) const {
-	auto it = _effects.find(atom);
-	assert(it != _effects.end());
-	return it->second;
+std::vector<AtomIdx>& RPGData::add(const Atom& atom, AtomIdx index, const ActionID* action) {
+	assert(index == this->index(atom));
+	return insert(atom, _supports.add(index, _current_layer, action));
 }
 
-std::pair<bool, RPGData::SupportMap::iterator> RPGData::getInsertionHint(const Atom& atom) {
-	SupportMap::iterator lb = _effects.lower_bound(atom); // @see http://stackoverflow.com/a/101980
-	bool keyInMap = lb != _effects.end() && !(_effects.key_comp()(atom, lb->first));
-	if (keyInMap) return std::make_pair(false, lb);
-	else return std::make_pair(true, lb);
+std::vector<AtomIdx>& RPGData::add(const Atom& atom, AtomIdx index, const GroundAction& action) {
+	assert(index == this->index(atom));
+	return insert(atom, _supports.add(index, _current_layer, action));
 }
 
-void RPGData::add(const Atom& atom, const ActionID* action, Atom::vctrp support, SupportMap::iterator hint) {
-	_effects.insert(hint, std::make_pair(atom, createAtomSupport(action, support)));
+std::vector<AtomIdx>& RPGData::insert(const Atom& atom, std::vector<AtomIdx>* support) {
+	assert(support);
 	_novel[atom.getVariable()].push_back(atom.getValue());
 	++_num_novel;
+	return *support;
 }
 
-void RPGData::add(const Atom& atom, const ActionID* action, Atom::vctrp support) {
-	auto hint = getInsertionHint(atom);
-	if (!hint.first) return; // Don't insert the atom if it was already tracked by the RPG
-	add(atom, action, support, hint.second);
-}
-
-unsigned RPGData::compute_hmax_sum(const std::vector<Atom>& atoms) const {
+unsigned RPGData::compute_hmax_sum(const std::vector<AtomIdx>& atoms) const {
 	unsigned sum = 0;
-	for (const Atom& atom:atoms) {
-		sum += std::get<0>(getAtomSupport(atom));
+	for (AtomIdx atom:atoms) {
+		sum += _supports.layer(atom);
 	}
 	return sum;
 }
 
 std::ostream& RPGData::print(std::ostream& os) const {
-	os << "Relaxed Planning Graph atoms (" << _effects.size() << "): " << std::endl;
-	for (const auto& x:_effects) {
-		const ActionID* action_id = std::get<1>(x.second);
-		os << x.first  << " - action: ";
+	os << "Relaxed Planning Graph atoms (" << _supports.reached_atoms().size() << "): " << std::endl;
+	for (AtomIdx atom:_supports.reached_atoms()) {
+		const ActionID* action_id = _supports.action(atom);
+		os << _index.to_atom(atom)  << " - action: ";
 		(action_id ? os << *action_id : os << "[INVALID-ACTION]");
-		os << " - layer #" << std::get<0>(x.second) << " - support: ";
-		printAtoms(std::get<2>(x.second), os);
+		os << " - layer #" << _supports.layer(atom) << " - support: ";
+		for (AtomIdx supporter:_supports.support(atom)) os << _index.to_atom(supporter) << ", ";
 		os << std::endl;
 	}
 	os << std::endl;
 	return os;
 }
 
-void RPGData::printAtoms(const Atom::vctrp vector, std::ostream& os) const {
-	for (const auto& fact:*vector) {
-		os << fact << ", ";
-	}
-}
-
 } // namespaces
-
@@ -1,15 +1,17 @@
 
 #pragma once
 
-#include <map>
 #include <fs_types.hxx>
 #include <atom.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
 
 
 namespace fs0 {
 
 class State;
 class ActionID;
+class GroundAction;
+class AtomIndex;
 
 /**
  * A data structure containing book-keeping information concerning the actions that support
@@ -17,13 +19,10 @@ class ActionID;
  * the atoms that make an action applicable (in a certain RPG layer) and the "extra"
  * atoms that make a particular effect reachable, i.e. those related to the relevant
  * variables of the effect procedure that achieves the effect.
+ * Atoms are identified by their index in an AtomIndex, and their supports kept in a RPGSupportTable that
+ * belongs to the heuristic and is reused across evaluations.
  */
 class RPGData {
-public:
-	//! <layer ID, Action ID, support>
-	typedef std::tuple<unsigned, const ActionID*, Atom::vctrp> AtomSupport;
-	typedef std::map<Atom, AtomSupport> SupportMap;
-
 protected:
 	//! This keeps a reference to the novel atoms that have been inserted in the most recent layer of the RPG.
 	std::vector<std::vector<ObjectIdx>> _novel;
@@ -31,18 +30,23 @@ protected:
 
 	//! The current number of layers.
 	unsigned _current_layer;
+	
+	const AtomIndex& _index;
 
 	/**
-	 * A map mapping every atom X=x reached in the RPG layer represented by this changeset to a pair < L, A, V >, where:
+	 * The table mapping every atom X=x reached in the RPG to < L, A, V >, where:
 	 * - 'L' is the first layer at which the atom has been achieved.
 	 * - 'A' is the index of one of the actions that achieves the atom.
-	 * - 'V' is a vector with all the atoms that support the achievement of atom X=x through the application of action A.
+	 * - 'V' is a vector with the indexes of all the atoms that support the achievement of atom X=x through the application of action A.
 	 */
-	SupportMap _effects;
+	RPGSupportTable& _supports;
 
 public:
-	RPGData(const State& seed, bool ignore_negated = false);
-	~RPGData();
+	//! Starts a new graph on the given support table, which is cleared. The atom index must index all atoms that the RPG can reach.
+	RPGData(const State& seed, const AtomIndex& index, RPGSupportTable& supports, bool ignore_negated = false);
+	
+	RPGData(const RPGData&) = delete;
+	RPGData& operator=(const RPGData&) = delete;
 
 	//! Returns the number of layers of the RPG.
 	unsigned getNumLayers() const  {return _current_layer + 1; } // 0-indexed!
@@ -53,38 +57,40 @@ public:
 	//! Closes the last RPG layer and opens up a new one
 	void advanceLayer();
 	
-	//! Creates an atom support data structure with the given data and taking into account the current RPG layer
-	AtomSupport createAtomSupport(const ActionID* action, Atom::vctrp support) const;
-
-	//! Returns the support for the given atom
-	const AtomSupport& getAtomSupport(const Atom& atom) const;
+	//! The index of the given atom
+	AtomIdx index(const Atom& atom) const;
+	
+	const AtomIndex& getAtomIndex() const { return _index; }
+	
+	//! The supports of the atoms reached so far
+	const RPGSupportTable& getSupports() const { return _supports; }
+	
+	//! Returns true iff the atom with the given index has already been reached
+	bool reached(AtomIdx atom) const { return _supports.reached(atom); }
 
 	//! Get the number of novel atoms in the last layer of the RPG
 	unsigned getNumNovelAtoms() const { return _num_novel; }
 	
 	const std::vector<std::vector<ObjectIdx>>& getNovelAtoms() const { return _novel; }
-
-
-	//! Returns a pair "<b, it>" such that b is true iff the given atom is not already tracked by the RPG.
-	//! In that case, 'it' is an iterator that can be used as an insertion hint
-	//! If, on the other hand, b is false, 'it' is a valid iterator pointing to the atom support
-	std::pair<bool, SupportMap::iterator> getInsertionHint(const Atom& atom);
 	
-	//! The version with hint assumes that the atom needs to be inserted.
-	void add(const Atom& atom, const ActionID* action, Atom::vctrp support, SupportMap::iterator hint);
-	
-	//! Add an atom to the set of newly-reached atoms, only if it is indeed new.
-	void add(const Atom& atom, const ActionID* action, Atom::vctrp support);
+	//! Add the given atom, which must not have been reached yet, to the set of newly-reached atoms, taking ownership
+	//! of the given action. Returns the (empty) support of the atom, to be filled in by the caller.
+	std::vector<AtomIdx>& add(const Atom& atom, AtomIdx index, const ActionID* action);
+
+	//! As above, through the given ground action, whose ID the support table interns
+	std::vector<AtomIdx>& add(const Atom& atom, AtomIdx index, const GroundAction& action);
 	
 	//! Compute the sum of h_max values of all the given atoms, assuming that they have already been reached in the RPG data structure
-	unsigned compute_hmax_sum(const std::vector<Atom>& atoms) const;
+	unsigned compute_hmax_sum(const std::vector<AtomIdx>& atoms) const;
 
 	friend std::ostream& operator<<(std::ostream &os, const RPGData& data) { return data.print(os); }
 
 	//! Prints a representation of the RPG data to the given stream.
 	std::ostream& print(std::ostream& os) const;
 
-	void printAtoms(const Atom::vctrp vector, std::ostream& os) const;
+protected:
+	//! Record the given atom as novel and return its support slot, which must not be null
+	std::vector<AtomIdx>& insert(const Atom& atom, std::vector<AtomIdx>* support);
 };
 
 
@@ -11,14 +11,16 @@
 namespace fs0 { namespace gecode {
 
 
-RPGIndex::RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler) :
-	_reached(tuple_index.size(), nullptr),
+RPGIndex::RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler, RPGSupportTable& supports) :
+	_supports(supports),
 	_novel_tuples(),
 	_current_layer(0),
 	_extension_handler(extension_handler),
 	_tuple_index(tuple_index),
 	_seed(seed)
 {
+	assert(_supports.size() == tuple_index.size());
+	_supports.clear();
 	_domains.reserve(seed.numAtoms());
 	_extension_handler.reset();
 	
@@ -40,6 +42,30 @@ RPGIndex::RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHan
 	next();
 }
 
+RPGIndex::RPGIndex(const RPGIndex& other, std::vector<Gecode::TupleSet>&& extensions, std::vector<Gecode::IntSet>&& domains) :
+	_supports(other._supports),
+	_novel_tuples(other._novel_tuples),
+	_current_layer(other._current_layer),
+	_extension_handler(other._extension_handler),
+	_extensions(std::move(extensions)),
+	_domains(std::move(domains)),
+	_domains_raw(other._domains_raw),
+	_tuple_index(other._tuple_index),
+	_seed(other._seed)
+{}
+
+RPGIndex RPGIndex::detached() const {
+	// The extension handler is only modified when advancing to a new layer, hence it generates anew the extensions of the
+	// current layer, while the domains are copied range by range, so that none of the two shares data with the graph.
+	std::vector<Gecode::IntSet> domains;
+	domains.reserve(_domains.size());
+	for (const Gecode::IntSet& domain:_domains) {
+		Gecode::IntSetRanges ranges(domain);
+		domains.push_back(Gecode::IntSet(ranges));
+	}
+	return RPGIndex(*this, _extension_handler.generate_extensions(), std::move(domains));
+}
+
 void RPGIndex::advance() {
 	_extension_handler.advance();
 	
@@ -64,36 +90,17 @@ void RPGIndex::next() {
 }
 
 
-RPGIndex::~RPGIndex() {
-	// delete all the pointers to action IDs, which belong to this container
-	for (auto element:_reached) {
-		if (element != nullptr) {
-			const ActionID* action_id = std::get<1>(*element);
-			delete action_id;
-			delete element;
-		}
-	}
-}
-
-
-RPGIndex::TupleSupport* RPGIndex::createTupleSupport(const ActionID* action, std::vector<AtomIdx>&& support) const {
-	return new TupleSupport(_current_layer, action, std::move(support));
-}
-
-const RPGIndex::TupleSupport& RPGIndex::getTupleSupport(AtomIdx tuple) const {
-	auto support = _reached.at(tuple);
-	assert(support != nullptr);
-	return *support;
+void RPGIndex::add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&& support) {
+	insert(_supports.add(tuple, _current_layer, action), tuple, std::move(support));
 }
 
-bool RPGIndex::reached(AtomIdx tuple) const {
-	return _reached.at(tuple) != nullptr;
+void RPGIndex::add(AtomIdx tuple, const GroundAction& action, std::vector<AtomIdx>&& support) {
+	insert(_supports.add(tuple, _current_layer, action), tuple, std::move(support));
 }
 
-void RPGIndex::add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&& support) {
-	auto& it = _reached.at(tuple);
-	if (it != nullptr) return; // Don't insert the atom if it was already tracked by the RPG
-	it = createTupleSupport(action, std::move(support)); // This effectively inserts the tuple into '_reached'
+void RPGIndex::insert(std::vector<AtomIdx>* slot, AtomIdx tuple, std::vector<AtomIdx>&& support) {
+	if (slot == nullptr) return; // Don't insert the atom if it was already tracked by the RPG
+	slot->assign(support.cbegin(), support.cend()); // Copy rather than move, so that the table keeps the capacity of its own vector
 	_novel_tuples.push_back(tuple);
 	const Atom& atom = _tuple_index.to_atom(tuple);
 	auto& domain = _domains_raw.at(atom.getVariable());
@@ -114,16 +121,13 @@ unsigned RPGIndex::compute_hmax_sum(const std::vector<Atom>& atoms) const {
 std::ostream& RPGIndex::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "RPG Tuples: " << std::endl;
-	for (unsigned i = 0; i < _reached.size(); ++i) {
-		TupleSupport* support = _reached[i];
-		if (support != nullptr) {
-			const ActionID* action_id = std::get<1>(*support);
-			os << "Tuple: " << i  << "\t(Atom: " << _tuple_index.to_atom(i) << ")\t- action: ";
-			(action_id ? os << *action_id : os << "[INVALID-ACTION]");
-			os << "\t- layer #" << std::get<0>(*support) << " - support: ";
-			printAtoms(std::get<2>(*support), os);
-			os << std::endl;
-		}
+	for (AtomIdx i:_supports.reached_atoms()) {
+		const ActionID* action_id = _supports.action(i);
+		os << "Tuple: " << i  << "\t(Atom: " << _tuple_index.to_atom(i) << ")\t- action: ";
+		(action_id ? os << *action_id : os << "[INVALID-ACTION]");
+		os << "\t- layer #" << _supports.layer(i) << " - support: ";
+		printAtoms(_supports.support(i), os);
+		os << std::endl;
 	}
 	os << std::endl;
 	
@@ -153,10 +157,7 @@ bool RPGIndex::is_true(VariableIdx variable) const {
 
 std::vector<bool> RPGIndex::achieved_atoms(const AtomIndex& tuple_index) const {
 	std::vector<bool> achieved(tuple_index.size(), false);
-	for (AtomIdx tuple = 0; tuple < tuple_index.size(); ++tuple) {
-// 		if (!reached(tuple)) unachieved.insert(tuple);
-		if (reached(tuple)) achieved[tuple] = true;
-	}
+	for (AtomIdx tuple:_supports.reached_atoms()) achieved[tuple] = true;
 	return achieved;
 }
 
@@ -3,11 +3,12 @@
 
 #include <gecode/int.hh>
 #include <fs_types.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
 #include <unordered_map>
 #include <unordered_set>
 
 
-namespace fs0 { class ProblemInfo; class State; class Atom; class ActionID; class AtomIndex; }
+namespace fs0 { class ProblemInfo; class State; class Atom; class ActionID; class GroundAction; class AtomIndex; }
 
 namespace fs0 { namespace gecode {
 	
@@ -22,22 +23,15 @@ class ExtensionHandler;
  * variables of the effect procedure that achieves the effect.
  */
 class RPGIndex {
-public:
-	//! <layer ID, Action ID, support>, where 'support' is a vector of indexes of logical symbol tuples
-	typedef std::tuple<unsigned, const ActionID*, std::vector<AtomIdx>> TupleSupport;
-	
-	//! A map from the index of a logical symbol tuple to its support in the RPG
-// 	typedef std::unordered_map<AtomIdx, TupleSupport> SupportMap;
-	typedef std::vector<TupleSupport*> SupportMap;
-
 protected:
 	/**
-	 * A map with all tuples that have been reached in the RPG. Each tuple index 'I' is mapped to a pair < L, A, V >, where:
+	 * The book-keeping of all tuples that have been reached in the RPG, indexed by tuple index. Each tuple index 'I' is mapped to < L, A, V >, where:
 	 * - 'L' is the first layer at which the atom has been achieved.
 	 * - 'A' is the index of one of the actions that achieves the atom.
 	 * - 'V' is a vector with the indexes of all tuples that support the achievement of tuple 'I' through the application of action A.
+	 * The table belongs to the heuristic, which reuses it across evaluations.
 	 */
-	SupportMap _reached;
+	RPGSupportTable& _supports;
 
 	//! This keeps a reference to the novel atoms that have been inserted in the most recent layer of the RPG.
 	std::vector<AtomIdx> _novel_tuples;
@@ -61,11 +55,18 @@ protected:
 	const State& _seed;
 
 public:
-	explicit RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler);
-	~RPGIndex();
+	//! Starts a new graph on the given support table, which is cleared
+	RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler, RPGSupportTable& supports);
+	
+	//! Returns a copy of the graph whose extensions and domains share no data with those of the graph, since Gecode
+	//! does not synchronize the reference counts of the tuple and integer sets shared among spaces. A thread can thus
+	//! instantiate CSPs on the copy while other threads do the same on their own copies. The copy still shares the support
+	//! table and the extension handler with the graph, hence it is only meant to be read, and only while the graph
+	//! does not change.
+	RPGIndex detached() const;
 	
 	//! Returns true if the given tuple has already been reached in the current graph.
-	bool reached(AtomIdx tuple) const;
+	bool reached(AtomIdx tuple) const { return _supports.reached(tuple); }
 	
 	bool is_true(VariableIdx variable) const;
 	const Gecode::TupleSet& get_extension(unsigned symbol_id) const { return _extensions.at(symbol_id); }
@@ -78,8 +79,11 @@ public:
 	//! Returns the current layer index
 	unsigned getCurrentLayerIdx() const  {return _current_layer; }
 
-	//! Returns the support for the given atom
-	const TupleSupport& getTupleSupport(AtomIdx tuple) const;
+	//! Returns the supports of the reached tuples
+	const RPGSupportTable& getSupports() const { return _supports; }
+	
+	//! Returns the layer at which the given (reached) tuple was first reached
+	unsigned getLayer(AtomIdx tuple) const { return _supports.layer(tuple); }
 	
 	const State& getSeed() const { return _seed; }
 
@@ -95,8 +99,11 @@ public:
 	void advance();
 	
 	
-	//! Add an atom to the set of newly-reached atoms, only if it is indeed new.
+	//! Add an atom to the set of newly-reached atoms, only if it is indeed new, taking ownership of the given action.
 	void add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&& support);
+
+	//! As above, through the given ground action, whose ID the support table interns
+	void add(AtomIdx tuple, const GroundAction& action, std::vector<AtomIdx>&& support);
 	
 	//! Compute the sum of h_max values of all the given atoms, assuming that they have already been reached in the RPG data structure
 // 	unsigned compute_hmax_sum(const std::vector<Atom>& atoms) const;
@@ -112,10 +119,13 @@ public:
 
 
 protected:
-	//! Creates an atom support data structure with the given data and taking into account the current RPG layer
-	TupleSupport* createTupleSupport(const ActionID* action, std::vector<AtomIdx>&& support) const;
+	//! See 'detached'
+	RPGIndex(const RPGIndex& other, std::vector<Gecode::TupleSet>&& extensions, std::vector<Gecode::IntSet>&& domains);
 	
 	void printAtoms(const std::vector<AtomIdx>& vector, std::ostream& os) const;
+
+	//! Fill in the given support slot of a newly-reached tuple, if any
+	void insert(std::vector<AtomIdx>* slot, AtomIdx tuple, std::vector<AtomIdx>&& support);
 	
 	void next();
 };
@@ -0,0 +1,109 @@
+
+#include <algorithm>
+
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
+#include <actions/action_id.hxx>
+#include <actions/actions.hxx>
+
+namespace fs0 {
+
+RPGSupportTable::RPGSupportTable(unsigned num_atoms) :
+	_stamps(num_atoms, 0),
+	_generation(1),
+	_layers(num_atoms, 0),
+	_actions(num_atoms, nullptr),
+	_supports(num_atoms),
+	_reached(),
+	_owned(num_atoms, false),
+	_interned(),
+	_processed(num_atoms),
+	_relevant(num_atoms)
+{
+	_reached.reserve(num_atoms);
+}
+
+RPGSupportTable::~RPGSupportTable() {
+	release();
+}
+
+RPGSupportTable::RPGSupportTable(RPGSupportTable&& other) :
+	_stamps(std::move(other._stamps)),
+	_generation(other._generation),
+	_layers(std::move(other._layers)),
+	_actions(std::move(other._actions)),
+	_supports(std::move(other._supports)),
+	_reached(std::move(other._reached)),
+	_owned(std::move(other._owned)),
+	_interned(std::move(other._interned)),
+	_processed(std::move(other._processed)),
+	_relevant(std::move(other._relevant))
+{
+	other._reached.clear(); // The moved-from table owns no action
+}
+
+RPGSupportTable& RPGSupportTable::operator=(RPGSupportTable&& other) {
+	if (this == &other) return *this;
+	release();
+	_stamps = std::move(other._stamps);
+	_generation = other._generation;
+	_layers = std::move(other._layers);
+	_actions = std::move(other._actions);
+	_supports = std::move(other._supports);
+	_reached = std::move(other._reached);
+	_owned = std::move(other._owned);
+	_interned = std::move(other._interned);
+	_processed = std::move(other._processed);
+	_relevant = std::move(other._relevant);
+	other._reached.clear();
+	return *this;
+}
+
+void RPGSupportTable::release() {
+	for (AtomIdx atom:_reached) {
+		if (_owned[atom]) delete _actions[atom];
+		_actions[atom] = nullptr;
+	}
+	_reached.clear();
+}
+
+void RPGSupportTable::clear() {
+	release();
+	if (++_generation == 0) { // On overflow, stale stamps could be taken for current ones
+		std::fill(_stamps.begin(), _stamps.end(), 0);
+		_generation = 1;
+	}
+}
+
+std::vector<AtomIdx>* RPGSupportTable::add(AtomIdx atom, unsigned layer, const ActionID* action) {
+	std::vector<AtomIdx>* support = reach(atom, layer, action, true);
+	if (!support) delete action;
+	return support;
+}
+
+std::vector<AtomIdx>* RPGSupportTable::add(AtomIdx atom, unsigned layer, const GroundAction& action) {
+	if (reached(atom)) return nullptr;
+	unsigned id = action.getId();
+	if (id >= _interned.size()) _interned.resize(id + 1);
+	std::unique_ptr<const PlainActionID>& interned = _interned[id];
+	if (!interned) interned = std::unique_ptr<const PlainActionID>(new PlainActionID(&action));
+	return reach(atom, layer, interned.get(), false);
+}
+
+std::vector<AtomIdx>* RPGSupportTable::reach(AtomIdx atom, unsigned layer, const ActionID* action, bool owned) {
+	if (reached(atom)) return nullptr;
+	_stamps[atom] = _generation;
+	_layers[atom] = layer;
+	_actions[atom] = action;
+	_owned[atom] = owned;
+	_reached.push_back(atom);
+	std::vector<AtomIdx>& support = _supports[atom];
+	support.clear(); // Keeps the capacity
+	return &support;
+}
+
+void RPGSupportTable::clear_marks() const {
+	_processed.reset();
+	_relevant.reset();
+}
+
+} // namespaces
@@ -0,0 +1,118 @@
+
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include <fs_types.hxx>
+#include <boost/dynamic_bitset.hpp>
+
+
+namespace fs0 {
+
+class ActionID;
+class PlainActionID;
+class GroundAction;
+
+/**
+ * Dense book-keeping of the atoms reached in a Relaxed Planning Graph, indexed by the AtomIdx of an AtomIndex:
+ * for each reached atom, the first layer at which it was reached, the action that reached it and the atoms that
+ * support its achievement through that action.
+ * The table is meant to be kept by a heuristic across evaluations. Starting a new graph only bumps a generation
+ * counter, atoms stamped with an older generation being deemed not reached, and the support vectors keep their
+ * capacity. The IDs of ground actions are interned: the table creates one for each ground action the first time
+ * that it reaches some atom, and keeps it across graphs, hence, once warmed up, building a graph through ground
+ * actions allocates nothing here. The IDs of lifted actions, which carry their own binding, are instead allocated
+ * by the action manager that reaches the atom, and owned by the table until the graph is discarded.
+ * The table also holds the marks that the extraction of a relaxed plan from the graph leaves on the atoms.
+ */
+class RPGSupportTable {
+public:
+	explicit RPGSupportTable(unsigned num_atoms);
+	~RPGSupportTable();
+
+	RPGSupportTable(const RPGSupportTable&) = delete;
+	RPGSupportTable(RPGSupportTable&& other);
+	RPGSupportTable& operator=(const RPGSupportTable&) = delete;
+	RPGSupportTable& operator=(RPGSupportTable&& other);
+
+	//! Discards the current graph, i.e. forgets all reached atoms, to start a new one
+	void clear();
+
+	//! The number of atoms that the table can hold
+	unsigned size() const { return _stamps.size(); }
+
+	//! Returns true iff the given atom has been reached in the current graph
+	bool reached(AtomIdx atom) const { return _stamps[atom] == _generation; }
+
+	//! The layer at which the given (reached) atom was first reached
+	unsigned layer(AtomIdx atom) const { assert(reached(atom)); return _layers[atom]; }
+
+	//! The action that reached the given (reached) atom, or nullptr if it was on the seed state
+	const ActionID* action(AtomIdx atom) const { assert(reached(atom)); return _actions[atom]; }
+
+	//! The atoms that support the achievement of the given (reached) atom
+	const std::vector<AtomIdx>& support(AtomIdx atom) const { assert(reached(atom)); return _supports[atom]; }
+
+	//! All the atoms reached in the current graph, in the order in which they were reached
+	const std::vector<AtomIdx>& reached_atoms() const { return _reached; }
+
+	//! Registers the given atom as reached on the given layer through the given action, of which the table takes ownership.
+	//! Returns the (empty) support of the atom, to be filled in by the caller, or nullptr if the atom had already been
+	//! reached, in which case the action is deleted.
+	std::vector<AtomIdx>* add(AtomIdx atom, unsigned layer, const ActionID* action);
+
+	//! As above, through the given ground action, whose interned ID becomes the action of the atom
+	std::vector<AtomIdx>* add(AtomIdx atom, unsigned layer, const GroundAction& action);
+
+	//! Unmarks all atoms, to start the extraction of a new relaxed plan
+	void clear_marks() const;
+
+	//! Marks the given atom as processed by the current plan extraction. Returns false if it already was.
+	bool mark_processed(AtomIdx atom) const { return mark(_processed, atom); }
+
+	//! Whether the given atom has been marked as processed by the current plan extraction
+	bool processed(AtomIdx atom) const { return _processed.test(atom); }
+
+	//! Marks the given atom as relevant to the current relaxed plan. Returns false if it already was.
+	bool mark_relevant(AtomIdx atom) const { return mark(_relevant, atom); }
+
+protected:
+	//! '_stamps[i]' is the generation of the last graph in which atom 'i' was reached
+	std::vector<unsigned> _stamps;
+
+	//! The generation of the current graph
+	unsigned _generation;
+
+	std::vector<unsigned> _layers;
+	std::vector<const ActionID*> _actions;
+	std::vector<std::vector<AtomIdx>> _supports;
+
+	//! The atoms reached in the current graph
+	std::vector<AtomIdx> _reached;
+
+	//! '_owned[i]' is true iff the action of atom 'i' in the current graph is owned by the table, rather than interned
+	std::vector<bool> _owned;
+
+	//! '_interned[a]' is the ID of the ground action with index 'a', if it has ever reached some atom
+	std::vector<std::unique_ptr<const PlainActionID>> _interned;
+
+	//! Plan extraction does not change the graph, hence the marks can be left on a const table
+	mutable boost::dynamic_bitset<> _processed;
+	mutable boost::dynamic_bitset<> _relevant;
+
+	static bool mark(boost::dynamic_bitset<>& marks, AtomIdx atom) {
+		if (marks.test(atom)) return false;
+		marks.set(atom);
+		return true;
+	}
+
+	//! Deletes the (owned) actions of the atoms reached in the current graph
+	void release();
+
+	//! Registers the given atom as reached, if it was not; see 'add'
+	std::vector<AtomIdx>* reach(AtomIdx atom, unsigned layer, const ActionID* action, bool owned);
+};
+
+} // namespaces
@@ -1,7 +1,9 @@
 
+#include <algorithm>
 #include <limits>
 
 #include <problem_info.hxx>
+#include <actions/action_id.hxx>
 #include <state.hxx>
 #include <languages/fstrips/language.hxx>
 #include <languages/fstrips/operations.hxx>
@@ -12,6 +14,7 @@
 #include <applicability/formula_interpreter.hxx>
 #include <constraints/gecode/handlers/lifted_effect_csp.hxx>
 #include <constraints/gecode/lifted_plan_extractor.hxx>
+#include <constraints/gecode/utils/csp_stats.hxx>
 #include <lapkt/tools/logging.hxx>
 #include <utils/config.hxx>
 #include <problem.hxx>
@@ -19,28 +22,54 @@
 namespace fs0 { namespace gecode {
 
 SmartRPG::SmartRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler) :
+	SmartRPG(problem, goal_formula, state_constraints, std::move(managers), extension_handler, Config::instance().getOption<int>("rpg.threads", 1))
+{}
+
+SmartRPG::SmartRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler, int threads) :
 	_problem(problem),
 	_info(ProblemInfo::getInstance()),
 	_tuple_index(problem.get_tuple_index()),
 	_managers(std::move(managers)),
 	_extension_handler(extension_handler),
-	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(fs::conjunction(*goal_formula, *state_constraints), _tuple_index, false)))
+	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(fs::conjunction(*goal_formula, *state_constraints), _tuple_index, false))),
+	_supports(_tuple_index.size()),
+	_pool(nullptr),
+	_evaluations(0),
+	_evaluation_time(0)
 {
-	LPT_INFO("heuristic", "SmartRPG heuristic initialized");
+	if (threads <= 0) throw std::runtime_error("The number of RPG threads needs to be positive");
+	if (threads > 1) _pool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(threads));
+	
+	LPT_INFO("heuristic", "SmartRPG heuristic initialized, solving the effect CSPs on " << threads << " thread(s)");
 	if (_managers.empty()) {
 		LPT_INFO("cout", "*** WARNING - Heuristic initialized with no applicable action ***");
 	}
 }
 
+SmartRPG::~SmartRPG() {
+	if (_evaluations == 0) return; // e.g. a moved-from object
+	double seconds = std::chrono::duration<double>(_evaluation_time).count();
+	LPT_INFO("heuristic", "SmartRPG heuristic: " << _evaluations << " evaluations on " << (_pool ? _pool->size() : 1) << " thread(s), "
+	                      << 1000.0 * seconds / _evaluations << " ms per evaluation on average");
+}
+
 
 //! The actual evaluation of the heuristic value for any given non-relaxed state s.
 long SmartRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
+	auto start = std::chrono::steady_clock::now();
+	long h = compute(seed, relevant);
+	++_evaluations;
+	_evaluation_time += std::chrono::steady_clock::now() - start;
+	return h;
+}
+
+long SmartRPG::compute(const State& seed, std::vector<Atom>& relevant) {
 	
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _supports);
 	
 	if (Config::instance().useMinHMaxGoalValueSelector()) {
 		_goal_handler->init_value_selector(&graph);
@@ -49,6 +78,25 @@ long SmartRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
 	while (true) {
 		
 		// Build a new layer of the RPG.
+		build_layer(graph);
+		
+		// TODO - RETHINK HOW TO FIT THE STATE CONSTRAINTS INTO THIS CSP MODEL
+// 		LPT_EDEBUG("heuristic", "The last layer of the RPG contains " << graph.num_novel_tuples() << " novel atoms." << std::endl << graph);
+		
+		// If there is no novel fact in the rpg, we reached a fixpoint, thus there is no solution.
+		if (!graph.hasNovelTuples()) return -1;
+		
+		
+		graph.advance(); // Integrates the novel tuples into the graph as a new layer.
+		LPT_EDEBUG("heuristic", "New RPG Layer: " << graph);
+		
+		long h = computeHeuristic(graph, relevant);
+		if (h > -1) return h;
+	}
+}
+
+void SmartRPG::build_layer(RPGIndex& graph) {
+	if (!_pool) {
 		for (const EffectHandlerPtr& manager:_managers) {
 			// TODO - RETHINK
 // 			if (i == 0 && Config::instance().useMinHMaxActionValueSelector()) { // We initialize the value selector only once
@@ -64,20 +112,39 @@ long SmartRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
 			// Otherwise, we process the effect to derive the new tuples that it can produce on the current RPG layer
 			manager->seek_novel_tuples(graph);
 		}
-		
-		
-		// TODO - RETHINK HOW TO FIT THE STATE CONSTRAINTS INTO THIS CSP MODEL
-// 		LPT_EDEBUG("heuristic", "The last layer of the RPG contains " << graph.num_novel_tuples() << " novel atoms." << std::endl << graph);
-		
-		// If there is no novel fact in the rpg, we reached a fixpoint, thus there is no solution.
-		if (!graph.hasNovelTuples()) return -1;
-		
-		
-		graph.advance(); // Integrates the novel tuples into the graph as a new layer.
-		LPT_EDEBUG("heuristic", "New RPG Layer: " << graph);
-		
-		long h = computeHeuristic(graph, relevant);
-		if (h > -1) return h;
+		return;
+	}
+	
+	// The effect CSPs are instantiated on the domains and extensions of the previous layers only, and thus do not depend
+	// on the tuples added to the current layer. We can hence solve them all concurrently, and then add the tuples
+	// they reach to the graph in the order of the managers, which results in exactly the same layer (supports included)
+	// as the sequential loop above. Tuples reached by several managers are just discarded but for the first one.
+	// Each thread takes a (strided) share of the managers and instantiates their CSPs on its own detached copy of the graph.
+	// The CSP statistics of each share are credited to the calling thread, which runs the search.
+	std::vector<std::vector<LiftedEffectCSP::NovelTuple>> reached(_managers.size());
+	std::size_t num_shares = std::min<std::size_t>(_pool->size(), _managers.size());
+	std::vector<CSPStats> stats(num_shares);
+	_pool->parallel_for(num_shares, [&](std::size_t share) {
+		stats[share] = CSPStats::collect([&]() {
+			RPGIndex layer = graph.detached();
+			for (std::size_t i = share; i < _managers.size(); i += num_shares) {
+				const EffectHandlerPtr& manager = _managers[i];
+				AtomIdx achievable = manager->get_achievable_tuple();
+				if (achievable != INVALID_TUPLE && graph.reached(achievable)) continue;
+				manager->collect_novel_tuples(layer, reached[i]);
+			}
+		});
+	});
+	for (const CSPStats& share_stats:stats) CSPStats::instance().merge(share_stats);
+	
+	for (auto& tuples:reached) {
+		for (auto& tuple:tuples) {
+			if (graph.reached(std::get<0>(tuple))) {
+				delete std::get<1>(tuple);
+				continue;
+			}
+			graph.add(std::get<0>(tuple), std::get<1>(tuple), std::move(std::get<2>(tuple)));
+		}
 	}
 }
 
@@ -89,18 +156,12 @@ long SmartRPG::computeHeuristic(const RPGIndex& graph, std::vector<Atom>& releva
 RPGIndex SmartRPG::compute_full_graph(const State& seed) {
 	LPT_EDEBUG("heuristic", std::endl << "Computing Full RPG from seed state: " << std::endl << seed);
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _supports);
 	
 	// See method 'evaluate' for comments on the logic of this loop
 	while (true) {
 		LPT_EDEBUG("heuristic", "Opening layer of the full RPG");
-		for (const EffectHandlerPtr& manager:_managers) {
-			AtomIdx achievable = manager->get_achievable_tuple();
-			if (achievable != INVALID_TUPLE && graph.reached(achievable)) continue;
-			
-			// Otherwise, we process the effect to derive the new tuples that it can produce on the current RPG layer
-			manager->seek_novel_tuples(graph);
-		}
+		build_layer(graph);
 		
 		if (!graph.hasNovelTuples()) break;
 
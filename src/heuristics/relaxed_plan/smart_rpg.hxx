@@ -5,7 +5,10 @@
 #include <constraints/gecode/extensions.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
 #include <constraints/gecode/handlers/lifted_effect_csp.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
 #include <utils/atom_index.hxx>
+#include <utils/thread_pool.hxx>
+#include <chrono>
 #include <unordered_set>
 
 namespace fs0 { class Problem; class State; class RPGData; }
@@ -23,7 +26,10 @@ protected:
 	
 public:
 	SmartRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler);
-	~SmartRPG() = default;
+
+	//! As above, but solving the effect CSPs on the given number of threads, rather than on the number given by option 'rpg.threads'
+	SmartRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<EffectHandlerPtr>&& managers, ExtensionHandler extension_handler, int threads);
+	~SmartRPG();
 	
 	// Disallow copies of the object, as they will be expensive, but allow moves.
 	SmartRPG(const SmartRPG&) = delete;
@@ -43,6 +49,8 @@ public:
 	//! To be subclassed in other RPG-based heuristics such as h_max
 	virtual long computeHeuristic(const RPGIndex& graph, std::vector<Atom>& relevant);
 	
+	//! Computes the full RPG until a fixpoint is reached. The graph keeps its supports in the table of the heuristic,
+	//! hence is only valid until the next evaluation.
 	RPGIndex compute_full_graph(const State& seed);
 
 	std::vector<EffectHandlerPtr>&  get_managers() { return _managers; }
@@ -62,6 +70,22 @@ protected:
 	ExtensionHandler _extension_handler;
 	
 	std::unique_ptr<FormulaCSP> _goal_handler;
+	
+	//! The book-keeping of the supports of the RPG, reused across evaluations
+	RPGSupportTable _supports;
+	
+	//! If the number of RPG threads is greater than one, the pool of threads on which the effect CSPs of each layer are solved
+	std::unique_ptr<utils::ThreadPool> _pool;
+	
+	//! The number of heuristic evaluations performed so far, and the (wall-clock) time they took
+	unsigned long _evaluations;
+	std::chrono::steady_clock::duration _evaluation_time;
+	
+	//! Add to the last layer of the given RPG the tuples that the effect CSPs can reach on it
+	void build_layer(RPGIndex& graph);
+	
+	//! The actual computation of the heuristic value, see 'evaluate'
+	long compute(const State& seed, std::vector<Atom>& relevant);
 };
 
 } } // namespaces
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <limits>
 
 #include <languages/fstrips/language.hxx>
@@ -9,33 +10,65 @@
 #include <heuristics/relaxed_plan/rpg_index.hxx>
 #include <heuristics/relaxed_plan/relaxed_plan.hxx>
 #include <relaxed_state.hxx>
+#include <actions/action_id.hxx>
 #include <applicability/formula_interpreter.hxx>
 #include <constraints/gecode/handlers/base_action_csp.hxx>
 #include <constraints/gecode/handlers/ground_effect_csp.hxx>
 #include <constraints/gecode/lifted_plan_extractor.hxx>
+#include <constraints/gecode/utils/csp_stats.hxx>
+#include <utils/config.hxx>
 
 
 namespace fs0 { namespace gecode {
 
 UnreachedAtomRPG::UnreachedAtomRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<HandlerPT>&& managers, ExtensionHandler extension_handler) :
+	UnreachedAtomRPG(problem, goal_formula, state_constraints, std::move(managers), extension_handler, Config::instance().getOption<int>("rpg.threads", 1))
+{}
+
+UnreachedAtomRPG::UnreachedAtomRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<HandlerPT>&& managers, ExtensionHandler extension_handler, int threads) :
 	_problem(problem),
 	_tuple_index(problem.get_tuple_index()),
 	_managers(std::move(managers)),
 	_goal_handler(std::unique_ptr<FormulaCSP>(new FormulaCSP(fs::conjunction(*goal_formula, *state_constraints), _tuple_index, false))),
 	_extension_handler(extension_handler),
-	_atom_achievers(build_achievers_index(_managers, _tuple_index))
+	_supports(_tuple_index.size()),
+	_atom_achievers(build_achievers_index(_managers, _tuple_index)),
+	_pool(nullptr),
+	_evaluations(0),
+	_evaluation_time(0)
 {
-	LPT_INFO("heuristic", "Unreached-Atom-Based heuristic initialized");
+	if (threads <= 0) throw std::runtime_error("The number of RPG threads needs to be positive");
+	if (threads > 1 && Config::instance().useApproximateActionResolution()) {
+		throw std::runtime_error("Approximate precondition resolution is not supported by the unreached-atom heuristic with more than one RPG thread");
+	}
+	if (threads > 1) _pool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(threads));
+	
+	LPT_INFO("heuristic", "Unreached-Atom-Based heuristic initialized, solving the effect CSPs on " << threads << " thread(s)");
+}
+
+UnreachedAtomRPG::~UnreachedAtomRPG() {
+	if (_evaluations == 0) return; // e.g. a moved-from object
+	double seconds = std::chrono::duration<double>(_evaluation_time).count();
+	LPT_INFO("heuristic", "Unreached-Atom-Based heuristic: " << _evaluations << " evaluations on " << (_pool ? _pool->size() : 1) << " thread(s), "
+	                      << 1000.0 * seconds / _evaluations << " ms per evaluation on average");
 }
 
 //! The actual evaluation of the heuristic value for any given non-relaxed state s.
 long UnreachedAtomRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
+	auto start = std::chrono::steady_clock::now();
+	long h = compute(seed, relevant);
+	++_evaluations;
+	_evaluation_time += std::chrono::steady_clock::now() - start;
+	return h;
+}
+
+long UnreachedAtomRPG::compute(const State& seed, std::vector<Atom>& relevant) {
 	
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 	
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 	
-	RPGIndex graph(seed, _tuple_index, _extension_handler);
+	RPGIndex graph(seed, _tuple_index, _extension_handler, _supports);
 
 	if (Config::instance().useMinHMaxGoalValueSelector()) {
 		_goal_handler->init_value_selector(&graph);
@@ -47,54 +80,8 @@ long UnreachedAtomRPG::evaluate(const State& seed, std::vector<Atom>& relevant)
 	while (true) {
 	
 		// Begin a new RPG Layer
-		
-		// cache[i] will contain the CSP corresponding to effect 'i' instantiated to the current layer, or nullptr.
-		// We use it to avoid instantiating the same effect CSP more than once per layer
-		std::vector<std::unique_ptr<GecodeCSP>> cache(_managers.size());
-		
-		// failure_cache[i] will be true iff the CSP corresponding to effect 'i' has already been found to be non-applicable in the current layer.
-		std::vector<bool> failure_cache(_managers.size(), false);
-		
-		for (unsigned atom_idx = 0; atom_idx < achieved.size(); ++atom_idx) {
-			if (achieved[atom_idx]) continue; // The atom has already been achieved, no need to do anything about it.
-// 		for (auto it = unachieved.begin(); it != unachieved.end(); ) {
-// 			unsigned atom_idx = *it;
-			const Atom& atom = _tuple_index.to_atom(atom_idx);
-			
-			// Check for a potential support
-			bool atom_supported = false;
-			for (unsigned manager_idx:_atom_achievers.at(atom_idx)) {
-				const HandlerT& manager = *_managers[manager_idx];
-				if (failure_cache[manager_idx]) {
-					LPT_EDEBUG("heuristic", "Found cached unapplicable effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\"");
-					continue; // The effect CSP has already been instantiated and found unapplicable on this very same layer
-				}
-				
-				if (cache[manager_idx] == nullptr) {
-					GecodeCSP* raw = manager.preinstantiate(graph);
-					if (!raw) { // We are instantiating the CSP for the first time in this layer and find that it is not applicable.
-						failure_cache[manager_idx] = true;
-						LPT_EDEBUG("heuristic", "Effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\" inconsistent => not applicable");
-						continue;
-					}
-					cache[manager_idx] = std::unique_ptr<GecodeCSP>(raw);
-				} else {
-					LPT_EDEBUG("heuristic", "Found cached & applicable effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\"");
-				}
-				
-				atom_supported = manager.find_atom_support(atom_idx, atom, seed, *cache[manager_idx], graph);
-				if (atom_supported) break; // No need to keep iterating
-			}
-			
-			// If a support was found, no need to check for that particular atom anymore.
-			if (atom_supported) {
-				LPT_EDEBUG("heuristic", "Found support for atom " << atom);
-				achieved[atom_idx] = true;
-// 				it = unachieved.erase(it);
-			} else {
-// 				++it;
-			}
-		}
+		if (_pool) build_layer_in_parallel(graph, achieved);
+		else build_layer(graph, seed, achieved);
 		
 		// TODO - RETHINK HOW TO FIT THE STATE CONSTRAINTS INTO THIS CSP MODEL
 		
@@ -111,6 +98,119 @@ long UnreachedAtomRPG::evaluate(const State& seed, std::vector<Atom>& relevant)
 	}
 }
 
+void UnreachedAtomRPG::build_layer(RPGIndex& graph, const State& seed, std::vector<bool>& achieved) {
+	// cache[i] will contain the CSP corresponding to effect 'i' instantiated to the current layer, or nullptr.
+	// We use it to avoid instantiating the same effect CSP more than once per layer
+	std::vector<std::unique_ptr<GecodeCSP>> cache(_managers.size());
+	
+	// failure_cache[i] will be true iff the CSP corresponding to effect 'i' has already been found to be non-applicable in the current layer.
+	std::vector<bool> failure_cache(_managers.size(), false);
+	
+	for (unsigned atom_idx = 0; atom_idx < achieved.size(); ++atom_idx) {
+		if (achieved[atom_idx]) continue; // The atom has already been achieved, no need to do anything about it.
+// 		for (auto it = unachieved.begin(); it != unachieved.end(); ) {
+// 			unsigned atom_idx = *it;
+		const Atom& atom = _tuple_index.to_atom(atom_idx);
+		
+		// Check for a potential support
+		bool atom_supported = false;
+		for (unsigned manager_idx:_atom_achievers.at(atom_idx)) {
+			const HandlerT& manager = *_managers[manager_idx];
+			if (failure_cache[manager_idx]) {
+				LPT_EDEBUG("heuristic", "Found cached unapplicable effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\"");
+				continue; // The effect CSP has already been instantiated and found unapplicable on this very same layer
+			}
+			
+			if (cache[manager_idx] == nullptr) {
+				GecodeCSP* raw = manager.preinstantiate(graph);
+				if (!raw) { // We are instantiating the CSP for the first time in this layer and find that it is not applicable.
+					failure_cache[manager_idx] = true;
+					LPT_EDEBUG("heuristic", "Effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\" inconsistent => not applicable");
+					continue;
+				}
+				cache[manager_idx] = std::unique_ptr<GecodeCSP>(raw);
+			} else {
+				LPT_EDEBUG("heuristic", "Found cached & applicable effect \"" << *manager.get_effect() << "\" of action \"" << manager.get_action() << "\"");
+			}
+			
+			atom_supported = manager.find_atom_support(atom_idx, atom, seed, *cache[manager_idx], graph);
+			if (atom_supported) break; // No need to keep iterating
+		}
+		
+		// If a support was found, no need to check for that particular atom anymore.
+		if (atom_supported) {
+			LPT_EDEBUG("heuristic", "Found support for atom " << atom);
+			achieved[atom_idx] = true;
+// 				it = unachieved.erase(it);
+		} else {
+// 				++it;
+		}
+	}
+}
+
+void UnreachedAtomRPG::build_layer_in_parallel(RPGIndex& graph, std::vector<bool>& achieved) {
+	std::vector<AtomIdx> unachieved;
+	for (unsigned atom_idx = 0; atom_idx < achieved.size(); ++atom_idx) {
+		if (!achieved[atom_idx]) unachieved.push_back(atom_idx);
+	}
+	
+	// The support of each atom depends only on the previous layers of the graph, hence the atoms can be processed concurrently,
+	// as long as the supports found are then added to the graph in the order of the atoms, which results in the same layer
+	// as the sequential loop. Each thread takes a (strided) share of the atoms and keeps its own cache of layer CSPs,
+	// instantiated on its own detached copy of the graph, so that it can clone them while other threads do the same with theirs.
+	// The CSP statistics of each share are credited to the calling thread, which runs the search.
+	struct AtomSupport {
+		AtomSupport() : supported(false), action(nullptr), support() {}
+		bool supported;
+		const ActionID* action;
+		std::vector<AtomIdx> support;
+	};
+	std::vector<AtomSupport> supports(unachieved.size());
+	std::size_t num_shares = std::min<std::size_t>(_pool->size(), unachieved.size());
+	std::vector<CSPStats> stats(num_shares);
+	
+	_pool->parallel_for(num_shares, [&](std::size_t share) {
+		stats[share] = CSPStats::collect([&]() {
+			RPGIndex layer = graph.detached();
+			std::vector<std::unique_ptr<GecodeCSP>> cache(_managers.size());
+			std::vector<bool> failure_cache(_managers.size(), false);
+		
+			for (std::size_t i = share; i < unachieved.size(); i += num_shares) {
+				AtomIdx atom_idx = unachieved[i];
+				const Atom& atom = _tuple_index.to_atom(atom_idx);
+				AtomSupport& atom_support = supports[i];
+			
+				for (unsigned manager_idx:_atom_achievers.at(atom_idx)) {
+					const HandlerT& manager = *_managers[manager_idx];
+					if (failure_cache[manager_idx]) continue;
+				
+					if (cache[manager_idx] == nullptr) {
+						GecodeCSP* raw = manager.preinstantiate_detached(layer);
+						if (!raw) {
+							failure_cache[manager_idx] = true;
+							continue;
+						}
+						cache[manager_idx] = std::unique_ptr<GecodeCSP>(raw);
+					}
+				
+					atom_support.supported = manager.collect_atom_support(atom, *cache[manager_idx], atom_support.action, atom_support.support);
+					if (atom_support.supported) break;
+				}
+			}
+		});
+	});
+	for (const CSPStats& share_stats:stats) CSPStats::instance().merge(share_stats);
+	
+	for (unsigned i = 0; i < unachieved.size(); ++i) {
+		AtomSupport& atom_support = supports[i];
+		if (!atom_support.supported) continue;
+		LPT_EDEBUG("heuristic", "Found support for atom " << _tuple_index.to_atom(unachieved[i]));
+		achieved[unachieved[i]] = true;
+		if (graph.reached(unachieved[i])) delete atom_support.action;
+		else graph.add(unachieved[i], atom_support.action, std::move(atom_support.support));
+	}
+}
+
 long UnreachedAtomRPG::computeHeuristic(const RPGIndex& graph) {
 	return support::compute_rpg_cost(_tuple_index, graph, *_goal_handler);
 }
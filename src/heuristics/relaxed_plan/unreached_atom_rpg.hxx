@@ -5,6 +5,9 @@
 #include <constraints/gecode/extensions.hxx>
 #include <constraints/gecode/handlers/formula_csp.hxx>
 #include <constraints/gecode/handlers/lifted_effect_unreached.hxx>
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
+#include <utils/thread_pool.hxx>
+#include <chrono>
 
 
 namespace fs0 { class Problem; class State; class RPGData; }
@@ -17,7 +20,10 @@ public:
 	using HandlerPT = std::unique_ptr<HandlerT>;
 
 	UnreachedAtomRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<HandlerPT>&& managers, ExtensionHandler extension_handler);
-	~UnreachedAtomRPG() = default;
+
+	//! As above, but seeking the support of the atoms on the given number of threads, rather than on the number given by option 'rpg.threads'
+	UnreachedAtomRPG(const Problem& problem, const fs::Formula* goal_formula, const fs::Formula* state_constraints, std::vector<HandlerPT>&& managers, ExtensionHandler extension_handler, int threads);
+	~UnreachedAtomRPG();
 	
 	// Disallow copies of the object, as they will be expensive, but allow moves.
 	UnreachedAtomRPG(const UnreachedAtomRPG&) = delete;
@@ -52,6 +58,9 @@ protected:
 	//!
 	ExtensionHandler _extension_handler;
 	
+	//! The book-keeping of the supports of the RPG, reused across evaluations
+	RPGSupportTable _supports;
+	
 	
 	//! a map from atom index to the set of action / effect managers that can (potentially) achieve that atom.
 	//! let L = _atom_achievers[i] be the vector of all potential achievers of atom with index 'i'.
@@ -61,6 +70,21 @@ protected:
 	
 	//! A helper to build the index of atom achievers.
 	static AchieverIndex build_achievers_index(const std::vector<HandlerPT>& managers, const AtomIndex& tuple_index);
+	
+	//! If the number of RPG threads is greater than one, the pool of threads on which the support of the unachieved atoms is sought
+	std::unique_ptr<utils::ThreadPool> _pool;
+	
+	//! The number of heuristic evaluations performed so far, and the (wall-clock) time they took
+	unsigned long _evaluations;
+	std::chrono::steady_clock::duration _evaluation_time;
+	
+	//! The actual computation of the heuristic value, see 'evaluate'
+	long compute(const State& seed, std::vector<Atom>& relevant);
+	
+	//! Add to the last layer of the given RPG the atoms not yet achieved that some effect CSP can support,
+	//! marking them as achieved.
+	void build_layer(RPGIndex& graph, const State& seed, std::vector<bool>& achieved);
+	void build_layer_in_parallel(RPGIndex& graph, std::vector<bool>& achieved);
 };
 
 } } // namespaces
@@ -6,12 +6,22 @@
 
 namespace fs0 {
 
-UnsatisfiedGoalAtomsHeuristic::UnsatisfiedGoalAtomsHeuristic(const Problem& problem) : _goal_conjunction(extract_goal_conjunction(problem)) {}
+UnsatisfiedGoalAtomsHeuristic::UnsatisfiedGoalAtomsHeuristic(const Problem& problem) :
+	_goal_conjunction(extract_goal_conjunction(problem)),
+	_compiled_conjuncts()
+{
+	for (const fs::Formula* condition:get_goal_conjuncts()) {
+		_compiled_conjuncts.push_back(std::unique_ptr<const CompiledFormula>(CompiledFormula::compile(condition, problem.getStateAtomIndexer())));
+	}
+}
 	
 float UnsatisfiedGoalAtomsHeuristic::evaluate(const State& state) const { 
 	unsigned unsatisfied = 0;
-	for (const fs::Formula* condition:get_goal_conjuncts()) {
-		if (!condition->interpret(state)) ++unsatisfied;
+	const auto& conjuncts = get_goal_conjuncts();
+	for (unsigned i = 0; i < conjuncts.size(); ++i) {
+		const auto& compiled = _compiled_conjuncts[i];
+		bool holds = compiled ? compiled->satisfied(state) : conjuncts[i]->interpret(state);
+		if (!holds) ++unsatisfied;
 	}
 	return unsatisfied;
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <languages/fstrips/language_fwd.hxx>
+#include <applicability/compiled_formula.hxx>
 
 namespace fs0 {
 
@@ -21,6 +22,9 @@ public:
 protected:
 	const std::unique_ptr<const fs::Conjunction> _goal_conjunction;
 	
+	//! The compiled form of each goal conjunct, or null if the conjunct cannot be compiled
+	std::vector<std::unique_ptr<const CompiledFormula>> _compiled_conjuncts;
+	
 	const fs::Conjunction* extract_goal_conjunction(const Problem& problem);
 };
 
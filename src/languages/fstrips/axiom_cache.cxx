@@ -0,0 +1,221 @@
+#include <cassert>
+#include <unordered_set>
+
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/formulae.hxx>
+#include <languages/fstrips/terms.hxx>
+#include <atom.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/thread_registry.hxx>
+
+
+namespace fs0 { namespace language { namespace fstrips {
+
+using AxiomSet = std::unordered_set<const Axiom*>;
+
+static bool _collect_variables(const Formula& formula, const ProblemInfo& info, std::vector<bool>& variables, AxiomSet& visited);
+
+static bool _collect_variables(const Axiom& axiom, const ProblemInfo& info, std::vector<bool>& variables, AxiomSet& visited) {
+	if (!visited.insert(&axiom).second) return true; // Recursive axioms read nothing beyond what we are already collecting
+	return _collect_variables(*axiom.getDefinition(), info, variables, visited);
+}
+
+//! Marks in 'variables' the state variables whose value the interpretation of the given term might depend on.
+//! Returns false if they cannot be determined, e.g. because the term uses some procedural axiom
+static bool _collect_variables(const Term& term, const ProblemInfo& info, std::vector<bool>& variables, AxiomSet& visited) {
+	if (dynamic_cast<const BoundVariable*>(&term) || dynamic_cast<const Constant*>(&term)) return true;
+
+	if (auto variable = dynamic_cast<const StateVariable*>(&term)) {
+		variables[variable->getValue()] = true;
+		return true;
+	}
+
+	auto nested = dynamic_cast<const NestedTerm*>(&term);
+	if (!nested || dynamic_cast<const AxiomaticTerm*>(&term)) return false;
+
+	if (auto fluent = dynamic_cast<const FluentHeadedNestedTerm*>(&term)) {
+		for (VariableIdx variable:info.resolveStateVariable(fluent->getSymbolId())) variables[variable] = true;
+	} else if (auto axiomatic = dynamic_cast<const AxiomaticTermWrapper*>(&term)) {
+		if (!_collect_variables(*axiomatic->getAxiom(), info, variables, visited)) return false;
+	}
+
+	for (const Term* subterm:nested->getSubterms()) {
+		if (!_collect_variables(*subterm, info, variables, visited)) return false;
+	}
+	return true;
+}
+
+static bool _collect_variables(const Formula& formula, const ProblemInfo& info, std::vector<bool>& variables, AxiomSet& visited) {
+	if (formula.is_tautology() || formula.is_contradiction()) return true;
+
+	if (auto atom = dynamic_cast<const AtomicFormula*>(&formula)) {
+		if (dynamic_cast<const AxiomaticFormula*>(&formula)) return false;
+		for (const Term* subterm:atom->getSubterms()) {
+			if (!_collect_variables(*subterm, info, variables, visited)) return false;
+		}
+		return true;
+	}
+
+	if (auto atom = dynamic_cast<const AxiomaticAtom*>(&formula)) {
+		for (const Term* subterm:atom->getSubterms()) {
+			if (!_collect_variables(*subterm, info, variables, visited)) return false;
+		}
+		return _collect_variables(*atom->getAxiom(), info, variables, visited);
+	}
+
+	if (auto open = dynamic_cast<const OpenFormula*>(&formula)) {
+		for (const Formula* subformula:open->getSubformulae()) {
+			if (!_collect_variables(*subformula, info, variables, visited)) return false;
+		}
+		return true;
+	}
+
+	if (auto quantified = dynamic_cast<const QuantifiedFormula*>(&formula)) {
+		return _collect_variables(*quantified->getSubformula(), info, variables, visited);
+	}
+
+	return false;
+}
+
+//! The caches of all threads
+static utils::ThreadRegistry<AxiomCache>& _registry() {
+	static utils::ThreadRegistry<AxiomCache> registry;
+	return registry;
+}
+
+//! The statistics of the caches of the threads that have exited, only accessed with the registry locked
+static AxiomCache::Statistics _retired = {0, 0, 0};
+
+AxiomCache::AxiomCache() :
+	_tables(), _readers(), _global(), _stamp(0), _last(nullptr), _copied(false), _num_values(0), _hits(0), _misses(0), _invalidations(0)
+{
+	_registry().add(this);
+}
+
+AxiomCache::~AxiomCache() {
+	_registry().remove(this, [](const AxiomCache& cache) {
+		_retired.hits += cache.hits();
+		_retired.misses += cache.misses();
+		_retired.invalidations += cache.invalidations();
+	});
+}
+
+AxiomCache::TableT&
+AxiomCache::table(const Axiom* axiom) {
+	auto it = _tables.find(axiom);
+	if (it != _tables.end()) return it->second;
+
+	TableT& table = _tables[axiom]; // References to the elements of an unordered map remain valid upon rehashing
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::vector<bool> variables(info.getNumVariables(), false);
+	AxiomSet visited;
+	if (!_collect_variables(*axiom, info, variables, visited)) {
+		_global.push_back(&table);
+		return table;
+	}
+
+	_readers.resize(info.getNumVariables());
+	for (VariableIdx variable = 0; variable < variables.size(); ++variable) {
+		if (variables[variable]) _readers[variable].push_back(&table);
+	}
+	return table;
+}
+
+void
+AxiomCache::sync(const State& state) {
+	if (state.stamp() == _stamp) return;
+	_stamp = state.stamp();
+
+	if (_num_values == 0) { // Nothing to invalidate, the state will be copied if some value is cached on it
+		_copied = false;
+		return;
+	}
+
+	assert(_copied);
+	if (_last->numAtoms() != state.numAtoms()) { // Not even the same problem
+		for (auto& element:_tables) element.second.clear();
+		_num_values = 0;
+		_copied = false;
+		return;
+	}
+
+	for (TableT* table:_global) {
+		_num_values -= table->size();
+		table->clear();
+		increment(_invalidations);
+	}
+
+	for (VariableIdx variable = 0; variable < _readers.size(); ++variable) {
+		if (_last->getValue(variable) == state.getValue(variable)) continue;
+		for (TableT* table:_readers[variable]) {
+			if (table->empty()) continue;
+			_num_values -= table->size();
+			table->clear();
+			increment(_invalidations);
+		}
+	}
+	_last->apply_inplace(state, std::vector<Atom>());
+}
+
+bool
+AxiomCache::find(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx& value) {
+	sync(state);
+	auto it = _tables.find(axiom);
+	if (it != _tables.end()) {
+		auto value_it = it->second.find(arguments);
+		if (value_it != it->second.end()) {
+			increment(_hits);
+			value = value_it->second;
+			return true;
+		}
+	}
+	increment(_misses);
+	return false;
+}
+
+void
+AxiomCache::store(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx value) {
+	sync(state);
+	if (!_copied) {
+		if (_last) _last->apply_inplace(state, std::vector<Atom>());
+		else _last = std::unique_ptr<State>(new State(state));
+		_copied = true;
+	}
+	if (table(axiom).insert(std::make_pair(arguments, value)).second) ++_num_values;
+}
+
+void
+AxiomCache::clear() {
+	_tables.clear();
+	_readers.clear();
+	_global.clear();
+	_last.reset();
+	_stamp = 0;
+	_copied = false;
+	_num_values = 0;
+}
+
+void
+AxiomCache::clear_all() {
+	_registry().visit([](const std::vector<AxiomCache*>& caches) {
+		for (AxiomCache* cache:caches) cache->clear();
+	});
+}
+
+AxiomCache::Statistics
+AxiomCache::totals() {
+	Statistics totals;
+	_registry().visit([&totals](const std::vector<AxiomCache*>& caches) {
+		totals = _retired;
+		for (const AxiomCache* cache:caches) {
+			totals.hits += cache->hits();
+			totals.misses += cache->misses();
+			totals.invalidations += cache->invalidations();
+		}
+	});
+	return totals;
+}
+
+} } } // namespaces
@@ -0,0 +1,106 @@
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class State; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class Axiom;
+
+//! A cache of the values of the axioms on the state on which they were last interpreted, keyed by axiom and arguments.
+//! When axioms are interpreted on a different state, only the cached values of the axioms that read some state variable
+//! with a different value in the new state are discarded: the state variables that each axiom reads, directly or through
+//! the axioms it uses, are computed once, and the cache keeps a copy of the last state to find out which variables change.
+//! Axioms whose definition uses externally-defined (procedural) axioms are assumed to read all state variables.
+//! States are told apart by their stamp (see State::stamp). The cache is kept separately for each thread, but the caches
+//! of all threads can be cleared at once, and their statistics aggregated, from any thread.
+class AxiomCache {
+public:
+	//! The number of lookups that found a cached value and that did not, and the number of times that the cached values
+	//! of some axiom have been discarded on a change of state
+	struct Statistics {
+		unsigned long hits;
+		unsigned long misses;
+		unsigned long invalidations;
+	};
+
+	//! The cache of the current thread
+	static AxiomCache& instance() {
+		static thread_local AxiomCache cache;
+		return cache;
+	}
+
+	AxiomCache(const AxiomCache&) = delete;
+	AxiomCache& operator=(const AxiomCache&) = delete;
+
+	//! Returns true iff the value of the given axiom on the given arguments and state is cached, leaving it in 'value'
+	bool find(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx& value);
+
+	//! Caches the value of the given axiom on the given arguments and state
+	void store(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx value);
+
+	//! Discards all cached values and dependencies, as well as the copy of the last state, which must be done before
+	//! any cached axiom, or the state indexer of the cached states, is destroyed
+	void clear();
+
+	//! Clears the caches of all threads, which must not be interpreting axioms at the time, e.g. when the problem is destroyed
+	static void clear_all();
+
+	unsigned long hits() const { return _hits.load(std::memory_order_relaxed); }
+	unsigned long misses() const { return _misses.load(std::memory_order_relaxed); }
+	unsigned long invalidations() const { return _invalidations.load(std::memory_order_relaxed); }
+
+	//! The statistics of the caches of all threads, those that have already exited included
+	static Statistics totals();
+
+protected:
+	using TableT = std::unordered_map<ValueTuple, ObjectIdx, boost::hash<ValueTuple>>;
+
+	AxiomCache();
+	~AxiomCache();
+
+	//! The cached values of each axiom
+	std::unordered_map<const Axiom*, TableT> _tables;
+
+	//! '_readers[x]' contains the tables of the axioms that read state variable 'x'
+	std::vector<std::vector<TableT*>> _readers;
+
+	//! The tables of the axioms that might read any state variable
+	std::vector<TableT*> _global;
+
+	//! The stamp of the state on which the cached values hold
+	uint64_t _stamp;
+
+	//! A copy of that state, valid only if '_copied'
+	std::unique_ptr<State> _last;
+	bool _copied;
+
+	//! The total number of values currently cached
+	std::size_t _num_values;
+
+	//! Only written by the thread of the cache, and read by any thread
+	std::atomic<unsigned long> _hits;
+	std::atomic<unsigned long> _misses;
+	std::atomic<unsigned long> _invalidations;
+
+	static void increment(std::atomic<unsigned long>& counter) {
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	//! Discard the cached values that might not hold on the given state, if different from the last one
+	void sync(const State& state);
+
+	//! Returns the table of the given axiom, creating it and indexing its dependencies if necessary
+	TableT& table(const Axiom* axiom);
+};
+
+} } } // namespaces
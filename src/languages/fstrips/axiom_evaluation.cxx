@@ -0,0 +1,320 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <lapkt/tools/logging.hxx>
+
+#include <languages/fstrips/axiom_evaluation.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/formulae.hxx>
+#include <languages/fstrips/terms.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+#include <utils/cartesian_iterator.hxx>
+#include <utils/thread_registry.hxx>
+
+
+namespace fs0 { namespace language { namespace fstrips {
+
+//! Each use of an axiom by the definition of another, and whether the use is monotonic, i.e. the definition can only
+//! become true, not false, when the extension of the used axiom grows
+using AxiomUse = std::pair<const Axiom*, bool>;
+
+//! Collect the axioms used by the given term; axioms in argument position are never used monotonically
+static void _collect_uses(const Term& term, bool monotonic, std::vector<AxiomUse>& uses) {
+	auto nested = dynamic_cast<const NestedTerm*>(&term);
+	if (!nested) return;
+	if (auto axiomatic = dynamic_cast<const AxiomaticTermWrapper*>(&term)) uses.push_back(std::make_pair(axiomatic->getAxiom(), monotonic));
+	for (const Term* subterm:nested->getSubterms()) _collect_uses(*subterm, false, uses);
+}
+
+//! Collect the axioms used by the given formula, which is under an even number of negations iff 'positive'
+static void _collect_uses(const Formula& formula, bool positive, std::vector<AxiomUse>& uses) {
+	if (auto atom = dynamic_cast<const AxiomaticAtom*>(&formula)) {
+		uses.push_back(std::make_pair(atom->getAxiom(), positive));
+		for (const Term* subterm:atom->getSubterms()) _collect_uses(*subterm, false, uses);
+		return;
+	}
+
+	if (auto atom = dynamic_cast<const AtomicFormula*>(&formula)) {
+		// A predicative axiom 'p(x)' is represented as 'p(x) = 1'
+		const std::vector<const Term*>& subterms = atom->getSubterms();
+		if (dynamic_cast<const EQAtomicFormula*>(&formula) && subterms.size() == 2) {
+			for (unsigned i = 0; i < 2; ++i) {
+				auto constant = dynamic_cast<const Constant*>(subterms[1 - i]);
+				if (constant && constant->getValue() != 0 && dynamic_cast<const AxiomaticTermWrapper*>(subterms[i])) {
+					_collect_uses(*subterms[i], positive, uses);
+					return;
+				}
+			}
+		}
+		for (const Term* subterm:subterms) _collect_uses(*subterm, false, uses);
+		return;
+	}
+
+	if (auto negation = dynamic_cast<const Negation*>(&formula)) {
+		_collect_uses(*negation->getSubformulae()[0], !positive, uses);
+		return;
+	}
+
+	if (auto open = dynamic_cast<const OpenFormula*>(&formula)) {
+		for (const Formula* subformula:open->getSubformulae()) _collect_uses(*subformula, positive, uses);
+		return;
+	}
+
+	if (auto quantified = dynamic_cast<const QuantifiedFormula*>(&formula)) {
+		_collect_uses(*quantified->getSubformula(), positive, uses);
+	}
+}
+
+//! Tarjan's algorithm to find the strongly connected components of the axiom dependency graph reachable from some
+//! axiom, skipping those already stratified. Components are found in reverse topological order, i.e. each component
+//! only depends on itself and on the components found before.
+struct _ComponentSearch {
+	_ComponentSearch(const std::unordered_map<const Axiom*, std::pair<unsigned, unsigned>>& stratified) : stratified(stratified) {}
+
+	const std::unordered_map<const Axiom*, std::pair<unsigned, unsigned>>& stratified;
+	std::unordered_map<const Axiom*, std::vector<AxiomUse>> uses;
+	std::unordered_map<const Axiom*, std::pair<unsigned, unsigned>> numbers; // The DFS number and lowlink of each axiom
+	std::vector<const Axiom*> stack;
+	std::vector<std::vector<const Axiom*>> components;
+
+	void visit(const Axiom* axiom) {
+		unsigned number = numbers.size();
+		numbers[axiom] = std::make_pair(number, number);
+		stack.push_back(axiom);
+
+		std::vector<AxiomUse>& axiom_uses = uses[axiom];
+		_collect_uses(*axiom->getDefinition(), true, axiom_uses);
+		for (const AxiomUse& use:axiom_uses) {
+			const Axiom* used = use.first;
+			if (stratified.count(used)) continue;
+			auto it = numbers.find(used);
+			if (it == numbers.end()) {
+				visit(used);
+				numbers[axiom].second = std::min(numbers[axiom].second, numbers[used].second);
+			} else if (std::find(stack.begin(), stack.end(), used) != stack.end()) {
+				numbers[axiom].second = std::min(numbers[axiom].second, it->second.first);
+			}
+		}
+
+		if (numbers[axiom].second != number) return;
+		std::vector<const Axiom*> component;
+		const Axiom* member = nullptr;
+		while (member != axiom) {
+			member = stack.back();
+			stack.pop_back();
+			component.push_back(member);
+		}
+		components.push_back(std::move(component));
+	}
+};
+
+//! All tuples of objects of the types of the parameters of the given axiom
+static std::vector<ValueTuple> _candidates(const Axiom& axiom) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	if (axiom.getSignature().empty()) return std::vector<ValueTuple>(1);
+
+	std::vector<const ObjectIdxVector*> values;
+	for (TypeIdx type:axiom.getSignature()) values.push_back(&info.getTypeObjects(type));
+
+	std::vector<ValueTuple> candidates;
+	for (utils::cartesian_iterator it(std::move(values)); !it.ended(); ++it) candidates.push_back(*it);
+	return candidates;
+}
+
+//! The evaluators of all threads
+static utils::ThreadRegistry<AxiomEvaluator>& _registry() {
+	static utils::ThreadRegistry<AxiomEvaluator> registry;
+	return registry;
+}
+
+//! The statistics of the evaluators of the threads that have exited, only accessed with the registry locked
+static AxiomEvaluator::Statistics _retired = {0, 0, 0};
+
+AxiomEvaluator::AxiomEvaluator() :
+	_strata(), _index(), _partial(), _fixpoints(0), _rounds(0), _evaluations(0)
+{
+	_registry().add(this);
+}
+
+AxiomEvaluator::~AxiomEvaluator() {
+	_registry().remove(this, [](const AxiomEvaluator& evaluator) {
+		_retired.fixpoints += evaluator.fixpoints();
+		_retired.rounds += evaluator.rounds();
+		_retired.evaluations += evaluator.evaluations();
+	});
+}
+
+const std::pair<unsigned, unsigned>&
+AxiomEvaluator::locate(const Axiom* axiom) {
+	auto it = _index.find(axiom);
+	if (it != _index.end()) return it->second;
+
+	_ComponentSearch search(_index);
+	search.visit(axiom);
+
+	// Check all components before stratifying any, so that a failure leaves the current strata untouched
+	std::unordered_map<const Axiom*, std::pair<unsigned, unsigned>> located;
+	for (unsigned c = 0; c < search.components.size(); ++c) {
+		const std::vector<const Axiom*>& component = search.components[c];
+		for (unsigned i = 0; i < component.size(); ++i) located[component[i]] = std::make_pair(_strata.size() + c, i);
+	}
+
+	std::vector<Stratum> strata;
+	for (unsigned c = 0; c < search.components.size(); ++c) {
+		const std::vector<const Axiom*>& component = search.components[c];
+		Stratum data;
+		data.axioms = component;
+		data.recursive = false;
+		for (unsigned i = 0; i < component.size(); ++i) {
+			for (const AxiomUse& use:search.uses[component[i]]) {
+				auto it = located.find(use.first);
+				if (it == located.end() || it->second.first != _strata.size() + c) continue; // Used from a lower stratum
+				if (!use.second) {
+					throw std::runtime_error("Axiom " + component[i]->getName() + " depends on itself through negation, hence axioms cannot be stratified");
+				}
+				data.recursive = true;
+			}
+		}
+
+		if (data.recursive) {
+			for (const Axiom* member:component) data.candidates.push_back(_candidates(*member));
+			LPT_DEBUG("main", "Axiom stratum #" << _strata.size() + c << " is recursive, with " << component.size() << " axioms, to be evaluated bottom-up");
+		}
+		strata.push_back(std::move(data));
+	}
+
+	_index.insert(located.begin(), located.end());
+	for (Stratum& data:strata) {
+		_strata.push_back(std::move(data));
+		_partial.push_back(nullptr);
+	}
+	return _index.at(axiom);
+}
+
+unsigned AxiomEvaluator::stratum(const Axiom* axiom) { return locate(axiom).first; }
+
+bool AxiomEvaluator::is_recursive(const Axiom* axiom) { return _strata[locate(axiom).first].recursive; }
+
+void
+AxiomEvaluator::clear() {
+	_strata.clear();
+	_index.clear();
+	_partial.clear();
+}
+
+void
+AxiomEvaluator::clear_all() {
+	_registry().visit([](const std::vector<AxiomEvaluator*>& evaluators) {
+		for (AxiomEvaluator* evaluator:evaluators) evaluator->clear();
+	});
+}
+
+AxiomEvaluator::Statistics
+AxiomEvaluator::totals() {
+	Statistics totals;
+	_registry().visit([&totals](const std::vector<AxiomEvaluator*>& evaluators) {
+		totals = _retired;
+		for (const AxiomEvaluator* evaluator:evaluators) {
+			totals.fixpoints += evaluator->fixpoints();
+			totals.rounds += evaluator->rounds();
+			totals.evaluations += evaluator->evaluations();
+		}
+	});
+	return totals;
+}
+
+bool
+AxiomEvaluator::evaluate(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx& value) {
+	std::pair<unsigned, unsigned> location = locate(axiom);
+	if (!_strata[location.first].recursive) return false;
+
+	// Within the computation of the fixpoint of the stratum, the axioms read the part of their extension derived so far
+	if (Fixpoint* partial = _partial[location.first]) {
+		value = partial->extension.at(location.second).count(arguments) > 0;
+		if (!value) partial->misses.push_back(std::make_pair(location.second, arguments));
+		return true;
+	}
+
+	std::vector<ExtensionT> extension;
+	materialize(location.first, state, extension);
+	value = extension[location.second].count(arguments) > 0;
+	return true;
+}
+
+void
+AxiomEvaluator::materialize(unsigned stratum, const State& state, std::vector<ExtensionT>& extension) {
+	const Stratum& data = _strata[stratum];
+	unsigned size = data.axioms.size();
+	extension.assign(size, ExtensionT());
+
+	// 'watchers[i]' maps each tuple of the i-th axiom not derived yet to the candidates whose evaluation looked it up,
+	// each candidate being identified by the position of its axiom and its own position among the candidates of the axiom
+	using CandidateT = std::pair<unsigned, unsigned>;
+	std::vector<std::unordered_map<ValueTuple, std::vector<CandidateT>, boost::hash<ValueTuple>>> watchers(size);
+
+	// 'queued[i][k]' is the last round in which the k-th candidate of the i-th axiom was scheduled for evaluation
+	std::vector<std::vector<unsigned long>> queued(size);
+	std::vector<CandidateT> agenda;
+	for (unsigned i = 0; i < size; ++i) {
+		queued[i].assign(data.candidates[i].size(), 0);
+		for (unsigned k = 0; k < data.candidates[i].size(); ++k) agenda.push_back(std::make_pair(i, k));
+	}
+
+	Fixpoint fixpoint{extension, {}};
+	std::vector<LookupT> derived;
+	unsigned long round = 0;
+	_partial[stratum] = &fixpoint;
+	try {
+		while (!agenda.empty()) {
+			increment(_rounds);
+			++round;
+			derived.clear();
+			for (const CandidateT& candidate:agenda) {
+				const ValueTuple& tuple = data.candidates[candidate.first][candidate.second];
+				if (extension[candidate.first].count(tuple)) continue; // As recursion is positive, derived tuples remain derived
+
+				increment(_evaluations);
+				fixpoint.misses.clear();
+				const Axiom* axiom = data.axioms[candidate.first];
+				Binding binding;
+				axiom->getBindingUnit().update_binding(binding, tuple);
+				if (axiom->getDefinition()->interpret(state, binding)) {
+					extension[candidate.first].insert(tuple);
+					derived.push_back(std::make_pair(candidate.first, tuple));
+				} else {
+					for (const LookupT& miss:fixpoint.misses) watchers[miss.first][miss.second].push_back(candidate);
+				}
+			}
+
+			// Only the candidates that missed some of the newly derived tuples might hold now
+			agenda.clear();
+			for (const LookupT& tuple:derived) {
+				auto it = watchers[tuple.first].find(tuple.second);
+				if (it == watchers[tuple.first].end()) continue;
+				for (const CandidateT& candidate:it->second) {
+					unsigned long& last = queued[candidate.first][candidate.second];
+					if (last == round) continue;
+					last = round;
+					agenda.push_back(candidate);
+				}
+				watchers[tuple.first].erase(it);
+			}
+		}
+	} catch (...) {
+		_partial[stratum] = nullptr;
+		throw;
+	}
+	_partial[stratum] = nullptr;
+	increment(_fixpoints);
+
+	AxiomCache& cache = AxiomCache::instance();
+	for (unsigned i = 0; i < size; ++i) {
+		const Axiom* axiom = data.axioms[i];
+		for (const ValueTuple& tuple:data.candidates[i]) cache.store(axiom, state, tuple, extension[i].count(tuple) > 0);
+	}
+}
+
+} } } // namespaces
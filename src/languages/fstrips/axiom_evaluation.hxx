@@ -0,0 +1,128 @@
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class State; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class Axiom;
+
+//! A bottom-up evaluator of recursive axioms, e.g. the transitive closure of some fluent relation, which cannot be
+//! interpreted top-down without looping forever.
+//! The dependency graph among axioms, where an axiom depends on the axioms its definition uses, is split into strongly
+//! connected components, i.e. strata, which are ordered so that each stratum depends only on itself and on lower strata.
+//! A stratum is recursive if some axiom in it depends on some axiom in the same stratum; recursion must be positive,
+//! i.e. not through negation or non-monotonic comparisons, otherwise the axioms cannot be stratified.
+//! The extension of the axioms of a recursive stratum on a state is computed as the least fixpoint of their definitions,
+//! semi-naively: each evaluation of a candidate tuple that does not hold records the tuples of the stratum that it looked
+//! up and found not derived yet. Since recursion is positive, and the evaluation is otherwise deterministic on the state,
+//! the candidate can only come to hold once one of them gets derived, hence after a first round over all candidate
+//! tuples, each round only re-evaluates the candidates that looked up some tuple derived in the previous round.
+//! The resulting extension is materialized into the AxiomCache of the thread, which discards it only when some state
+//! variable read by the stratum changes its value; non-recursive axioms are left to top-down interpretation.
+//! Stratification is computed lazily, for the axioms reachable from those being evaluated. Kept separately for each thread,
+//! but the evaluators of all threads can be cleared at once, and their statistics aggregated, from any thread.
+class AxiomEvaluator {
+public:
+	//! The number of fixpoints computed, and of evaluation rounds and of candidate tuple evaluations that they took overall
+	struct Statistics {
+		unsigned long fixpoints;
+		unsigned long rounds;
+		unsigned long evaluations;
+	};
+
+	//! The evaluator of the current thread
+	static AxiomEvaluator& instance() {
+		static thread_local AxiomEvaluator evaluator;
+		return evaluator;
+	}
+
+	AxiomEvaluator(const AxiomEvaluator&) = delete;
+	AxiomEvaluator& operator=(const AxiomEvaluator&) = delete;
+
+	//! Returns true iff the given axiom is recursive, in which case its value on the given arguments and state is left in
+	//! 'value', computed bottom-up if necessary. Throws if the axioms cannot be stratified.
+	bool evaluate(const Axiom* axiom, const State& state, const ValueTuple& arguments, ObjectIdx& value);
+
+	//! The index of the stratum of the given axiom, with the axioms it depends on in the same or lower strata
+	unsigned stratum(const Axiom* axiom);
+
+	//! Whether the given axiom belongs to a recursive stratum
+	bool is_recursive(const Axiom* axiom);
+
+	//! Discards the stratification, which must be done before any stratified axiom is destroyed
+	void clear();
+
+	//! Clears the evaluators of all threads, which must not be interpreting axioms at the time, e.g. when the problem is destroyed
+	static void clear_all();
+
+	unsigned long fixpoints() const { return _fixpoints.load(std::memory_order_relaxed); }
+	unsigned long rounds() const { return _rounds.load(std::memory_order_relaxed); }
+	unsigned long evaluations() const { return _evaluations.load(std::memory_order_relaxed); }
+
+	//! The statistics of the evaluators of all threads, those that have already exited included
+	static Statistics totals();
+
+protected:
+	using ExtensionT = std::unordered_set<ValueTuple, boost::hash<ValueTuple>>;
+
+	struct Stratum {
+		//! The axioms in the stratum
+		std::vector<const Axiom*> axioms;
+
+		//! Whether some axiom in the stratum depends on some axiom in the same stratum
+		bool recursive;
+
+		//! 'candidates[i]' contains all tuples of objects of the types of the parameters of the i-th axiom
+		std::vector<std::vector<ValueTuple>> candidates;
+	};
+
+	AxiomEvaluator();
+	~AxiomEvaluator();
+
+	std::vector<Stratum> _strata;
+
+	//! The stratum of each axiom and its position within it
+	std::unordered_map<const Axiom*, std::pair<unsigned, unsigned>> _index;
+
+	//! A tuple of the i-th axiom of some stratum
+	using LookupT = std::pair<unsigned, ValueTuple>;
+
+	//! The state of the computation of the fixpoint of some stratum
+	struct Fixpoint {
+		//! The extensions of the axioms of the stratum derived so far
+		const std::vector<ExtensionT>& extension;
+
+		//! The tuples of the stratum looked up and not found by the evaluation of the current candidate
+		std::vector<LookupT> misses;
+	};
+
+	//! '_partial[s]' points to the state of the fixpoint of the s-th stratum while it is being computed
+	std::vector<Fixpoint*> _partial;
+
+	//! Only written by the thread of the evaluator, and read by any thread
+	std::atomic<unsigned long> _fixpoints;
+	std::atomic<unsigned long> _rounds;
+	std::atomic<unsigned long> _evaluations;
+
+	static void increment(std::atomic<unsigned long>& counter) {
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	//! Returns the stratum and position of the given axiom, stratifying it and the axioms it depends on if necessary
+	const std::pair<unsigned, unsigned>& locate(const Axiom* axiom);
+
+	//! Computes the least fixpoint of the given stratum on the given state into 'extension', and stores it into the AxiomCache
+	void materialize(unsigned stratum, const State& state, std::vector<ExtensionT>& extension);
+};
+
+} } } // namespaces
@@ -55,6 +55,12 @@ Axiom::~Axiom() {
 	delete _definition;
 }
 
+void Axiom::define(const Formula* definition) {
+	if (definition == _definition) return;
+	delete _definition;
+	_definition = definition;
+}
+
 Axiom::Axiom(const Axiom& other) :
 	_name(other._name),
 	_signature(other._signature),
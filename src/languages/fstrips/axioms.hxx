@@ -57,6 +57,10 @@ public:
 	const BindingUnit& getBindingUnit() const { return _bunit; }
 	const Formula* getDefinition() const { return _definition; }
 	
+	//! Replace the definition of the axiom, taking ownership of the new one.
+	//! Allows axioms to be redefined in terms of other axioms, or of themselves, without invalidating references to them.
+	void define(const Formula* definition);
+	
 	//! Prints a representation of the object to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const Axiom& entity) { return entity.print(os); }
 	std::ostream& print(std::ostream& os) const;
@@ -3,6 +3,9 @@
 #include <languages/fstrips/formulae.hxx>
 #include <languages/fstrips/terms.hxx>
 #include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/quantification.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axiom_evaluation.hxx>
 #include <problem.hxx>
 #include <utils/utils.hxx>
 #include <state.hxx>
@@ -32,13 +35,15 @@ AtomicFormula::~AtomicFormula() {
 AtomicFormula* AtomicFormula::clone() const { return clone(Utils::clone(_subterms)); }
 
 bool AtomicFormula::interpret(const PartialAssignment& assignment, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
-	return _satisfied(_interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, assignment, binding, buffer.get());
+	return _satisfied(buffer.get());
 }
 
 bool AtomicFormula::interpret(const State& state, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return _satisfied(_interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, buffer.get());
+	return _satisfied(buffer.get());
 }
 
 std::ostream& RelationalFormula::print(std::ostream& os, const fs0::ProblemInfo& info) const {
@@ -67,8 +72,9 @@ bool AxiomaticFormula::interpret(const PartialAssignment& assignment, Binding& b
 }
 
 bool AxiomaticFormula::interpret(const State& state, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return compute(state, _interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, buffer.get());
+	return compute(state, buffer.get());
 }
 
 
@@ -82,17 +88,28 @@ AxiomaticAtom::AxiomaticAtom(const AxiomaticAtom& other) :
 {}
 
 bool AxiomaticAtom::interpret(const PartialAssignment& assignment, Binding& binding) const {
-	std::vector<ObjectIdx> _interpreted_subterms;
-	NestedTerm::interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
-	Binding axiom_binding(_interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, assignment, binding, buffer.get());
+	if (AxiomEvaluator::instance().is_recursive(_axiom)) {
+		throw std::runtime_error("Recursive axiom " + _axiom->getName() + " cannot be interpreted on a partial assignment");
+	}
+	Binding axiom_binding(buffer.get());
 	return _axiom->getDefinition()->interpret(assignment, axiom_binding);
 }
 
 bool AxiomaticAtom::interpret(const State& state, Binding& binding) const {
-	std::vector<ObjectIdx> _interpreted_subterms;
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	Binding axiom_binding(_interpreted_subterms);
-	return _axiom->getDefinition()->interpret(state, axiom_binding);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, buffer.get());
+
+	AxiomCache& cache = AxiomCache::instance();
+	ObjectIdx value;
+	if (cache.find(_axiom, state, buffer.get(), value)) return value;
+	if (AxiomEvaluator::instance().evaluate(_axiom, state, buffer.get(), value)) return value; // Recursive axioms are evaluated bottom-up
+
+	Binding axiom_binding(buffer.get());
+	bool holds = _axiom->getDefinition()->interpret(state, axiom_binding);
+	cache.store(_axiom, state, buffer.get(), holds);
+	return holds;
 }
 
 std::ostream& AxiomaticAtom::print(std::ostream& os, const fs0::ProblemInfo& info) const {
@@ -178,7 +195,7 @@ QuantifiedFormula::~QuantifiedFormula() {
 }
 
 QuantifiedFormula::QuantifiedFormula(const QuantifiedFormula& other) :
-_variables(Utils::clone(other._variables)), _subformula(other._subformula->clone())
+_variables(Utils::clone(other._variables)), _subformula(other._subformula->clone()), _plan()
 {}
 
 //! Prints a representation of the object to the given stream.
@@ -192,53 +209,25 @@ std::ostream& QuantifiedFormula::print(std::ostream& os, const fs0::ProblemInfo&
 	return os;
 }
 
-bool ExistentiallyQuantifiedFormula::interpret(const PartialAssignment& assignment, Binding& binding) const {
-	assert(binding.size()==0); // ATM we do not allow for nested quantifications
-	return interpret_rec(assignment, binding, 0);
+const QuantifierPlan& QuantifiedFormula::plan(bool existential) const {
+	std::call_once(_plan_compiled, [this, existential]() { _plan = std::make_shared<const QuantifierPlan>(*this, existential); });
+	return *_plan;
 }
 
-bool ExistentiallyQuantifiedFormula::interpret(const State& state, Binding& binding) const {
-	assert(binding.size()==0); // ATM we do not allow for nested quantifications
-	return interpret_rec(state, binding, 0);
+bool ExistentiallyQuantifiedFormula::interpret(const PartialAssignment& assignment, Binding& binding) const {
+	return plan(true).interpret(assignment, binding);
 }
 
-template <typename T>
-bool ExistentiallyQuantifiedFormula::interpret_rec(const T& assignment, Binding& binding, unsigned i) const {
-	// Base case - all quantified variables have been bound
-	if (i == _variables.size()) return _subformula->interpret(assignment, binding);
-
-	const ProblemInfo& info = ProblemInfo::getInstance();
-	const BoundVariable* variable = _variables.at(i);
-	//! Otherwise, iterate through all possible assignments to the currently analyzed variable 'i'
-	for (ObjectIdx elem:info.getTypeObjects(variable->getType())) {
-		binding.set(variable->getVariableId(), elem);
-		if (interpret_rec(assignment, binding, i + 1)) return true;
-	}
-	return false;
+bool ExistentiallyQuantifiedFormula::interpret(const State& state, Binding& binding) const {
+	return plan(true).interpret(state, binding);
 }
 
-
 bool UniversallyQuantifiedFormula::interpret(const PartialAssignment& assignment, Binding& binding) const {
-	return interpret_rec(assignment, binding, 0);
+	return plan(false).interpret(assignment, binding);
 }
 
 bool UniversallyQuantifiedFormula::interpret(const State& state, Binding& binding) const {
-	return interpret_rec(state, binding, 0);
-}
-
-template <typename T>
-bool UniversallyQuantifiedFormula::interpret_rec(const T& assignment, Binding& binding, unsigned i) const {
-	// Base case - all quantified variables have been bound
-	if (i == _variables.size()) return _subformula->interpret(assignment, binding);
-
-	const ProblemInfo& info = ProblemInfo::getInstance();
-	const BoundVariable* variable = _variables.at(i);
-	//! Otherwise, iterate through all possible assignments to the currently analyzed variable 'i'
-	for (ObjectIdx elem:info.getTypeObjects(variable->getType())) {
-		binding.set(variable->getVariableId(), elem);
-		if (!interpret_rec(assignment, binding, i + 1)) return false;
-	}
-	return true;
+	return plan(false).interpret(state, binding);
 }
 
 std::vector<const AtomicFormula*> check_all_atomic_formulas(const std::vector<const Formula*> formulas) {
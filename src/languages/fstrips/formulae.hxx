@@ -2,6 +2,8 @@
 #pragma once
 
 #include <iostream>
+#include <memory>
+#include <mutex>
 
 #include <languages/fstrips/base.hxx>
 #include <languages/fstrips/language_fwd.hxx>
@@ -23,6 +25,7 @@ class Conjunction;
 class ExistentiallyQuantifiedFormula;
 class Tautology;
 class Contradiction;
+class QuantifierPlan;
 
 //! The base interface for a logic formula
 class Formula :	public LogicalElement {
@@ -50,7 +53,7 @@ class AtomicFormula : public Formula {
 public:
 	LOKI_DEFINE_CONST_VISITABLE();
 	
-	AtomicFormula(const std::vector<const Term*>& subterms) : _subterms(subterms), _interpreted_subterms(subterms.size(), -1) {}
+	AtomicFormula(const std::vector<const Term*>& subterms) : _subterms(subterms) {}
 
 	virtual ~AtomicFormula();
 
@@ -70,9 +73,6 @@ public:
 protected:
 	//! The formula subterms
 	std::vector<const Term*> _subterms;
-
-	//! The last interpretation of the subterms (acts as a cache)
-	mutable std::vector<ObjectIdx> _interpreted_subterms;
 };
 
 class ExternallyDefinedFormula : public AtomicFormula {
@@ -124,6 +124,8 @@ public:
 
 	const std::vector<const Term*>& getSubterms() const { return _subterms; }
 	
+	const Axiom* getAxiom() const { return _axiom; }
+	
 protected:
 	const Axiom* _axiom;
 	
@@ -258,7 +260,7 @@ public:
 //! A formula quantified by at least one variable
 class QuantifiedFormula : public Formula {
 public:
-	QuantifiedFormula(const std::vector<const BoundVariable*>& variables, const Formula* subformula) : _variables(variables), _subformula(subformula) {}
+	QuantifiedFormula(const std::vector<const BoundVariable*>& variables, const Formula* subformula) : _variables(variables), _subformula(subformula), _plan() {}
 
 	virtual ~QuantifiedFormula();
 
@@ -279,6 +281,12 @@ protected:
 
 	//! ATM we only allow quantification of conjunctions
 	const Formula* _subformula;
+	
+	//! The plan to interpret the formula, compiled on the first interpretation
+	mutable std::shared_ptr<const QuantifierPlan> _plan;
+	mutable std::once_flag _plan_compiled;
+	
+	const QuantifierPlan& plan(bool existential) const;
 };
 
 //! A formula quantified by at least one existential variable
@@ -295,11 +303,6 @@ public:
 	bool interpret(const State& state, Binding& binding) const override;
 	
 	std::string name() const override { return "exists"; }
-
-protected:
-	//! A naive recursive implementation of the interpretation routine
-	template <typename T>
-	bool interpret_rec(const T& assignment, Binding& binding, unsigned i) const;
 };
 
 //! A formula quantified by at least one universal variable
@@ -316,11 +319,6 @@ public:
 	bool interpret(const State& state, Binding& binding) const override;
 	
 	std::string name() const override { return "forall"; }
-
-protected:
-	//! A naive recursive implementation of the interpretation routine
-	template <typename T>
-	bool interpret_rec(const T& assignment, Binding& binding, unsigned i) const;	
 };
 
 
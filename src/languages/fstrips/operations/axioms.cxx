@@ -69,6 +69,11 @@ Visit(const Disjunction& lhs) {
 	_result =  new Disjunction(disjuncts);
 }
 
+void FormulaAxiomVisitor::
+Visit(const Negation& lhs) {
+	_result = new Negation(process_axioms(*lhs.getSubformulae()[0], _info));
+}
+
 
 void FormulaAxiomVisitor::
 Visit(const ExistentiallyQuantifiedFormula& lhs) {
@@ -26,6 +26,7 @@ class FormulaAxiomVisitor
 	, public Loki::Visitor<Conjunction, void, true>
 	, public Loki::Visitor<AtomConjunction, void, true>
 	, public Loki::Visitor<Disjunction, void, true>
+	, public Loki::Visitor<Negation, void, true>
 	, public Loki::Visitor<ExistentiallyQuantifiedFormula, void, true>
 	, public Loki::Visitor<UniversallyQuantifiedFormula, void, true>
 	, public Loki::Visitor<AxiomaticFormula, void, true>
@@ -45,6 +46,7 @@ public:
 	void Visit(const Conjunction& lhs) override;
 	void Visit(const AtomConjunction& lhs) override;
 	void Visit(const Disjunction& lhs) override;
+	void Visit(const Negation& lhs) override;
 	void Visit(const ExistentiallyQuantifiedFormula& lhs) override;
 	void Visit(const UniversallyQuantifiedFormula& lhs) override;
 	void Visit(const AxiomaticFormula& lhs) override;
@@ -37,9 +37,9 @@ template <typename AssignmentT>
 void VariableInterpretationVisitor<AssignmentT>::
 Visit(const FluentHeadedNestedTerm& lhs) {
 	const auto& subterms = lhs.getSubterms();
-	std::vector<ObjectIdx> interpreted(subterms.size());
-	NestedTerm::interpret_subterms(subterms, _assignment, _binding, interpreted);
-	_result = ProblemInfo::getInstance().resolveStateVariable(lhs.getSymbolId(), interpreted);
+	InterpretationBuffer buffer(subterms.size());
+	NestedTerm::interpret_subterms(subterms, _assignment, _binding, buffer.get());
+	_result = ProblemInfo::getInstance().resolveStateVariable(lhs.getSymbolId(), buffer.get());
 }
 
 
@@ -0,0 +1,221 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include <lapkt/tools/logging.hxx>
+
+#include <languages/fstrips/quantification.hxx>
+#include <languages/fstrips/formulae.hxx>
+#include <languages/fstrips/terms.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+
+
+namespace fs0 { namespace language { namespace fstrips {
+
+//! An empty assignment under which to interpret static parts
+static const PartialAssignment NO_ASSIGNMENT;
+
+//! What the compilation of a plan needs to know about each part of a quantified formula
+struct PartAnalysis {
+	PartAnalysis(unsigned num_variables) : is_static(true), opaque(false), foreign(false), mentions(num_variables, false) {}
+
+	//! Whether the part can be interpreted without a state
+	bool is_static;
+
+	//! Whether the part contains some construct that the analysis does not know of
+	bool opaque;
+
+	//! Whether the part mentions some variable bound outside the quantified formula
+	bool foreign;
+
+	//! 'mentions[i]' is true iff the part mentions the i-th quantified variable
+	std::vector<bool> mentions;
+};
+
+//! Analyze the given term. 'variables' are the IDs of the quantified variables, and 'inner' those of the variables bound
+//! by the quantified formulae nested within the part
+static void _analyze(const Term& term, const std::vector<unsigned>& variables, std::vector<unsigned>& inner, PartAnalysis& analysis) {
+	if (auto variable = dynamic_cast<const BoundVariable*>(&term)) {
+		auto it = std::find(variables.begin(), variables.end(), variable->getVariableId());
+		if (it != variables.end()) analysis.mentions[it - variables.begin()] = true;
+		else if (std::find(inner.begin(), inner.end(), variable->getVariableId()) == inner.end()) analysis.foreign = true;
+		return;
+	}
+
+	if (dynamic_cast<const Constant*>(&term)) return;
+
+	if (dynamic_cast<const StateVariable*>(&term)) {
+		analysis.is_static = false;
+		return;
+	}
+
+	auto nested = dynamic_cast<const NestedTerm*>(&term);
+	if (!nested) {
+		analysis.is_static = false;
+		analysis.opaque = true;
+		return;
+	}
+
+	if (dynamic_cast<const FluentHeadedNestedTerm*>(&term) || dynamic_cast<const AxiomaticTermWrapper*>(&term) || dynamic_cast<const AxiomaticTerm*>(&term)) {
+		analysis.is_static = false;
+	}
+	for (const Term* subterm:nested->getSubterms()) _analyze(*subterm, variables, inner, analysis);
+}
+
+static void _analyze(const Formula& formula, const std::vector<unsigned>& variables, std::vector<unsigned>& inner, PartAnalysis& analysis) {
+	if (formula.is_tautology() || formula.is_contradiction()) return;
+
+	if (auto atom = dynamic_cast<const AtomicFormula*>(&formula)) {
+		if (dynamic_cast<const AxiomaticFormula*>(&formula)) analysis.is_static = false;
+		for (const Term* subterm:atom->getSubterms()) _analyze(*subterm, variables, inner, analysis);
+		return;
+	}
+
+	if (auto atom = dynamic_cast<const AxiomaticAtom*>(&formula)) {
+		analysis.is_static = false;
+		for (const Term* subterm:atom->getSubterms()) _analyze(*subterm, variables, inner, analysis);
+		return;
+	}
+
+	if (auto open = dynamic_cast<const OpenFormula*>(&formula)) {
+		for (const Formula* subformula:open->getSubformulae()) _analyze(*subformula, variables, inner, analysis);
+		return;
+	}
+
+	if (auto quantified = dynamic_cast<const QuantifiedFormula*>(&formula)) {
+		for (const BoundVariable* variable:quantified->getVariables()) inner.push_back(variable->getVariableId());
+		_analyze(*quantified->getSubformula(), variables, inner, analysis);
+		return;
+	}
+
+	analysis.is_static = false;
+	analysis.opaque = true;
+}
+
+//! Flatten into 'parts' the conjuncts (if 'conjunctive') or disjuncts (otherwise) of the given formula
+static void _collect_parts(const Formula* formula, bool conjunctive, std::vector<const Formula*>& parts) {
+	auto open = dynamic_cast<const OpenFormula*>(formula);
+	bool flatten = conjunctive ? (dynamic_cast<const Conjunction*>(formula) != nullptr) : (dynamic_cast<const Disjunction*>(formula) != nullptr);
+	if (!open || !flatten) {
+		parts.push_back(formula);
+		return;
+	}
+	for (const Formula* subformula:open->getSubformulae()) _collect_parts(subformula, conjunctive, parts);
+}
+
+QuantifierPlan::QuantifierPlan(const QuantifiedFormula& formula, bool existential) :
+	_existential(existential), _polarity(existential), _variables(), _candidates(), _checks()
+{
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const std::vector<const BoundVariable*>& quantified = formula.getVariables();
+	unsigned num_variables = quantified.size();
+
+	std::vector<unsigned> ids;
+	for (const BoundVariable* variable:quantified) ids.push_back(variable->getVariableId());
+
+	std::vector<const Formula*> parts;
+	_collect_parts(formula.getSubformula(), existential, parts);
+
+	std::vector<ObjectIdxVector> candidates;
+	for (const BoundVariable* variable:quantified) candidates.push_back(info.getTypeObjects(variable->getType()));
+
+	// Restrict the candidates of each variable through the static parts that mention only it, and analyze the rest
+	std::vector<std::pair<const Formula*, PartAnalysis>> residue;
+	for (const Formula* part:parts) {
+		// A tautology in a conjunction (contradiction in a disjunction) is satisfied by any witness
+		if ((existential && part->is_tautology()) || (!existential && part->is_contradiction())) continue;
+
+		std::vector<unsigned> inner;
+		PartAnalysis analysis(num_variables);
+		_analyze(*part, ids, inner, analysis);
+
+		auto mentioned = std::count(analysis.mentions.begin(), analysis.mentions.end(), true);
+		if (analysis.is_static && !analysis.opaque && !analysis.foreign && mentioned == 1) {
+			unsigned i = std::find(analysis.mentions.begin(), analysis.mentions.end(), true) - analysis.mentions.begin();
+			try {
+				ObjectIdxVector consistent;
+				Binding binding;
+				for (ObjectIdx value:candidates[i]) {
+					binding.set(ids[i], value);
+					if (part->interpret(NO_ASSIGNMENT, binding) == _polarity) consistent.push_back(value);
+				}
+				candidates[i] = std::move(consistent);
+				continue;
+			} catch (const std::exception& e) {
+				// Some static term is not defined for some candidate; leave the part to be interpreted on each state
+			}
+		}
+		residue.push_back(std::make_pair(part, std::move(analysis)));
+	}
+
+	// Bind the variables with fewer candidates first
+	std::vector<unsigned> order(num_variables);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&candidates](unsigned i, unsigned j) { return candidates[i].size() < candidates[j].size(); });
+
+	std::vector<unsigned> position(num_variables);
+	for (unsigned k = 0; k < num_variables; ++k) {
+		position[order[k]] = k;
+		_variables.push_back(ids[order[k]]);
+		_candidates.push_back(std::move(candidates[order[k]]));
+	}
+
+	// Check each part as soon as the variables it mentions are bound, the static ones before the rest
+	_checks.resize(num_variables + 1);
+	for (bool static_parts:{true, false}) {
+		for (const auto& part:residue) {
+			const PartAnalysis& analysis = part.second;
+			if (analysis.is_static != static_parts) continue;
+
+			unsigned level = 0;
+			if (analysis.opaque) level = num_variables;
+			else {
+				for (unsigned i = 0; i < num_variables; ++i) {
+					if (analysis.mentions[i]) level = std::max(level, position[i] + 1);
+				}
+			}
+			_checks[level].push_back(part.first);
+		}
+	}
+
+	LPT_DEBUG("main", "Compiled quantified formula " << formula << ": " << residue.size() << " out of " << parts.size() << " parts checked on each interpretation");
+}
+
+std::vector<std::size_t>
+QuantifierPlan::num_candidates() const {
+	std::vector<std::size_t> sizes;
+	for (const auto& candidates:_candidates) sizes.push_back(candidates.size());
+	return sizes;
+}
+
+template <typename T>
+bool QuantifierPlan::find_witness(const T& assignment, Binding& binding, unsigned i) const {
+	for (const Formula* part:_checks[i]) {
+		if (part->interpret(assignment, binding) != _polarity) return false;
+	}
+
+	// Base case - all quantified variables have been bound
+	if (i == _variables.size()) return true;
+
+	unsigned variable = _variables[i];
+	for (ObjectIdx value:_candidates[i]) {
+		binding.set(variable, value);
+		if (find_witness(assignment, binding, i + 1)) return true;
+	}
+	return false;
+}
+
+template <typename T>
+bool QuantifierPlan::interpret_impl(const T& assignment, Binding& binding) const {
+	bool found = find_witness(assignment, binding, 0);
+	for (unsigned variable:_variables) binding.unset(variable);
+	return _existential ? found : !found;
+}
+
+bool QuantifierPlan::interpret(const State& state, Binding& binding) const { return interpret_impl(state, binding); }
+
+bool QuantifierPlan::interpret(const PartialAssignment& assignment, Binding& binding) const { return interpret_impl(assignment, binding); }
+
+} } } // namespaces
@@ -0,0 +1,65 @@
+
+#pragma once
+
+#include <vector>
+
+#include <fs_types.hxx>
+
+namespace fs0 { class State; class Binding; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+class Formula;
+class QuantifiedFormula;
+
+//! A plan to interpret a quantified formula Qx_1...x_n phi, compiled once for the formula.
+//! Both types of quantification are interpreted as the search for a "witness" binding of the quantified variables:
+//! a binding that satisfies all conjuncts of phi in the case of an existential formula, which holds iff there is such
+//! a witness, or that falsifies all disjuncts of phi in the case of a universal formula, which holds iff there is none.
+//! At compilation time:
+//!   - The candidate values of each variable are restricted to those objects of its type that are consistent with the
+//!     static parts (conjuncts or disjuncts) of phi that mention no other variable, which are then dropped from phi.
+//!   - Variables are ordered by increasing number of candidates, so that the most selective ones are bound first.
+//!   - Each remaining part is checked as soon as all the quantified variables it mentions have been bound, static
+//!     parts first, so that the search backtracks as early as possible.
+//! Parts can mention variables bound elsewhere (e.g. action parameters or the variables of enclosing quantifiers),
+//! and contain further quantified formulae, hence nested quantification is supported.
+class QuantifierPlan {
+public:
+	QuantifierPlan(const QuantifiedFormula& formula, bool existential);
+
+	QuantifierPlan(const QuantifierPlan&) = delete;
+	QuantifierPlan& operator=(const QuantifierPlan&) = delete;
+
+	//! Returns true iff the interpretation of the formula under the given state / assignment and binding is true.
+	//! The quantified variables are left unbound.
+	bool interpret(const State& state, Binding& binding) const;
+	bool interpret(const PartialAssignment& assignment, Binding& binding) const;
+
+	//! The number of candidate values of each quantified variable, in the order in which they are bound
+	std::vector<std::size_t> num_candidates() const;
+
+protected:
+	//! Whether the formula is existential
+	const bool _existential;
+
+	//! The truth value that each part needs to have in a witness binding
+	const bool _polarity;
+
+	//! The IDs of the quantified variables, in the order in which they are bound
+	std::vector<unsigned> _variables;
+
+	//! '_candidates[i]' contains the values that the i-th variable can take in a witness binding
+	std::vector<ObjectIdxVector> _candidates;
+
+	//! '_checks[i]' contains the parts to be checked once the first i variables have been bound
+	std::vector<std::vector<const Formula*>> _checks;
+
+	template <typename T>
+	bool find_witness(const T& assignment, Binding& binding, unsigned i) const;
+
+	template <typename T>
+	bool interpret_impl(const T& assignment, Binding& binding) const;
+};
+
+} } } // namespaces
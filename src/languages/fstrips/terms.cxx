@@ -1,9 +1,13 @@
 
+#include <deque>
+
 #include <boost/functional/hash.hpp>
 
 #include <problem_info.hxx>
 #include <languages/fstrips/terms.hxx>
 #include <languages/fstrips/builtin.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axiom_evaluation.hxx>
 #include <state.hxx>
 #include <utils/utils.hxx>
 #include <lapkt/tools/logging.hxx>
@@ -14,6 +18,25 @@
 
 namespace fs0 { namespace language { namespace fstrips {
 
+//! The stack of interpretation buffers of each thread, and the number of buffers of the stack currently in use.
+//! A deque guarantees that growing the stack does not invalidate the buffers in use.
+static thread_local std::deque<ObjectIdxVector> interpretation_stack;
+static thread_local std::size_t interpretation_depth = 0;
+
+static ObjectIdxVector& acquire_interpretation_buffer(std::size_t size) {
+	if (interpretation_depth == interpretation_stack.size()) interpretation_stack.emplace_back();
+	ObjectIdxVector& buffer = interpretation_stack[interpretation_depth++];
+	buffer.resize(size);
+	return buffer;
+}
+
+InterpretationBuffer::InterpretationBuffer(std::size_t size) : _buffer(acquire_interpretation_buffer(size)) {}
+
+InterpretationBuffer::~InterpretationBuffer() {
+	assert(interpretation_depth > 0);
+	--interpretation_depth;
+}
+
 ObjectIdx Term::interpret(const PartialAssignment& assignment) const { return interpret(assignment, Binding::EMPTY_BINDING); }
 ObjectIdx Term::interpret(const State& state) const  { return interpret(state, Binding::EMPTY_BINDING); }
 
@@ -21,8 +44,7 @@ ObjectIdx Term::interpret(const State& state) const  { return interpret(state, B
 
 NestedTerm::NestedTerm(const NestedTerm& term) :
 	_symbol_id(term._symbol_id),
-	_subterms(Utils::clone(term._subterms)),
-	_interpreted_subterms(term._interpreted_subterms)
+	_subterms(Utils::clone(term._subterms))
 {}
 
 UserDefinedStaticTerm::UserDefinedStaticTerm(unsigned symbol_id, const std::vector<const Term*>& subterms)
@@ -44,21 +66,33 @@ AxiomaticTermWrapper::AxiomaticTermWrapper(const AxiomaticTermWrapper& other) :
 {}
 
 ObjectIdx AxiomaticTermWrapper::interpret(const PartialAssignment& assignment, const Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, assignment, binding, buffer.get());
+	if (AxiomEvaluator::instance().is_recursive(_axiom)) {
+		throw std::runtime_error("Recursive axiom " + _axiom->getName() + " cannot be interpreted on a partial assignment");
+	}
 	
 	// The binding to interpret the inner condition of the axiom is independent, i.e. axioms need to be sentences
 	Binding axiom_binding;
-	_axiom->getBindingUnit().update_binding(axiom_binding, _interpreted_subterms);
+	_axiom->getBindingUnit().update_binding(axiom_binding, buffer.get());
 	return _axiom->getDefinition()->interpret(assignment, axiom_binding);
 }
 
 ObjectIdx AxiomaticTermWrapper::interpret(const State& state, const Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	
+	InterpretationBuffer buffer(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, buffer.get());
+
+	AxiomCache& cache = AxiomCache::instance();
+	ObjectIdx value;
+	if (cache.find(_axiom, state, buffer.get(), value)) return value;
+	if (AxiomEvaluator::instance().evaluate(_axiom, state, buffer.get(), value)) return value; // Recursive axioms are evaluated bottom-up
+
 	// The binding to interpret the inner condition of the axiom is independent, i.e. axioms need to be sentences
 	Binding axiom_binding;
-	_axiom->getBindingUnit().update_binding(axiom_binding, _interpreted_subterms);
-	return _axiom->getDefinition()->interpret(state, axiom_binding);
+	_axiom->getBindingUnit().update_binding(axiom_binding, buffer.get());
+	value = _axiom->getDefinition()->interpret(state, axiom_binding);
+	cache.store(_axiom, state, buffer.get(), value);
+	return value;
 }
 
 std::ostream& AxiomaticTermWrapper::print(std::ostream& os, const fs0::ProblemInfo& info) const {
@@ -73,19 +107,24 @@ AxiomaticTerm* AxiomaticTerm::clone() const { return clone(Utils::clone(_subterm
 
 
 ObjectIdx UserDefinedStaticTerm::interpret(const PartialAssignment& assignment, const Binding& binding) const {
-	interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
-	return _function.getFunction()(_interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	interpret_subterms(_subterms, assignment, binding, buffer.get());
+	if (const utils::StaticTable* table = _function.getTable()) return table->value(buffer.get().data(), _subterms.size());
+	return _function.getFunction()(buffer.get());
 }
 
 ObjectIdx UserDefinedStaticTerm::interpret(const State& state, const Binding& binding) const {
-	interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return _function.getFunction()(_interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	interpret_subterms(_subterms, state, binding, buffer.get());
+	if (const utils::StaticTable* table = _function.getTable()) return table->value(buffer.get().data(), _subterms.size());
+	return _function.getFunction()(buffer.get());
 }
 
 
 ObjectIdx AxiomaticTerm::interpret(const State& state, const Binding& binding) const {
-	interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return compute(state, _interpreted_subterms);
+	InterpretationBuffer buffer(_subterms.size());
+	interpret_subterms(_subterms, state, binding, buffer.get());
+	return compute(state, buffer.get());
 }
 
 
@@ -10,6 +10,24 @@ namespace fs0 { namespace language { namespace fstrips {
 
 class Axiom;
 
+//! A buffer to hold the interpretation of the subterms of some term or atomic formula while the term is interpreted.
+//! Buffers are taken from a thread-local stack, one per nesting level, which makes interpretation reentrant
+//! (and thread-safe) without allocating memory once the stack has grown to the maximum nesting depth.
+//! Buffers must be destroyed in the reverse order of their construction, hence they are meant to be used as local variables.
+class InterpretationBuffer {
+public:
+	explicit InterpretationBuffer(std::size_t size);
+	~InterpretationBuffer();
+
+	InterpretationBuffer(const InterpretationBuffer&) = delete;
+	InterpretationBuffer& operator=(const InterpretationBuffer&) = delete;
+
+	ObjectIdxVector& get() { return _buffer; }
+
+protected:
+	ObjectIdxVector& _buffer;
+};
+
 //! A logical term in FSTRIPS
 class Term : public LogicalElement {
 public:
@@ -39,7 +57,7 @@ public:
 	LOKI_DEFINE_CONST_VISITABLE();
 
 	NestedTerm(unsigned symbol_id, const std::vector<const Term*>& subterms)
-		: _symbol_id(symbol_id), _subterms(subterms), _interpreted_subterms(subterms.size(), -1)
+		: _symbol_id(symbol_id), _subterms(subterms)
 	{}
 
 	~NestedTerm() {
@@ -76,9 +94,6 @@ protected:
 	//! The tuple of fixed, constant symbols of the state variable, e.g. {A, B} in the state variable 'on(A,B)'
 	// TODO This should be const
 	std::vector<const Term*> _subterms;
-	
-	//! The last interpretation of the subterms (acts as a cache)
-	mutable std::vector<ObjectIdx> _interpreted_subterms;
 };
 
 
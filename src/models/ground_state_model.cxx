@@ -13,8 +13,16 @@ namespace fs0 {
 
 GroundStateModel::GroundStateModel(const Problem& problem) :
 	_task(problem),
-	_manager(build_action_manager(problem))
-{}
+	_manager(build_action_manager(problem)),
+	_compiled_effects()
+{
+	const auto& actions = problem.getGroundActions();
+	_compiled_effects.reserve(actions.size());
+	for (const GroundAction* action:actions) {
+		assert(action->getId() == _compiled_effects.size());
+		_compiled_effects.push_back(CompiledEffects(*action));
+	}
+}
 
 State GroundStateModel::init() const {
 	// We need to make a copy so that we can return it as non-const.
@@ -39,8 +47,13 @@ State GroundStateModel::next(const State& state, const GroundAction::IdType& act
 }
 
 State GroundStateModel::next(const State& state, const GroundAction& a) const {
-	NaiveApplicabilityManager::computeEffects(state, a, _effects_cache);
-	return State(state, _effects_cache); // Copy everything into the new state and apply the changeset
+	State successor(state);
+	next(successor, a, successor); // Apply the effects directly on the copy
+	return successor;
+}
+
+void GroundStateModel::next(const State& state, const GroundAction& a, State& successor) const {
+	_compiled_effects[a.getId()].apply(state, successor);
 }
 
 GroundApplicableSet GroundStateModel::applicable_actions(const State& state) const {
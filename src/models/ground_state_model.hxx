@@ -3,6 +3,7 @@
 
 #include <lapkt/search/interfaces/det_state_model.hxx>
 #include <actions/actions.hxx>
+#include <actions/compiled_effects.hxx>
 #include <applicability/base.hxx>
 
 namespace fs0 {
@@ -18,6 +19,9 @@ public:
 	using ActionType = GroundAction;
 	using ActionId = ActionType::IdType;
 
+	//! The model can be used concurrently from several threads, e.g. to generate successors in parallel
+	static constexpr bool is_reentrant() { return true; }
+
 	GroundStateModel(const Problem& problem);
 	~GroundStateModel() = default;
 
@@ -42,6 +46,10 @@ public:
 	State next(const State& state, const GroundAction::IdType& id) const;
 	State next(const State& state, const GroundAction& a) const;
 
+	//! Overwrite 'successor' with the state resulting from applying the given action on the given state, reusing its memory.
+	//! 'successor' might be the given state itself.
+	void next(const State& state, const GroundAction& a, State& successor) const;
+
 	const Problem& getTask() const { return _task; }
 
 	unsigned get_action_idx(const ActionId& action) const { return static_cast<unsigned>(action); }
@@ -54,8 +62,8 @@ protected:
 
 	std::unique_ptr<ActionManagerI> _manager;
 
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
+	//! The compiled effects of each ground action, indexed by action ID
+	std::vector<CompiledEffects> _compiled_effects;
 };
 
 } // namespaces
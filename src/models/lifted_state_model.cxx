@@ -5,7 +5,10 @@
 #include <applicability/formula_interpreter.hxx>
 #include <applicability/action_managers.hxx>
 #include <actions/lifted_action_iterator.hxx>
+#include <actions/lifted_action_cache.hxx>
+#include <actions/lifted_action_view.hxx>
 #include <actions/actions.hxx>
+#include <utils/config.hxx>
 
 #include <languages/fstrips/language.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
@@ -44,11 +47,19 @@ bool LiftedStateModel::goal(const State& state) const {
 	return _task.getGoalSatManager().satisfied(state);
 }
 
+//! The action view, and the buffer for the atoms produced by the action effects, are reused across calls to avoid memory allocations
+static thread_local LiftedActionView _view;
+static thread_local std::vector<Atom> _atoms;
+
 bool LiftedStateModel::is_applicable(const State& state, const ActionType& action) const {
-	auto ground_action = action.generate();
-	bool res = is_applicable(state, *ground_action);
-	delete ground_action;
-	return res;
+	_view.set(action);
+	if (!_view.applicable(state)) return false;
+	
+	_view.effects(state, _atoms);
+	if (!NaiveApplicabilityManager::checkAtomsWithinBounds(_atoms)) return false;
+	
+	const fs::Formula* state_constraints = _task.getStateConstraints();
+	return state_constraints->is_tautology() || state_constraints->interpret(State(state, _atoms));
 }
 
 bool LiftedStateModel::is_applicable(const State& state, const GroundAction& action) const {
@@ -57,10 +68,10 @@ bool LiftedStateModel::is_applicable(const State& state, const GroundAction& act
 }
 
 State LiftedStateModel::next(const State& state, const LiftedActionID& action) const {
-	auto ground_action = action.generate();
-	auto s1 = next(state, *ground_action);
-	delete ground_action;
-	return s1;
+	_view.set(action);
+	assert(_view.applicable(state));
+	_view.effects(state, _atoms);
+	return State(state, _atoms); // Copy everything into the new state and apply the changeset
 }
 
 State LiftedStateModel::next(const State& state, const GroundAction& action) const { 
@@ -71,7 +82,7 @@ State LiftedStateModel::next(const State& state, const GroundAction& action) con
 
 
 gecode::LiftedActionIterator LiftedStateModel::applicable_actions(const State& state) const {
-	return gecode::LiftedActionIterator(state, _handlers, _task.getStateConstraints());
+	return gecode::LiftedActionIterator(state, _handlers, _task.getStateConstraints(), _cache.get());
 }
 
 
@@ -87,10 +98,17 @@ LiftedStateModel::goal(const StateT& s, unsigned i) const {
 LiftedStateModel
 LiftedStateModel::build(const Problem& problem) {
 	auto model = LiftedStateModel(problem, obtain_goal_atoms(problem.getGoalConditions()));
-	model.set_handlers(gecode::LiftedActionCSP::create_derived(problem.getPartiallyGroundedActions(), problem.get_tuple_index(), false, false));
+	unsigned cache_size = Config::instance().getOption<unsigned>("lifted.cache_size", 10000);
+	model.set_handlers(gecode::LiftedActionCSP::create_derived(problem.getPartiallyGroundedActions(), problem.get_tuple_index(), false, false), cache_size);
 	return model;
 }
 
+void
+LiftedStateModel::set_handlers(std::vector<std::shared_ptr<gecode::LiftedActionCSP>>&& handlers, unsigned cache_size) {
+	_handlers = std::move(handlers);
+	_cache = (cache_size > 0) ? std::make_shared<gecode::LiftedActionCache>(_handlers, cache_size) : nullptr;
+}
+
 LiftedStateModel::LiftedStateModel(const Problem& problem, const std::vector<const fs::Formula*>& subgoals) :
 	_task(problem),
 	_subgoals(subgoals)
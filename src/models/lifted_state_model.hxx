@@ -5,7 +5,7 @@
 #include <actions/lifted_action_iterator.hxx>
 
 
-namespace fs0 { namespace gecode { class LiftedActionCSP; }}
+namespace fs0 { namespace gecode { class LiftedActionCSP; class LiftedActionCache; }}
 
 namespace fs0 {
 
@@ -20,6 +20,10 @@ class LiftedStateModel
 public:
 	using StateT = State;
 	using ActionType = LiftedActionID;
+
+	//! The CSP handlers used to compute successors, and the cache of their solutions, are not reentrant,
+	//! hence the model cannot be used concurrently
+	static constexpr bool is_reentrant() { return false; }
 	
 protected:
 	LiftedStateModel(const Problem& problem, const std::vector<const fs::Formula*>& subgoals);
@@ -54,7 +58,9 @@ public:
 
 	
 	const Problem& getTask() const { return _task; }
-	void set_handlers(std::vector<std::shared_ptr<gecode::LiftedActionCSP>>&& handlers) { _handlers = std::move(handlers); }
+	
+	//! Set the CSP handlers, and the cache of their solutions, if it has a positive max. size
+	void set_handlers(std::vector<std::shared_ptr<gecode::LiftedActionCSP>>&& handlers, unsigned cache_size);
 	
 	unsigned get_action_idx(const LiftedActionID& action) const { return 0; }
 	
@@ -70,6 +76,9 @@ protected:
 	
 	std::vector<std::shared_ptr<gecode::LiftedActionCSP>> _handlers;
 	
+	//! The cache of the solutions of the handlers' CSPs, shared between copies of the model, or null if disabled
+	std::shared_ptr<gecode::LiftedActionCache> _cache;
+	
 	const std::vector<const fs::Formula*> _subgoals;
 };
 
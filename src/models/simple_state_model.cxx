@@ -53,8 +53,21 @@ SimpleStateModel::build(const Problem& problem) {
 SimpleStateModel::SimpleStateModel(const Problem& problem, const std::vector<const fs::Formula*>& subgoals) :
 	_task(problem),
 	_manager(build_action_manager(problem)),
-	_subgoals(subgoals)
-{}
+	_subgoals(subgoals),
+	_compiled_subgoals(),
+	_compiled_effects()
+{
+	for (const fs::Formula* subgoal:_subgoals) {
+		_compiled_subgoals.push_back(std::unique_ptr<const CompiledFormula>(CompiledFormula::compile(subgoal, problem.getStateAtomIndexer())));
+	}
+
+	const auto& actions = problem.getGroundActions();
+	_compiled_effects.reserve(actions.size());
+	for (const GroundAction* action:actions) {
+		assert(action->getId() == _compiled_effects.size());
+		_compiled_effects.push_back(CompiledEffects(*action));
+	}
+}
 
 SimpleStateModel::StateT
 SimpleStateModel::init() const {
@@ -85,12 +98,20 @@ SimpleStateModel::next(const StateT& state, const GroundAction::IdType& actionId
 
 SimpleStateModel::StateT
 SimpleStateModel::next(const StateT& state, const GroundAction& a) const {
-	NaiveApplicabilityManager::computeEffects(state, a, _effects_cache);
-	return StateT(state, _effects_cache); // Copy everything into the new state and apply the changeset
+	StateT successor(state);
+	next(successor, a, successor); // Apply the effects directly on the copy
+	return successor;
+}
+
+void
+SimpleStateModel::next(const StateT& state, const GroundAction& a, StateT& successor) const {
+	_compiled_effects[a.getId()].apply(state, successor);
 }
 
 bool
 SimpleStateModel::goal(const StateT& s, unsigned i) const {
+	const auto& compiled = _compiled_subgoals.at(i);
+	if (compiled) return compiled->satisfied(s);
 	Binding binding;
 	return _subgoals.at(i)->interpret(s, binding);
 // 	return s.contains(_subgoals.at(i)); // TODO SHOULD BE:
@@ -130,14 +151,14 @@ SimpleStateModel::build_action_manager(const Problem& problem) {
 	
 	if (strategy == StrategyT::naive) {
 		LPT_INFO( "cout", "Successor Generator: Naive");
-		return new NaiveActionManager(actions, constraints);
+		return new NaiveActionManager(actions, constraints, &problem.getStateAtomIndexer());
 	}
 
 	if (strategy == StrategyT::functional_aware) {
 		LPT_INFO( "cout", "Successor Generator: Functional Aware");
 		BasicApplicabilityAnalyzer analyzer(actions, tuple_idx);
 		analyzer.build();
-		return new SmartActionManager(actions, constraints, tuple_idx, analyzer);
+		return new SmartActionManager(actions, constraints, tuple_idx, analyzer, &problem.getStateAtomIndexer());
 
 
 	} else if (strategy == StrategyT::match_tree) {
@@ -149,7 +170,7 @@ SimpleStateModel::build_action_manager(const Problem& problem) {
 		LPT_INFO("cout", "Mem. usage before match-tree construction: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
 
 
-		auto mng = new MatchTreeActionManager(actions, constraints, tuple_idx);
+		auto mng = new MatchTreeActionManager(actions, constraints, tuple_idx, config.getOption<bool>("match_tree.flat", true));
 		LPT_INFO("cout", "Match-tree built with " << mng->count() << " nodes.");
 		LPT_INFO("cout", "Mem. usage after match-tree construction: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
 		return mng;
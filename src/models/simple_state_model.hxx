@@ -3,6 +3,8 @@
 
 #include <actions/actions.hxx>
 #include <applicability/base.hxx>
+#include <applicability/compiled_formula.hxx>
+#include <actions/compiled_effects.hxx>
 #include <atom.hxx>
 
 // namespace lapkt { class MultivaluedState; }
@@ -25,6 +27,9 @@ public:
 	using ActionType = GroundAction;
 	using ActionId = ActionType::IdType;
 
+	//! The model can be used concurrently from several threads, e.g. to generate successors in parallel
+	static constexpr bool is_reentrant() { return true; }
+
 	//! Factory method
 	static SimpleStateModel build(const Problem& problem);
 
@@ -55,6 +60,10 @@ public:
 	StateT next(const StateT& state, const GroundAction::IdType& id) const;
 	StateT next(const StateT& state, const GroundAction& a) const;
 
+	//! Overwrite 'successor' with the state resulting from applying the given action on the given state, reusing its memory.
+	//! 'successor' might be the given state itself.
+	void next(const StateT& state, const GroundAction& a, StateT& successor) const;
+
 	//! Returns the number of subgoals into which the goal can be decomposed
 	unsigned num_subgoals() const { return _subgoals.size(); }
 
@@ -73,10 +82,13 @@ protected:
 
 	std::unique_ptr<ActionManagerI> _manager;
 
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
-
 	const std::vector<const fs::Formula*> _subgoals;
+
+	//! The compiled form of each subgoal, or null if the subgoal cannot be compiled
+	std::vector<std::unique_ptr<const CompiledFormula>> _compiled_subgoals;
+
+	//! The compiled effects of each ground action, indexed by action ID
+	std::vector<CompiledEffects> _compiled_effects;
 };
 
 } // namespaces
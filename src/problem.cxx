@@ -10,6 +10,8 @@
 #include <applicability/formula_interpreter.hxx>
 #include <languages/fstrips/formulae.hxx>
 #include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axiom_evaluation.hxx>
 #include <languages/fstrips/operations/axioms.hxx>
 
 
@@ -17,8 +19,9 @@ namespace fs0 {
 
 std::unique_ptr<Problem> Problem::_instance = nullptr;
 
-Problem::Problem(State* init, StateAtomIndexer* state_indexer, const std::vector<const ActionData*>& action_data, const std::unordered_map<std::string, const fs::Axiom*>& axioms, const fs::Formula* goal, const fs::Formula* state_constraints, AtomIndex&& tuple_index) :
+Problem::Problem(State* init, StateAtomIndexer* state_indexer, const std::vector<const ActionData*>& action_data, const std::unordered_map<std::string, fs::Axiom*>& axioms, const fs::Formula* goal, const fs::Formula* state_constraints, AtomIndex&& tuple_index) :
 	_tuple_index(std::move(tuple_index)),
+	_reachability(),
 	_init(init),
 	_state_indexer(state_indexer),
 	_action_data(action_data),
@@ -27,12 +30,14 @@ Problem::Problem(State* init, StateAtomIndexer* state_indexer, const std::vector
 	_partials(),
 	_state_constraint_formula(state_constraints),
 	_goal_formula(goal),
-	_goal_sat_manager(FormulaInterpreter::create(_goal_formula, get_tuple_index())),
+	_goal_sat_manager(FormulaInterpreter::create(_goal_formula, get_tuple_index(), *_state_indexer)),
 	_is_predicative(check_is_predicative())
 {
 }
 
 Problem::~Problem() {
+	fs::AxiomCache::clear_all(); // The caches of all threads point to the axioms and might hold a state of the problem
+	fs::AxiomEvaluator::clear_all();
 	for (const auto pointer:_action_data) delete pointer;
 	for (const auto it:_axioms) delete it.second;
 	for (const auto pointer:_ground) delete pointer;
@@ -41,9 +46,9 @@ Problem::~Problem() {
 	delete _goal_formula;
 }
 
-std::unordered_map<std::string, const fs::Axiom*>
-_clone_axioms(const std::unordered_map<std::string, const fs::Axiom*>& axioms) {
-	std::unordered_map<std::string, const fs::Axiom*> cloned;
+std::unordered_map<std::string, fs::Axiom*>
+_clone_axioms(const std::unordered_map<std::string, fs::Axiom*>& axioms) {
+	std::unordered_map<std::string, fs::Axiom*> cloned;
 	for (const auto it:axioms) {
 		cloned.insert(std::make_pair(it.first, new fs::Axiom(*it.second)));
 	}
@@ -52,6 +57,7 @@ _clone_axioms(const std::unordered_map<std::string, const fs::Axiom*>& axioms) {
 
 Problem::Problem(const Problem& other) :
 	_tuple_index(other._tuple_index),
+	_reachability(other._reachability),
 	_init(new State(*other._init)),
 	_state_indexer(new StateAtomIndexer(*other._state_indexer)),
 	_action_data(Utils::copy(other._action_data)),
@@ -120,13 +126,11 @@ void Problem::consolidateAxioms() {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 
 	// NOTE Order is FUNDAMENTAL: we need to process the axioms first of all.
-	// TODO This won't work for recursive axioms. We need a better strategy, e.g. lazy retrieval of the axiom pointers whenever interpretation is required, etc.
-	// Update the axioms
+	// Axioms are redefined in place, so that the axioms used in their definitions, possibly themselves, which are resolved
+	// through the problem, remain valid (and recursive axioms can be evaluated, see AxiomEvaluator)
 	for (auto& it:_axioms) {
-		const fs::Axiom* axiom = it.second;
-		auto definition = fs::process_axioms(*(axiom->getDefinition()), info);
-		it.second = new fs::Axiom(axiom->getName(), axiom->getSignature(), axiom->getParameterNames(), axiom->getBindingUnit(), definition);
-		delete axiom;
+		fs::Axiom* axiom = it.second;
+		axiom->define(fs::process_axioms(*(axiom->getDefinition()), info));
 	}
 
 	// Recreate the goal formula with axioms, delete the old one, and recreate the goal manager with the new one
@@ -134,7 +138,7 @@ void Problem::consolidateAxioms() {
 	auto tmp = _goal_formula;
 	_goal_formula = fs::process_axioms(*_goal_formula, info);
 	delete tmp;
-	_goal_sat_manager = std::unique_ptr<FormulaInterpreter>(FormulaInterpreter::create(_goal_formula, get_tuple_index()));
+	_goal_sat_manager = std::unique_ptr<FormulaInterpreter>(FormulaInterpreter::create(_goal_formula, get_tuple_index(), *_state_indexer));
 
 	// Recreate the state-constraint formula with axioms, delete the old one
 	tmp = _state_constraint_formula;
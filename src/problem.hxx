@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include <fs_types.hxx>
 #include <utils/atom_index.hxx>
 
@@ -16,10 +18,11 @@ class ActionData;
 class ActionBase;
 class PartiallyGroundedAction;
 class GroundAction;
+class RelaxedReachability;
 
 class Problem {
 public:
-	Problem(State* init, StateAtomIndexer* state_indexer, const std::vector<const ActionData*>& action_data, const std::unordered_map<std::string, const fs::Axiom*>& axioms, const fs::Formula* goal, const fs::Formula* state_constraints, AtomIndex&& tuple_index);
+	Problem(State* init, StateAtomIndexer* state_indexer, const std::vector<const ActionData*>& action_data, const std::unordered_map<std::string, fs::Axiom*>& axioms, const fs::Formula* goal, const fs::Formula* state_constraints, AtomIndex&& tuple_index);
 	~Problem();
 	
 	Problem(const Problem& other);
@@ -57,7 +60,8 @@ public:
 		_instance = std::move(problem);
 	}
 	
-	//! Global singleton object accessor
+	//! Global singleton object accessor. Once the problem has been loaded and its actions grounded,
+	//! it is only accessed through const methods, which are safe to call from several threads.
 	static const Problem& getInstance() {
 		assert(_instance);
 		return *_instance;
@@ -71,6 +75,11 @@ public:
 	
 	const AtomIndex& get_tuple_index() const { return _tuple_index; }
 	
+	//! The relaxed reachability analysis with which the atom index was pruned, if any, and which then needs to be used
+	//! to ground the actions as well, so that they only mention indexed atoms
+	const RelaxedReachability* get_reachability() const { return _reachability.get(); }
+	void set_reachability(const std::shared_ptr<const RelaxedReachability>& reachability) { _reachability = reachability; }
+	
 	//! Return true if all the symbols of the problem are predicates
 	bool is_predicative() const { return _is_predicative; }
 	
@@ -87,6 +96,8 @@ protected:
 	//! An index of tuples and atoms
 	AtomIndex _tuple_index;
 	
+	std::shared_ptr<const RelaxedReachability> _reachability;
+	
 	//! The initial state of the problem
 	const std::unique_ptr<State> _init;
 
@@ -94,8 +105,8 @@ protected:
 	
 	std::vector<const ActionData*> _action_data;
 	
-	//! An index mapping symbol names to the axiomatic definition of the symbol, if it exists.
-	std::unordered_map<std::string, const fs::Axiom*> _axioms;
+	//! An index mapping symbol names to the axiomatic definition of the symbol, if it exists. Owned by the problem.
+	std::unordered_map<std::string, fs::Axiom*> _axioms;
 	
 	// The set of grounded actions of the problem
 	std::vector<const GroundAction*> _ground;
@@ -70,6 +70,7 @@ unsigned ProblemInfo::getNumObjects() const { return objectNames.size(); }
 
 void ProblemInfo::loadVariableIndex(const rapidjson::Value& data) {
 	assert(variableNames.empty());
+	std::vector<utils::TupleTable::EntriesT> variables_by_symbol(_functionData.size());
 
 	for (unsigned i = 0; i < data.Size(); ++i) {
 		unsigned id = variableNames.size();
@@ -95,9 +96,13 @@ void ProblemInfo::loadVariableIndex(const rapidjson::Value& data) {
 			constants.push_back(var_data[1][j].GetInt());
 		}
 
-		variableDataToId.insert(std::make_pair(std::make_pair(symbol_id, constants),  id));
+		variables_by_symbol.at(symbol_id).push_back(std::make_pair(constants, id));
 		variableIdToData.push_back(std::make_pair(symbol_id, constants));
 	}
+
+	for (const auto& entries:variables_by_symbol) {
+		variableDataToId.push_back(utils::TupleTable(entries));
+	}
 }
 
 void ProblemInfo::loadSymbolIndex(const rapidjson::Value& data) {
@@ -223,7 +228,7 @@ void ProblemInfo::loadProblemMetadata(const rapidjson::Value& data) {
 void
 ProblemInfo::set_extension(unsigned symbol_id, std::unique_ptr<StaticExtension>&& extension) {
 	assert(_extensions.at(symbol_id) == nullptr); // Shouldn't be setting twice the same extension
-	setFunction(symbol_id, extension->get_function());
+	_functionData.at(symbol_id).setTable(&extension->get_table());
 	_extensions.at(symbol_id) = std::move(extension);
 }
 
@@ -7,6 +7,7 @@
 #include <lib/rapidjson/document.h>
 #include <utils/static.hxx>
 #include <utils/external.hxx>
+#include <utils/tuple_table.hxx>
 
 namespace fs0 {
 
@@ -19,7 +20,7 @@ public:
 	enum class Type {PREDICATE, FUNCTION};
 
 	SymbolData(Type type, const Signature& signature, TypeIdx codomain, std::vector<VariableIdx>& variables, bool stat, bool unbounded):
-		_type(type), _signature(signature), _codomain(codomain), _variables(variables), _static(stat), _unbounded_arity(unbounded) {}
+		_type(type), _signature(signature), _codomain(codomain), _variables(variables), _static(stat), _unbounded_arity(unbounded), _function(), _table(nullptr) {}
 
 	//! Returns the state variables derived from the given function (e.g. for a function "f", f(1), f(2), ...)
 	const std::vector<VariableIdx>& getStateVariables() const {
@@ -40,12 +41,22 @@ public:
 	void setFunction(const Function& function) {
 		assert(_static);
 		_function = function;
+		_table = nullptr;
 	}
 	const Function& getFunction() const {
 		assert(_function);
 		return _function;
 	}
 
+	//! Sets/Gets the flat table with the extension of the function, if the function is implemented by one,
+	//! in which case it can be looked up directly rather than through the function object
+	void setTable(const utils::StaticTable* table) {
+		assert(_static && table);
+		_function = table->get_function();
+		_table = table;
+	}
+	const utils::StaticTable* getTable() const { return _table; }
+
 protected:
 	Type _type;
 	Signature _signature;
@@ -56,6 +67,9 @@ protected:
 
 	//! The actual implementation of the function
 	Function _function;
+
+	//! The table implementing the function, or null if it is implemented otherwise (e.g. externally)
+	const utils::StaticTable* _table;
 };
 
 /**
@@ -72,7 +86,7 @@ public:
 		return *_instance;
 	}
 
-	//! Global singleton object accessor
+	//! Global singleton object accessor. The object is read-only once loaded, hence safe to read from several threads.
 	static const ProblemInfo& getInstance() {
 		assert(_instance);
 		return *_instance;
@@ -88,8 +102,8 @@ protected:
 	//! A map from state variable name to state variable ID
 	std::map<std::string, VariableIdx> variableIds;
 
-	//! A map from the actual data "f(t1, t2, ..., tn)" to the assigned variable ID
-	std::map<std::pair<unsigned, std::vector<ObjectIdx>>, VariableIdx> variableDataToId;
+	//! variableDataToId[f] maps each tuple (t1, t2, ..., tn) to the ID of the state variable "f(t1, t2, ..., tn)"
+	std::vector<utils::TupleTable> variableDataToId;
 	std::vector<std::pair<unsigned, std::vector<ObjectIdx>>> variableIdToData;
 
 	//! A map from state variable index to the type of the state variable
@@ -207,8 +221,8 @@ public:
 
 
 	//! Resolves a pair of function ID + an assignment of values to their parameters to the corresponding state variable.
-	VariableIdx resolveStateVariable(unsigned symbol_id, std::vector<ObjectIdx>&& constants) const { return variableDataToId.at(std::make_pair(symbol_id, std::move(constants))); }
-	VariableIdx resolveStateVariable(unsigned symbol_id, const std::vector<ObjectIdx>& constants) const { return variableDataToId.at(std::make_pair(symbol_id, constants)); }
+	//! Throws std::out_of_range if there is no such state variable.
+	VariableIdx resolveStateVariable(unsigned symbol_id, const std::vector<ObjectIdx>& constants) const { return variableDataToId.at(symbol_id).at(constants); }
 
 	//! Return the data that originated a state variable
 	const std::pair<unsigned, std::vector<ObjectIdx>>& getVariableData(VariableIdx variable) const { return variableIdToData.at(variable); }
@@ -6,46 +6,46 @@
 namespace fs0 {
 	
 
-RelaxedState::~RelaxedState() {
-	assert(checkPointerOwnershipIsCorrect());
-}
-
-bool RelaxedState::checkPointerOwnershipIsCorrect() const {
-	for (const DomainPtr& domain:_domains) {
-		if (domain.use_count() != 1) return false;
-	}
-	return true;
-}
-
-RelaxedState::RelaxedState(const State& state) {
+RelaxedState::RelaxedState(const DomainLayout& layout, const State& state) : _layout(layout) {
 	unsigned n = state.numAtoms();
+	assert(n == layout.getNumVariables());
 	_domains.reserve(n);
 	
 	// For each vector index, we construct a new domain containing only the value from the non-relaxed state.
 	for (unsigned i = 0; i < n; ++i) {
-		DomainPtr domain = std::make_shared<Domain>();
-		domain->insert(state.getValue(i));
-		_domains.push_back(domain);
+		_domains.push_back(layout.at(i).singleton(state.getValue(i)));
 	}
 }
 
 void RelaxedState::accumulate(const std::vector<std::vector<ObjectIdx>>& atoms) {
 	for (VariableIdx variable = 0; variable < atoms.size(); ++variable) {
-		const auto& var_atoms = atoms[variable];
-		_domains.at(variable)->insert(var_atoms.cbegin(), var_atoms.cend());
+		const VariableLayout& layout = _layout.at(variable);
+		BitsetDomain& domain = _domains.at(variable);
+		for (ObjectIdx value:atoms[variable]) {
+			assert(layout.position(value) < layout.size());
+			domain.set(layout.position(value));
+		}
 	}
 }
 
+DomainPtr RelaxedState::getValues(VariableIdx variable) const {
+	return std::make_shared<Domain>(_layout.at(variable).decode(_domains.at(variable)));
+}
+
+void RelaxedState::setValues(VariableIdx variable, const Domain& domain) {
+	_domains.at(variable) = _layout.at(variable).encode(domain);
+}
+
 std::ostream& RelaxedState::print(std::ostream& os) const {
 	const ProblemInfo& problemInfo = ProblemInfo::getInstance();
 	os << "RelaxedState[";
 	for (unsigned i = 0; i < _domains.size(); ++i) { // Iterate through all the sets
-		const DomainPtr& vals = _domains.at(i);
-		assert(vals->size() != 0);
+		const BitsetDomain& vals = _domains.at(i);
+		assert(vals.any());
 		
 		os << problemInfo.getVariableName(i) << "={";
-		for (const auto& objIdx:*vals) { // Iterate through the set elements.
-			os << problemInfo.getObjectName(i, objIdx) << ",";
+		for (auto bit = vals.find_first(); bit != BitsetDomain::npos; bit = vals.find_next(bit)) { // Iterate through the set elements.
+			os << problemInfo.getObjectName(i, _layout.at(i).value(bit)) << ",";
 		}
 		if (i < _domains.size() - 1) os << "}, ";
 	}
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <fs_types.hxx>
+#include <constraints/direct/bitset_domain.hxx>
 
 
 namespace fs0 {
@@ -10,14 +11,17 @@ class State; class Problem;
 
 class RelaxedState {
 protected:
-	//! A vector associating symbol IDs to all their possible current extensional value in the relaxed state.
-	DomainVector _domains;
+	//! The layout of the values of each state variable onto the bits of its domain
+	const DomainLayout& _layout;
+
+	//! A vector associating variable IDs to all their possible current values in the relaxed state, as bitset domains.
+	std::vector<BitsetDomain> _domains;
 
 public:
-	virtual ~RelaxedState();
+	virtual ~RelaxedState() = default;
 
 	//! The only way to construct a relaxed state is from a non-relaxed state.
-	RelaxedState(const State& state);
+	RelaxedState(const DomainLayout& layout, const State& state);
 	
 	// No need to use this - but if ever needed, check the git history!
 	// https://bitbucket.org/gfrances/fs0/src/28ce4119f27a537d8f7628c6ca0487d03d5ed0b1/src/relaxed_state.hxx?at=gecode_integration
@@ -27,17 +31,22 @@ public:
 	
 	void accumulate(const std::vector<std::vector<ObjectIdx>>& atoms);
 	
-	const DomainVector& getDomains() const { return _domains; }
+	const DomainLayout& getLayout() const { return _layout; }
+	
+	//! The bitset domain of the given variable
+	const BitsetDomain& getDomain(VariableIdx variable) const { return _domains.at(variable); }
+	
+	//! Returns a (set-based) copy of the domain of the given variable
+	DomainPtr getValues(VariableIdx variable) const;
 	
-	//! Const and non-const accessors
-	const DomainPtr& getValues(const VariableIdx& variable) const { return _domains.at(variable); }
-	DomainPtr getValues(const VariableIdx& variable) { return _domains.at(variable); }
+	//! Replaces the domain of the given variable
+	void setValues(VariableIdx variable, const Domain& domain);
 	
 	//! Returns the total number of distinct atoms in the relaxed state.
 	unsigned getNumberOfAtoms() const {
 		unsigned total = 0;
-		for (const DomainPtr& domain:_domains) {
-			total += domain->size();
+		for (const BitsetDomain& domain:_domains) {
+			total += domain.count();
 		}
 		return total;
 	}
@@ -48,10 +57,6 @@ public:
 	//! Prints a representation of the state to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const RelaxedState&  state) { return state.print(os); }
 	std::ostream& print(std::ostream& os) const;
-
-protected:
-	//! Small helper for debugging purposes
-	bool checkPointerOwnershipIsCorrect() const;
 };
 
 } // namespaces
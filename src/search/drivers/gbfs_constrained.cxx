@@ -26,7 +26,7 @@ GBFS_CRPGDriver::~GBFS_CRPGDriver() {
 
 ExitCode
 GBFS_CRPGDriver::search(Problem& problem, const Config& config, const std::string& out_dir, float start_time) {
-	
+	Validation::check_no_reachability_pruning(problem);
 	const auto model = drivers::GroundingSetup::fully_ground_model(problem);
 	const std::vector<const GroundAction*>& actions = problem.getGroundActions();
 	
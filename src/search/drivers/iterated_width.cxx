@@ -55,7 +55,12 @@ do_search(const StateModelT& model, const Config& config, const std::string& out
 		}
 	}
 	
-	if (indexer.is_fully_binary()) { // The state is fully binary
+	if (indexer.is_packed()) { // Packed states offer no direct access to the underlying vectors of values
+		LPT_INFO("cout", "FEATURE EVALUATION: Packed state, using a generic StraightHybridFeatureSetEvaluator");
+		using FeatureEvaluatorT = lapkt::novelty::StraightHybridFeatureSetEvaluator;
+		return do_search1<StateModelT, bfws::FSMultivaluedNoveltyEvaluatorI, FeatureEvaluatorT>(model, FeatureEvaluatorT(), config, out_dir, start_time, stats);
+		
+	} else if (indexer.is_fully_binary()) { // The state is fully binary
 		LPT_INFO("cout", "FEATURE EVALUATION: Using the specialized StraightFeatureSetEvaluator<bin>");
 		using FeatureEvaluatorT = lapkt::novelty::StraightFeatureSetEvaluator<bool>;
 		return do_search1<StateModelT, bfws::FSBinaryNoveltyEvaluatorI, FeatureEvaluatorT>(model, FeatureEvaluatorT(), config, out_dir, start_time, stats);
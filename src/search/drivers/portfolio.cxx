@@ -0,0 +1,118 @@
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <lapkt/tools/logging.hxx>
+
+#include <search/drivers/portfolio.hxx>
+#include <utils/cancellation.hxx>
+#include <utils/config.hxx>
+
+
+namespace fs0 { namespace drivers {
+
+//! Copy the given file, if it exists
+static void copy_file(const std::string& from, const std::string& to) {
+	std::ifstream in(from, std::ios::binary);
+	if (!in) return;
+	std::ofstream out(to, std::ios::binary);
+	out << in.rdbuf();
+}
+
+std::vector<std::string>
+PortfolioDriver::parse_drivers(const std::string& list) {
+	std::vector<std::string> names;
+	boost::split(names, list, boost::is_any_of(","));
+	for (auto& name:names) boost::trim(name);
+	names.erase(std::remove(names.begin(), names.end(), std::string()), names.end());
+
+	if (names.empty()) throw std::runtime_error("Option 'portfolio.drivers' needs to specify at least one driver");
+	for (unsigned i = 0; i < names.size(); ++i) {
+		if (names[i] == "portfolio") throw std::runtime_error("A portfolio cannot contain itself");
+		// Drivers keep their own state (statistics, event handlers, etc.), hence they cannot run twice at the same time
+		if (std::find(names.begin(), names.begin() + i, names[i]) != names.begin() + i) {
+			throw std::runtime_error("Driver '" + names[i] + "' appears more than once in the portfolio");
+		}
+	}
+	return names;
+}
+
+ExitCode
+PortfolioDriver::search(Problem& problem, const Config& config, const std::string& out_dir, float start_time) {
+	const std::vector<std::string> names = parse_drivers(config.getOption<std::string>("portfolio.drivers"));
+	const double budget = config.getOption<double>("portfolio.budget", 0);
+
+	std::vector<Driver*> drivers;
+	for (const auto& name:names) drivers.push_back(EngineRegistry::instance().get(name));
+
+	// A token per driver, all of them chained to the token of the portfolio itself, which will be cancelled
+	// once some driver finds a plan. If the portfolio itself runs under some token, we chain to it as well.
+	utils::CancellationToken portfolio_token(utils::CancellationToken::current());
+	std::vector<std::unique_ptr<utils::CancellationToken>> tokens;
+	for (unsigned i = 0; i < drivers.size(); ++i) {
+		tokens.push_back(std::unique_ptr<utils::CancellationToken>(new utils::CancellationToken(&portfolio_token)));
+		if (budget > 0) tokens.back()->set_budget(budget);
+	}
+
+	std::vector<std::string> directories;
+	for (const auto& name:names) {
+		directories.push_back(out_dir + "/" + name);
+		mkdir(directories.back().c_str(), 0755); // The directory might well exist already
+	}
+
+	LPT_INFO("cout", "Running a portfolio of " << drivers.size() << " drivers: " << config.getOption<std::string>("portfolio.drivers"));
+
+	std::mutex mutex;
+	int winner = -1;
+	std::vector<ExitCode> results(drivers.size(), ExitCode::UNSOLVED_INCOMPLETE);
+
+	std::vector<std::thread> threads;
+	for (unsigned i = 0; i < drivers.size(); ++i) {
+		threads.emplace_back([&, i]() {
+			utils::CancellationToken::install(tokens[i].get());
+			ExitCode result = ExitCode::UNSOLVED_INCOMPLETE;
+			try {
+				result = drivers[i]->search(problem, config, directories[i], start_time);
+			} catch (const utils::SearchCancelled& ex) {
+				// The driver was stopped before its search started, e.g. while computing some heuristic
+			} catch (const std::bad_alloc& ex) {
+				result = ExitCode::OUT_OF_MEMORY;
+			} catch (const std::exception& ex) {
+				LPT_INFO("cout", "Portfolio: driver '" << names[i] << "' failed: " << ex.what());
+				result = ExitCode::CRITICAL_ERROR;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex);
+			results[i] = result;
+			if (result == ExitCode::PLAN_FOUND && winner < 0) {
+				winner = i;
+				portfolio_token.cancel();
+			}
+		});
+	}
+
+	for (auto& thread:threads) thread.join();
+
+	if (winner < 0) {
+		LPT_INFO("cout", "Portfolio: no driver found a plan");
+		// If some driver exhausted its search space, we report so; otherwise, we report the outcome of the first driver
+		for (ExitCode result:results) {
+			if (result == ExitCode::UNSOLVABLE) return result;
+		}
+		return results[0];
+	}
+
+	LPT_INFO("cout", "Portfolio: plan found by driver '" << names[winner] << "'");
+	copy_file(directories[winner] + "/first.plan", out_dir + "/first.plan");
+	copy_file(directories[winner] + "/results.json", out_dir + "/results.json");
+	return ExitCode::PLAN_FOUND;
+}
+
+} } // namespaces
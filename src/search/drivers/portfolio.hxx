@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <search/drivers/registry.hxx>
+
+
+namespace fs0 { class Config; }
+
+namespace fs0 { namespace drivers {
+
+//! A driver that runs a number of other (registered) drivers in parallel, one thread each,
+//! and stops all of them as soon as any finds a plan. The drivers to run are given as a comma-separated
+//! list of driver names in option 'portfolio.drivers', and each of them can be given a maximum
+//! (wall-clock) time budget through option 'portfolio.budget'.
+//! Each driver writes its results to a subdirectory of the output directory named after it;
+//! the plan and results of the winner are then copied into the output directory itself.
+class PortfolioDriver : public Driver {
+public:
+	ExitCode search(Problem& problem, const Config& config, const std::string& out_dir, float start_time) override;
+
+protected:
+	//! Parse the list of driver names of the portfolio
+	static std::vector<std::string> parse_drivers(const std::string& list);
+};
+
+} } // namespaces
@@ -10,6 +10,7 @@
 #include <search/drivers/smart_effect_driver.hxx>
 #include <search/drivers/smart_lifted_driver.hxx>
 #include <search/drivers/fully_lifted_driver.hxx>
+#include <search/drivers/portfolio.hxx>
 // #include <heuristics/relaxed_plan/direct_crpg.hxx>
 // #include <heuristics/relaxed_plan/gecode_crpg.hxx>
 #include <actions/grounding.hxx>
@@ -42,6 +43,7 @@ EngineRegistry::EngineRegistry() {
 	add("liw",  new IteratedWidthDriver<LiftedStateModel>());
 	
 	add("sbfws",  new bfws::SBFWSDriver<SimpleStateModel>());
+	add("psbfws",  new bfws::SBFWSDriver<SimpleStateModel>(true));
 	add("lsbfws",  new bfws::SBFWSDriver<LiftedStateModel>());
 	
 	add("bfs",  new BreadthFirstSearchDriver<GroundStateModel>());
@@ -49,6 +51,8 @@ EngineRegistry::EngineRegistry() {
 	
 	add("smart",  new SmartEffectDriver());
 	add("lsmart",  new SmartLiftedDriver());
+	
+	add("portfolio",  new PortfolioDriver());
 }
 
 EngineRegistry::~EngineRegistry() {
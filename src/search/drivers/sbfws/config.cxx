@@ -1,14 +1,18 @@
 
+#include <algorithm>
+#include <thread>
+
 #include "config.hxx"
 #include <utils/config.hxx>
 
 namespace fs0 { namespace bfws {
 
-SBFWSConfig::SBFWSConfig(const Config& config) :
+SBFWSConfig::SBFWSConfig(const Config& config, bool parallel) :
 	search_width(config.getOption<int>("width.search", 2)),
 	simulation_width(config.getOption<int>("width.simulation", 1)),
 	mark_negative_propositions(config.getOption<bool>("simulation.neg_prop", false)),
-	complete_simulation(config.getOption<bool>("simulation.complete", true))
+	complete_simulation(config.getOption<bool>("simulation.complete", true)),
+	threads(parallel ? std::max(1u, config.getOption<unsigned>("bfws.threads", std::thread::hardware_concurrency())) : 1)
 {
 	std::string rs = config.getOption<std::string>("bfws.rs");
 	if  (rs == "sim") relevant_set_type = RelevantSetType::Sim;
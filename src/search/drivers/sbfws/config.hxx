@@ -8,7 +8,8 @@ namespace fs0 { namespace bfws {
 
 //! A configuration class for the SBFWS search
 struct SBFWSConfig {
-	SBFWSConfig(const Config&);
+	//! A parallel configuration expands nodes on several threads, as many as hardware threads by default
+	SBFWSConfig(const Config&, bool parallel = false);
 	SBFWSConfig(const SBFWSConfig&) = default;
 	SBFWSConfig& operator=(const SBFWSConfig&) = default;
 	SBFWSConfig(SBFWSConfig&&) = default;
@@ -20,6 +21,9 @@ struct SBFWSConfig {
 	const bool mark_negative_propositions;
 	const bool complete_simulation;
 	
+	//! The number of threads on which the successors of the nodes of the search are generated
+	const unsigned threads;
+	
 	enum class NoveltyEvaluatorType {Adaptive, Generic};
 	NoveltyEvaluatorType evaluator_t;
 	
@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include <vector>
+#include <boost/optional.hpp>
+
+#include <atom.hxx>
+#include "state_cache.hxx"
+#include "stats.hxx"
+
+
+namespace fs0 { namespace bfws {
+
+//! A store of delta-encoded node states.
+//! With a checkpoint interval k > 0, only nodes whose depth g is a multiple of k keep their full
+//! state; the rest of nodes keep only the atoms that changed wrt the state of their parent,
+//! and their full state is rebuilt lazily from the closest ancestor whose state is available.
+//! A small StateCache holds the most recently rebuilt states.
+//! With k = 0, delta-encoding is disabled and all nodes keep their full state.
+//!
+//! The node type is expected to have the fields 'parent', 'g', '_gen_order', '_state' (a boost::optional<StateT>),
+//! '_delta' (a vector of atoms) and '_store' (a pointer to this store).
+template <typename NodeT, typename StateT>
+class DeltaStateStore {
+protected:
+	//! The checkpoint interval k
+	unsigned _interval;
+
+	//! A cache of recently rebuilt states, indexed by the generation order of their nodes.
+	//! Generation orders start at 1, which complies with the requirements of the cache on its keys.
+	StateCache<StateT> _cache;
+
+	BFWSStats& _stats;
+
+public:
+	DeltaStateStore(unsigned interval, BFWSStats& stats) :
+		_interval(interval), _cache(), _stats(stats)
+	{}
+
+	DeltaStateStore(const DeltaStateStore&) = delete;
+	DeltaStateStore(DeltaStateStore&&) = default;
+	DeltaStateStore& operator=(const DeltaStateStore&) = delete;
+	DeltaStateStore& operator=(DeltaStateStore&&) = delete;
+
+	bool enabled() const { return _interval > 0; }
+
+	bool is_checkpoint(const NodeT& node) const { return !enabled() || node.g % _interval == 0; }
+
+	//! Drop the full state of the given node, unless it is a checkpoint, and keep only its changeset
+	//! wrt the given state of its parent.
+	void encode(NodeT& node, const StateT& parent_state) {
+		if (is_checkpoint(node) || !node._state) return;
+		assert(node.has_parent());
+		node._delta = node._state->diff(parent_state);
+		node._delta.shrink_to_fit();
+		node._state = boost::none;
+		node._store = this;
+		_stats.delta_encoded_node();
+	}
+
+	//! Return the state of the given node, rebuilding it if necessary.
+	//! The returned reference is valid at least until the second subsequent call to this method.
+	const StateT& get(const NodeT& node) {
+		if (node._state) return *node._state;
+
+		unsigned cached = _cache.find(node._gen_order);
+		if (cached != StateCache<StateT>::NOT_FOUND) {
+			_stats.delta_cache_hit();
+			return _cache.get(cached);
+		}
+
+		// Walk up the path until a node whose full state is available, either on the node itself or on the cache.
+		std::vector<const NodeT*> path;
+		const NodeT* current = &node;
+		const StateT* base = nullptr;
+		while (true) {
+			if (current->_state) {
+				base = &(*current->_state);
+				break;
+			}
+			cached = _cache.find(current->_gen_order);
+			if (cached != StateCache<StateT>::NOT_FOUND) {
+				base = &_cache.peek(cached);
+				break;
+			}
+			path.push_back(current);
+			assert(current->has_parent());
+			current = current->parent;
+		}
+
+		StateT state(*base);
+		for (auto it = path.rbegin(); it != path.rend(); ++it) {
+			state.accumulate((*it)->_delta);
+		}
+		assert(state.hash() == node._hash);
+		_stats.delta_state_rebuilt();
+		return _cache.insert(node._gen_order, std::move(state));
+	}
+
+	//! Clear the cache of rebuilt states. Necessary whenever generation orders are reset.
+	void clear() { _cache.clear(); }
+};
+
+} } // namespaces
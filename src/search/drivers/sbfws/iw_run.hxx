@@ -10,11 +10,16 @@
 #include <problem.hxx>
 #include "base.hxx"
 #include "stats.hxx"
+#include "delta_state_store.hxx"
 #include <search/drivers/sbfws/relevant_atomset.hxx>
 #include <utils/printers/vector.hxx>
 #include <utils/printers/actions.hxx>
 #include <lapkt/search/components/open_lists.hxx>
 #include <utils/config.hxx>
+#include <utils/node_arena.hxx>
+#include <utils/thread_pool.hxx>
+#include <utils/fingerprint_set.hxx>
+#include <utils/cancellation.hxx>
 
 
 namespace fs0 { namespace bfws {
@@ -23,10 +28,21 @@ template <typename StateT, typename ActionType>
 class IWRunNode {
 public:
 	using ActionT = ActionType;
-	using PT = std::shared_ptr<IWRunNode<StateT, ActionT>>;
+	//! Nodes are owned by the node pool of the simulation, hence we refer to them through plain pointers
+	using PT = IWRunNode<StateT, ActionT>*;
+	using StoreT = DeltaStateStore<IWRunNode<StateT, ActionT>, StateT>;
 
-	//! The state in this node
-	StateT state;
+	//! The state in this node, unless the node is delta-encoded
+	boost::optional<StateT> _state;
+	
+	//! The changeset wrt the parent state, if the node is delta-encoded
+	std::vector<Atom> _delta;
+	
+	//! The store able to rebuild the state of the node, if the node is delta-encoded
+	StoreT* _store;
+	
+	//! The hash of the state
+	std::size_t _hash;
 
 	//! The action that led to this node
 	typename ActionT::IdType action;
@@ -70,8 +86,11 @@ public:
 	IWRunNode(const StateT& s, unsigned long gen_order) : IWRunNode(StateT(s), ActionT::invalid_action_id, nullptr, gen_order) {}
 
 	//! Constructor with move of the state (cheaper)
-	IWRunNode(StateT&& _state, typename ActionT::IdType _action, PT _parent, uint32_t gen_order) :
-		state(std::move(_state)),
+	IWRunNode(StateT&& state_, typename ActionT::IdType _action, PT _parent, uint32_t gen_order) :
+		_state(std::move(state_)),
+		_delta(),
+		_store(nullptr),
+		_hash(_state->hash()),
 //		feature_valuation(0),
 		action(_action),
 		parent(_parent),
@@ -86,6 +105,9 @@ public:
 
 
 	bool has_parent() const { return parent != nullptr; }
+	
+	//! The state of the node, which might need to be rebuilt if the node is delta-encoded
+	const StateT& state() const { return _state ? *_state : _store->get(*this); }
 
 	//! Print the node into the given stream
 	friend std::ostream& operator<<(std::ostream &os, const IWRunNode<StateT, ActionT>& object) { return object.print(os); }
@@ -93,7 +115,7 @@ public:
 // 		const Problem& problem = Problem::getInstance();
 		os << "{@ = " << this;
 		os << ", #=" << _gen_order ;
-		os << ", s = " << state ;
+		os << ", s = " << state() ;
 		os << ", g=" << g ;
 		//os << ", w=" << (_evaluated ? (_w == std::numeric_limits<unsigned char>::max() ? "INF" : std::to_string(_w)) : "?") ;
 		os << ", w=" << (_w == std::numeric_limits<unsigned char>::max() ? "INF" : std::to_string(_w));
@@ -110,9 +132,9 @@ public:
 		return os;
 	}
 
-	bool operator==( const IWRunNode<StateT, ActionT>& o ) const { return state == o.state; }
+	bool operator==( const IWRunNode<StateT, ActionT>& o ) const { return _hash == o._hash && state() == o.state(); }
 
-	std::size_t hash() const { return state.hash(); }
+	std::size_t hash() const { return _hash; }
 };
 
 
@@ -137,9 +159,9 @@ public:
 	unsigned evaluate(NodeT& node) {
 		if (node.parent) {
 			// Important: the novel-based computation works only when the parent has the same novelty type and thus goes against the same novelty tables!!!
-			node._w = _evaluator->evaluate(_features.evaluate(node.state), _features.evaluate(node.parent->state));
+			node._w = _evaluator->evaluate(_features.evaluate(node.state()), _features.evaluate(node.parent->state()));
 		} else {
-			node._w = _evaluator->evaluate(_features.evaluate(node.state));
+			node._w = _evaluator->evaluate(_features.evaluate(node.state()));
 		}
 		
 		return node._w;
@@ -177,13 +199,16 @@ public:
 	using StateT = typename StateModel::StateT;
 	
 	using ActionIdT = typename StateModel::ActionType::IdType;
-	using NodePT = std::shared_ptr<NodeT>;
+	using NodePT = NodeT*;
 	
 	using SimEvaluatorT = SimulationEvaluator<NodeT, FeatureSetT, NoveltyEvaluatorT>;
 	
 	using FeatureValueT = typename NoveltyEvaluatorT::FeatureValueT;
 	
-	using OpenListT = lapkt::SimpleQueue<NodeT>;
+	using OpenListT = lapkt::SimpleQueue<NodeT, NodePT>;
+	
+	//! The number of nodes per thread expanded at once when expanding a layer in parallel
+	static const std::size_t BLOCK_NODES_PER_THREAD = 64;
 	
 	struct Config {
 		//! Whether to perform a complete run or a partial one, i.e. up until (independent) satisfaction of all goal atoms.
@@ -213,6 +238,15 @@ public:
 		//!
 		unsigned _gr_actions_cutoff;
 		
+		//! The interval k at which simulation nodes keep a full state checkpoint (0 to disable delta-encoding)
+		unsigned _checkpoint_interval;
+		
+		//! The number of threads used to generate the successors of each layer of the simulation (1 to run sequentially)
+		unsigned _threads;
+		
+		//! Whether to prune generated states that were already seen in the current simulation
+		bool _detect_duplicates;
+		
 		Config(bool complete, bool mark_negative, unsigned max_width, const fs0::Config& global_config) :
 			_complete(complete),
 			_mark_negative(mark_negative),
@@ -222,7 +256,10 @@ public:
 			_force_adaptive_run(global_config.getOption<bool>("sim.hybrid", false)),
 			_force_R_all(global_config.getOption<bool>("sim.r_all", false)),
 			_r_g_prime(global_config.getOption<bool>("sim.r_g_prime", false)),
-			_gr_actions_cutoff(global_config.getOption<unsigned>("sim.act_cutoff", std::numeric_limits<unsigned>::max()))
+			_gr_actions_cutoff(global_config.getOption<unsigned>("sim.act_cutoff", std::numeric_limits<unsigned>::max())),
+			_checkpoint_interval(global_config.getOption<unsigned>("bfws.checkpoint_interval", 0)),
+			_threads(global_config.getOption<unsigned>("sim.threads", 1)),
+			_detect_duplicates(global_config.getOption<bool>("sim.duplicates", false))
 		{}
 	};
 	
@@ -232,6 +269,10 @@ protected:
 	
 	//! The simulation configuration
 	Config _config;
+	
+	//! The pool that owns all nodes of the current simulation, which are destroyed when the simulation is reset.
+	//! Must be declared before any member holding nodes, so that it is destroyed after them.
+	utils::NodePool<NodeT> _nodes;
 
 	//!
 	std::vector<NodePT> _optimal_paths;
@@ -239,8 +280,12 @@ protected:
 	//! '_unreached' contains the indexes of all those goal atoms that have yet not been reached.
 	std::unordered_set<unsigned> _unreached;
 	
-	//! Contains the indexes of all those goal atoms that were already reached in the seed state
-	std::vector<bool> _in_seed;
+	//! _in_seed[i] == _run iff the i-th goal atom was already reached in the seed state of the current run.
+	//! Stamping the entries with the run number saves us from clearing the table on each run.
+	std::vector<uint32_t> _in_seed;
+	
+	//! The number of runs performed so far, including the current one
+	uint32_t _run;
 	
 	//! A single novelty evaluator will be in charge of evaluating all nodes
 	SimEvaluatorT _evaluator;
@@ -256,8 +301,25 @@ protected:
 	//! The general statistics of the search
 	BFWSStats& _stats;
 	
+	//! The store of delta-encoded states
+	typename NodeT::StoreT _store;
+	
+	//! The fingerprints of all states seen in the current simulation, if duplicate detection is enabled
+	utils::FingerprintSet _seen;
+	
 	//! Whether to print some useful extra information or not
 	bool _verbose;
+	
+	//! The pool of threads that generate successors in parallel, if the simulation runs on more than one thread
+	std::unique_ptr<utils::ThreadPool> _pool;
+	
+	//! Buffers for the parallel expansion of a layer of the simulation: the nodes being expanded, their states,
+	//! and the successors of each of them, in the order in which they would be generated by a sequential run.
+	//! The buffers are kept across runs to avoid memory allocations.
+	std::vector<NodePT> _layer;
+	std::vector<boost::optional<StateT>> _rebuilt;
+	std::vector<const StateT*> _layer_states;
+	std::vector<std::vector<std::pair<ActionIdT, StateT>>> _successors;
 
 public:
 
@@ -265,9 +327,11 @@ public:
 	IWRun(const StateModel& model, const FeatureSetT& featureset, NoveltyEvaluatorT* evaluator, const IWRun::Config& config, BFWSStats& stats, bool verbose) :
 		_model(model),
 		_config(config),
+		_nodes(),
 		_optimal_paths(model.num_subgoals()),
 		_unreached(),
-		_in_seed(),
+		_in_seed(model.num_subgoals(), 0),
+		_run(0),
 		_evaluator(featureset, evaluator),
 		_generated(1),
 		_w1_nodes_expanded(0),
@@ -276,13 +340,30 @@ public:
 		_w2_nodes_generated(0),		
 		_w_gt2_nodes_generated(0),
 		_stats(stats),
-		_verbose(verbose)		
+		_store(config._checkpoint_interval, stats),
+		_seen(),
+		_verbose(verbose),
+		_pool(),
+		_layer(),
+		_rebuilt(),
+		_layer_states(),
+		_successors()
 	{
+		if (_config._threads > 1) {
+			if (StateModel::is_reentrant()) {
+				_pool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(_config._threads));
+			} else {
+				LPT_INFO("cout", "Simulation - The state model does not support concurrent successor generation, running the simulation sequentially");
+			}
+		}
 	}
 	
 	void reset() {
-		std::vector<NodePT> _(_optimal_paths.size(), nullptr);
-		_optimal_paths.swap(_);
+		_optimal_paths.assign(_optimal_paths.size(), nullptr);
+		
+		// Nodes of the previous run are no longer referenced by any member
+		_nodes.clear();
+		
 		_generated = 1;
 		_w1_nodes_expanded = 0;
 		_w2_nodes_expanded = 0;
@@ -290,9 +371,13 @@ public:
 		_w2_nodes_generated = 0;		
 		_w_gt2_nodes_generated = 0;
 		_evaluator.reset();
+		_store.clear();
+		_seen.clear();
 	}
 
 	~IWRun() = default;
+	
+	void set_verbose(bool verbose) { _verbose = verbose; }
 
 	// Disallow copy, but allow move
 	IWRun(const IWRun&) = delete;
@@ -317,8 +402,8 @@ public:
 				auto res = all_visited.insert(node);
 				if (!res.second) break;
 				
-				const StateT& state = node->state;
-				const StateT& parent_state = node->parent->state;
+				const StateT& state = node->state();
+				const StateT& parent_state = node->parent->state();
 				_unused(state);
 				
 				for (const auto& p_q:node->_nov2_pairs) {
@@ -352,7 +437,7 @@ public:
 				}
 				
 				/*
-				const StateT& state = node->state;
+				const StateT& state = node->state();
 				for (unsigned var = 0; var < state.numAtoms(); ++var) {
 					if (state.getValue(var) == 0) continue; // TODO THIS WON'T GENERALIZE WELL TO FSTRIPS DOMAINS
 					AtomIdx atom = index.to_index(var, state.getValue(var));
@@ -379,7 +464,7 @@ public:
 				auto res = all_visited.insert(node);
 				if (!res.second) break;
 				
-				const StateT& state = node->state;
+				const StateT& state = node->state();
 				for (unsigned var = 0; var < state.numAtoms(); ++var) {
 					ObjectIdx val = state.getValue(var);
 					if (val != 0) {
@@ -395,6 +480,8 @@ public:
 	
 	void report_simulation_stats(float simt0) {
 		_stats.simulation();
+		_stats.sim_arena_size(_nodes.reserved_bytes());
+		if (_config._detect_duplicates) _stats.sim_seen_set_size(_seen.bytes());
 		_stats.sim_add_time(aptk::time_used() - simt0);
 		_stats.sim_add_expanded_nodes(_w1_nodes_expanded+_w2_nodes_expanded);
 		_stats.sim_add_generated_nodes(_w1_nodes_generated+_w2_nodes_generated+_w_gt2_nodes_generated);
@@ -567,7 +654,7 @@ public:
 		/*
 		for (unsigned subgoal_idx = 0; subgoal_idx < _all_paths.size(); ++subgoal_idx) {
 			const std::vector<NodePT>& paths = _all_paths[subgoal_idx];
-			assert(_in_seed[subgoal_idx] || !paths.empty());
+			assert(in_seed(subgoal_idx) || !paths.empty());
 			seed_nodes.insert(seed_nodes.end(), paths.begin(), paths.end());
 		}
 		*/
@@ -575,7 +662,7 @@ public:
 		
 		if (r_all_fallback) {
 			unsigned num_subgoals = _model.num_subgoals();
-			unsigned initially_reached = std::count(_in_seed.begin(), _in_seed.end(), true);
+			unsigned initially_reached = std::count(_in_seed.begin(), _in_seed.end(), _run);
 			unsigned reached_by_simulation = num_subgoals - _unreached.size() - initially_reached;
 			if (_verbose) LPT_INFO("cout", "Simulation - " << reached_by_simulation << " subgoals were newly reached by the simulation.");
 			bool decide_r_all = (reached_by_simulation < (0.5*num_subgoals));
@@ -615,7 +702,7 @@ public:
 	std::vector<NodePT> extract_seed_nodes() {
 		std::vector<NodePT> seed_nodes;
 		for (unsigned subgoal_idx = 0; subgoal_idx < _optimal_paths.size(); ++subgoal_idx) {
-			if (!_in_seed[subgoal_idx] && _optimal_paths[subgoal_idx] != nullptr) {
+			if (!in_seed(subgoal_idx) && _optimal_paths[subgoal_idx] != nullptr) {
 				seed_nodes.push_back(_optimal_paths[subgoal_idx]);
 			}
 		}
@@ -688,8 +775,12 @@ public:
 	bool run(const StateT& seed, unsigned max_width) {
 		if (_verbose) LPT_INFO("cout", "Simulation - Starting IW Simulation");
 		
-		NodePT root = std::make_shared<NodeT>(seed, _generated++);
+		NodePT root = make_node(seed, _generated++);
 		mark_seed_subgoals(root);
+		if (_config._detect_duplicates) {
+			_seen.clear();
+			_seen.insert(root->hash());
+		}
 		
 		auto nov =_evaluator.evaluate(*root);
 		assert(nov==1);
@@ -705,28 +796,28 @@ public:
 		open_w1.insert(root);
 		
 		while (true) {
+			utils::CancellationToken::check();
+			if (_pool && expand_layer_in_parallel(open_w1, open_w2, open_w1_next, open_w2_next, max_width)) {
+				report("All subgoals reached");
+				return true;
+			}
+			
 			while (!open_w1.empty() || !open_w2.empty()) {
 				NodePT current = open_w1.empty() ? open_w2.next() : open_w1.next();
 				
 				// Expand the node
 				update_novelty_counters_on_expansion(current->_w);
+				
+				// A rebuilt state lives in a cache of limited size, hence we need to copy it
+				boost::optional<StateT> rebuilt;
+				if (!current->_state) rebuilt.emplace(current->state());
+				const StateT& state = current->_state ? *current->_state : *rebuilt;
 
-				for (const auto& a : _model.applicable_actions(current->state)) {
-					StateT s_a = _model.next( current->state, a );
-					NodePT successor = std::make_shared<NodeT>(std::move(s_a), a, current, _generated++);
-					
-					unsigned char novelty = _evaluator.evaluate(*successor);
-					update_novelty_counters_on_generation(novelty);
-					
-					// LPT_INFO("cout", "Simulation - Node generated: " << *successor);
-					
-					if (process_node(successor)) {  // i.e. all subgoals have been reached before reaching the bound
+				for (const auto& a : _model.applicable_actions(state)) {
+					if (generate(current, state, a, _model.next(state, a), max_width, open_w1_next, open_w2_next)) {
 						report("All subgoals reached");
 						return true;
 					}
-					
-					if (novelty <= max_width && novelty == 1) open_w1_next.insert(successor);
-					else if (novelty <= max_width && novelty == 2) open_w2_next.insert(successor);
 				}
 				
 			}
@@ -741,6 +832,98 @@ public:
 		return false;
 	}
 	
+	//! Process the successor 's_a' of the given node, which has the given state. Returns true iff all subgoals have been reached.
+	bool generate(const NodePT& current, const StateT& state, const ActionIdT& a, StateT&& s_a, unsigned max_width, OpenListT& open_w1_next, OpenListT& open_w2_next) {
+		// All tuples of a state that was already seen are already in the novelty tables, and all subgoals it
+		// satisfies are already reached, hence the state would be pruned anyway, and we can skip its evaluation.
+		if (_config._detect_duplicates && !_seen.insert(s_a.hash())) {
+			_stats.sim_duplicate();
+			return false;
+		}
+		
+		NodePT successor = make_node(std::move(s_a), a, current, _generated++);
+		
+		unsigned char novelty = _evaluator.evaluate(*successor);
+		update_novelty_counters_on_generation(novelty);
+		
+		// LPT_INFO("cout", "Simulation - Node generated: " << *successor);
+		
+		// A node becomes the optimal path to some subgoal iff the subgoal was unreached until now
+		const std::size_t unreached = _unreached.size();
+		if (process_node(successor)) {  // i.e. all subgoals have been reached before reaching the bound
+			return true;
+		}
+		
+		if (novelty <= max_width && novelty == 1) open_w1_next.insert(successor);
+		else if (novelty <= max_width && novelty == 2) open_w2_next.insert(successor);
+		else if (_unreached.size() == unreached) { // The node is pruned and referenced nowhere, hence we can reuse its memory
+			_nodes.discard(successor);
+			return false;
+		}
+		
+		_store.encode(*successor, state);
+		return false;
+	}
+	
+	//! Expand all nodes in the given queues, i.e. the current layer of the simulation, generating the successors of
+	//! each block of nodes in parallel. Novelty tables, goal checks and queues are however only updated in a sequential
+	//! merge step, which processes the successors in the exact order in which a sequential run would generate them.
+	//! This ensures that the result of the simulation (and hence the set R) does not depend on the number of threads.
+	//! Returns true iff all subgoals have been reached, in which case the expansion stops at the same point that
+	//! it would in a sequential run.
+	bool expand_layer_in_parallel(OpenListT& open_w1, OpenListT& open_w2, OpenListT& open_w1_next, OpenListT& open_w2_next, unsigned max_width) {
+		// The sequential run expands all nodes of novelty 1 in the layer before those of novelty 2
+		while (!open_w1.empty()) _layer.push_back(open_w1.next());
+		while (!open_w2.empty()) _layer.push_back(open_w2.next());
+		
+		// We bound the number of successors held in memory at the same time by expanding the layer in blocks
+		const std::size_t block_size = BLOCK_NODES_PER_THREAD * _pool->size();
+		if (_successors.size() < block_size) {
+			_successors.resize(block_size);
+			_rebuilt.resize(block_size);
+			_layer_states.resize(block_size);
+		}
+		
+		bool solved = false;
+		for (std::size_t start = 0; start < _layer.size() && !solved; start += block_size) {
+			const std::size_t size = std::min(block_size, _layer.size() - start);
+			
+			// Delta-encoded states need to be rebuilt (and copied out of the cache of the store) beforehand,
+			// since the store is not thread-safe
+			for (std::size_t k = 0; k < size; ++k) {
+				const NodePT& node = _layer[start + k];
+				_rebuilt[k] = boost::none;
+				if (!node->_state) _rebuilt[k].emplace(node->state());
+				_layer_states[k] = node->_state ? &(*node->_state) : &(*_rebuilt[k]);
+			}
+			
+			_pool->parallel_for(size, [this](std::size_t k) {
+				const StateT& state = *_layer_states[k];
+				auto& successors = _successors[k];
+				for (const auto& a : _model.applicable_actions(state)) {
+					successors.emplace_back(a, _model.next(state, a));
+				}
+			});
+			
+			// The merge step
+			for (std::size_t k = 0; k < size; ++k) {
+				if (!solved) {
+					const NodePT& current = _layer[start + k];
+					update_novelty_counters_on_expansion(current->_w);
+					for (auto& successor:_successors[k]) {
+						solved = generate(current, *_layer_states[k], successor.first, std::move(successor.second), max_width, open_w1_next, open_w2_next);
+						if (solved) break;
+					}
+				}
+				_successors[k].clear();
+				_rebuilt[k] = boost::none;
+			}
+		}
+		
+		_layer.clear();
+		return solved;
+	}
+	
 	void update_novelty_counters_on_expansion(unsigned char novelty) {
 		if (novelty == 1) ++_w1_nodes_expanded;
 		else if (novelty== 2) ++_w2_nodes_expanded;
@@ -764,12 +947,20 @@ public:
 	}
 
 protected:
+	
+	inline bool in_seed(unsigned subgoal_idx) const { return _in_seed[subgoal_idx] == _run; }
+	
+	//! Create a node on the node pool of the simulation
+	template <typename... Args>
+	NodePT make_node(Args&&... args) {
+		return _nodes.create(std::forward<Args>(args)...);
+	}
 
 	//! Returns true iff all goal atoms have been reached in the IW search
 	bool process_node(NodePT& node) {
 		if (_config._complete) return process_node_complete(node);
 		
-		const StateT& state = node->state;
+		const StateT& state = node->state();
 
 		// We iterate through the indexes of all those goal atoms that have not yet been reached in the IW search
 		// to check if the current node satisfies any of them - and if it does, we mark it appropriately.
@@ -791,10 +982,10 @@ protected:
 	
 	//! Returns true iff all goal atoms have been reached in the IW search
 	bool process_node_complete(NodePT& node) {
-		const StateT& state = node->state;
+		const StateT& state = node->state();
 
 		for (unsigned i = 0; i < _model.num_subgoals(); ++i) {
-			if (!_in_seed[i] && _model.goal(state, i)) {
+			if (!in_seed(i) && _model.goal(state, i)) {
 // 				node->satisfies_subgoal = true;
 				if (!_optimal_paths[i]) _optimal_paths[i] = node;
 				_unreached.erase(i);
@@ -805,12 +996,11 @@ protected:
 	}
 	
 	void mark_seed_subgoals(const NodePT& node) {
-		std::vector<bool> _(_model.num_subgoals(), false);
-		_in_seed.swap(_);
+		++_run;
 		_unreached.clear();
 		for (unsigned i = 0; i < _model.num_subgoals(); ++i) {
-			if (_model.goal(node->state, i)) {
-				_in_seed[i] = true;
+			if (_model.goal(node->state(), i)) {
+				_in_seed[i] = _run;
 			} else {
 				_unreached.insert(i);
 			}
@@ -0,0 +1,55 @@
+
+#pragma once
+
+#include <state_registry.hxx>
+#include "state_cache.hxx"
+#include "stats.hxx"
+
+
+namespace fs0 { namespace bfws {
+
+//! A store of the states of search nodes, which keep only the (4-byte) ID of their state in a StateRegistry.
+//! Full states are unpacked from the registry on demand, and a small StateCache holds the most recently used ones.
+template <typename StateT>
+class RegistryStateStore {
+protected:
+	StateRegistry _registry;
+
+	//! A cache of unpacked states, indexed by their ID + 1, since the cache does not accept a zero key.
+	StateCache<StateT> _cache;
+
+	BFWSStats& _stats;
+
+public:
+	RegistryStateStore(const StateAtomIndexer& indexer, const ProblemInfo& info, BFWSStats& stats) :
+		_registry(indexer, info), _cache(), _stats(stats)
+	{}
+
+	RegistryStateStore(const RegistryStateStore&) = delete;
+	RegistryStateStore(RegistryStateStore&&) = default;
+	RegistryStateStore& operator=(const RegistryStateStore&) = delete;
+	RegistryStateStore& operator=(RegistryStateStore&&) = delete;
+
+	//! Register the given state. Returns the ID of the state and whether the state was newly registered.
+	//! The state is additionally placed on the cache, since it will most likely be accessed right away.
+	std::pair<StateID, bool> insert(StateT&& state) {
+		auto inserted = _registry.insert(state);
+		if (_cache.find(inserted.first + 1) == StateCache<StateT>::NOT_FOUND) {
+			_cache.insert(inserted.first + 1, std::move(state));
+		}
+		return inserted;
+	}
+
+	//! Return the state with the given ID, unpacking it from the registry if necessary.
+	//! The returned reference is valid at least until the second subsequent call to this method.
+	const StateT& get(StateID id) {
+		unsigned cached = _cache.find(id + 1);
+		if (cached != StateCache<StateT>::NOT_FOUND) return _cache.get(cached);
+		_stats.registry_state_unpacked();
+		return _cache.insert(id + 1, _registry.get(id));
+	}
+
+	const StateRegistry& registry() const { return _registry; }
+};
+
+} } // namespaces
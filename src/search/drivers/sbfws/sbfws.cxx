@@ -49,7 +49,12 @@ SBFWSDriver<StateModelT>::do_search(const StateModelT& model, const Config& conf
 		}
 	}
 	
-	if (indexer.is_fully_binary()) { // The state is fully binary
+	if (indexer.is_packed()) { // Packed states offer no direct access to the underlying vectors of values
+		LPT_INFO("cout", "FEATURE EVALUATION: Packed state, using a generic StraightHybridFeatureSetEvaluator");
+		using FeatureEvaluatorT = lapkt::novelty::StraightHybridFeatureSetEvaluator;
+		return do_search1<FSMultivaluedNoveltyEvaluatorI, FeatureEvaluatorT>(model, FeatureEvaluatorT(), config, out_dir, start_time);
+		
+	} else if (indexer.is_fully_binary()) { // The state is fully binary
 		LPT_INFO("cout", "FEATURE EVALUATION: Using the specialized StraightFeatureSetEvaluator<bin>");
 		using FeatureEvaluatorT = lapkt::novelty::StraightFeatureSetEvaluator<bool>;
 		return do_search1<FSBinaryNoveltyEvaluatorI, FeatureEvaluatorT>(model, FeatureEvaluatorT(), config, out_dir, start_time);
@@ -71,7 +76,7 @@ template <typename StateModelT>
 template <typename NoveltyEvaluatorT, typename FeatureEvaluatorT>
 ExitCode
 SBFWSDriver<StateModelT>::do_search1(const StateModelT& model, FeatureEvaluatorT&& featureset, const Config& config, const std::string& out_dir, float start_time) {
-	SBFWSConfig bfws_config(config);
+	SBFWSConfig bfws_config(config, _parallel);
 	
 	auto engine = create<StateModelT, FeatureEvaluatorT, NoveltyEvaluatorT>(config, std::move(featureset), bfws_config, model, _stats);
 	
@@ -2,13 +2,17 @@
 #pragma once
 
 #include <search/drivers/sbfws/iw_run.hxx>
+#include <search/drivers/sbfws/registry_state_store.hxx>
 #include <search/drivers/registry.hxx>
 #include <search/drivers/setups.hxx>
 #include <search/drivers/sbfws/base.hxx>
 #include <heuristics/unsat_goal_atoms.hxx>
+#include <problem_info.hxx>
+#include <utils/node_arena.hxx>
+#include <utils/thread_pool.hxx>
+#include <utils/cancellation.hxx>
 
 #include <lapkt/search/components/open_lists.hxx>
-#include <lapkt/search/components/stl_unordered_map_closed_list.hxx>
 
 #include "stats.hxx"
 
@@ -50,11 +54,16 @@ struct novelty_comparer {
 template <typename StateT, typename ActionT>
 class SBFWSNode {
 public:
-	using ptr_t = std::shared_ptr<SBFWSNode<StateT, ActionT>>;
+	//! Nodes are owned by the node pool of the search, hence we refer to them through plain pointers
+	using ptr_t = SBFWSNode<StateT, ActionT>*;
 	using action_t = typename ActionT::IdType;
+	using StoreT = RegistryStateStore<StateT>;
 	
-	//! The state corresponding to the search node
-	StateT state;
+	//! The ID of the state corresponding to the search node in the state registry
+	StateID _id;
+	
+	//! The store able to retrieve the state of the node from its ID
+	StoreT* _store;
 
 	//! The action that led to the state in this search node
 	action_t action;
@@ -94,12 +103,12 @@ public:
 	//! atoms in s with novelty 1.
 // 	std::vector<unsigned> _nov1atom_idxs;	
 	
-	//! Constructor with full copying of the state (expensive)
-	SBFWSNode(const StateT& s, unsigned long gen_order) : SBFWSNode(StateT(s), ActionT::invalid_action_id, nullptr, gen_order) {}
+	//! Constructor for the root node
+	SBFWSNode(StateID id, StoreT* store, uint32_t gen_order) : SBFWSNode(id, store, ActionT::invalid_action_id, nullptr, gen_order) {}
 
-	//! Constructor with move of the state (cheaper)
-	SBFWSNode(StateT&& _state, action_t action_, ptr_t parent_, uint32_t gen_order) :
-		state(std::move(_state)), action(action_), parent(parent_), g(parent ? parent->g+1 : 0),
+	SBFWSNode(StateID id, StoreT* store, action_t action_, ptr_t parent_, uint32_t gen_order) :
+		_id(id), _store(store),
+		action(action_), parent(parent_), g(parent ? parent->g+1 : 0),
 		unachieved_subgoals(std::numeric_limits<unsigned>::max()),
 		_processed(false),
 		_gen_order(gen_order),
@@ -120,12 +129,17 @@ public:
 	
 	
 	bool has_parent() const { return parent != nullptr; }
+	
+	//! The state of the node, which might need to be unpacked from the state registry.
+	//! The returned reference is valid at least until the second subsequent call to this method on any node.
+	const StateT& state() const { return _store->get(_id); }
 
-	bool operator==( const SBFWSNode<StateT, ActionT>& o ) const { return state == o.state; }
+	//! Two nodes are equal iff their states are, i.e. iff they have the same state ID
+	bool operator==( const SBFWSNode<StateT, ActionT>& o ) const { return _id == o._id; }
 
 	bool dead_end() const { return false; }
 
-	std::size_t hash() const { return state.hash(); }
+	std::size_t hash() const { return _id; }
 
 	//! Print the node into the given stream
 	friend std::ostream& operator<<(std::ostream &os, const SBFWSNode<StateT, ActionT>& object) { return object.print(os); }
@@ -135,7 +149,7 @@ public:
 		if (_relevant_atoms) {
 			reached = std::to_string(_relevant_atoms->num_reached()) + " / " + std::to_string(_relevant_atoms->getHelper()._num_relevant);
 		}
-		os << "#" << _gen_order << " (" << this << "), " << state;
+		os << "#" << _gen_order << " (" << this << "), " << state();
 		os << ", g = " << g << ", w_g" << w_g <<  ", w_gr" << w_gr << ", #g=" << unachieved_subgoals << ", #r=" << reached;
 		os << ", parent = " << (parent ? "#" + std::to_string(parent->_gen_order) : "None");
 		os << ", decr(#g)= " << this->decreases_unachieved_subgoals();
@@ -197,6 +211,10 @@ protected:
 
 	SBFWSConfig _sbfwsconfig;
 	
+	//! The simulation engine, which is created on the first computation of a set R, and reused
+	//! (together with its novelty tables, node memory, etc.) on all subsequent computations.
+	std::unique_ptr<SimulationT> _simulator;
+	
 	
 public:
 	SBFWSHeuristic(const SBFWSConfig& config, const Config& c, const StateModelT& model, const FeatureSetT& features, BFWSStats& stats) :
@@ -214,7 +232,8 @@ public:
 				   config.simulation_width,
 					c),
 		_stats(stats),
-		_sbfwsconfig(config)
+		_sbfwsconfig(config),
+		_simulator(nullptr)
 	{
 	}
 
@@ -234,6 +253,19 @@ public:
 		return nov;
 	}
 
+	//! As above, with the feature valuations of the node and of its parent already computed, e.g. concurrently with
+	//! those of other nodes. The parent valuation is only read if the node has a parent of the same novelty type.
+	template <typename NodeT, typename ValuationT>
+	unsigned evaluate_wg1(NodeT& node, const ValuationT& valuation, const ValuationT& parent_valuation) {
+		unsigned type = node.unachieved_subgoals;
+		NoveltyEvaluatorT* evaluator = fetch_evaluator(_wg_novelty_evaluators[1], 1, type);
+		bool same_type = node.has_parent() && type == node.parent->unachieved_subgoals;
+		unsigned nov = same_type ? evaluator->evaluate(valuation, parent_valuation, 1) : evaluator->evaluate(valuation, 1);
+		assert(node.w_g == Novelty::Unknown);
+		node.w_g = (nov == 1) ? Novelty::One : Novelty::GTOne;
+		return nov;
+	}
+
 	template <typename NodeT>
 	unsigned evaluate_wg2(NodeT& node) {
 		unsigned type = node.unachieved_subgoals;
@@ -327,10 +359,10 @@ public:
 
 		if (node.has_parent() && type == parent_type) {
 			// Important: the novel-based computation works only when the parent has the same novelty type and thus goes against the same novelty tables!!!
-			return evaluator->evaluate(_featureset.evaluate(node.state), _featureset.evaluate(node.parent->state), k);
+			return evaluator->evaluate(_featureset.evaluate(node.state()), _featureset.evaluate(node.parent->state()), k);
 		}
 
-		return evaluator->evaluate(_featureset.evaluate(node.state), k);
+		return evaluator->evaluate(_featureset.evaluate(node.state()), k);
 	}
 	
 	//! Compute the RelevantAtomSet that corresponds to the given node, and from which
@@ -349,18 +381,11 @@ public:
 
 			// Throw a simulation from the node, and compute a set R[IW1] from there.
 			bool verbose = !node.has_parent(); // Print info only on the s0 simulation
-			auto evaluator = _sim_novelty_factory.create_compound_evaluator(_sbfwsconfig.simulation_width);
-			// TODO Fix this horrible hack
-			if (_sbfwsconfig.simulation_width==2) { _stats.sim_table_created(1); _stats.sim_table_created(2); }
-			else  { assert(_sbfwsconfig.simulation_width); _stats.sim_table_created(1); }
-			
-			
-			SimulationT simulator(_model, _featureset, evaluator, _simconfig, _stats, verbose);
-			std::vector<bool> relevant = simulator.compute_R(node.state);
+			std::vector<bool> relevant = simulation_engine(verbose).compute_R(node.state());
 			
 			node._helper = new AtomsetHelper(_problem.get_tuple_index(), relevant);
 			node._relevant_atoms = new RelevantAtomSet(*node._helper);
-			node._relevant_atoms->init(node.state);
+			node._relevant_atoms->init(node.state());
 			
 			if (!node.has_parent()) { // Log some info, but only for the seed state
 				LPT_DEBUG("cout", "R(s_0)  (#=" << node._relevant_atoms->getHelper()._num_relevant << "): " << std::endl << *(node._relevant_atoms));
@@ -373,9 +398,9 @@ public:
 			node._relevant_atoms = new RelevantAtomSet(compute_R(*node.parent)); // This might trigger a recursive computation
 			
 			if (node.decreases_unachieved_subgoals()) {
- 				node._relevant_atoms->init(node.state); // THIS IS ABSOLUTELY KEY E.G. IN BARMAN
+ 				node._relevant_atoms->init(node.state()); // THIS IS ABSOLUTELY KEY E.G. IN BARMAN
 			} else {
-				node._relevant_atoms->update(node.state, nullptr);
+				node._relevant_atoms->update(node.state(), nullptr);
 				// node._relevant_atoms->update(node.state, &(node.parent->state));
 			}
 	}
@@ -383,13 +408,29 @@ public:
 		return *node._relevant_atoms;
 	}
 
+	//! Return the simulation engine, ready to perform a new simulation. The engine is created on the first call,
+	//! and reset on subsequent calls, which is much cheaper than allocating and zeroing all novelty tables anew.
+	SimulationT& simulation_engine(bool verbose) {
+		assert(_sbfwsconfig.simulation_width == 1 || _sbfwsconfig.simulation_width == 2);
+		if (!_simulator) {
+			auto evaluator = _sim_novelty_factory.create_compound_evaluator(_sbfwsconfig.simulation_width);
+			_simulator = std::unique_ptr<SimulationT>(new SimulationT(_model, _featureset, evaluator, _simconfig, _stats, verbose));
+			for (unsigned k = 1; k <= _sbfwsconfig.simulation_width; ++k) _stats.sim_table_created(k);
+		} else {
+			_simulator->reset();
+			_simulator->set_verbose(verbose);
+			for (unsigned k = 1; k <= _sbfwsconfig.simulation_width; ++k) _stats.sim_table_reused(k);
+		}
+		return *_simulator;
+	}
+
 	template <typename NodeT>
 	inline bool computation_of_R_necessary(const NodeT& node) const {
 		if (_sbfwsconfig.r_computation == SBFWSConfig::RComputation::Seed) return (!node.has_parent());
 		else return !node.has_parent() || node.decreases_unachieved_subgoals();
 	}
 	
-	unsigned compute_unachieved(const State& state) {
+	unsigned compute_unachieved(const State& state) const {
 		return _unsat_goal_atoms_heuristic.evaluate(state);
 	}
 
@@ -411,11 +452,25 @@ public:
 	using ActionIdT = typename ActionT::IdType;
 	using NodeT = SBFWSNode<fs0::State, ActionT>;
 	using PlanT =  std::vector<ActionIdT>;
-	using NodePT = std::shared_ptr<NodeT>;
-	using ClosedListT = aptk::StlUnorderedMapClosedList<NodeT>;
+	using NodePT = NodeT*;
+	using StoreT = typename NodeT::StoreT;
 	using HeuristicT = SBFWSHeuristic<StateModelT, SBFWSNoveltyIndexer, FeatureSetT, NoveltyEvaluatorT>;
 	using SimulationNodeT = typename HeuristicT::IWNodeT;
 	using SimulationNodePT = typename HeuristicT::IWNodePT;
+	using FeatureValuationT = std::vector<typename NoveltyEvaluatorT::FeatureValueT>;
+	
+	//! A successor generated in a parallel search, together with the parts of its evaluation that do not
+	//! depend on the novelty tables, i.e. whether it is a goal, its #g and its feature valuation
+	struct Successor {
+		Successor(const ActionIdT& action_, StateT&& state_) :
+			action(action_), state(std::move(state_)), goal(false), unachieved(0), valuation() {}
+		
+		ActionIdT action;
+		StateT state;
+		bool goal;
+		unsigned unachieved;
+		FeatureValuationT valuation;
+	};
 	
 
 protected:
@@ -433,6 +488,10 @@ protected:
 
 	//! The search model
 	const StateModelT& _model;
+	
+	//! The pool that owns all search nodes, which are destroyed with it.
+	//! Must be declared before any member holding nodes, so that it is destroyed after them.
+	utils::NodePool<NodeT> _nodes;
 
 	//! The solution node, if any. This will be set during the search process
 	NodePT _solution;
@@ -451,9 +510,6 @@ protected:
 	//! yet been processed.
 	UnachievedOpenList _qrest;
 
-	//! The closed list
-	ClosedListT _closed;
-
 	//! The novelty feature evaluator.
 	//! We hold the object here so that we can reuse the same featureset for search and simulations
 	FeatureSetT _featureset;
@@ -462,6 +518,15 @@ protected:
 	HeuristicT _heuristic;
 
 	BFWSStats& _stats;
+	
+	//! The store of the states of all generated nodes, which assigns them a StateID
+	StoreT _store;
+	
+	//! _closed[id] is true iff the state with the given ID has been closed, i.e. processed
+	std::vector<bool> _closed;
+	
+	//! _open[id] is the number of open lists (queues) where the node with the given state ID is
+	std::vector<uint8_t> _open;
 
 	//! Whether we want to prune those nodes with novelty w_{#g, #r} > 2 or not
 	bool _pruning;
@@ -475,6 +540,19 @@ protected:
 	//! How many novelty levels we want to use in the search.
 	unsigned _novelty_levels;
 	
+	//! The pool of threads that generate successors in parallel, if the search runs on more than one thread
+	std::unique_ptr<utils::ThreadPool> _pool;
+	
+	//! In a parallel search, the max. number of nodes that are selected from the queues and then expanded at once
+	unsigned _batch_size;
+	
+	//! The nodes of the current batch, a copy of their states, their feature valuations and the successors of each of them.
+	//! The buffers are kept across batches to avoid memory allocations.
+	std::vector<NodePT> _batch;
+	std::vector<StateT> _batch_states;
+	std::vector<FeatureValuationT> _batch_valuations;
+	std::vector<std::vector<Successor>> _successors;
+	
 public:
 
 	//!
@@ -485,15 +563,33 @@ public:
           SBFWSConfig& conf) :
              
 		_model(model),
+		_nodes(),
 		_solution(nullptr),
 		_featureset(std::move(featureset)),
 		_heuristic(conf, config, model, _featureset, stats),
 		_stats(stats),
+		_store(model.getTask().getStateAtomIndexer(), ProblemInfo::getInstance(), stats),
+		_closed(),
+		_open(),
 		_pruning(config.getOption<bool>("bfws.prune", false)),
 		_generated(1),
 		_min_subgoals_to_reach(std::numeric_limits<unsigned>::max()),
-		_novelty_levels(setup_novelty_levels(model, config))
+		_novelty_levels(setup_novelty_levels(model, config)),
+		_pool(),
+		_batch_size(std::max(1u, config.getOption<unsigned>("bfws.batch", 4 * conf.threads))),
+		_batch(),
+		_batch_states(),
+		_batch_valuations(),
+		_successors()
 	{
+		if (conf.threads > 1) {
+			if (StateModelT::is_reentrant()) {
+				LPT_INFO("cout", "Parallel search: generating successors on " << conf.threads << " threads, in batches of up to " << _batch_size << " nodes");
+				_pool = std::unique_ptr<utils::ThreadPool>(new utils::ThreadPool(conf.threads));
+			} else {
+				LPT_INFO("cout", "The state model does not support concurrent successor generation, running the search sequentially");
+			}
+		}
 	}
 
 	~SBFWS() = default;
@@ -537,7 +633,7 @@ public:
 	bool solve_model(PlanT& solution) { return search(_model.init(), solution); }
 
 	bool search(const StateT& s, PlanT& plan) {
-		NodePT root = std::make_shared<NodeT>(s, ++_generated);
+		NodePT root = make_node(register_state(StateT(s)).first, &_store, ++_generated);
 		create_node(root);
 		assert(_q1.size()==1); // The root node must necessarily have novelty 1
 		
@@ -551,8 +647,12 @@ public:
 		_solution = nullptr; // Make sure we start assuming no solution found
 
 		for (bool remaining_nodes = true; !_solution && remaining_nodes;) {
-			remaining_nodes = process_one_node();
+			utils::CancellationToken::check();
+			remaining_nodes = _pool ? process_one_batch() : process_one_node();
 		}
+		
+		_stats.set_registry_size(_store.registry().size(), _store.registry().bytes());
+		_stats.search_arena_size(_nodes.reserved_bytes());
 
 		return extract_plan(_solution, plan);
 	}
@@ -566,7 +666,7 @@ protected:
 		///// Q1 QUEUE /////
 		// First process nodes with w_{#g}=1
 		if (!_q1.empty()) {
-			NodePT node = _q1.next();
+			NodePT node = dequeue(_q1);
 			process_node(node);
 			_stats.wg1_node();
 			return true;
@@ -575,7 +675,7 @@ protected:
 		///// QWGR1 QUEUE /////
 		// Check whether there are nodes with w_{#g, #r} = 1
 		if (!_qwgr1.empty()) {
-			NodePT node = _qwgr1.next();
+			NodePT node = dequeue(_qwgr1);
 
 			// Compute wgr1 (this will compute #r lazily if necessary), and if novelty is one, expand the node.
 			// Note that we _need_ to process the node through the wgr1 tables even if the node itself
@@ -598,7 +698,7 @@ protected:
 		///// QWGR2 QUEUE /////
 		// Check whether there are nodes with w_{#g, #r} = 2
 		if (_novelty_levels == 3 && !_qwgr2.empty()) {
-			NodePT node = _qwgr2.next();
+			NodePT node = dequeue(_qwgr2);
 
 			// unsigned nov = _heuristic.evaluate_wg2(*node);
 			unsigned nov = _heuristic.evaluate_wgr2(*node);
@@ -623,7 +723,7 @@ protected:
 		// that will thus have more priority than the rest of nodes in this queue.
 		if (!_qrest.empty()) {
 			LPT_EDEBUG("multiqueue-search", "Expanding one remaining node with w_{#g, #r} > 2");
-			NodePT node = _qrest.next();
+			NodePT node = dequeue(_qrest);
 			if (!node->_processed) {
 				_stats.wgr_gt2_node();
 				process_node(node);
@@ -634,9 +734,100 @@ protected:
 		return false;
 	}
 	
+	//! Select nodes from the queues, as process_one_node would, until a full batch of nodes to be expanded
+	//! has been selected or the queues are empty, and expand all nodes of the batch at once.
+	//! Since nodes generated from the batch can only be selected in subsequent batches, the order
+	//! in which nodes are expanded only approximates the one of the sequential search.
+	//! Returns true if some action has been performed, false if all queues were empty
+	bool process_one_batch() {
+		bool remaining_nodes = true;
+		while (_batch.size() < _batch_size && remaining_nodes) {
+			remaining_nodes = process_one_node();
+		}
+		
+		if (_batch.empty()) return remaining_nodes;
+		expand_batch();
+		return true;
+	}
+	
+	//! Generate and evaluate the successors of all nodes in the batch in parallel, and then create the successor nodes
+	//! sequentially, in the same order in which expand_node would create them for each node of the batch.
+	//! Each thread computes the goal check, #g and feature valuation of the successors of its nodes, which only read the
+	//! state; the novelty tables are then updated with those valuations in the sequential merge, hence novelty values
+	//! do not depend on the scheduling of the threads.
+	void expand_batch() {
+		const std::size_t size = _batch.size();
+		if (_successors.size() < size) _successors.resize(size);
+		if (_batch_valuations.size() < size) _batch_valuations.resize(size);
+		
+		// States returned by the store live in a cache of limited size, and the store is not thread-safe,
+		// hence we need to copy them beforehand
+		for (const NodePT& node:_batch) _batch_states.push_back(node->state());
+		
+		_pool->parallel_for(size, [this](std::size_t k) {
+			const StateT& state = _batch_states[k];
+			_batch_valuations[k] = _featureset.evaluate(state);
+			auto& successors = _successors[k];
+			for (const auto& action:_model.applicable_actions(state)) {
+				successors.emplace_back(action, _model.next(state, action));
+				Successor& successor = successors.back();
+				successor.goal = _model.goal(successor.state);
+				if (successor.goal) break; // The successors after a goal are never generated
+				successor.unachieved = _heuristic.compute_unachieved(successor.state);
+				successor.valuation = _featureset.evaluate(successor.state);
+			}
+		});
+		
+		for (std::size_t k = 0; k < size; ++k) {
+			if (!_solution) {
+				const NodePT& node = _batch[k];
+				LPT_DEBUG("cout", *node);
+				record_expansion(*node);
+				for (Successor& successor:_successors[k]) {
+					NodePT child = make_successor(node, successor.action, std::move(successor.state));
+					if (child && create_node(child, successor, _batch_valuations[k])) break;
+				}
+			}
+			_successors[k].clear();
+		}
+		
+		_batch.clear();
+		_batch_states.clear();
+	}
+	
+	//! Create a node on the node pool of the search
+	template <typename... Args>
+	NodePT make_node(Args&&... args) {
+		return _nodes.create(std::forward<Args>(args)...);
+	}
+
+	//! Insert the node into the given queue, keeping track of the number of queues where its state is
+	inline void enqueue(UnachievedOpenList& queue, const NodePT& node) {
+		queue.insert(node);
+		++_open[node->_id];
+	}
+
+	inline NodePT dequeue(UnachievedOpenList& queue) {
+		NodePT node = queue.next();
+		assert(_open[node->_id] > 0);
+		--_open[node->_id];
+		return node;
+	}
+
+	//! Register the given state, and return its ID and whether the state is new
+	std::pair<StateID, bool> register_state(StateT&& state) {
+		auto inserted = _store.insert(std::move(state));
+		if (inserted.second) {
+			_closed.push_back(false);
+			_open.push_back(0);
+			assert(_closed.size() == _store.registry().size());
+		}
+		return inserted;
+	}
+
 	inline void handle_unprocessed_node(const NodePT& node, bool is_last_queue) {
 		if (is_last_queue && !_pruning) {
-			_qrest.insert(node);
+			enqueue(_qrest, node);
 		}
 	}
 
@@ -645,28 +836,41 @@ protected:
 	//! if that is the case, we insert it into a special queue.
 	//! Returns true iff the newly-created node is a solution
 	bool create_node(const NodePT& node) {
-		if (is_goal(node)) {
-			LPT_INFO("cout", "Goal node was found");
-			_solution = node;
-			return true;
-		}
-		node->unachieved_subgoals = _heuristic.compute_unachieved(node->state);
-		
+		if (is_goal(node)) return set_solution(node);
+		node->unachieved_subgoals = _heuristic.compute_unachieved(node->state());
+		_heuristic.evaluate_wg1(*node);
+		return open_node(node);
+	}
+	
+	//! As above, for a successor node whose goal check, #g and feature valuation have already been computed
+	bool create_node(const NodePT& node, const Successor& successor, const FeatureValuationT& parent_valuation) {
+		if (successor.goal) return set_solution(node);
+		node->unachieved_subgoals = successor.unachieved;
+		_heuristic.evaluate_wg1(*node, successor.valuation, parent_valuation);
+		return open_node(node);
+	}
+	
+	bool set_solution(const NodePT& node) {
+		LPT_INFO("cout", "Goal node was found");
+		_solution = node;
+		return true;
+	}
+	
+	//! Insert a node whose #g and w_{#g} have already been computed into the appropriate queues
+	bool open_node(const NodePT& node) {
 		if (node->unachieved_subgoals < _min_subgoals_to_reach) {
 			_min_subgoals_to_reach = node->unachieved_subgoals;
 			LPT_INFO("cout", "Min. # unreached subgoals: " << _min_subgoals_to_reach << "/" << _model.num_subgoals());
 		}
 
-		// Now insert the node into the appropriate queues
-		_heuristic.evaluate_wg1(*node);
 		if (node->w_g == Novelty::One) {
-			_q1.insert(node);
+			enqueue(_q1, node);
 		}
 
-		_qwgr1.insert(node); // The node is surely pending evaluation in the w_{#g,#r}=1 tables
+		enqueue(_qwgr1, node); // The node is surely pending evaluation in the w_{#g,#r}=1 tables
 		
 		if (_novelty_levels == 3) {
-			_qwgr2.insert(node); // The node is surely pending evaluation in the w_{#g,#r}=2 tables
+			enqueue(_qwgr2, node); // The node is surely pending evaluation in the w_{#g,#r}=2 tables
 		}
 
 		_stats.generation();
@@ -675,43 +879,58 @@ protected:
 		return false;
 	}
 
-	//! Process the node. Return true iff at least one node was created during the processing.
+	//! Process the node. In a parallel search, the node is only added to the current batch, and expanded later with the rest of the batch.
 	void process_node(const NodePT& node) {
 		//assert(!node->_processed); // Don't process a node twice!
 		node->_processed = true; // Mark the node as processed
-		_closed.put(node);
-		expand_node(node);
+		_closed[node->_id] = true;
+		if (_pool) _batch.push_back(node);
+		else expand_node(node);
 	}
 
-	// Return true iff at least one node was created
 	void expand_node(const NodePT& node) {
 		LPT_DEBUG("cout", *node);
-		_stats.expansion();
-		if (node->decreases_unachieved_subgoals()) _stats.expansion_g_decrease();
+		record_expansion(*node);
 
-		for (const auto& action:_model.applicable_actions(node->state)) {
-			// std::cout << *(Problem::getInstance().getGroundActions()[action]) << std::endl;
-			StateT s_a = _model.next(node->state, action);
-			NodePT successor = std::make_shared<NodeT>(std::move(s_a), action, node, ++_generated);
-
-			if (_closed.check(successor)) continue; // The node has already been closed
-			if (is_open(successor)) continue; // The node is currently on (some) open list, so we ignore it
+		// States returned by the store live in a cache of limited size, hence we need to copy it
+		const StateT state(node->state());
 
-			if (create_node(successor)) {
-				break;
-			}
+		for (const auto& action:_model.applicable_actions(state)) {
+			// std::cout << *(Problem::getInstance().getGroundActions()[action]) << std::endl;
+			if (generate(node, action, _model.next(state, action))) break;
 		}
 	}
+	
+	void record_expansion(const NodeT& node) {
+		_stats.expansion();
+		if (node.decreases_unachieved_subgoals()) _stats.expansion_g_decrease();
+	}
+	
+	//! Create the successor of the given node with the given state, unless the state is a duplicate.
+	//! Returns true iff the successor is a solution
+	bool generate(const NodePT& node, const ActionIdT& action, StateT&& state) {
+		NodePT successor = make_successor(node, action, std::move(state));
+		return successor && create_node(successor);
+	}
+	
+	//! Register the successor state of the given node, and create a node for it, unless the state is a duplicate,
+	//! in which case null is returned
+	NodePT make_successor(const NodePT& node, const ActionIdT& action, StateT&& state) {
+		StateID id = register_state(std::move(state)).first;
 
-	bool is_open(const NodePT& node) const {
-		return _q1.contains(node) ||
-		       _qwgr1.contains(node) ||
-		       _qwgr2.contains(node) ||
-		       _qrest.contains(node);
+		// Skip the successor if its state has already been closed or is currently on (some) open list
+		if (_closed[id] || is_open(id)) {
+			_stats.duplicate();
+			return nullptr;
+		}
+
+		return make_node(id, &_store, action, node, ++_generated);
 	}
 
+	inline bool is_open(StateID id) const { return _open[id] > 0; }
+
 	inline bool is_goal(const NodePT& node) const {
-		return _model.goal(node->state);
+		return _model.goal(node->state());
 	}
 
 	//! Returns true iff there is an actual plan (i.e. because the given solution node is non-null)
@@ -751,10 +970,16 @@ class SBFWSDriver : public drivers::Driver {
 public:
 	using StateT = typename StateModelT::StateT;
 	
+	//! A parallel driver generates the successors of the search nodes on several threads
+	explicit SBFWSDriver(bool parallel = false) : _parallel(parallel) {}
+	
 	//! The necessary search method
 	ExitCode search(Problem& problem, const Config& config, const std::string& out_dir, float start_time) override;
 
 protected:
+	//! Whether to run a parallel search
+	bool _parallel;
+	
 	//! The stats of the search
 	BFWSStats _stats;
 
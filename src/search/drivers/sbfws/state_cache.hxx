@@ -0,0 +1,81 @@
+
+#pragma once
+
+#include <vector>
+#include <boost/optional.hpp>
+
+
+namespace fs0 { namespace bfws {
+
+//! A small ring of full states that have been rebuilt from some compact representation, indexed by some
+//! 32-bit key, e.g. a node generation order or a state ID.
+template <typename StateT>
+class StateCache {
+public:
+	//! The number of states that we cache
+	static const unsigned SIZE = 8;
+
+	//! Keys are assumed to never take this value, which marks empty positions of the cache
+	static const uint32_t INVALID_KEY = 0;
+
+	//! The value returned by 'find' when the key is not in the cache
+	static const unsigned NOT_FOUND = SIZE;
+
+protected:
+	//! A ring of <key, state> pairs. States are held in optionals, since they cannot be assigned to.
+	std::vector<std::pair<uint32_t, boost::optional<StateT>>> _ring;
+
+	//! The position of the ring where the next state will be placed
+	unsigned _next;
+
+	//! The position of the ring of the last returned state, which we never overwrite right away,
+	//! so that the reference returned by a call to 'get' or 'insert' remains valid after a second call.
+	unsigned _last;
+
+public:
+	StateCache() : _ring(SIZE), _next(0), _last(SIZE) { clear(); }
+
+	//! Returns the position of the given key in the cache, or NOT_FOUND
+	unsigned find(uint32_t key) const {
+		for (unsigned i = 0; i < SIZE; ++i) {
+			if (_ring[i].first == key) return i;
+		}
+		return NOT_FOUND;
+	}
+
+	//! Returns the state at the given position of the cache
+	const StateT& get(unsigned position) {
+		assert(position < SIZE && _ring[position].second);
+		_last = position;
+		return *_ring[position].second;
+	}
+
+	//! Returns the state at the given position of the cache, without counting it as returned
+	const StateT& peek(unsigned position) const {
+		assert(position < SIZE && _ring[position].second);
+		return *_ring[position].second;
+	}
+
+	const StateT& insert(uint32_t key, StateT&& state) {
+		assert(key != INVALID_KEY);
+		if (_next == _last) _next = (_next + 1) % SIZE;
+		auto& elem = _ring[_next];
+		elem.first = key;
+		elem.second = boost::none;
+		elem.second.emplace(std::move(state));
+		_last = _next;
+		_next = (_next + 1) % SIZE;
+		return *elem.second;
+	}
+
+	void clear() {
+		for (auto& elem:_ring) {
+			elem.first = INVALID_KEY;
+			elem.second = boost::none;
+		}
+		_next = 0;
+		_last = SIZE;
+	}
+};
+
+} } // namespaces
@@ -8,13 +8,36 @@
 
 namespace fs0 { namespace bfws {
 
-BFWSStats::BFWSStats() : _expanded(0), _generated(0), _evaluated(0),
+BFWSStats::BFWSStats() : _expanded(0), _generated(0), _evaluated(0), _simulations(0),
 	_initial_reachable_subgoals(std::numeric_limits<unsigned>::max()),
 	_max_reachable_subgoals(0),
 	_sum_reachable_subgoals(0),
 	_initial_relevant_atoms(std::numeric_limits<unsigned>::max()),
 	_max_relevant_atoms(0),
-	_sum_relevant_atoms(0)
+	_sum_relevant_atoms(0),
+	_r_type(0),
+	_num_wg1_nodes(0),
+	_num_wgr1_nodes(0),
+	_num_wg1_5_nodes(0),
+	_num_wgr2_nodes(0),
+	_num_wgr_gt2_nodes(0),
+	_num_expanded_g_decrease(0),
+	_num_generated_g_decrease(0),
+	_reused_simulation_nodes(0),
+	_delta_encoded_nodes(0),
+	_delta_rebuilt_states(0),
+	_delta_cache_hits(0),
+	_duplicates(0),
+	_registered_states(0),
+	_registry_bytes(0),
+	_registry_unpacked_states(0),
+	_search_arena_bytes(0),
+	_max_sim_arena_bytes(0),
+	_sim_duplicates(0),
+	_max_sim_seen_bytes(0),
+	_sim_expanded_nodes(0),
+	_sim_generated_nodes(0),
+	_sim_time(0)
 {}
 
 std::string
@@ -59,6 +82,21 @@ std::vector<BFWSStats::DataPointT> BFWSStats::dump() const {
 		
 		std::make_tuple("sim_avg_reached_subgoals", "Avg. number of subgoals reached during simulations", _avg(_sum_reachable_subgoals, _simulations)),
 		
+		std::make_tuple("delta_encoded_nodes", "Nodes with delta-encoded states", std::to_string(_delta_encoded_nodes)),
+		std::make_tuple("delta_rebuilt_states", "Delta-encoded states rebuilt", std::to_string(_delta_rebuilt_states)),
+		std::make_tuple("delta_cache_hits", "Delta-encoded states found in cache", std::to_string(_delta_cache_hits)),
+		
+		std::make_tuple("duplicates", "Generated states already open or closed", std::to_string(_duplicates)),
+		std::make_tuple("registered_states", "States in the state registry", std::to_string(_registered_states)),
+		std::make_tuple("registry_kb", "Memory of the state registry (kB)", std::to_string(_registry_bytes / 1024)),
+		std::make_tuple("registry_unpacked_states", "States unpacked from the state registry", std::to_string(_registry_unpacked_states)),
+		
+		std::make_tuple("search_arena_kb", "Memory of the search node arena (kB)", std::to_string(_search_arena_bytes / 1024)),
+		std::make_tuple("sim_arena_kb_max", "Max. memory of a simulation node arena (kB)", std::to_string(_max_sim_arena_bytes / 1024)),
+		
+		std::make_tuple("sim_duplicates", "Simulation states not re-evaluated since already seen", std::to_string(_sim_duplicates)),
+		std::make_tuple("sim_seen_kb_max", "Max. memory of the set of seen states of a simulation (kB)", std::to_string(_max_sim_seen_bytes / 1024)),
+		
 		std::make_tuple("reused_simulation_nodes", "Simulation nodes reused in the search", std::to_string(_reused_simulation_nodes)),
 		
 		std::make_tuple("r_type", "Type of R set", std::to_string(_r_type)),
@@ -76,6 +114,11 @@ std::vector<BFWSStats::DataPointT> BFWSStats::dump() const {
 		data.push_back(std::make_tuple("sim_w" + kstr + "_tables", "Number of width-" + kstr + " tables created during simulation", std::to_string(_sim_wtables[k])));
 	}
 	
+	for (unsigned k = 1; k < _sim_wtables_reused.size(); ++k) {
+		std::string kstr = std::to_string(k);
+		data.push_back(std::make_tuple("sim_w" + kstr + "_tables_reused", "Number of times a width-" + kstr + " table was reused during simulation", std::to_string(_sim_wtables_reused[k])));
+	}
+	
 	for (unsigned k = 1; k < _search_wtables.size(); ++k) {
 		std::string kstr = std::to_string(k);
 		data.push_back(std::make_tuple("search_w" + kstr + "_tables", "Number of width-" + kstr + " tables created during search", std::to_string(_search_wtables[k])));
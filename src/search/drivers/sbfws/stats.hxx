@@ -33,11 +33,33 @@ public:
 		++_sim_wtables[k];
 	}
 	
+	void sim_table_reused(unsigned k) {
+		if (k >= _sim_wtables_reused.size()) _sim_wtables_reused.resize(k+1);
+		++_sim_wtables_reused[k];
+	}
+	
 	void search_table_created(unsigned k) {
 		if (k >= _search_wtables.size()) _search_wtables.resize(k+1);
 		++_search_wtables[k];
 	}	
 	
+	void delta_encoded_node() { ++_delta_encoded_nodes; }
+	void delta_state_rebuilt() { ++_delta_rebuilt_states; }
+	void delta_cache_hit() { ++_delta_cache_hits; }
+	
+	void duplicate() { ++_duplicates; }
+	void registry_state_unpacked() { ++_registry_unpacked_states; }
+	void set_registry_size(unsigned long states, unsigned long bytes) {
+		_registered_states = states;
+		_registry_bytes = bytes;
+	}
+	
+	void search_arena_size(unsigned long bytes) { _search_arena_bytes = bytes; }
+	void sim_arena_size(unsigned long bytes) { _max_sim_arena_bytes = std::max(bytes, _max_sim_arena_bytes); }
+	
+	void sim_duplicate() { ++_sim_duplicates; }
+	void sim_seen_set_size(unsigned long bytes) { _max_sim_seen_bytes = std::max(bytes, _max_sim_seen_bytes); }
+	
 	void expansion_g_decrease() { ++_num_expanded_g_decrease; }
 	void generation_g_decrease() { ++_num_generated_g_decrease; }
 
@@ -99,12 +121,29 @@ protected:
 	
 	unsigned _reused_simulation_nodes;
 	
+	unsigned long _delta_encoded_nodes; // The number of simulation nodes that keep only a changeset wrt their parent
+	unsigned long _delta_rebuilt_states; // The number of times that the state of a delta-encoded node had to be rebuilt
+	unsigned long _delta_cache_hits; // The number of times that the state of a delta-encoded node was found already rebuilt
+	
+	unsigned long _duplicates; // The number of generated search states that were already open or closed
+	unsigned long _registered_states; // The number of distinct states in the state registry of the search
+	unsigned long _registry_bytes; // The memory taken by the state registry of the search
+	unsigned long _registry_unpacked_states; // The number of times that a state had to be unpacked from the registry
+	
+	unsigned long _search_arena_bytes; // The memory reserved by the node arena of the search
+	unsigned long _max_sim_arena_bytes; // The max. memory reserved by the node arena of any simulation
+	
+	unsigned long _sim_duplicates; // The number of states generated in simulations whose evaluation was skipped because they had already been seen
+	unsigned long _max_sim_seen_bytes; // The max. memory taken by the set of seen states of any simulation
+	
 	unsigned long _sim_expanded_nodes;
 	unsigned long _sim_generated_nodes;
 	float _sim_time;
 	
 	//! _sim_wtables[w] contains the number of width-w novelty tables created during simulation
 	std::vector<unsigned> _sim_wtables;
+	//! _sim_wtables_reused[w] contains the number of times that a width-w novelty table was reset and reused for a new simulation
+	std::vector<unsigned> _sim_wtables_reused;
 	std::vector<unsigned> _search_wtables;
 };
 
@@ -2,39 +2,67 @@
 #include <problem.hxx>
 #include <problem_info.hxx>
 #include <actions/grounding.hxx>
+#include <actions/reachability.hxx>
 #include <search/drivers/setups.hxx>
 #include <search/drivers/validation.hxx>
 #include <constraints/gecode/handlers/lifted_action_csp.hxx>
 #include <models/ground_state_model.hxx>
 
+#include <mutex>
+
 
 namespace fs0 { namespace drivers {
 
+// Several drivers might be set up concurrently on the same problem (e.g. within a portfolio),
+// hence each type of grounding is performed once and for all, and then shared by all of them
+static std::once_flag full_grounding, lifted_grounding;
+
+static void ground_fully(Problem& problem) {
+	std::call_once(full_grounding, [&problem]() {
+		// If the atom index was pruned by a reachability analysis, only the actions deemed reachable by it can be grounded
+		if (const RelaxedReachability* reachability = problem.get_reachability()) {
+			problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance(), *reachability));
+		} else {
+			problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+		}
+	});
+}
+
+static void ground_lifted(Problem& problem) {
+	if (problem.get_reachability()) {
+		throw std::runtime_error("The 'grounding.reachability' option is not supported by drivers that use lifted actions");
+	}
+	std::call_once(lifted_grounding, [&problem]() {
+		problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	});
+}
+
 LiftedStateModel 
 GroundingSetup::fully_lifted_model(Problem& problem) {
 	Validation::check_no_conditional_effects(problem);
 	
 	// We don't ground any action
-	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	ground_lifted(problem);
 	return LiftedStateModel::build(problem);
 }
 
 GroundStateModel
 GroundingSetup::fully_ground_model(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	ground_fully(problem);
 	return GroundStateModel(problem); 
 }
 
 SimpleStateModel
 GroundingSetup::fully_ground_simple_model(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	ground_fully(problem);
 	return SimpleStateModel::build(problem); 
 }
 
 GroundStateModel
 GroundingSetup::ground_search_lifted_heuristic(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	Validation::check_no_reachability_pruning(problem);
+	ground_fully(problem);
+	ground_lifted(problem);
 	return GroundStateModel(problem);
 }
 
@@ -7,6 +7,7 @@
 #include <heuristics/relaxed_plan/unreached_atom_rpg.hxx>
 #include <utils/support.hxx>
 #include <search/drivers/setups.hxx>
+#include <search/drivers/validation.hxx>
 #include <constraints/gecode/handlers/lifted_effect_unreached.hxx>
 
 
@@ -48,6 +49,7 @@ UnreachedAtomDriver<StateModelT>::create(const Config& config, const StateModelT
 template <>
 GroundStateModel
 UnreachedAtomDriver<GroundStateModel>::setup(Problem& problem) const {
+	Validation::check_no_reachability_pruning(problem);
 	return GroundingSetup::fully_ground_model(problem);
 }
 
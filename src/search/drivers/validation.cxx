@@ -16,5 +16,10 @@ void Validation::check_no_conditional_effects(const Problem& problem) {
 	}
 }
 
+void Validation::check_no_reachability_pruning(const Problem& problem) {
+	if (problem.get_reachability()) {
+		throw std::runtime_error("The 'grounding.reachability' option is not supported by drivers that use CSP-based heuristics");
+	}
+}
 
 } } // namespaces
@@ -9,6 +9,10 @@ namespace fs0 { namespace drivers {
 class Validation {
 public:
 	static void check_no_conditional_effects(const Problem& problem);
+	
+	//! CSP-based heuristics reason about the whole atom index and about the lifted action schemas, and hence
+	//! cannot be combined with the pruning of the atom index performed by the 'grounding.reachability' option
+	static void check_no_reachability_pruning(const Problem& problem);
 };
 
 } } // namespaces
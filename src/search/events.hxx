@@ -6,6 +6,7 @@
 #include <utils/printers/vector.hxx>
 #include <search/nodes/heuristic_search_node.hxx>
 #include <utils/config.hxx>
+#include <utils/cancellation.hxx>
 
 #include <lapkt/tools/events.hxx>
 #include <heuristics/relaxed_plan/smart_rpg.hxx>
@@ -64,6 +65,8 @@ protected:
 	}
 	
 	void expansion(lapkt::events::Subject&, const lapkt::events::Event& event) {
+		// This is the hook through which the LAPKT engines can be stopped when running in a portfolio
+		utils::CancellationToken::check();
 		_stats.expansion();
 		if (_verbose) {
 			LPT_DEBUG("search", std::setw(7) << "EXPAND: " << dynamic_cast<const ExpansionEvent&>(event).node);
@@ -4,6 +4,10 @@
 #include <tuple>
 #include <vector>
 
+#include <constraints/gecode/utils/csp_stats.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axiom_evaluation.hxx>
+
 namespace fs0 { 
 
 class SearchStats {
@@ -20,11 +24,41 @@ public:
 	
 	using DataPointT = std::tuple<std::string, std::string, std::string>;
 	std::vector<DataPointT> dump() const {
-		return {
+		std::vector<DataPointT> points{
 			std::make_tuple("expanded", "Expansions", std::to_string(expanded())),
 			std::make_tuple("generated", "Generations", std::to_string(generated())),
 			std::make_tuple("evaluated", "Evaluations", std::to_string(evaluated()))
 		};
+		
+		// The work done with Gecode spaces on the current thread, if any, e.g. by the CSP-based heuristics
+		const gecode::CSPStats& csp = gecode::CSPStats::instance();
+		if (csp.clones() > 0 || csp.clones_avoided() > 0 || csp.propagations() > 0) {
+			points.push_back(std::make_tuple("csp_clones", "Gecode spaces cloned", std::to_string(csp.clones())));
+			points.push_back(std::make_tuple("csp_clones_avoided", "Gecode clones avoided", std::to_string(csp.clones_avoided())));
+			points.push_back(std::make_tuple("csp_clone_time", "Gecode cloning time (s)", std::to_string(csp.clone_time())));
+			points.push_back(std::make_tuple("csp_propagations", "Gecode propagations", std::to_string(csp.propagations())));
+			points.push_back(std::make_tuple("csp_propagation_time", "Gecode propagation time (s)", std::to_string(csp.propagation_time())));
+		}
+		
+		// The use made of the caches of axiom values of all threads, if any, i.e. of the current thread and of the workers
+		// of any parallel search or heuristic, as well as of any other search run concurrently, e.g. in a portfolio
+		const language::fstrips::AxiomCache::Statistics axioms = language::fstrips::AxiomCache::totals();
+		unsigned long lookups = axioms.hits + axioms.misses;
+		if (lookups > 0) {
+			points.push_back(std::make_tuple("axiom_cache_hits", "Axiom values found in cache", std::to_string(axioms.hits)));
+			points.push_back(std::make_tuple("axiom_cache_misses", "Axiom values computed", std::to_string(axioms.misses)));
+			points.push_back(std::make_tuple("axiom_cache_hit_rate", "Axiom cache hit rate", std::to_string(((double) axioms.hits) / lookups)));
+			points.push_back(std::make_tuple("axiom_cache_invalidations", "Axiom cache invalidations", std::to_string(axioms.invalidations)));
+		}
+		
+		// The bottom-up evaluation of recursive axioms on all threads, if any, as for the axiom cache
+		const language::fstrips::AxiomEvaluator::Statistics evaluator = language::fstrips::AxiomEvaluator::totals();
+		if (evaluator.fixpoints > 0) {
+			points.push_back(std::make_tuple("axiom_fixpoints", "Recursive axiom fixpoints computed", std::to_string(evaluator.fixpoints)));
+			points.push_back(std::make_tuple("axiom_fixpoint_rounds", "Recursive axiom fixpoint rounds", std::to_string(evaluator.rounds)));
+			points.push_back(std::make_tuple("axiom_fixpoint_evaluations", "Recursive axiom candidate tuples evaluated", std::to_string(evaluator.evaluations)));
+		}
+		return points;
 	}
 	
 protected:
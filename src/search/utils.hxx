@@ -16,6 +16,7 @@
 #include <actions/checker.hxx>
 #include <utils/printers/printers.hxx>
 #include <utils/system.hxx>
+#include <utils/cancellation.hxx>
 
 
 namespace fs0 { namespace drivers {
@@ -50,7 +51,7 @@ static ExitCode do_search(SearchAlgorithmT& engine, const StateModelT& model, co
 	std::vector<typename StateModelT::ActionType::IdType> plan;
 	float t0 = aptk::time_used();
 	
-	bool solved = false, oom = false;
+	bool solved = false, oom = false, cancelled = false;
 	try {
 		solved = engine.solve_model( plan );
 	}
@@ -59,6 +60,11 @@ static ExitCode do_search(SearchAlgorithmT& engine, const StateModelT& model, co
 		LPT_INFO("cout", "FAILED TO ALLOCATE MEMORY");
 		oom = true;
 	}
+	catch (const utils::SearchCancelled& ex)
+	{
+		LPT_INFO("cout", "SEARCH CANCELLED");
+		cancelled = true;
+	}
 	
 	float search_time = aptk::time_used() - t0;
 	float total_planning_time = aptk::time_used() - start_time;
@@ -86,6 +92,7 @@ static ExitCode do_search(SearchAlgorithmT& engine, const StateModelT& model, co
 	json_out << "\t\"solved\": " << ( solved ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"valid\": " << ( valid ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"out_of_memory\": " << ( oom ? "true" : "false" ) << "," << std::endl;
+	json_out << "\t\"cancelled\": " << ( cancelled ? "true" : "false" ) << "," << std::endl;
 	json_out << "\t\"plan_length\": " << plan.size() << "," << std::endl;
 	json_out << "\t\"plan\": ";
 	PlanPrinter::print_json( plan, json_out);
@@ -115,6 +122,9 @@ static ExitCode do_search(SearchAlgorithmT& engine, const StateModelT& model, co
 	} else if (oom) {
 		LPT_INFO("cout", "Search Result: Out of memory. Peak memory: " << get_peak_memory_in_kb());
 		result = ExitCode::OUT_OF_MEMORY;
+	} else if (cancelled) {
+		LPT_INFO("cout", "Search Result: The search was cancelled before finding a plan.");
+		result = ExitCode::UNSOLVED_INCOMPLETE;
 	} else {
 		LPT_INFO("cout", "Search Result: No plan was found.");
 		result = ExitCode::UNSOLVABLE;
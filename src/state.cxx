@@ -1,4 +1,8 @@
 
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
 #include <boost/functional/hash.hpp>
 
 #include <state.hxx>
@@ -9,8 +13,75 @@
 namespace fs0 {
 
 
+PackedStateLayout::PackedStateLayout(const ProblemInfo& info) :
+	_slots(info.getNumVariables()), _num_words(0), _lane_counts(WORD_BITS+1, 0)
+{
+	// Compute the lane width of each variable from the bounds of its domain. Zero is always
+	// considered part of the domain, since it is the default value of any state variable.
+	std::vector<std::vector<VariableIdx>> by_width(WORD_BITS+1);
+	for (VariableIdx var = 0; var < info.getNumVariables(); ++var) {
+		Slot& slot = _slots[var];
+		if (info.isPredicativeVariable(var)) {
+			slot.offset = 0;
+			slot.mask = 1;
+			by_width[1].push_back(var);
+			continue;
+		}
+		
+		ObjectIdx lb = 0, ub = 0;
+		TypeIdx type = info.getVariableType(var);
+		if (info.isBoundedType(type)) {
+			const auto& bounds = info.getTypeBounds(type);
+			lb = std::min(lb, bounds.first);
+			ub = std::max(ub, bounds.second);
+		} else {
+			for (ObjectIdx o:info.getTypeObjects(type)) {
+				lb = std::min(lb, o);
+				ub = std::max(ub, o);
+			}
+		}
+		
+		uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(ub) - lb);
+		unsigned width = (range < (1ULL<<8)) ? 8 : ((range < (1ULL<<16)) ? 16 : 32);
+		slot.offset = lb;
+		slot.mask = (width == 32) ? 0xFFFFFFFFULL : ((1ULL << width) - 1);
+		by_width[width].push_back(var);
+	}
+	
+	// Place first all the boolean variables, then the narrowest lanes. Since all widths are powers of two,
+	// lanes are naturally aligned and never straddle words.
+	unsigned bit = 0;
+	for (unsigned width:{1, 8, 16, 32}) {
+		bit = ((bit + width - 1) / width) * width; // Align to the lane width
+		for (VariableIdx var:by_width[width]) {
+			_slots[var].word = bit / WORD_BITS;
+			_slots[var].shift = bit % WORD_BITS;
+			bit += width;
+		}
+		_lane_counts[width] = by_width[width].size();
+	}
+	_num_words = (bit + WORD_BITS - 1) / WORD_BITS;
+	
+	_zero.resize(_num_words, 0);
+	for (VariableIdx var = 0; var < _slots.size(); ++var) {
+		set(_zero, var, 0);
+	}
+}
+
+void PackedStateLayout::out_of_lane(VariableIdx variable, ObjectIdx value) {
+	throw std::out_of_range("Value " + std::to_string(value) + " out of the packed domain of state variable #" + std::to_string(variable));
+}
+
+std::ostream& PackedStateLayout::print(std::ostream& os) const {
+	os << "PackedStateLayout[" << _num_words << " words; ";
+	os << _lane_counts[1] << " bool vars; ";
+	os << _lane_counts[8] << "/" << _lane_counts[16] << "/" << _lane_counts[32] << " vars in 8/16/32-bit lanes]";
+	return os;
+}
+
+
 StateAtomIndexer*
-StateAtomIndexer::create(const ProblemInfo& info)
+StateAtomIndexer::create(const ProblemInfo& info, bool packed)
 {
 	unsigned n_vars = info.getNumVariables(), n_bool = 0, n_int = 0;
 	IndexT index;
@@ -24,11 +95,11 @@ StateAtomIndexer::create(const ProblemInfo& info)
 	}
 	assert(index.size() == n_vars && n_vars == n_bool + n_int);
 
-	return new StateAtomIndexer(std::move(index), n_bool, n_int);
+	return new StateAtomIndexer(std::move(index), n_bool, n_int, packed ? new PackedStateLayout(info) : nullptr);
 }
 
-StateAtomIndexer::StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int) :
-	_index(std::move(index)), _n_bool(n_bool), _n_int(n_int)
+StateAtomIndexer::StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int, const PackedStateLayout* packed) :
+	_index(std::move(index)), _n_bool(n_bool), _n_int(n_int), _packed(packed)
 {
 }
 
@@ -52,6 +123,8 @@ ObjectIdx
 StateAtomIndexer::get(const State& state, VariableIdx variable) const {
 	std::size_t n_vars = _index.size();
 	assert(variable < n_vars);
+	
+	if (_packed) return _packed->get(state._packed_values, variable);
 
 	// If the state is fully boolean or fully multivalued, we can optimize the operation,
 	// since the variable index will be exactly `variable`
@@ -64,6 +137,14 @@ StateAtomIndexer::get(const State& state, VariableIdx variable) const {
 	else return state._int_values[ind.second];
 }
 
+StateAtomIndexer::Location
+StateAtomIndexer::locate(VariableIdx variable) const {
+	assert(variable < _index.size());
+	if (_packed) return Location{Location::Storage::Packed, variable};
+	const IndexElemT& ind = _index[variable];
+	return Location{ind.first ? Location::Storage::Bool : Location::Storage::Int, ind.second};
+}
+
 void
 StateAtomIndexer::set(State& state, const Atom& atom) const { set(state, atom.getVariable(), atom.getValue()); }
 
@@ -72,9 +153,11 @@ StateAtomIndexer::set(State& state, VariableIdx variable, ObjectIdx value) const
 	std::size_t n_vars = _index.size();
 	assert(variable < n_vars);
 
+	if (_packed) _packed->set(state._packed_values, variable, value);
+
 	// If the state is fully boolean or fully multivalued, we can optimize the operation,
 	// since the variable index will be exactly `variable`
-	if (n_vars == _n_bool) state._bool_values[variable] = value;
+	else if (n_vars == _n_bool) state._bool_values[variable] = value;
 	else if (n_vars == _n_int) state._int_values[variable] = value;
 	else {
 		const IndexElemT& ind = _index[variable];
@@ -90,8 +173,11 @@ State* State::create(const StateAtomIndexer& index, unsigned numAtoms, const std
 
 State::State(const StateAtomIndexer& index, const std::vector<Atom>& atoms) :
 	_indexer(index),
-	_bool_values(index.num_bool(), 0),
-	_int_values(index.num_int(), 0)
+	_bool_values(index.is_packed() ? 0 : index.num_bool(), 0),
+	_int_values(index.is_packed() ? 0 : index.num_int(), 0),
+	_packed_values(index.is_packed() ? index.packed_layout().zero() : PackedT()),
+	_hash(0),
+	_stamp(next_stamp())
 {
 	// Note that those facts not explicitly set in the initial state will be initialized to 0, i.e. "false", which is convenient to us.
 	for (const Atom& atom:atoms) { // Insert all the elements of the vector
@@ -100,6 +186,25 @@ State::State(const StateAtomIndexer& index, const std::vector<Atom>& atoms) :
 	updateHash();
 }
 
+State::State(const StateAtomIndexer& index, const PackedStateLayout& layout, const PackedStateLayout::WordT* words) :
+	_indexer(index),
+	_bool_values(index.is_packed() ? 0 : index.num_bool(), 0),
+	_int_values(index.is_packed() ? 0 : index.num_int(), 0),
+	_packed_values(),
+	_hash(0),
+	_stamp(next_stamp())
+{
+	if (index.is_packed()) {
+		assert(index.packed_layout().num_words() == layout.num_words());
+		_packed_values.assign(words, words + layout.num_words());
+	} else {
+		for (VariableIdx var = 0; var < index.size(); ++var) {
+			_indexer.set(*this, var, layout.get(words, var));
+		}
+	}
+	updateHash();
+}
+
 State::State(const State& state, const std::vector<Atom>& atoms) :
 	State(state) {
 	accumulate(atoms);
@@ -121,12 +226,114 @@ State::getValue(const VariableIdx& variable) const {
 
 //! Applies the given changeset into the current state.
 void State::accumulate(const std::vector<Atom>& atoms) {
+	if (!atoms.empty()) _stamp = next_stamp();
+	if (_indexer.is_packed()) return accumulate_packed(atoms);
 	for (const Atom& fact:atoms) {
 		set(fact);
 	}
 	updateHash(); // Important to update the hash value after all the changes have been applied!
 }
 
+void State::copy_values(const State& state) {
+	assert(&_indexer == &state._indexer);
+	if (this == &state) return;
+	// Copy-assigning the vectors reuses their storage, as all states of the same indexer have the same size
+	_bool_values = state._bool_values;
+	_int_values = state._int_values;
+	_packed_values = state._packed_values;
+	_hash = state._hash;
+	_stamp = state._stamp;
+}
+
+void State::update(VariableIdx variable, ObjectIdx value) {
+	if (!_indexer.is_packed()) return _indexer.set(*this, variable, value);
+
+	const PackedStateLayout& layout = _indexer.packed_layout();
+	ObjectIdx old = layout.get(_packed_values, variable);
+	if (old == value) return;
+	_hash ^= PackedStateLayout::zobrist(variable, old) ^ PackedStateLayout::zobrist(variable, value);
+	layout.set(_packed_values, variable, value);
+}
+
+void State::apply_inplace(const State& state, const std::vector<Atom>& atoms) {
+	copy_values(state);
+	if (!atoms.empty()) _stamp = next_stamp();
+	for (const Atom& atom:atoms) {
+		update(atom.getVariable(), atom.getValue());
+	}
+	if (!_indexer.is_packed()) updateHash(); // Packed states have their hash updated incrementally
+	assert(_hash == computeHash());
+}
+
+void State::apply_inplace(const State& state, const VariableIdx* variables, const ObjectIdx* values, std::size_t size) {
+	copy_values(state);
+	if (size > 0) _stamp = next_stamp();
+	for (std::size_t i = 0; i < size; ++i) {
+		update(variables[i], values[i]);
+	}
+	if (!_indexer.is_packed()) updateHash();
+	assert(_hash == computeHash());
+}
+
+std::vector<Atom> State::diff(const State& other) const {
+	assert(&_indexer == &other._indexer);
+	std::vector<Atom> changeset;
+	
+	if (_indexer.is_packed()) { // Skip whole words of the packed representation when they are equal
+		const PackedStateLayout& layout = _indexer.packed_layout();
+		for (VariableIdx var = 0; var < _indexer.size(); ++var) {
+			unsigned w = layout.word(var);
+			if (_packed_values[w] == other._packed_values[w]) continue;
+			ObjectIdx value = layout.get(_packed_values, var);
+			if (value != layout.get(other._packed_values, var)) changeset.push_back(Atom(var, value));
+		}
+		return changeset;
+	}
+	
+	for (VariableIdx var = 0; var < _indexer.size(); ++var) {
+		ObjectIdx value = getValue(var);
+		if (value != other.getValue(var)) changeset.push_back(Atom(var, value));
+	}
+	return changeset;
+}
+
+void State::pack(const PackedStateLayout& layout, PackedStateLayout::WordT* words) const {
+	if (_indexer.is_packed()) { // Both layouts are computed from the same problem, hence are identical
+		assert(_packed_values.size() == layout.num_words());
+		std::copy(_packed_values.begin(), _packed_values.end(), words);
+		return;
+	}
+	
+	std::fill(words, words + layout.num_words(), 0);
+	for (VariableIdx var = 0; var < _indexer.size(); ++var) {
+		layout.set(words, var, getValue(var));
+	}
+}
+
+void State::accumulate_packed(const std::vector<Atom>& atoms) {
+	const PackedStateLayout& layout = _indexer.packed_layout();
+	for (const Atom& fact:atoms) {
+		VariableIdx var = fact.getVariable();
+		ObjectIdx old = layout.get(_packed_values, var), value = fact.getValue();
+		if (old == value) continue;
+		_hash ^= PackedStateLayout::zobrist(var, old) ^ PackedStateLayout::zobrist(var, value);
+		layout.set(_packed_values, var, value);
+	}
+	assert(_hash == computeHash());
+}
+
+uint64_t State::next_stamp() {
+	// Each thread hands out the stamps of a block reserved at once, so that threads seldom contend for the counter
+	static const uint64_t BLOCK_SIZE = 1 << 16;
+	static std::atomic<uint64_t> reserved(0);
+	static thread_local uint64_t next = 0, end = 0;
+	if (next == end) {
+		next = reserved.fetch_add(BLOCK_SIZE);
+		end = next + BLOCK_SIZE;
+	}
+	return ++next;
+}
+
 std::ostream& State::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "State";
@@ -148,6 +355,14 @@ std::ostream& State::print(std::ostream& os) const {
 
 
 std::size_t State::computeHash() const {
+	if (_indexer.is_packed()) {
+		std::size_t hash = 0;
+		for (VariableIdx var = 0; var < _indexer.size(); ++var) {
+			hash ^= PackedStateLayout::zobrist(var, getValue(var));
+		}
+		return hash;
+	}
+	
 	//return std::hash<BitsetT>{}(_bool_values);
 //     auto a = boost::hash_value( _bool_values);
 //     auto b = boost::hash_value( _int_values);
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <fs_types.hxx>
 // #include <utils/bitsets.hxx>
 
@@ -13,6 +15,89 @@ class StateAtomIndexer;
 class ProblemInfo;
 class State;
 
+
+//! A packed layout of the values of all state variables into a contiguous array of 64-bit words.
+//! Predicative variables take one bit each, and are placed on the first words of the array;
+//! multivalued variables take the narrowest lane (8, 16 or 32 bits) that fits their domain, as
+//! derived from the bounds of their type, and lanes never straddle two words.
+//! Values are stored with an offset, so that the domain lower bound is mapped to a zero lane.
+class PackedStateLayout {
+public:
+	using WordT = uint64_t;
+	using WordsT = std::vector<WordT>;
+
+	static const unsigned WORD_BITS = 64;
+
+protected:
+	//! The position of a single state variable within the packed array
+	struct Slot {
+		uint32_t word;
+		uint8_t shift;
+		WordT mask;
+		ObjectIdx offset;
+	};
+
+	//! _slots[v] is the slot of the state variable v
+	std::vector<Slot> _slots;
+
+	//! The total number of words of the packed representation
+	std::size_t _num_words;
+
+	//! The number of variables packed in lanes of each possible width, for reporting purposes
+	std::vector<unsigned> _lane_counts;
+	
+	//! The packed representation of the state where all variables take value 0, which is not
+	//! necessarily all-zero words, since lanes are offset by the lower bound of the domain.
+	WordsT _zero;
+
+public:
+	PackedStateLayout(const ProblemInfo& info);
+
+	std::size_t num_words() const { return _num_words; }
+	
+	//! The packed representation of the state where all variables take value 0
+	const WordsT& zero() const { return _zero; }
+	
+	//! The index of the word where the value of the given variable is stored
+	inline unsigned word(VariableIdx variable) const { return _slots[variable].word; }
+
+	inline ObjectIdx get(const WordT* words, VariableIdx variable) const {
+		const Slot& slot = _slots[variable];
+		return static_cast<ObjectIdx>((words[slot.word] >> slot.shift) & slot.mask) + slot.offset;
+	}
+	inline ObjectIdx get(const WordsT& words, VariableIdx variable) const { return get(words.data(), variable); }
+
+	//! Stores the given value of the given variable. Values that do not fit the lane of the variable,
+	//! which would otherwise be silently masked into some other value, raise an exception.
+	inline void set(WordT* words, VariableIdx variable, ObjectIdx value) const {
+		const Slot& slot = _slots[variable];
+		if (value < slot.offset || static_cast<WordT>(static_cast<int64_t>(value) - slot.offset) > slot.mask) out_of_lane(variable, value);
+		WordT& word = words[slot.word];
+		word = (word & ~(slot.mask << slot.shift)) | ((static_cast<WordT>(value - slot.offset) & slot.mask) << slot.shift);
+	}
+	inline void set(WordsT& words, VariableIdx variable, ObjectIdx value) const { set(words.data(), variable, value); }
+
+	//! The Zobrist key of atom X=x. The key of any atom X=0 is zero, hence the hash of a state
+	//! is the XOR of the keys of all those variables with a non-zero value.
+	static inline std::size_t zobrist(VariableIdx variable, ObjectIdx value) {
+		if (value == 0) return 0;
+		// A splitmix64 finalizer over the pair <X, x>, which avoids the need of storing a table of random keys.
+		uint64_t z = (static_cast<uint64_t>(variable) << 32) ^ static_cast<uint32_t>(value);
+		z += 0x9e3779b97f4a7c15ULL;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return static_cast<std::size_t>(z ^ (z >> 31));
+	}
+
+	//! Prints a representation of the object to the given stream.
+	friend std::ostream& operator<<(std::ostream &os, const PackedStateLayout& o) { return o.print(os); }
+	std::ostream& print(std::ostream& os) const;
+
+protected:
+	[[noreturn]] static void out_of_lane(VariableIdx variable, ObjectIdx value);
+};
+
+
 class StateAtomIndexer {
 public:
 	using IndexElemT = std::pair<bool, unsigned>;
@@ -27,12 +112,15 @@ protected:
 	std::size_t _n_bool;
 	std::size_t _n_int;
 	
+	//! The packed layout of the state, if states are to be stored in packed form, or null otherwise.
+	std::shared_ptr<const PackedStateLayout> _packed;
+	
 	//! Private constructor
-	StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int);
+	StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int, const PackedStateLayout* packed);
 	
 public:	
-	//! Factory method
-	static StateAtomIndexer* create(const ProblemInfo& info);
+	//! Factory method. If 'packed' is true, states indexed by this indexer will use a PackedStateLayout
+	static StateAtomIndexer* create(const ProblemInfo& info, bool packed = false);
 	
 	std::size_t size() const { return _index.size(); }
 	
@@ -42,9 +130,28 @@ public:
 	bool is_fully_binary() const { return _n_int == 0; }
 	bool is_fully_multivalued() const { return _n_bool == 0; }
 	
+	//! Whether states are stored in packed form
+	bool is_packed() const { return (bool) _packed; }
+	const PackedStateLayout& packed_layout() const {
+		assert(is_packed());
+		return *_packed;
+	}
+	
 	//! Obtain and return the value of the given variable from the given state
 	ObjectIdx get(const State& state, VariableIdx variable) const;
 	
+	//! The position of the value of some state variable within the storage of any state indexed by this indexer.
+	//! Resolving it once through 'locate' allows reading the value of the variable without deindexing it every time.
+	struct Location {
+		enum class Storage : unsigned char {Bool, Int, Packed};
+		Storage storage;
+		unsigned index;
+	};
+	Location locate(VariableIdx variable) const;
+	
+	//! Obtain the value stored at the given location of the given state
+	inline ObjectIdx get(const State& state, const Location& location) const;
+	
 	//! Set a value into the state
 	void set(State& state, const Atom& atom) const;
 	void set(State& state, VariableIdx variable, ObjectIdx value) const;
@@ -59,6 +166,7 @@ public:
 	// using BitsetT = boost::dynamic_bitset<>;
 	using BitsetT = std::vector<bool>;
 	using IntsetT = std::vector<int>;
+	using PackedT = PackedStateLayout::WordsT;
 
 protected:
 	const StateAtomIndexer& _indexer;
@@ -66,9 +174,16 @@ protected:
 	//! A vector mapping state variable (implicit) ids to their value in the current state.
 	BitsetT _bool_values;
 	IntsetT _int_values;
+	
+	//! The values of all state variables, when the indexer uses a packed layout.
+	//! Only one of the two representations (the two vectors above, or this one) is non-empty.
+	PackedT _packed_values;
 
 	std::size_t _hash;
 
+	//! See 'stamp()'
+	uint64_t _stamp;
+
 protected:
 	//! Construct a state specifying the values of all state variables
 	//! Note that it is not necessarily the case that numAtoms == atoms.size(); since the initial values of
@@ -86,14 +201,20 @@ public:
 	//! state plus the new atoms. Note that we do not check that there are no contradictory atoms.
 	State(const State& state, const std::vector<Atom>& atoms);
 
+	//! Construct a state from its packed representation under the given layout, which needs not be
+	//! the layout used by the indexer, if any.
+	State(const StateAtomIndexer& index, const PackedStateLayout& layout, const PackedStateLayout::WordT* words);
+
 	//! Default copy constructors and assignment operators
 	State(const State&) = default;
 	State(State&&) = default;
 	State& operator=(const State&) = default;
 	State& operator=(State&&) = default;
 
-	// Check the hash first for performance.
-	bool operator==(const State &rhs) const { return _hash == rhs._hash && _bool_values == rhs._bool_values && _int_values == rhs._int_values; }
+	// Check the hash first for performance. Packed values are compared word-wise.
+	bool operator==(const State &rhs) const {
+		return _hash == rhs._hash && _bool_values == rhs._bool_values && _int_values == rhs._int_values && _packed_values == rhs._packed_values;
+	}
 	bool operator!=(const State &rhs) const { return !(this->operator==(rhs));}
 
 
@@ -101,17 +222,32 @@ public:
 
 	ObjectIdx getValue(const VariableIdx& variable) const;
 
-	unsigned numAtoms() const { return _bool_values.size() + _int_values.size(); }
+	unsigned numAtoms() const { return _indexer.size(); }
 
 	//! "Applies" the given atoms into the current state.
 	void accumulate(const std::vector<Atom>& atoms);
 
+	//! Overwrite the current state with the given state plus the given atoms, reusing the memory of the current state
+	//! instead of allocating a new one, e.g. to write successors into a preallocated buffer. Both states must be indexed
+	//! by the same indexer, and might be the same state. As with 'accumulate', atoms are applied in order.
+	void apply_inplace(const State& state, const std::vector<Atom>& atoms);
+
+	//! As above, with the atoms given as the arrays 'variables' and 'values', of 'size' elements each
+	void apply_inplace(const State& state, const VariableIdx* variables, const ObjectIdx* values, std::size_t size);
+	
+	//! Returns the atoms X=x of the current state such that X has a different value in the given state,
+	//! i.e. the changeset that would need to be accumulated into 'other' to obtain the current state.
+	std::vector<Atom> diff(const State& other) const;
+	
+	//! Write the packed representation of the state under the given layout into the given array of words
+	void pack(const PackedStateLayout& layout, PackedStateLayout::WordT* words) const;
+
 	const BitsetT& get_boolean_values() const {
-		assert(_indexer.is_fully_binary());
+		assert(_indexer.is_fully_binary() && !_indexer.is_packed());
 		return _bool_values;
 	}
 	const IntsetT& get_int_values() const {
-		assert(_indexer.is_fully_multivalued());
+		assert(_indexer.is_fully_multivalued() && !_indexer.is_packed());
 		return _int_values;
 	}
 	
@@ -119,16 +255,41 @@ protected:
 	void set(const Atom& atom);
 
 	void updateHash() { _hash = computeHash(); }
+	
+	//! Applies the given atoms updating the Zobrist hash of a packed state incrementally
+	void accumulate_packed(const std::vector<Atom>& atoms);
+
+	//! Copy the values and hash of the given state into the current state, reusing the memory of the latter
+	void copy_values(const State& state);
+
+	//! Set the given value, updating the Zobrist hash incrementally if the state is packed
+	void update(VariableIdx variable, ObjectIdx value);
 
 	std::size_t computeHash() const;
 
+	//! A stamp that no other state has been given before, on any thread
+	static uint64_t next_stamp();
+
 public:
 	//! Prints a representation of the state to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const State&  state) { return state.print(os); }
 	std::ostream& print(std::ostream& os) const;
 
 	std::size_t hash() const { return _hash; }
+
+	//! Identifies the values of the state: copies of a state keep its stamp, while any change of values gives the state
+	//! a fresh one, hence two states with the same stamp hold the same values, whatever their addresses.
+	uint64_t stamp() const { return _stamp; }
 };
 
+inline ObjectIdx
+StateAtomIndexer::get(const State& state, const Location& location) const {
+	switch (location.storage) {
+		case Location::Storage::Bool: return state._bool_values[location.index];
+		case Location::Storage::Int: return state._int_values[location.index];
+		default: return _packed->get(state._packed_values, location.index);
+	}
+}
+
 } // namespaces
 
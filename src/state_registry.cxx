@@ -0,0 +1,92 @@
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <state_registry.hxx>
+#include <problem_info.hxx>
+
+
+namespace fs0 {
+
+//! The initial number of buckets of the hash table. Must be a power of two.
+static const std::size_t INITIAL_TABLE_SIZE = 1024;
+
+const StateID StateRegistry::INVALID_ID;
+
+StateRegistry::StateRegistry(const StateAtomIndexer& indexer, const ProblemInfo& info) :
+	_indexer(indexer),
+	_layout(info),
+	_num_words(_layout.num_words()),
+	_arena(),
+	_size(0),
+	_table(INITIAL_TABLE_SIZE, INVALID_ID),
+	_buffer(_num_words, 0)
+{}
+
+std::pair<StateID, bool>
+StateRegistry::insert(const State& state) {
+	state.pack(_layout, _buffer.data());
+	std::size_t pos = probe(hash(_buffer.data(), _num_words));
+	if (_table[pos] != INVALID_ID) return std::make_pair(_table[pos], false);
+
+	if (_size == INVALID_ID) throw std::runtime_error("StateRegistry: Maximum number of registered states exceeded");
+
+	StateID id = _size++;
+	_arena.insert(_arena.end(), _buffer.begin(), _buffer.end());
+	_table[pos] = id;
+
+	// Keep the load factor of the table below 1/2
+	if (2 * _size > _table.size()) grow();
+
+	return std::make_pair(id, true);
+}
+
+StateID
+StateRegistry::find(const State& state) const {
+	state.pack(_layout, _buffer.data());
+	return _table[probe(hash(_buffer.data(), _num_words))];
+}
+
+State
+StateRegistry::get(StateID id) const {
+	assert(id < _size);
+	return State(_indexer, _layout, words(id));
+}
+
+std::size_t
+StateRegistry::hash(const WordT* words, std::size_t num_words) {
+	// A splitmix64-like mixing of each word into the accumulated hash
+	uint64_t h = 0x9e3779b97f4a7c15ULL ^ num_words;
+	for (std::size_t i = 0; i < num_words; ++i) {
+		uint64_t z = h ^ words[i];
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		h = z ^ (z >> 31);
+	}
+	return static_cast<std::size_t>(h);
+}
+
+std::size_t
+StateRegistry::probe(std::size_t hash) const {
+	const std::size_t mask = _table.size() - 1;
+	const std::size_t bytes = _num_words * sizeof(WordT);
+	for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+		StateID id = _table[pos];
+		if (id == INVALID_ID || std::memcmp(words(id), _buffer.data(), bytes) == 0) return pos;
+	}
+}
+
+void
+StateRegistry::grow() {
+	std::vector<StateID> table(2 * _table.size(), INVALID_ID);
+	const std::size_t mask = table.size() - 1;
+	for (StateID id = 0; id < _size; ++id) {
+		std::size_t pos = hash(words(id), _num_words) & mask;
+		while (table[pos] != INVALID_ID) pos = (pos + 1) & mask;
+		table[pos] = id;
+	}
+	_table.swap(table);
+}
+
+} // namespaces
@@ -0,0 +1,87 @@
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <state.hxx>
+
+
+namespace fs0 {
+
+class ProblemInfo;
+
+//! A dense identifier of a state within a StateRegistry
+using StateID = uint32_t;
+
+//! A registry that interns states, i.e. keeps a single copy of each distinct state, and assigns to each
+//! of them a dense StateID. States are stored in packed form (see PackedStateLayout), one after the other, in
+//! a single contiguous arena, and are deduplicated by means of an open-addressing hash table of IDs.
+//! Note that states are stored in packed form even if the indexer of the problem does not use a packed layout.
+class StateRegistry {
+public:
+	using WordT = PackedStateLayout::WordT;
+
+	static const StateID INVALID_ID = std::numeric_limits<StateID>::max();
+
+protected:
+	//! The indexer of the states that we register
+	const StateAtomIndexer& _indexer;
+
+	//! The layout of the states in the arena
+	const PackedStateLayout _layout;
+
+	//! The number of words taken by each state
+	const std::size_t _num_words;
+
+	//! The packed representation of all registered states, one after the other
+	std::vector<WordT> _arena;
+
+	//! The number of registered states
+	std::size_t _size;
+
+	//! An open-addressing hash table (with linear probing) of the IDs of all registered states.
+	//! Its size is always a power of two, and empty buckets are marked with INVALID_ID.
+	std::vector<StateID> _table;
+
+	//! A scratch buffer where the state being looked up is packed
+	mutable std::vector<WordT> _buffer;
+
+public:
+	StateRegistry(const StateAtomIndexer& indexer, const ProblemInfo& info);
+
+	StateRegistry(const StateRegistry&) = delete;
+	StateRegistry(StateRegistry&&) = default;
+	StateRegistry& operator=(const StateRegistry&) = delete;
+	StateRegistry& operator=(StateRegistry&&) = delete;
+
+	//! Register the given state, if it was not registered yet.
+	//! Returns the ID of the state and whether the state was newly registered.
+	std::pair<StateID, bool> insert(const State& state);
+
+	//! Returns the ID of the given state, or INVALID_ID if the state has not been registered.
+	StateID find(const State& state) const;
+
+	//! Returns a (newly-built) copy of the state with the given ID
+	State get(StateID id) const;
+
+	//! The number of registered states
+	std::size_t size() const { return _size; }
+
+	//! The (approximate) amount of memory used by the registry, in bytes
+	std::size_t bytes() const { return (_arena.capacity() + _buffer.capacity()) * sizeof(WordT) + _table.capacity() * sizeof(StateID); }
+
+protected:
+	const WordT* words(StateID id) const { return _arena.data() + id * _num_words; }
+
+	static std::size_t hash(const WordT* words, std::size_t num_words);
+
+	//! Returns the position of the table where the ID of the packed state in _buffer is, or where it should be placed
+	std::size_t probe(std::size_t hash) const;
+
+	//! Double the size of the hash table and reinsert all IDs
+	void grow();
+};
+
+} // namespaces
@@ -1,25 +1,25 @@
 
-#include <boost/functional/hash.hpp>
-
 #include <utils/atom_index.hxx>
 #include <problem_info.hxx>
+#include <actions/reachability.hxx>
 
 
 namespace fs0 {
 
 bool AtomIndex::is_indexed(VariableIdx variable, ObjectIdx value) const {
-	return !_info.isPredicativeVariable(variable) || _indexes_negated_literals || value == 1;
+	return _atom_index_inv[variable].find(&value, 1) != utils::TupleTable::INVALID;
 }
 
 		
-AtomIndex::AtomIndex(const ProblemInfo& info, bool index_negated_literals) :
+AtomIndex::AtomIndex(const ProblemInfo& info, bool index_negated_literals, const RelaxedReachability* reachability) :
 	_info(info),
 	_indexes_negated_literals(index_negated_literals),
-	_tuple_index_inv(info.getNumLogicalSymbols()),
-	_atom_index_inv(info.getNumVariables()),
+	_tuple_index_inv(),
+	_atom_index_inv(),
 	_variable_to_atom_index(info.getNumVariables())
 {
-	auto tuples_by_symbol = compute_all_reachable_tuples(info);
+	auto tuples_by_symbol = compute_all_reachable_tuples(info, reachability);
+	std::vector<utils::TupleTable::EntriesT> tuple_entries(info.getNumLogicalSymbols()), atom_entries(info.getNumVariables());
 	
 	std::vector<std::pair<unsigned, unsigned>> symbol_ranges;
 	unsigned idx = 0;
@@ -40,7 +40,7 @@ AtomIndex::AtomIndex(const ProblemInfo& info, bool index_negated_literals) :
 			
 			if (_indexes_negated_literals || info.isFunction(symbol) || value) {
 				VariableIdx variable = info.resolveStateVariable(symbol, arguments);
-				add(info, symbol, tuple, idx, Atom(variable, value));
+				add(info, symbol, tuple, idx, Atom(variable, value), tuple_entries, atom_entries);
 				idx++;
 			}
 		}
@@ -48,9 +48,13 @@ AtomIndex::AtomIndex(const ProblemInfo& info, bool index_negated_literals) :
 		range.second = idx - 1;
 		symbol_ranges.push_back(range);
 	}
+	
+	for (const auto& entries:tuple_entries) _tuple_index_inv.push_back(utils::TupleTable(entries));
+	for (const auto& entries:atom_entries) _atom_index_inv.push_back(utils::TupleTable(entries));
 }
 
-void AtomIndex::add(const ProblemInfo& info, unsigned symbol, const ValueTuple& tuple, unsigned idx, const Atom& atom) {
+void AtomIndex::add(const ProblemInfo& info, unsigned symbol, const ValueTuple& tuple, unsigned idx, const Atom& atom,
+                    std::vector<utils::TupleTable::EntriesT>& tuple_entries, std::vector<utils::TupleTable::EntriesT>& atom_entries) {
 	assert(_tuple_index.size() == idx);
 	_tuple_index.push_back(tuple);
 	
@@ -58,21 +62,20 @@ void AtomIndex::add(const ProblemInfo& info, unsigned symbol, const ValueTuple&
 	_symbol_index.push_back(symbol);
 	
 	if (info.isFunction(symbol) || atom.getValue() == 1) { // For predicative symbols, we only map the logical symbol to the index of the corresponding "true" atom
-		_tuple_index_inv.at(symbol).insert(std::make_pair(tuple, idx));
+		tuple_entries.at(symbol).push_back(std::make_pair(tuple, idx));
 	}
 	
 	assert(_atom_index.size() == idx);
 	_atom_index.push_back(atom);
 	
-	_atom_index_inv.at(atom.getVariable()).insert(std::make_pair(atom.getValue(), idx));
+	atom_entries.at(atom.getVariable()).push_back(std::make_pair(ValueTuple{atom.getValue()}, idx));
 	_variable_to_atom_index.at(atom.getVariable()).push_back(idx);
 }
 
 AtomIdx AtomIndex::to_index(unsigned symbol, const ValueTuple& tuple) const {
-	const auto& map = _tuple_index_inv.at(symbol);
-	auto it = map.find(tuple);
-	assert(it != map.end());
-	return it->second;
+	AtomIdx idx = _tuple_index_inv.at(symbol).find(tuple);
+	assert(idx != utils::TupleTable::INVALID);
+	return idx;
 }
 
 AtomIdx AtomIndex::to_index(const Atom& atom) const {
@@ -80,14 +83,12 @@ AtomIdx AtomIndex::to_index(const Atom& atom) const {
 }
 
 AtomIdx AtomIndex::to_index(VariableIdx variable, ObjectIdx value) const {
-	const auto& map = _atom_index_inv.at(variable);
-	auto it = map.find(value);
-	assert(it != map.end());
-	return it->second;
+	AtomIdx idx = _atom_index_inv.at(variable).find(&value, 1);
+	assert(idx != utils::TupleTable::INVALID);
+	return idx;
 }
 
-// TODO - We should be applying some reachability analysis here to prune out tuples that will never be reachable at all.
-std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> AtomIndex::compute_all_reachable_tuples(const ProblemInfo& info) {
+std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> AtomIndex::compute_all_reachable_tuples(const ProblemInfo& info, const RelaxedReachability* reachability) {
 	std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> tuples_by_symbol(info.getNumLogicalSymbols());
 
 	for (VariableIdx var = 0; var < info.getNumVariables(); ++var) {
@@ -95,6 +96,7 @@ std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> AtomIndex::compute_al
 		auto& symbol_tuples = tuples_by_symbol.at(data.first); // The tupleset corresponding to the symbol index
 		
 		for (ObjectIdx value:info.getVariableObjects(var)) {
+			if (reachability && !reachability->reachable(var, value)) continue;
 			symbol_tuples.push_back(std::make_pair(data.second, value)); 
 		}
 	}
@@ -1,15 +1,14 @@
 
 #pragma once
 
-#include <unordered_map>
-#include <boost/functional/hash.hpp>
-
 #include <atom.hxx>
+#include <utils/tuple_table.hxx>
 
 namespace fs0 {
 
 class ProblemInfo;
 class Atom;
+class RelaxedReachability;
 
 //! An AtomIndex indexes all possible atoms of a certain problem (be it predicative as in 'clear(b)',
 //! or coming from a function, as in 'loc(b,c)'. This essentially means that all
@@ -29,12 +28,12 @@ protected:
 	//! A map from tuple index to its corresponding symbol
 	std::vector<unsigned> _symbol_index;
 	
-	//! A map from actual tuples to their index
-	std::vector<std::unordered_map<ValueTuple, AtomIdx, boost::hash<ValueTuple>>> _tuple_index_inv;
+	//! _tuple_index_inv.at(s) maps actual tuples of symbol 's' to their index
+	std::vector<utils::TupleTable> _tuple_index_inv;
 	
-	//! _atom_index_inv.at(i) contains a map mapping all possible values 'v' of variable 'i'
+	//! _atom_index_inv.at(i) maps all possible values 'v' of variable 'i' (as unary tuples)
 	//! to the tuple that corresponds to the atom <i, v>
-	std::vector<std::unordered_map<ObjectIdx, AtomIdx>> _atom_index_inv;
+	std::vector<utils::TupleTable> _atom_index_inv;
 	
 	//! A map from each variable index to all possible atoms that arise from that variable; e.g. for variable
 	//! 'loc(b)' with ID 7, _variable_to_atom_index[7] will contain the indexes of atoms loc(b)=a, loc(b)=c, etc.
@@ -42,8 +41,8 @@ protected:
 	std::vector<std::vector<AtomIdx>> _variable_to_atom_index;
 	
 public:
-	//! Constructs a full tuple index
-	AtomIndex(const ProblemInfo& info, bool index_negated_literals = true);
+	//! Constructs a full tuple index or, if a reachability analysis is given, an index of the atoms deemed reachable by it
+	AtomIndex(const ProblemInfo& info, bool index_negated_literals = true, const RelaxedReachability* reachability = nullptr);
 	AtomIndex(const AtomIndex&) = default;
 	AtomIndex(AtomIndex&&) = default;
 	AtomIndex& operator=(const AtomIndex& other) = default;
@@ -63,6 +62,8 @@ public:
 	AtomIdx to_index(const Atom& atom) const;
 	AtomIdx to_index(VariableIdx variable, ObjectIdx value) const;
 	
+	//! Whether the given atom is in the index, which might not be the case if it is a negated literal
+	//! and these are not indexed, or if it was found to be unreachable
 	bool is_indexed(VariableIdx variable, ObjectIdx value) const;
 
 	
@@ -75,13 +76,15 @@ public:
 	const std::vector<AtomIdx>& all_variable_atoms(VariableIdx variable) const { return _variable_to_atom_index[variable]; }
 	
 protected:
-	//! Add a new element to the index.
-	void add(const ProblemInfo& info,unsigned symbol, const ValueTuple& tuple, unsigned idx, const Atom& atom);
+	//! Add a new element to the index. The entries of the inverse indexes are added to the given vectors,
+	//! from which the inverse indexes are built once all elements have been added.
+	void add(const ProblemInfo& info,unsigned symbol, const ValueTuple& tuple, unsigned idx, const Atom& atom,
+	         std::vector<utils::TupleTable::EntriesT>& tuple_entries, std::vector<utils::TupleTable::EntriesT>& atom_entries);
 	
 	//! A helper to compute and index all reachable tuples.
 	//! Returns an index from each logical symbol to all the tuples that are reachable / make sense for that particular
-	//! logical symbol.
-	static std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> compute_all_reachable_tuples(const ProblemInfo& info);
+	//! logical symbol, i.e. all of them, unless a reachability analysis is given.
+	static std::vector<std::vector<std::pair<ValueTuple, ObjectIdx>>> compute_all_reachable_tuples(const ProblemInfo& info, const RelaxedReachability* reachability);
 };
 
 } // namespaces
@@ -78,6 +78,11 @@ public:
 		_set[variable] = true;
 	}
 	
+	//! Unsets the given position of the binding, if set
+	void unset(unsigned variable) {
+		if (variable < _set.size()) _set[variable] = false;
+	}
+	
 	std::size_t size() const { return _values.size(); }
 
 	friend bool operator==(const Binding&, const Binding&);
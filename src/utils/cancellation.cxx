@@ -0,0 +1,29 @@
+
+#include <utils/cancellation.hxx>
+
+
+namespace fs0 { namespace utils {
+
+thread_local const CancellationToken* CancellationToken::_current = nullptr;
+
+void
+CancellationToken::set_budget(double seconds) {
+	_deadline = ClockT::now() + std::chrono::duration_cast<ClockT::duration>(std::chrono::duration<double>(seconds));
+	_has_deadline = true;
+}
+
+bool
+CancellationToken::cancelled() const {
+	if (_cancelled.load(std::memory_order_relaxed)) return true;
+	if (_has_deadline && ClockT::now() >= _deadline) return true;
+	return _parent && _parent->cancelled();
+}
+
+const CancellationToken*
+CancellationToken::install(const CancellationToken* token) {
+	const CancellationToken* previous = _current;
+	_current = token;
+	return previous;
+}
+
+} } // namespaces
@@ -0,0 +1,64 @@
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+
+namespace fs0 { namespace utils {
+
+//! The exception raised on the thread of a search that has been cancelled
+class SearchCancelled : public std::runtime_error {
+public:
+	SearchCancelled() : std::runtime_error("The search was cancelled") {}
+};
+
+//! A flag through which a search running on some thread can be asked to stop from any other thread.
+//! A token can be chained to a parent token, in which case it is cancelled whenever its parent is,
+//! and can be given a deadline (in wall-clock time), after which it counts as cancelled.
+//! Cancellation is cooperative: the search engines poll the token of their thread through 'check()'
+//! at regular points (e.g. on each node expansion), which throws a SearchCancelled exception.
+class CancellationToken {
+public:
+	using ClockT = std::chrono::steady_clock;
+
+	explicit CancellationToken(const CancellationToken* parent = nullptr) :
+		_cancelled(false), _parent(parent), _has_deadline(false), _deadline()
+	{}
+
+	CancellationToken(const CancellationToken&) = delete;
+	CancellationToken& operator=(const CancellationToken&) = delete;
+
+	//! Ask the searches observing this token (or any of its descendants) to stop
+	void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+	//! Cancel the token once the given amount of seconds, counting from now, has elapsed.
+	//! Must be set before the token is shared with other threads.
+	void set_budget(double seconds);
+
+	bool cancelled() const;
+
+	//! The token of the search running on the current thread, if any
+	static const CancellationToken* current() { return _current; }
+
+	//! Make the given token the one of the current thread; returns the previously installed token
+	static const CancellationToken* install(const CancellationToken* token);
+
+	//! Throw a SearchCancelled exception iff the token of the current thread, if any, has been cancelled
+	static void check() {
+		if (_current && _current->cancelled()) throw SearchCancelled();
+	}
+
+protected:
+	std::atomic<bool> _cancelled;
+
+	const CancellationToken* _parent;
+
+	bool _has_deadline;
+	ClockT::time_point _deadline;
+
+	static thread_local const CancellationToken* _current;
+};
+
+} } // namespaces
@@ -15,7 +15,7 @@ void Config::init(const std::string& root, const std::unordered_map<std::string,
 }
 
 //! Retrieve the singleton instance, which has been previously initialized
-Config& Config::instance() {
+const Config& Config::instance() {
 	if (!_instance) throw std::runtime_error("The global configuration object needs to be explicitly initialized before using it");
 	return *_instance;
 }
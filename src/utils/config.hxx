@@ -40,8 +40,9 @@ public:
 	//! Explicit initizalition of the singleton
 	static void init(const std::string& root, const std::unordered_map<std::string, std::string>& user_options, const std::string& filename);
 
-	//! Retrieve the singleton instance, which has been previously initialized
-	static Config& instance();
+	//! Retrieve the singleton instance, which has been previously initialized.
+	//! The configuration is read-only once initialized, hence safe to read from several threads.
+	static const Config& instance();
 
 	//! Prints a representation of the object to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const Config& o) { return o.print(os); }
@@ -0,0 +1,66 @@
+
+#include <algorithm>
+#include <cassert>
+
+#include <utils/fingerprint_set.hxx>
+
+
+namespace fs0 { namespace utils {
+
+FingerprintSet::FingerprintSet(std::size_t initial_size) :
+	_table(), _size(0)
+{
+	std::size_t size = 1;
+	while (size < initial_size) size <<= 1;
+	_table.resize(size, 0);
+}
+
+bool
+FingerprintSet::insert(uint64_t fingerprint) {
+	const uint64_t key = mix(fingerprint);
+	const std::size_t mask = _table.size() - 1;
+	std::size_t pos = key & mask;
+	for (; _table[pos] != 0; pos = (pos + 1) & mask) {
+		if (_table[pos] == key) return false;
+	}
+
+	_table[pos] = key;
+	++_size;
+
+	// Keep the load factor of the table below 1/2
+	if (2 * _size > _table.size()) grow();
+	return true;
+}
+
+void
+FingerprintSet::clear() {
+	if (_size == 0) return;
+	std::fill(_table.begin(), _table.end(), 0);
+	_size = 0;
+}
+
+uint64_t
+FingerprintSet::mix(uint64_t fingerprint) {
+	// The splitmix64 finalizer
+	uint64_t z = fingerprint;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	z = z ^ (z >> 31);
+	return z == 0 ? 1 : z;
+}
+
+void
+FingerprintSet::grow() {
+	std::vector<uint64_t> table(2 * _table.size(), 0);
+	const std::size_t mask = table.size() - 1;
+	for (uint64_t key:_table) {
+		if (key == 0) continue;
+		std::size_t pos = key & mask;
+		while (table[pos] != 0) pos = (pos + 1) & mask;
+		table[pos] = key;
+	}
+	_table.swap(table);
+	assert(2 * _size <= _table.size());
+}
+
+} } // namespaces
@@ -0,0 +1,44 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace fs0 { namespace utils {
+
+//! A compact set of 64-bit fingerprints (e.g. hashes of states), stored in an open-addressing table
+//! with linear probing. Only the fingerprints are stored, hence two distinct objects with the same
+//! fingerprint are considered equal by the set; with 64-bit hashes this is negligible in practice.
+class FingerprintSet {
+public:
+	explicit FingerprintSet(std::size_t initial_size = 1024);
+
+	//! Insert the given fingerprint, returning true iff it was not already in the set
+	bool insert(uint64_t fingerprint);
+
+	//! Remove all fingerprints from the set, keeping the memory of the table
+	void clear();
+
+	std::size_t size() const { return _size; }
+
+	//! The memory taken by the table of the set
+	std::size_t bytes() const { return _table.size() * sizeof(uint64_t); }
+
+protected:
+	//! The table of (mixed) fingerprints. Its size is a power of two, and 0 denotes an empty bucket.
+	std::vector<uint64_t> _table;
+
+	//! The number of fingerprints in the set
+	std::size_t _size;
+
+	//! A bijective mixing of the bits of the fingerprint, so that poor hashes are spread evenly over the table.
+	//! Fingerprints that mix into 0 are mapped to 1, as 0 marks the empty buckets.
+	static uint64_t mix(uint64_t fingerprint);
+
+	//! Double the size of the table
+	void grow();
+};
+
+} } // namespaces
@@ -5,6 +5,7 @@
 #include <utils/loader.hxx>
 #include <actions/actions.hxx>
 #include <actions/grounding.hxx>
+#include <actions/reachability.hxx>
 #include <utils/component_factory.hxx>
 #include <languages/fstrips/loader.hxx>
 #include <languages/fstrips/axioms.hxx>
@@ -14,6 +15,7 @@
 #include <utils/printers/registry.hxx>
 #include <utils/config.hxx>
 #include <utils/static.hxx>
+#include <utils/utils.hxx>
 #include <state.hxx>
 #include <problem_info.hxx>
 #include <languages/fstrips/formulae.hxx>
@@ -26,10 +28,10 @@ namespace fs = fs0::language::fstrips;
 
 namespace fs0 {
 	
-std::unordered_map<std::string, const fs::Axiom*>
-_index_axioms(const std::vector<const fs::Axiom*>& axioms) {
-	std::unordered_map<std::string, const fs::Axiom*> index;
-	for (const fs::Axiom* axiom:axioms) {
+std::unordered_map<std::string, fs::Axiom*>
+_index_axioms(const std::vector<fs::Axiom*>& axioms) {
+	std::unordered_map<std::string, fs::Axiom*> index;
+	for (fs::Axiom* axiom:axioms) {
 		index.insert(std::make_pair(axiom->getName(), axiom));
 	}
 	return index;
@@ -52,12 +54,34 @@ _check_negated_preconditions(std::vector<const ActionData*>& schemas) {
 	return false;
 }
 
+//! Run a relaxed reachability analysis from the initial state. The atoms of the fluent symbols that appear in those of
+//! the given formulae with existential quantifiers are all kept, since these formulae are handled by CSPs, which
+//! might expect any of them to be indexed.
+std::shared_ptr<const RelaxedReachability>
+_compute_reachability(const std::vector<const ActionData*>& schemas, const State& init, const std::vector<const fs::Formula*>& formulae, const ProblemInfo& info) {
+	LPT_INFO("main", "Computing relaxed reachability...");
+	auto reachability = std::make_shared<RelaxedReachability>(schemas, info);
+	reachability->compute(init);
+	
+	for (const fs::Formula* formula:formulae) {
+		if (Utils::filter_by_type<const fs::ExistentiallyQuantifiedFormula*>(fs::all_formulae(*formula)).empty()) continue;
+		for (const fs::Term* term:fs::all_terms(*formula)) {
+			if (auto nested = dynamic_cast<const fs::FluentHeadedNestedTerm*>(term)) reachability->add_all_atoms(nested->getSymbolId());
+			if (auto variable = dynamic_cast<const fs::StateVariable*>(term)) reachability->add_all_atoms(info.getVariableData(variable->getValue()).first);
+		}
+	}
+	return reachability;
+}
+
 Problem* Loader::loadProblem(const rapidjson::Document& data) {
 	const Config& config = Config::instance();
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	
 	LPT_INFO("main", "Creating State Indexer...");
-	auto indexer = StateAtomIndexer::create(info);
+	auto indexer = StateAtomIndexer::create(info, config.getOption<bool>("state.packed", false));
+	if (indexer->is_packed()) {
+		LPT_INFO("cout", "State representation: " << indexer->packed_layout());
+	}
 	
 	LPT_INFO("main", "Loading initial state...");
 	auto init = loadState(*indexer, data["init"]);
@@ -76,10 +100,16 @@ Problem* Loader::loadProblem(const rapidjson::Document& data) {
 	LPT_INFO("main", "Loading state constraints...");
 	auto sc = loadGroundedFormula(data["state_constraints"], info);
 	
+	std::shared_ptr<const RelaxedReachability> reachability;
+	if (config.getOption<bool>("grounding.reachability", false)) {
+		reachability = _compute_reachability(action_data, *init, {goal, sc}, info);
+	}
+	
 	//! Set the global singleton Problem instance
 	bool has_negated_preconditions = _check_negated_preconditions(action_data);
 	LPT_INFO("cout", "Quick Negated-Precondition Test: Does the problem have negated preconditions? " << has_negated_preconditions);
-	Problem* problem = new Problem(init, indexer, action_data, axiom_idx, goal, sc, AtomIndex(info, has_negated_preconditions));
+	Problem* problem = new Problem(init, indexer, action_data, axiom_idx, goal, sc, AtomIndex(info, has_negated_preconditions, reachability.get()));
+	problem->set_reachability(reachability);
 	Problem::setInstance(std::unique_ptr<Problem>(problem));
 	
 	problem->consolidateAxioms();
@@ -143,9 +173,9 @@ Loader::loadAllActionData(const rapidjson::Value& data, const ProblemInfo& info,
 	return schemata;
 }
 
-std::vector<const fs::Axiom*>
+std::vector<fs::Axiom*>
 Loader::loadAxioms(const rapidjson::Value& data, const ProblemInfo& info) {
-	std::vector<const fs::Axiom*> axioms;
+	std::vector<fs::Axiom*> axioms;
 	for (const ActionData* action:loadAllActionData(data, info, false)) {
 		axioms.push_back(new fs::Axiom(action->getName(), action->getSignature(), action->getParameterNames(), action->getBindingUnit(), action->getPrecondition()->clone()));
 		delete action;
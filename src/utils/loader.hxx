@@ -44,7 +44,7 @@ protected:
 	//! Load the data related to the problem functions and predicates into the info object
 	static void loadFunctions(const BaseComponentFactory& factory, ProblemInfo& info);
 	
-	static std::vector<const fs::Axiom*> loadAxioms(const rapidjson::Value& data, const ProblemInfo& info);
+	static std::vector<fs::Axiom*> loadAxioms(const rapidjson::Value& data, const ProblemInfo& info);
 
 	static std::vector<const ActionData*> loadAllActionData(const rapidjson::Value& data, const ProblemInfo& info, bool load_effects);
 	
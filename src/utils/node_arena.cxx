@@ -0,0 +1,71 @@
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include <utils/node_arena.hxx>
+
+
+namespace fs0 { namespace utils {
+
+const std::size_t NodeArena::CHUNK_SIZE;
+const std::size_t NodeArena::ALIGNMENT;
+
+NodeArena::NodeArena() :
+	_chunks(), _chunk_idx(0), _current(nullptr), _remaining(0), _free(), _live(0), _reused(0)
+{}
+
+void*
+NodeArena::allocate(std::size_t bytes) {
+	std::size_t cls = size_class(bytes);
+	if (cls < _free.size() && _free[cls] != nullptr) { // Pop a block from the free list
+		void* block = _free[cls];
+		_free[cls] = *static_cast<void**>(block);
+		++_live;
+		++_reused;
+		return block;
+	}
+
+	std::size_t size = cls * ALIGNMENT;
+	if (size > CHUNK_SIZE) throw std::runtime_error("NodeArena: Cannot allocate objects larger than the chunk size");
+	if (size > _remaining) next_chunk();
+
+	void* block = _current;
+	_current += size;
+	_remaining -= size;
+	++_live;
+	return block;
+}
+
+void
+NodeArena::deallocate(void* block, std::size_t bytes) {
+	std::size_t cls = size_class(bytes);
+	if (cls >= _free.size()) _free.resize(cls + 1, nullptr);
+
+	// Push the block into the free list, reusing the block itself to store the link
+	*static_cast<void**>(block) = _free[cls];
+	_free[cls] = block;
+	assert(_live > 0);
+	--_live;
+}
+
+void
+NodeArena::release() {
+	assert(_live == 0);
+	std::fill(_free.begin(), _free.end(), nullptr);
+	_chunk_idx = 0;
+	_current = _chunks.empty() ? nullptr : _chunks[0].get();
+	_remaining = _chunks.empty() ? 0 : CHUNK_SIZE;
+}
+
+void
+NodeArena::next_chunk() {
+	if (_current != nullptr) ++_chunk_idx; // Otherwise, we have not started using any chunk yet
+	if (_chunk_idx == _chunks.size()) {
+		_chunks.push_back(std::unique_ptr<char[]>(new char[CHUNK_SIZE]));
+	}
+	_current = _chunks[_chunk_idx].get();
+	_remaining = CHUNK_SIZE;
+}
+
+} } // namespaces
@@ -0,0 +1,140 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+
+namespace fs0 { namespace utils {
+
+//! An arena of memory for search nodes. Memory is obtained from large chunks through bump allocation,
+//! blocks that are deallocated are kept on free lists (one per block size) for later reuse, and all
+//! memory can be released at once, e.g. between two consecutive searches, while keeping the chunks around.
+//! The arena is not thread-safe, and must outlive all objects allocated on it.
+class NodeArena {
+public:
+	//! The size of each of the chunks of memory
+	static const std::size_t CHUNK_SIZE = 1 << 16;
+
+	//! All blocks are aligned, and their sizes rounded up, to this value
+	static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+protected:
+	//! The chunks of memory of the arena
+	std::vector<std::unique_ptr<char[]>> _chunks;
+
+	//! The index of the chunk from which we are currently allocating
+	std::size_t _chunk_idx;
+
+	//! The next free position of the current chunk, and the number of bytes remaining in it
+	char* _current;
+	std::size_t _remaining;
+
+	//! _free[i] is the head of a linked list of deallocated blocks of i*ALIGNMENT bytes
+	std::vector<void*> _free;
+
+	//! The number of blocks currently allocated, and the number of allocations served from some free list
+	std::size_t _live;
+	std::size_t _reused;
+
+public:
+	NodeArena();
+	~NodeArena() = default;
+
+	NodeArena(const NodeArena&) = delete;
+	NodeArena(NodeArena&&) = default;
+	NodeArena& operator=(const NodeArena&) = delete;
+	NodeArena& operator=(NodeArena&&) = default;
+
+	void* allocate(std::size_t bytes);
+
+	void deallocate(void* block, std::size_t bytes);
+
+	//! Make all the memory of the arena available again. No object allocated on the arena can be alive.
+	void release();
+
+	//! The number of bytes of memory reserved by the arena
+	std::size_t reserved_bytes() const { return _chunks.size() * CHUNK_SIZE; }
+
+	std::size_t live_blocks() const { return _live; }
+	std::size_t reused_blocks() const { return _reused; }
+
+protected:
+	static std::size_t size_class(std::size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT; }
+
+	//! Move to the next chunk, allocating it if necessary
+	void next_chunk();
+};
+
+
+//! A pool of nodes of type T placed on a NodeArena. Nodes are referred to through plain pointers,
+//! which remain valid until the pool is cleared or destroyed, at which point all nodes are destroyed
+//! at once; there is thus no per-node reference counting nor deallocation.
+template <typename T>
+class NodePool {
+protected:
+	NodeArena _arena;
+
+	//! All nodes currently alive, which need to be destroyed with the pool
+	std::vector<T*> _nodes;
+
+public:
+	NodePool() : _arena(), _nodes() {}
+	~NodePool() { destroy_all(); }
+
+	NodePool(const NodePool&) = delete;
+	NodePool(NodePool&&) = default;
+	NodePool& operator=(const NodePool&) = delete;
+	NodePool& operator=(NodePool&&) = delete;
+
+	//! Construct a new node with the given arguments
+	template <typename... Args>
+	T* create(Args&&... args) {
+		// Grow the vector beforehand, so that pushing the node cannot throw once constructed
+		if (_nodes.size() == _nodes.capacity()) _nodes.reserve(std::max<std::size_t>(1024, 2 * _nodes.capacity()));
+
+		void* block = _arena.allocate(sizeof(T));
+		try {
+			_nodes.push_back(new (block) T(std::forward<Args>(args)...));
+		} catch (...) {
+			_arena.deallocate(block, sizeof(T));
+			throw;
+		}
+		return _nodes.back();
+	}
+
+	//! Destroy the given node, which must be the last one created and not be referenced anywhere,
+	//! so that its memory can be reused by the next node
+	void discard(T* node) {
+		assert(!_nodes.empty() && _nodes.back() == node);
+		_nodes.pop_back();
+		node->~T();
+		_arena.deallocate(node, sizeof(T));
+	}
+
+	//! Destroy all nodes of the pool, and make all the memory of the arena available again
+	void clear() {
+		destroy_all();
+		_arena.release();
+	}
+
+	std::size_t size() const { return _nodes.size(); }
+
+	//! The number of bytes of memory reserved by the underlying arena
+	std::size_t reserved_bytes() const { return _arena.reserved_bytes(); }
+
+protected:
+	void destroy_all() {
+		for (T* node:_nodes) {
+			node->~T();
+			_arena.deallocate(node, sizeof(T));
+		}
+		_nodes.clear();
+	}
+};
+
+} } // namespaces
@@ -19,12 +19,11 @@ ObjectIdxVector Projections::project(const State& s, const VariableIdxVector& sc
 }
 
 
-DomainMap Projections::project(RelaxedState& state, const VariableIdxVector& scope) { //!  TODO - CHECK THIS IS APPLYING RVO??
-	DomainMap projection;
-	for (VariableIdx var:scope) {
-		projection.insert(std::make_pair(var, state.getValues(var)));
+void Projections::project(const RelaxedState& state, const VariableIdxVector& scope, std::vector<BitsetDomain>& projection) {
+	projection.resize(scope.size());
+	for (unsigned i = 0; i < scope.size(); ++i) {
+		projection[i] = state.getDomain(scope[i]); // Assignment between bitsets of equal size reuses the storage
 	}
-	return projection;
 }
 
 PartialAssignment Projections::zip(const VariableIdxVector& scope, const ObjectIdxVector& values) {
@@ -49,8 +48,7 @@ const DomainVector Projections::projectValues(const RelaxedState& state, const V
 DomainMap Projections::projectCopy(const RelaxedState& state, const VariableIdxVector& scope) {
 	DomainMap projection;
 	for (VariableIdx var:scope) {
-		projection.insert(std::make_pair(var, std::make_shared<Domain>(*(state.getValues(var))))); // We copy construct the whole domain
-		assert( *(state.getValues(var)) == *(projection.at(var)) );
+		projection.insert(std::make_pair(var, state.getValues(var))); // The relaxed state returns a copy of the whole domain
 	}
 	return projection;
 }	
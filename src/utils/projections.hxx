@@ -2,6 +2,7 @@
 #pragma once
 
 #include <fs_types.hxx>
+#include <constraints/direct/bitset_domain.hxx>
 
 
 namespace fs0 {
@@ -16,14 +17,14 @@ public:
 	//! Zip a scope and a values to an equivalent partial assignment
 	static PartialAssignment zip(const VariableIdxVector& scope, const ObjectIdxVector& values);
 	
-	//! Project values only - no copy, const version
+	//! Project values only, copied as set-based domains
 	static const DomainVector projectValues(const RelaxedState& state, const VariableIdxVector& scope);
 	
 	/**
-	 * Returns the projection of the domains of a relaxed state into a subset of variables.
-	 * It is assumed that scope contains no repeated indexes.
+	 * Copies the bitset domains of a relaxed state for the variables in 'scope' into 'projection', in the same order.
+	 * The bitsets already in 'projection' are overwritten, hence no allocation is made when it comes from a previous projection.
 	 */
-	static DomainMap project(RelaxedState& state, const VariableIdxVector& scope);
+	static void project(const RelaxedState& state, const VariableIdxVector& scope, std::vector<BitsetDomain>& projection);
 	
 	/**
 	 * Returns the projection of the domains of a relaxed state into a subset of variables, cloning the projected domains.
@@ -1,9 +1,46 @@
 
 #include <utils/static.hxx>
+#include <utils/tuple_file.hxx>
 #include <problem_info.hxx>
 
 namespace fs0 {
 
+//! Helpers to flatten the (de)serialized extensions into static tables
+static ValueTuple to_tuple(int x) { return {x}; }
+static ValueTuple to_tuple(const std::pair<int, int>& x) { return {x.first, x.second}; }
+static ValueTuple to_tuple(const std::tuple<int, int, int>& x) { return {std::get<0>(x), std::get<1>(x), std::get<2>(x)}; }
+static ValueTuple to_tuple(const std::tuple<int, int, int, int>& x) { return {std::get<0>(x), std::get<1>(x), std::get<2>(x), std::get<3>(x)}; }
+
+template <typename MapT>
+static utils::StaticTable function_table(const MapT& data, std::size_t arity) {
+	utils::StaticTable::EntriesT entries;
+	entries.reserve(data.size());
+	for (const auto& elem:data) entries.push_back(std::make_pair(to_tuple(elem.first), elem.second));
+	return utils::StaticTable::function(entries, arity);
+}
+
+template <typename SetT>
+static utils::StaticTable predicate_table(const SetT& data, std::size_t arity) {
+	std::vector<ValueTuple> tuples;
+	tuples.reserve(data.size());
+	for (const auto& elem:data) tuples.push_back(to_tuple(elem));
+	return utils::StaticTable::predicate(tuples, arity);
+}
+
+ZeroaryFunction::ZeroaryFunction(ObjectIdx data) : StaticExtension(utils::StaticTable::function({{ValueTuple(), data}}, 0)) {}
+
+UnaryFunction::UnaryFunction(Serializer::BoostUnaryMap&& data) : StaticExtension(function_table(data, 1)) {}
+UnaryPredicate::UnaryPredicate(Serializer::BoostUnarySet&& data) : StaticExtension(predicate_table(data, 1)) {}
+
+BinaryFunction::BinaryFunction(Serializer::BoostBinaryMap&& data) : StaticExtension(function_table(data, 2)) {}
+BinaryPredicate::BinaryPredicate(Serializer::BoostBinarySet&& data) : StaticExtension(predicate_table(data, 2)) {}
+
+Arity3Function::Arity3Function(Serializer::BoostArity3Map&& data) : StaticExtension(function_table(data, 3)) {}
+Arity3Predicate::Arity3Predicate(Serializer::BoostArity3Set&& data) : StaticExtension(predicate_table(data, 3)) {}
+
+Arity4Function::Arity4Function(Serializer::BoostArity4Map&& data) : StaticExtension(function_table(data, 4)) {}
+Arity4Predicate::Arity4Predicate(Serializer::BoostArity4Set&& data) : StaticExtension(predicate_table(data, 4)) {}
+
 
 std::unique_ptr<StaticExtension>
 StaticExtension::load_static_extension(const std::string& name, const ProblemInfo& info) {
@@ -13,6 +50,11 @@ StaticExtension::load_static_extension(const std::string& name, const ProblemInf
 	SymbolData::Type type = data.getType();
 	assert(type == SymbolData::Type::PREDICATE || type == SymbolData::Type::FUNCTION);
 	
+	std::string binary_filename = info.getDataDir() + "/" + name + ".bin";
+	if (utils::TupleFile::exists(binary_filename)) {
+		return load_binary_extension(binary_filename, type == SymbolData::Type::PREDICATE, arity);
+	}
+	
 	std::string filename = info.getDataDir() + "/" + name + ".data";
 	StaticExtension* extension = nullptr;
 	
@@ -41,4 +83,30 @@ StaticExtension::load_static_extension(const std::string& name, const ProblemInf
 	return std::unique_ptr<StaticExtension>(extension);
 }
 
+std::unique_ptr<StaticExtension>
+StaticExtension::load_binary_extension(const std::string& filename, bool predicate, unsigned arity) {
+	// Nullary symbols, even predicates, are stored as their single value, as in the text format
+	predicate = predicate && arity > 0;
+	utils::TupleFile file(filename);
+	const std::size_t width = predicate ? arity : arity + 1;
+	if (file.num_sections() != 1 || file.section(0).width() != width || (arity == 0 && file.section(0).rows() != 1)) {
+		throw std::runtime_error("Unexpected contents of static data file '" + filename + "'");
+	}
+	
+	// The table is built right from the mapped data, which is unmapped once the extension is loaded
+	const utils::TupleFile::Section& section = file.section(0);
+	utils::StaticTable table = predicate ? utils::StaticTable::predicate(section.data(), section.rows(), arity)
+	                                     : utils::StaticTable::function(section.data(), section.rows(), arity);
+	StaticExtension* extension = nullptr;
+	
+	if (arity == 0) extension = new ZeroaryFunction(std::move(table));
+	else if (arity == 1) extension = predicate ? (StaticExtension*) new UnaryPredicate(std::move(table)) : new UnaryFunction(std::move(table));
+	else if (arity == 2) extension = predicate ? (StaticExtension*) new BinaryPredicate(std::move(table)) : new BinaryFunction(std::move(table));
+	else if (arity == 3) extension = predicate ? (StaticExtension*) new Arity3Predicate(std::move(table)) : new Arity3Function(std::move(table));
+	else if (arity == 4) extension = predicate ? (StaticExtension*) new Arity4Predicate(std::move(table)) : new Arity4Function(std::move(table));
+	else WORK_IN_PROGRESS("Such high symbol arities have not yet been implemented");
+	
+	return std::unique_ptr<StaticExtension>(extension);
+}
+
 } // namespaces
@@ -1,187 +1,127 @@
-
 #pragma once
 
 #include <fs_types.hxx>
 #include <utils/serializer.hxx>
+#include <utils/static_table.hxx>
 
 namespace fs0 {
 
 class ProblemInfo;
 
+//! The extension of a static symbol, as loaded from the data files of the problem, either from the binary,
+//! memory-mapped 'name.bin' file, if the preprocessor generated it, or else from the text 'name.data' file.
+//! All extensions are stored in a flat utils::StaticTable, which is what the interpretation of static terms
+//! looks up directly; the subclasses merely offer typed accessors for the use of externally-defined components.
 class StaticExtension {
 public:
+	explicit StaticExtension(utils::StaticTable&& table) : _table(std::move(table)) {}
 	virtual ~StaticExtension() = default;
-	virtual Function get_function() const = 0;
+
+	Function get_function() const { return _table.get_function(); }
+
+	const utils::StaticTable& get_table() const { return _table; }
 	
 	//! Factory method
 	static std::unique_ptr<StaticExtension> load_static_extension(const std::string& name, const ProblemInfo& info);
+	
+	//! Load the extension of a symbol with the given arity from the given binary data file
+	static std::unique_ptr<StaticExtension> load_binary_extension(const std::string& filename, bool predicate, unsigned arity);
+
+protected:
+	utils::StaticTable _table;
 };
 
 
 class ZeroaryFunction : public StaticExtension {
-protected:
-	ObjectIdx _data;
-	
 public:
-	ZeroaryFunction(ObjectIdx data) : _data(data) {}
+	using StaticExtension::StaticExtension;
+	ZeroaryFunction(ObjectIdx data);
 	
-	ObjectIdx value() const { return _data; }
-	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 0);
-			return data;
-		};
-	}
+	ObjectIdx value() const { return _table.value(nullptr, 0); }
 };
 
 class UnaryFunction : public StaticExtension {
-protected:
-	Serializer::BoostUnaryMap _data;
-	
 public:
-	UnaryFunction(Serializer::BoostUnaryMap&& data) : _data(std::move(data)) {}
-	
-	ObjectIdx value(ObjectIdx x) const { return _data.at(x); }
+	using StaticExtension::StaticExtension;
+	UnaryFunction(Serializer::BoostUnaryMap&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 1);
-			return data.at(parameters[0]);
-		};
-	}
+	ObjectIdx value(ObjectIdx x) const { return _table.value(&x, 1); }
 };
 
 class UnaryPredicate : public StaticExtension {
-protected:
-	Serializer::BoostUnarySet _data;
-	
 public:
-	UnaryPredicate(Serializer::BoostUnarySet&& data) : _data(std::move(data)) {}
-	
-	bool value(ObjectIdx x) const { return _data.find(x) != _data.end(); }
+	using StaticExtension::StaticExtension;
+	UnaryPredicate(Serializer::BoostUnarySet&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 1);
-			return data.find(parameters[0]) != data.end();
-		};
-	}
+	bool value(ObjectIdx x) const { return _table.value(&x, 1); }
 };
 
 
 class BinaryFunction : public StaticExtension {
-protected:
-	Serializer::BoostBinaryMap _data;
-	
 public:
-	BinaryFunction(Serializer::BoostBinaryMap&& data) : _data(std::move(data)) {}
-	
-	ObjectIdx value(ObjectIdx x, ObjectIdx y) const { return _data.at({x, y}); }
+	using StaticExtension::StaticExtension;
+	BinaryFunction(Serializer::BoostBinaryMap&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 2);
-			return data.at({parameters[0], parameters[1]});
-		};
+	ObjectIdx value(ObjectIdx x, ObjectIdx y) const {
+		const ObjectIdx arguments[] = {x, y};
+		return _table.value(arguments, 2);
 	}
-	
-	const Serializer::BoostBinaryMap& get_data() const { return _data; }
 };
 
 class BinaryPredicate : public StaticExtension {
-protected:
-	Serializer::BoostBinarySet _data;
-	
 public:
-	BinaryPredicate(Serializer::BoostBinarySet&& data) : _data(std::move(data)) {}
+	using StaticExtension::StaticExtension;
+	BinaryPredicate(Serializer::BoostBinarySet&& data);
 	
-	bool value(ObjectIdx x, ObjectIdx y) const { return _data.find({x,y}) != _data.end(); }
-	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 2);
-			return data.find({parameters[0], parameters[1]}) != data.end();
-		};
+	bool value(ObjectIdx x, ObjectIdx y) const {
+		const ObjectIdx arguments[] = {x, y};
+		return _table.value(arguments, 2);
 	}
 };
 
 class Arity3Function : public StaticExtension {
-protected:
-	Serializer::BoostArity3Map _data;
-	
 public:
-	Arity3Function(Serializer::BoostArity3Map&& data) : _data(std::move(data)) {}
-	
-	ObjectIdx value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2) const { return _data.at(std::make_tuple(x0,x1,x2)); }
+	using StaticExtension::StaticExtension;
+	Arity3Function(Serializer::BoostArity3Map&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 3);
-			return data.at(std::make_tuple(parameters[0], parameters[1], parameters[2]));
-		};
+	ObjectIdx value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2) const {
+		const ObjectIdx arguments[] = {x0, x1, x2};
+		return _table.value(arguments, 3);
 	}
 };
 
 class Arity3Predicate : public StaticExtension {
-protected:
-	Serializer::BoostArity3Set _data;
-	
 public:
-	Arity3Predicate(Serializer::BoostArity3Set&& data) : _data(std::move(data)) {}
-	
-	bool value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2) const { return _data.find(std::make_tuple(x0,x1,x2)) != _data.end(); }
+	using StaticExtension::StaticExtension;
+	Arity3Predicate(Serializer::BoostArity3Set&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 3);
-			return data.find(std::make_tuple(parameters[0], parameters[1], parameters[2])) != data.end();
-		};
+	bool value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2) const {
+		const ObjectIdx arguments[] = {x0, x1, x2};
+		return _table.value(arguments, 3);
 	}
 };
 
 class Arity4Function : public StaticExtension {
-protected:
-	Serializer::BoostArity4Map _data;
-	
 public:
-	Arity4Function(Serializer::BoostArity4Map&& data) : _data(std::move(data)) {}
+	using StaticExtension::StaticExtension;
+	Arity4Function(Serializer::BoostArity4Map&& data);
 	
-	ObjectIdx value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2, ObjectIdx x3) const { return _data.at(std::make_tuple(x0,x1,x2,x3)); }
-	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 4);
-			return data.at(std::make_tuple(parameters[0], parameters[1], parameters[2], parameters[3]));
-		};
+	ObjectIdx value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2, ObjectIdx x3) const {
+		const ObjectIdx arguments[] = {x0, x1, x2, x3};
+		return _table.value(arguments, 4);
 	}
 };
 
 class Arity4Predicate : public StaticExtension {
-protected:
-	Serializer::BoostArity4Set _data;
-	
 public:
-	Arity4Predicate(Serializer::BoostArity4Set&& data) : _data(std::move(data)) {}
-	
-	bool value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2, ObjectIdx x3) const { return _data.find(std::make_tuple(x0,x1,x2,x3)) != _data.end(); }
+	using StaticExtension::StaticExtension;
+	Arity4Predicate(Serializer::BoostArity4Set&& data);
 	
-	Function get_function() const override {
-		auto& data = _data;
-		return [&data](const ValueTuple& parameters){
-			assert(parameters.size() == 4);
-			return data.find(std::make_tuple(parameters[0], parameters[1], parameters[2], parameters[3])) != data.end();
-		};
+	bool value(ObjectIdx x0, ObjectIdx x1, ObjectIdx x2, ObjectIdx x3) const {
+		const ObjectIdx arguments[] = {x0, x1, x2, x3};
+		return _table.value(arguments, 4);
 	}
 };
 
 
-} // namespaces
\ No newline at end of file
+} // namespaces
@@ -0,0 +1,132 @@
+
+#include <limits>
+
+#include <utils/static_table.hxx>
+
+
+namespace fs0 { namespace utils {
+
+const std::size_t StaticTable::MAX_DENSE_SLOTS_PER_TUPLE;
+const std::size_t StaticTable::MAX_DENSE_BITS_PER_TUPLE;
+const std::size_t StaticTable::MIN_DENSE_SIZE;
+
+StaticTable
+StaticTable::function(const EntriesT& entries, std::size_t arity) {
+	std::vector<ObjectIdx> points;
+	points.reserve(entries.size() * (arity + 1));
+	for (const auto& entry:entries) {
+		if (entry.first.size() != arity) throw std::runtime_error("All tuples of a static extension need to have the same arity");
+		points.insert(points.end(), entry.first.begin(), entry.first.end());
+		points.push_back(entry.second);
+	}
+	return StaticTable(points.data(), entries.size(), arity, false);
+}
+
+StaticTable
+StaticTable::predicate(const std::vector<ValueTuple>& tuples, std::size_t arity) {
+	std::vector<ObjectIdx> flat;
+	flat.reserve(tuples.size() * arity);
+	for (const ValueTuple& tuple:tuples) {
+		if (tuple.size() != arity) throw std::runtime_error("All tuples of a static extension need to have the same arity");
+		flat.insert(flat.end(), tuple.begin(), tuple.end());
+	}
+	return StaticTable(flat.data(), tuples.size(), arity, true);
+}
+
+StaticTable
+StaticTable::function(const ObjectIdx* points, std::size_t size, std::size_t arity) {
+	return StaticTable(points, size, arity, false);
+}
+
+StaticTable
+StaticTable::predicate(const ObjectIdx* tuples, std::size_t size, std::size_t arity) {
+	return StaticTable(tuples, size, arity, true);
+}
+
+StaticTable::StaticTable(const ObjectIdx* rows, std::size_t size, std::size_t arity, bool predicate) :
+	_arity(arity), _size(size), _predicate(predicate), _layout(Layout::Dense),
+	_offsets(arity, 0), _radixes(arity, 0), _bits(), _codes(), _values(), _tuples()
+{
+	const std::size_t stride = _predicate ? _arity : _arity + 1;
+	auto row = [rows, stride](std::size_t i) { return rows + i * stride; };
+
+	// Compute the range of objects on each position of the tuples. An empty extension gets null radixes,
+	// so that every lookup falls outside of the range (but for arity 0, where the single code is left unset)
+	std::vector<int64_t> max(_arity, std::numeric_limits<int64_t>::min());
+	if (_size > 0) _offsets.assign(_arity, std::numeric_limits<int64_t>::max());
+	for (std::size_t j = 0; j < _size; ++j) {
+		for (std::size_t i = 0; i < _arity; ++i) {
+			_offsets[i] = std::min<int64_t>(_offsets[i], row(j)[i]);
+			max[i] = std::max<int64_t>(max[i], row(j)[i]);
+		}
+	}
+
+	uint64_t span = 1;
+	bool overflow = false;
+	for (std::size_t i = 0; i < _arity && _size > 0; ++i) {
+		_radixes[i] = static_cast<uint64_t>(max[i] - _offsets[i]) + 1;
+		if (span > std::numeric_limits<uint64_t>::max() / _radixes[i]) overflow = true;
+		else span *= _radixes[i];
+	}
+
+	if (overflow) {
+		_layout = Layout::Hashed;
+		for (std::size_t j = 0; j < _size; ++j) {
+			_tuples.insert(std::make_pair(ValueTuple(row(j), row(j) + _arity), _predicate ? 1 : row(j)[_arity]));
+		}
+		if (_tuples.size() != _size) throw std::runtime_error("Duplicate tuple in static extension");
+		return;
+	}
+
+	const std::size_t slots_per_tuple = _predicate ? MAX_DENSE_BITS_PER_TUPLE : MAX_DENSE_SLOTS_PER_TUPLE;
+	if (span > std::max(MIN_DENSE_SIZE, slots_per_tuple * _size)) _layout = Layout::Sorted;
+
+	std::vector<std::pair<uint64_t, ObjectIdx>> coded;
+	coded.reserve(_size);
+	for (std::size_t j = 0; j < _size; ++j) {
+		uint64_t code = 0;
+		for (std::size_t i = 0; i < _arity; ++i) {
+			code = code * _radixes[i] + static_cast<uint64_t>(row(j)[i] - _offsets[i]);
+		}
+		coded.push_back(std::make_pair(code, _predicate ? 1 : row(j)[_arity]));
+	}
+
+	if (_layout == Layout::Dense) {
+		_bits.assign(span, false);
+		if (!_predicate) _values.assign(span, 0);
+		for (const auto& elem:coded) {
+			if (_bits[elem.first]) throw std::runtime_error("Duplicate tuple in static extension");
+			_bits[elem.first] = true;
+			if (!_predicate) _values[elem.first] = elem.second;
+		}
+		return;
+	}
+
+	std::sort(coded.begin(), coded.end());
+	_codes.reserve(coded.size());
+	if (!_predicate) _values.reserve(coded.size());
+	for (const auto& elem:coded) {
+		if (!_codes.empty() && _codes.back() == elem.first) throw std::runtime_error("Duplicate tuple in static extension");
+		_codes.push_back(elem.first);
+		if (!_predicate) _values.push_back(elem.second);
+	}
+}
+
+Function
+StaticTable::get_function() const {
+	return [this](const ValueTuple& arguments) { return value(arguments); };
+}
+
+void
+StaticTable::throw_undefined() {
+	throw std::out_of_range("Static function undefined on the given arguments");
+}
+
+ObjectIdx
+StaticTable::hashed_value(const ObjectIdx* arguments) const {
+	auto it = _tuples.find(ValueTuple(arguments, arguments + _arity));
+	if (it == _tuples.end()) return undefined();
+	return it->second;
+}
+
+} } // namespaces
@@ -0,0 +1,129 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <fs_types.hxx>
+
+
+namespace fs0 { namespace utils {
+
+//! The flat, immutable extension of a static function or predicate symbol, i.e. the value of the symbol on each
+//! tuple of arguments where it is defined. Tuples are encoded into a single integer through mixed-radix offsets,
+//! as in TupleTable, the i-th digit being the distance of the i-th argument to the smallest object that appears
+//! on that position. Depending on the density of the extension, i.e. on how many of the possible codes do denote
+//! a tuple of the extension, it is stored in one of the following layouts:
+//!   - Dense: a bitset indexed by the code telling whether the tuple is in the extension and, for functions,
+//!     an array of values indexed by the code.
+//!   - Sorted: a sorted array of the codes of the tuples in the extension and, for functions, a parallel array
+//!     of values, looked up by binary search.
+//!   - Hashed: a hash table of the tuples themselves, used only when codes do not fit in 64 bits.
+//! Lookups are non-virtual and can be inlined into the caller, unlike those through a 'Function' object.
+class StaticTable {
+public:
+	using EntriesT = std::vector<std::pair<ValueTuple, ObjectIdx>>;
+
+	enum class Layout {Dense, Sorted, Hashed};
+
+	//! Dense layouts are used as long as they need at most this many slots per tuple (or MIN_DENSE_SIZE slots in total);
+	//! slots of predicates take a single bit, hence a sparser predicate extension can still be stored densely.
+	static const std::size_t MAX_DENSE_SLOTS_PER_TUPLE = 8;
+	static const std::size_t MAX_DENSE_BITS_PER_TUPLE = 64;
+	static const std::size_t MIN_DENSE_SIZE = 1024;
+
+	//! The extension of a function with the given points, all of which need to have the same arity and different tuples
+	static StaticTable function(const EntriesT& entries, std::size_t arity);
+
+	//! The extension of a predicate that holds exactly on the given tuples, all of which need to have the same arity
+	static StaticTable predicate(const std::vector<ValueTuple>& tuples, std::size_t arity);
+
+	//! Same as above, but with the points of the function (the arguments followed by the value) or the tuples
+	//! of the predicate laid out contiguously in memory, one after the other, as e.g. in a mapped TupleFile
+	static StaticTable function(const ObjectIdx* points, std::size_t size, std::size_t arity);
+	static StaticTable predicate(const ObjectIdx* tuples, std::size_t size, std::size_t arity);
+
+	//! The value of the symbol on the given arguments: for functions, throws std::out_of_range if the symbol
+	//! is not defined on them; for predicates, 1 if the arguments are in the extension and 0 otherwise.
+	inline ObjectIdx value(const ObjectIdx* arguments, std::size_t arity) const {
+		assert(arity == _arity);
+		if (_layout == Layout::Hashed) return hashed_value(arguments);
+
+		uint64_t code = 0;
+		for (std::size_t i = 0; i < arity; ++i) {
+			const uint64_t digit = static_cast<uint64_t>(static_cast<int64_t>(arguments[i]) - _offsets[i]);
+			if (digit >= _radixes[i]) return undefined(); // Note that this also covers values below the offset
+			code = code * _radixes[i] + digit;
+		}
+
+		if (_layout == Layout::Dense) {
+			if (!_bits[code]) return undefined();
+			return _predicate ? 1 : _values[code];
+		}
+
+		auto it = std::lower_bound(_codes.begin(), _codes.end(), code);
+		if (it == _codes.end() || *it != code) return undefined();
+		return _predicate ? 1 : _values[it - _codes.begin()];
+	}
+	ObjectIdx value(const ValueTuple& arguments) const { return value(arguments.data(), arguments.size()); }
+
+	//! A 'Function' object that looks up the table, which needs to outlive it
+	Function get_function() const;
+
+	//! The number of tuples in the extension
+	std::size_t size() const { return _size; }
+
+	std::size_t arity() const { return _arity; }
+
+	bool is_predicate() const { return _predicate; }
+
+	Layout layout() const { return _layout; }
+
+protected:
+	//! Build the extension from 'size' contiguous rows, each with the arguments and, for functions, the value
+	StaticTable(const ObjectIdx* rows, std::size_t size, std::size_t arity, bool predicate);
+
+	//! The value of the symbol on arguments outside its extension
+	ObjectIdx undefined() const {
+		if (_predicate) return 0;
+		throw_undefined();
+	}
+
+	[[noreturn]] static void throw_undefined();
+
+	ObjectIdx hashed_value(const ObjectIdx* arguments) const;
+
+	std::size_t _arity;
+
+	std::size_t _size;
+
+	bool _predicate;
+
+	Layout _layout;
+
+	//! The smallest object on each position of the tuples, and the number of possible digits on each position
+	std::vector<int64_t> _offsets;
+	std::vector<uint64_t> _radixes;
+
+	//! Dense layout: which codes denote a tuple of the extension
+	std::vector<bool> _bits;
+
+	//! Sorted layout: the codes of the tuples of the extension, in increasing order
+	std::vector<uint64_t> _codes;
+
+	//! The values of the function, indexed by code (dense layout) or parallel to '_codes' (sorted layout); empty for predicates
+	std::vector<ObjectIdx> _values;
+
+	//! Hashed layout: the value of each tuple of the extension
+	std::unordered_map<ValueTuple, ObjectIdx, boost::hash<ValueTuple>> _tuples;
+};
+
+} } // namespaces
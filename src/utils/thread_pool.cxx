@@ -0,0 +1,80 @@
+
+#include <utils/thread_pool.hxx>
+
+
+namespace fs0 { namespace utils {
+
+ThreadPool::ThreadPool(unsigned num_threads) :
+	_workers(), _task(nullptr), _num_tasks(0), _next(0), _active(0), _generation(0), _stop(false), _exception(nullptr)
+{
+	for (unsigned i = 1; i < num_threads; ++i) {
+		_workers.emplace_back(&ThreadPool::loop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wakeup.notify_all();
+	for (auto& worker:_workers) worker.join();
+}
+
+void
+ThreadPool::parallel_for(std::size_t num_tasks, const TaskT& task) {
+	if (_workers.empty() || num_tasks <= 1) { // No need to bother the workers
+		for (std::size_t i = 0; i < num_tasks; ++i) task(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		_num_tasks = num_tasks;
+		_next = 0;
+		_active = _workers.size();
+		_exception = nullptr;
+		++_generation;
+	}
+	_wakeup.notify_all();
+
+	work();
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_done.wait(lock, [this]{ return _active == 0; });
+	_task = nullptr;
+	if (_exception) std::rethrow_exception(_exception);
+}
+
+void
+ThreadPool::loop() {
+	std::size_t seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_wakeup.wait(lock, [this, seen]{ return _stop || _generation != seen; });
+			if (_stop) return;
+			seen = _generation;
+		}
+
+		work();
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_active == 0) _done.notify_one();
+	}
+}
+
+void
+ThreadPool::work() {
+	for (std::size_t i = _next++; i < _num_tasks; i = _next++) {
+		try {
+			(*_task)(i);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_exception) _exception = std::current_exception();
+		}
+	}
+}
+
+} } // namespaces
@@ -0,0 +1,78 @@
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace fs0 { namespace utils {
+
+//! A fixed pool of worker threads able to run parallel loops, i.e. a number of independent tasks
+//! identified by their index. The thread that launches the loop takes part in it, and blocks
+//! until all tasks have been performed, hence a pool of size n runs n-1 extra threads.
+//! Tasks are handed out to threads dynamically, one at a time, and thus in no particular order;
+//! any ordering requirement on the results must be enforced by the caller.
+class ThreadPool {
+public:
+	using TaskT = std::function<void(std::size_t)>;
+
+protected:
+	//! The worker threads
+	std::vector<std::thread> _workers;
+
+	//! The synchronization primitives of the pool
+	std::mutex _mutex;
+	std::condition_variable _wakeup;
+	std::condition_variable _done;
+
+	//! The loop currently being run, if any, and its number of tasks
+	const TaskT* _task;
+	std::size_t _num_tasks;
+
+	//! The index of the next task to be performed
+	std::atomic<std::size_t> _next;
+
+	//! The number of workers that have not yet finished their part of the current loop
+	unsigned _active;
+
+	//! Incremented on each new loop, so that workers can tell whether there is new work
+	std::size_t _generation;
+
+	//! Whether the workers need to terminate
+	bool _stop;
+
+	//! The first exception thrown by any task of the current loop, if any
+	std::exception_ptr _exception;
+
+public:
+	//! Construct a pool running loops on a total of 'num_threads' threads, the caller's included
+	explicit ThreadPool(unsigned num_threads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	//! The total number of threads of the pool, the caller's included
+	unsigned size() const { return _workers.size() + 1; }
+
+	//! Run 'task(i)' for all i in [0, num_tasks), returning once all of them are done.
+	//! If some task throws, the first exception is rethrown here once the rest of the tasks are done.
+	void parallel_for(std::size_t num_tasks, const TaskT& task);
+
+protected:
+	//! The main loop of each worker thread
+	void loop();
+
+	//! Perform tasks of the current loop until none is left
+	void work();
+};
+
+} } // namespaces
@@ -0,0 +1,45 @@
+
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+
+namespace fs0 { namespace utils {
+
+//! A registry of the instances of some per-thread (thread_local) object, e.g. a cache, through which any thread
+//! can reach the instances of all threads, e.g. to clear them or to aggregate their statistics.
+//! Instances register themselves on construction and unregister on destruction, i.e. when their thread exits.
+//! The registry only synchronizes the set of instances: whoever visits the instances of other threads must make sure
+//! that those threads are not using them at the time, e.g. because they are idle workers of some thread pool.
+template <typename T>
+class ThreadRegistry {
+protected:
+	std::mutex _mutex;
+	std::vector<T*> _instances;
+
+public:
+	void add(T* instance) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_instances.push_back(instance);
+	}
+
+	//! Unregister the given instance, calling 'retire(instance)' while the registry is locked, e.g. to keep its
+	//! statistics after its thread is gone, so that no visitor can miss them or count them twice
+	template <typename FunctionT>
+	void remove(T* instance, FunctionT retire) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_instances.erase(std::remove(_instances.begin(), _instances.end(), instance), _instances.end());
+		retire(*instance);
+	}
+
+	//! Call 'function(instances)' on the vector of the instances of all threads, with the registry locked
+	template <typename FunctionT>
+	void visit(FunctionT function) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		function(const_cast<const std::vector<T*>&>(_instances));
+	}
+};
+
+} } // namespaces
@@ -0,0 +1,128 @@
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utils/tuple_file.hxx>
+
+
+namespace fs0 { namespace utils {
+
+const char TupleFile::MAGIC[8] = {'F', 'S', 'T', 'U', 'P', 'L', 'E', '1'};
+
+static const std::size_t FILE_HEADER_SIZE = 16;
+static const std::size_t SECTION_HEADER_SIZE = 24;
+
+static_assert(sizeof(ObjectIdx) == sizeof(int32_t), "Tuple files store objects as 32-bit integers");
+
+//! Both the preprocessor and the planner store integers in the native byte order, which we only accept if little-endian
+static bool is_little_endian() {
+	const uint16_t value = 1;
+	unsigned char first;
+	std::memcpy(&first, &value, 1);
+	return first == 1;
+}
+
+template <typename T>
+static T read_field(const char* address) {
+	T value;
+	std::memcpy(&value, address, sizeof(T));
+	return value;
+}
+
+template <typename T>
+static void write_field(std::ostream& out, T value) {
+	out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+TupleFile::TupleFile(const std::string& filename) :
+	_filename(filename), _data(nullptr), _size(0), _sections()
+{
+	if (!is_little_endian()) throw std::runtime_error("Tuple files are only supported on little-endian architectures");
+
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) throw std::runtime_error("Could not open tuple file '" + filename + "'");
+
+	struct stat status;
+	if (::fstat(fd, &status) != 0 || status.st_size < (off_t) FILE_HEADER_SIZE) {
+		::close(fd);
+		throw std::runtime_error("Invalid tuple file '" + filename + "'");
+	}
+	_size = status.st_size;
+
+	_data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // The mapping remains valid after closing the descriptor
+	if (_data == MAP_FAILED) {
+		_data = nullptr;
+		throw std::runtime_error("Could not map tuple file '" + filename + "' into memory");
+	}
+
+	try {
+		const char* base = static_cast<const char*>(_data);
+		if (std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("Invalid tuple file '" + filename + "'");
+
+		const uint32_t num_sections = read_field<uint32_t>(base + 8);
+		if (_size < FILE_HEADER_SIZE + num_sections * SECTION_HEADER_SIZE) throw std::runtime_error("Truncated tuple file '" + filename + "'");
+
+		for (std::size_t i = 0; i < num_sections; ++i) {
+			const char* header = base + FILE_HEADER_SIZE + i * SECTION_HEADER_SIZE;
+			const uint64_t width = read_field<uint32_t>(header);
+			const uint64_t rows = read_field<uint64_t>(header + 8);
+			const uint64_t offset = read_field<uint64_t>(header + 16);
+
+			const uint64_t max_elements = std::numeric_limits<uint64_t>::max() / sizeof(ObjectIdx);
+			if (offset % sizeof(ObjectIdx) != 0 || offset > _size || (width > 0 && rows > max_elements / width) ||
+				rows * width * sizeof(ObjectIdx) > _size - offset) {
+				throw std::runtime_error("Invalid section " + std::to_string(i) + " in tuple file '" + filename + "'");
+			}
+			_sections.push_back(Section(reinterpret_cast<const ObjectIdx*>(base + offset), width, rows));
+		}
+	} catch (...) {
+		::munmap(_data, _size);
+		throw;
+	}
+}
+
+TupleFile::~TupleFile() {
+	if (_data) ::munmap(_data, _size);
+}
+
+bool
+TupleFile::exists(const std::string& filename) {
+	return ::access(filename.c_str(), R_OK) == 0;
+}
+
+void
+TupleFile::write(const std::string& filename, const std::vector<SectionData>& sections) {
+	std::ofstream out(filename, std::ios::binary);
+	if (!out) throw std::runtime_error("Could not open tuple file '" + filename + "' for writing");
+
+	out.write(MAGIC, sizeof(MAGIC));
+	write_field(out, static_cast<uint32_t>(sections.size()));
+	write_field(out, static_cast<uint32_t>(0));
+
+	uint64_t offset = FILE_HEADER_SIZE + sections.size() * SECTION_HEADER_SIZE;
+	for (const SectionData& section:sections) {
+		if (section.data.size() != section.width * section.rows) {
+			throw std::runtime_error("The size of a tuple file section needs to be its number of rows times its width");
+		}
+		write_field(out, static_cast<uint32_t>(section.width));
+		write_field(out, static_cast<uint32_t>(0));
+		write_field(out, static_cast<uint64_t>(section.rows));
+		write_field(out, offset);
+		offset += section.data.size() * sizeof(ObjectIdx);
+	}
+
+	for (const SectionData& section:sections) {
+		out.write(reinterpret_cast<const char*>(section.data.data()), section.data.size() * sizeof(ObjectIdx));
+	}
+	if (!out) throw std::runtime_error("Error writing tuple file '" + filename + "'");
+}
+
+} } // namespaces
@@ -0,0 +1,86 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <fs_types.hxx>
+
+
+namespace fs0 { namespace utils {
+
+//! A read-only, memory-mapped file in the binary format in which the preprocessor can optionally store the bulkiest
+//! parts of the problem data (the extensions of static symbols and the groundings of the action schemas), as an
+//! alternative to the line-based text files, which take much longer to parse. A file consists of a number of
+//! sections, each of which is a matrix of integers with a fixed number of columns (e.g. the arguments and value of
+//! each point of a static function, or the parameters of each grounding of an action schema). Sections are exposed
+//! as views into the mapped memory, hence no data is copied until the caller does so.
+//!
+//! The layout, where all integers are little-endian, is:
+//!   - An 8-byte magic string "FSTUPLE1", followed by the number of sections (uint32) and 4 bytes of padding.
+//!   - For each section, a 24-byte header: the number of columns (uint32), 4 bytes of padding, the number of
+//!     rows (uint64) and the offset (uint64) from the start of the file to the section data.
+//!   - The data of each section, as a row-major array of int32.
+class TupleFile {
+public:
+	//! A view of one section of the file, valid as long as the file is open
+	class Section {
+	public:
+		Section(const ObjectIdx* data, std::size_t width, std::size_t rows) : _data(data), _width(width), _rows(rows) {}
+
+		std::size_t width() const { return _width; }
+		std::size_t rows() const { return _rows; }
+
+		//! The i-th row of the section, of 'width()' elements
+		const ObjectIdx* row(std::size_t i) const { return _data + i * _width; }
+
+		//! All the rows of the section, contiguously
+		const ObjectIdx* data() const { return _data; }
+
+	protected:
+		const ObjectIdx* _data;
+		std::size_t _width;
+		std::size_t _rows;
+	};
+
+	//! The contents of a section to be written
+	struct SectionData {
+		std::size_t width;
+		std::size_t rows;
+		std::vector<ObjectIdx> data; // Row-major, of 'width * rows' elements
+	};
+
+	//! Map the given file into memory, throwing std::runtime_error if it cannot be read or is not a valid tuple file
+	explicit TupleFile(const std::string& filename);
+	~TupleFile();
+
+	TupleFile(const TupleFile&) = delete;
+	TupleFile& operator=(const TupleFile&) = delete;
+
+	//! Whether a file with the given name exists and can be read
+	static bool exists(const std::string& filename);
+
+	//! Write the given sections to a file with the given name, mostly for testing purposes, as the files are
+	//! usually generated by the preprocessor
+	static void write(const std::string& filename, const std::vector<SectionData>& sections);
+
+	std::size_t num_sections() const { return _sections.size(); }
+
+	const Section& section(std::size_t i) const { return _sections.at(i); }
+
+protected:
+	static const char MAGIC[8];
+
+	const std::string _filename;
+
+	//! The mapped memory
+	void* _data;
+	std::size_t _size;
+
+	std::vector<Section> _sections;
+};
+
+} } // namespaces
@@ -0,0 +1,63 @@
+
+#include <algorithm>
+#include <cassert>
+
+#include <utils/tuple_table.hxx>
+
+
+namespace fs0 { namespace utils {
+
+const unsigned TupleTable::INVALID;
+const std::size_t TupleTable::MAX_DENSE_SLOTS_PER_TUPLE;
+const std::size_t TupleTable::MIN_DENSE_SIZE;
+
+TupleTable::TupleTable() :
+	_arity(0), _size(0), _offsets(), _radixes(), _dense(true), _overflow(false), _table(), _sparse(), _tuples()
+{}
+
+TupleTable::TupleTable(const EntriesT& entries) :
+	TupleTable()
+{
+	if (entries.empty()) return;
+	_arity = entries[0].first.size();
+	_size = entries.size();
+
+	// Compute the range of objects on each position of the tuples
+	_offsets.assign(_arity, std::numeric_limits<int64_t>::max());
+	std::vector<int64_t> max(_arity, std::numeric_limits<int64_t>::min());
+	for (const auto& entry:entries) {
+		if (entry.first.size() != _arity) throw std::runtime_error("All tuples of a TupleTable need to have the same arity");
+		for (std::size_t i = 0; i < _arity; ++i) {
+			_offsets[i] = std::min<int64_t>(_offsets[i], entry.first[i]);
+			max[i] = std::max<int64_t>(max[i], entry.first[i]);
+		}
+	}
+
+	uint64_t span = 1;
+	for (std::size_t i = 0; i < _arity; ++i) {
+		_radixes.push_back(static_cast<uint64_t>(max[i] - _offsets[i]) + 1);
+		if (span > std::numeric_limits<uint64_t>::max() / _radixes[i]) _overflow = true;
+		else span *= _radixes[i];
+	}
+
+	if (_overflow) {
+		_dense = false;
+		for (const auto& entry:entries) _tuples.insert(entry);
+		assert(_tuples.size() == _size);
+		return;
+	}
+
+	_dense = span <= std::max(MIN_DENSE_SIZE, MAX_DENSE_SLOTS_PER_TUPLE * _size);
+	if (_dense) _table.assign(span, INVALID);
+
+	for (const auto& entry:entries) {
+		uint64_t code = 0;
+		for (std::size_t i = 0; i < _arity; ++i) {
+			code = code * _radixes[i] + static_cast<uint64_t>(entry.first[i] - _offsets[i]);
+		}
+		if (_dense) _table[code] = entry.second;
+		else _sparse.insert(std::make_pair(code, entry.second));
+	}
+}
+
+} } // namespaces
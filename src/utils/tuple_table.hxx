@@ -0,0 +1,94 @@
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include <fs_types.hxx>
+
+
+namespace fs0 { namespace utils {
+
+//! An immutable map from tuples of objects of some fixed arity to unsigned integers (e.g. the state variables or atoms
+//! that the tuples denote). Each tuple is encoded into a single integer through mixed-radix offsets, where the
+//! i-th digit is the distance of the i-th object of the tuple to the smallest object that appears on that position.
+//! When the range of codes is not much larger than the number of tuples, values are stored in a dense array indexed
+//! by the code; otherwise, in a hash table keyed by the code (which is collision-free, as the encoding is bijective).
+//! Only when the codes do not fit in 64 bits are tuples hashed as such.
+class TupleTable {
+public:
+	using EntriesT = std::vector<std::pair<ValueTuple, unsigned>>;
+
+	//! The value returned by 'find' for tuples not in the table
+	static const unsigned INVALID = std::numeric_limits<unsigned>::max();
+
+	//! Dense arrays are used as long as they need at most this many slots per tuple (or MIN_DENSE_SIZE slots in total)
+	static const std::size_t MAX_DENSE_SLOTS_PER_TUPLE = 8;
+	static const std::size_t MIN_DENSE_SIZE = 1024;
+
+	//! An empty table
+	TupleTable();
+
+	//! A table with the given entries, all of which need to have the same arity and different tuples
+	explicit TupleTable(const EntriesT& entries);
+
+	//! Return the value of the given tuple, or INVALID if it is not in the table
+	inline unsigned find(const ObjectIdx* tuple, std::size_t arity) const {
+		if (_size == 0 || arity != _arity) return INVALID;
+		if (_overflow) {
+			auto it = _tuples.find(ValueTuple(tuple, tuple + arity));
+			return it == _tuples.end() ? INVALID : it->second;
+		}
+
+		uint64_t code = 0;
+		for (std::size_t i = 0; i < arity; ++i) {
+			const uint64_t digit = static_cast<uint64_t>(static_cast<int64_t>(tuple[i]) - _offsets[i]);
+			if (digit >= _radixes[i]) return INVALID; // Note that this also covers values below the offset
+			code = code * _radixes[i] + digit;
+		}
+
+		if (_dense) return _table[code];
+		auto it = _sparse.find(code);
+		return it == _sparse.end() ? INVALID : it->second;
+	}
+	unsigned find(const ValueTuple& tuple) const { return find(tuple.data(), tuple.size()); }
+
+	//! Return the value of the given tuple, throwing std::out_of_range if it is not in the table
+	unsigned at(const ValueTuple& tuple) const {
+		unsigned value = find(tuple);
+		if (value == INVALID) throw std::out_of_range("Tuple not found in table");
+		return value;
+	}
+
+	//! The number of tuples in the table
+	std::size_t size() const { return _size; }
+
+	bool is_dense() const { return _dense; }
+
+protected:
+	std::size_t _arity;
+
+	std::size_t _size;
+
+	//! The smallest object on each position of the tuples, and the number of possible digits on each position
+	std::vector<int64_t> _offsets;
+	std::vector<uint64_t> _radixes;
+
+	//! Whether the values are stored in the dense array, and whether the codes overflow 64 bits
+	bool _dense;
+	bool _overflow;
+
+	//! The dense array, the sparse table and the table of tuples; only one of them is used
+	std::vector<unsigned> _table;
+	std::unordered_map<uint64_t, unsigned> _sparse;
+	std::unordered_map<ValueTuple, unsigned, boost::hash<ValueTuple>> _tuples;
+};
+
+} } // namespaces
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <lib/rapidjson/document.h>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <applicability/compiled_formula.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A small problem with two predicative variables p(a), p(b), an object-valued variable f() and an integer variable g()
+static const char* PROBLEM_DATA = R"J({
+	"types": [[0, "bool", ["0","1"]], [1, "object", ["0","1","2","3"]], [2, "num", "int", [0, 500]]],
+	"objects": [{"id":0,"name":"a"},{"id":1,"name":"b"},{"id":2,"name":"c"}],
+	"symbols": [[0, "p", "predicate", ["object"], "bool", [[0],[1]], false, false],
+	            [1, "f", "function", [], "object", [[2]], false, false],
+	            [2, "g", "function", [], "num", [[3]], false, false]],
+	"variables": [{"id":0,"name":"p(a)","type":"bool","data":[0,[0]]},{"id":1,"name":"p(b)","type":"bool","data":[0,[1]]},
+	              {"id":2,"name":"f()","type":"object","data":[1,[]]},{"id":3,"name":"g()","type":"num","data":[2,[]]}],
+	"problem": {"domain":"test","instance":"test"}
+})J";
+
+class CompiledFormulaBenchmark : public testing::Test {
+protected:
+	static void SetUpTestCase() {
+		rapidjson::Document data;
+		data.Parse(PROBLEM_DATA);
+		ProblemInfo::setInstance(std::unique_ptr<ProblemInfo>(new ProblemInfo(data, ".")));
+	}
+
+	static const fs::StateVariable* variable(VariableIdx var, unsigned symbol) {
+		return new fs::StateVariable(var, new fs::FluentHeadedNestedTerm(symbol, {}));
+	}
+
+	//! p(a) = 1 and f() != 2 and g() + 1 > 3 and g() * 2 <= 900 and g() - 10 != f()
+	static const fs::Formula* build_formula() {
+		return new fs::Conjunction({
+			new fs::EQAtomicFormula({variable(0, 0), new fs::Constant(1)}),
+			new fs::NEQAtomicFormula({variable(2, 1), new fs::Constant(2)}),
+			new fs::GTAtomicFormula({new fs::AdditionTerm({variable(3, 2), new fs::IntConstant(1)}), new fs::IntConstant(3)}),
+			new fs::LEQAtomicFormula({new fs::MultiplicationTerm({variable(3, 2), new fs::IntConstant(2)}), new fs::IntConstant(900)}),
+			new fs::NEQAtomicFormula({new fs::SubtractionTerm({variable(3, 2), new fs::IntConstant(10)}), variable(2, 1)})
+		});
+	}
+
+	//! A number of random states, indexed by the given indexer
+	static std::vector<State> random_states(const StateAtomIndexer& indexer, unsigned n) {
+		std::mt19937 generator(1);
+		std::vector<State> states;
+		for (unsigned i = 0; i < n; ++i) {
+			std::unique_ptr<State> state(State::create(indexer, 4, {
+				Atom(0, generator() % 2), Atom(1, generator() % 2), Atom(2, generator() % 4), Atom(3, generator() % 501)
+			}));
+			states.push_back(*state);
+		}
+		return states;
+	}
+};
+
+//! The number of evaluations per second of the compiled formula and of the formula tree
+TEST_F(CompiledFormulaBenchmark, Evaluations) {
+	const unsigned rounds = 200;
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(ProblemInfo::getInstance()));
+	std::unique_ptr<const fs::Formula> formula(build_formula());
+	std::unique_ptr<const CompiledFormula> compiled(CompiledFormula::compile(formula.get(), *indexer));
+	const std::vector<State> states = random_states(*indexer, 10000);
+
+	benchmarks::PerfCounters counters;
+	unsigned interpreted_count = 0, compiled_count = 0;
+	auto interpreted = counters.measure([&]() {
+		for (unsigned i = 0; i < rounds; ++i) {
+			for (const State& state:states) interpreted_count += formula->interpret(state);
+		}
+	});
+	auto flat = counters.measure([&]() {
+		for (unsigned i = 0; i < rounds; ++i) {
+			for (const State& state:states) compiled_count += compiled->satisfied(state);
+		}
+	});
+	ASSERT_EQ(interpreted_count, compiled_count);
+
+	const double evaluations = (double) rounds * states.size();
+	std::cout << "Interpreted formula: " << evaluations / (interpreted.nanoseconds / 1e9) << " evaluations/s" << std::endl;
+	std::cout << "Compiled formula: " << evaluations / (flat.nanoseconds / 1e9) << " evaluations/s (" << compiled->size() << " instructions)" << std::endl;
+	benchmarks::PerfCounters::report("Interpreted formula", interpreted, evaluations, "evaluation");
+	benchmarks::PerfCounters::report("Compiled formula", flat, evaluations, "evaluation");
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <applicability/action_managers.hxx>
+#include <applicability/match_tree.hxx>
+#include <utils/atom_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! The cost of computing the applicable actions along a random walk with the pointer-based match tree, the flat match
+//! tree, the flat match tree updated incrementally from the effects of each step, and the SmartActionManager, on a
+//! problem with a number of locations, some of them holding a token, and a schema 'move(x, y)' that moves a token
+//! to a different, clear location.
+class MatchTreeBenchmark : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 100;
+	static const unsigned NUM_TOKENS = 20;
+	static const unsigned NUM_STEPS = 2000;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	static fs::ActionEffect* assign(unsigned symbol, unsigned param, int value) {
+		return new fs::ActionEffect(new fs::FluentHeadedNestedTerm(symbol, {parameter(param)}), new fs::IntConstant(value), new fs::Tautology);
+	}
+
+	//! move(x, y): PRE x != y and at(x) and clear(y); EFF at(y) := 1, at(x) := 0, clear(x) := 1, clear(y) := 0
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(0, {parameter(0)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(1)}), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{assign(0, 1, 1), assign(0, 0, 0), assign(1, 0, 1), assign(1, 1, 0)};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	static unsigned long count_applicable(const ActionManagerI& manager, const State& state) {
+		unsigned long count = 0;
+		auto range = manager.applicable(state);
+		for (auto it = range.begin(); it != range.end(); ++it) ++count;
+		return count;
+	}
+};
+
+TEST_F(MatchTreeBenchmark, ApplicableActions) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+	std::vector<const GroundAction*> actions = ActionGrounder::fully_ground({schema.get()}, info, 1);
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	AtomIndex tuple_idx(info);
+	fs::Tautology constraints;
+
+	MatchTreeActionManager pointer_tree(actions, &constraints, tuple_idx, false);
+	MatchTreeActionManager flat_tree(actions, &constraints, tuple_idx, true);
+	BasicApplicabilityAnalyzer analyzer(actions, tuple_idx);
+	analyzer.build();
+	SmartActionManager smart(actions, &constraints, tuple_idx, analyzer);
+
+	// Place the tokens on random locations, and then move them around randomly
+	std::mt19937 generator(1);
+	std::vector<unsigned> locations(NUM_LOCATIONS);
+	std::iota(locations.begin(), locations.end(), 0);
+	std::shuffle(locations.begin(), locations.end(), generator);
+	std::vector<Atom> init;
+	for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+		bool token = std::find(locations.begin(), locations.begin() + NUM_TOKENS, l) != locations.begin() + NUM_TOKENS;
+		init.push_back(Atom(l, token));
+		init.push_back(Atom(NUM_LOCATIONS + l, !token));
+	}
+
+	std::vector<State> states{*std::unique_ptr<State>(State::create(*indexer, 2 * NUM_LOCATIONS, init))};
+	std::vector<std::vector<Atom>> effects;
+	std::vector<ActionIdx> whitelist, incremental;
+	for (unsigned step = 0; step < NUM_STEPS; ++step) {
+		const State& state = states.back();
+		whitelist.clear();
+		for (ActionIdx action:flat_tree.applicable(state)) whitelist.push_back(action);
+		const GroundAction& action = *actions[whitelist[std::uniform_int_distribution<unsigned>(0, whitelist.size() - 1)(generator)]];
+		effects.push_back(NaiveApplicabilityManager::computeEffects(state, action));
+		states.push_back(State(state, effects.back()));
+	}
+
+	const unsigned long expected = states.size() * NUM_TOKENS * (NUM_LOCATIONS - NUM_TOKENS);
+	benchmarks::PerfCounters counters;
+	unsigned long pointer_total = 0, flat_total = 0, incremental_total = 0, smart_total = 0;
+	auto pointer_sample = counters.measure([&]() {
+		for (const State& state:states) pointer_total += count_applicable(pointer_tree, state);
+	});
+	auto flat_sample = counters.measure([&]() {
+		for (const State& state:states) flat_total += count_applicable(flat_tree, state);
+	});
+	whitelist.clear();
+	for (ActionIdx action:flat_tree.applicable(states[0])) whitelist.push_back(action);
+	incremental_total = whitelist.size();
+	auto incremental_sample = counters.measure([&]() {
+		for (unsigned i = 0; i < NUM_STEPS; ++i) {
+			flat_tree.compute_whitelist(states[i+1], whitelist, effects[i], incremental);
+			std::swap(whitelist, incremental);
+			incremental_total += whitelist.size();
+		}
+	});
+	auto smart_sample = counters.measure([&]() {
+		for (const State& state:states) smart_total += count_applicable(smart, state);
+	});
+	ASSERT_EQ(expected, pointer_total);
+	ASSERT_EQ(expected, flat_total);
+	ASSERT_EQ(expected, incremental_total);
+	ASSERT_EQ(expected, smart_total);
+
+	std::cout << "Applicable actions in " << states.size() << " states, " << actions.size() << " ground actions:" << std::endl;
+	benchmarks::PerfCounters::report("\tPointer-based match tree", pointer_sample, states.size(), "state");
+	benchmarks::PerfCounters::report("\tFlat match tree", flat_sample, states.size(), "state");
+	benchmarks::PerfCounters::report("\tIncremental flat match tree", incremental_sample, NUM_STEPS, "state");
+	benchmarks::PerfCounters::report("\tSmartActionManager", smart_sample, states.size(), "state");
+
+	for (const GroundAction* action:actions) delete action;
+}
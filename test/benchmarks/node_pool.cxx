@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <utils/node_arena.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+
+//! A node of roughly the size of a search node, linked to its parent either through a plain pointer or a shared pointer
+template <bool Pooled>
+struct BenchmarkNode {
+	using PT = typename std::conditional<Pooled, BenchmarkNode*, std::shared_ptr<BenchmarkNode>>::type;
+
+	PT parent;
+	unsigned g;
+	uint32_t gen_order;
+	uint64_t payload[4];
+
+	BenchmarkNode(PT parent_, uint32_t gen_order_) : parent(parent_), g(parent ? parent->g + 1 : 0), gen_order(gen_order_), payload() {}
+};
+
+//! The sum of the depths of all nodes, which are expanded breadth-first, in order to avoid the loops being optimized away
+template <typename PT, typename MakerT>
+static unsigned long generate_tree(unsigned nodes, unsigned branching, MakerT make) {
+	std::vector<PT> layer, next;
+	layer.push_back(make(PT(), 1));
+	unsigned long depths = 0;
+	for (uint32_t generated = 1; generated < nodes; layer.swap(next), next.clear()) {
+		for (const PT& node:layer) {
+			for (unsigned k = 0; k < branching && generated < nodes; ++k) {
+				next.push_back(make(node, ++generated));
+				depths += next.back()->g;
+			}
+		}
+	}
+	return depths;
+}
+
+TEST(NodePoolBenchmark, Throughput) {
+	using SharedNode = BenchmarkNode<false>;
+	using PooledNode = BenchmarkNode<true>;
+	const unsigned nodes = 2000000, branching = 4, runs = 5;
+
+	benchmarks::PerfCounters counters;
+	unsigned long shared_sum = 0, pooled_sum = 0;
+	auto shared = counters.measure([&]() {
+		for (unsigned r = 0; r < runs; ++r) {
+			shared_sum += generate_tree<std::shared_ptr<SharedNode>>(nodes, branching, [](const std::shared_ptr<SharedNode>& parent, uint32_t order) {
+				return std::make_shared<SharedNode>(parent, order);
+			});
+		}
+	});
+	utils::NodePool<PooledNode> pool;
+	auto pooled = counters.measure([&]() {
+		for (unsigned r = 0; r < runs; ++r) {
+			pooled_sum += generate_tree<PooledNode*>(nodes, branching, [&pool](PooledNode* parent, uint32_t order) {
+				return pool.create(parent, order);
+			});
+			ASSERT_EQ(nodes, pool.size());
+			pool.clear(); // As a simulation does between two consecutive runs
+		}
+	});
+	ASSERT_EQ(shared_sum, pooled_sum);
+
+	const double total = (double) nodes * runs;
+	benchmarks::PerfCounters::report("std::make_shared nodes", shared, total, "node");
+	benchmarks::PerfCounters::report("Node pool", pooled, total, "node");
+	std::cout << "Node pool memory reserved: " << pool.reserved_bytes() / (1024 * 1024) << " MB" << std::endl;
+}
@@ -0,0 +1,124 @@
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace fs0 { namespace benchmarks {
+
+//! Measures a region of code through the hardware cycle and instruction counters of the calling thread,
+//! read through perf_event_open. Wall time is always measured as well, and is all that gets reported
+//! when the counters are unavailable, e.g. on virtual machines or when perf_event_paranoid forbids them.
+class PerfCounters {
+public:
+	using ClockT = std::chrono::steady_clock;
+
+	struct Sample {
+		double nanoseconds;
+		uint64_t cycles;
+		uint64_t instructions;
+		bool hardware; //!< Whether the cycles and instructions were actually counted
+	};
+
+protected:
+	int _cycles;
+	int _instructions;
+	ClockT::time_point _start;
+
+public:
+	PerfCounters() : _cycles(open_counter(0)), _instructions(-1) {
+		if (_cycles >= 0) _instructions = open_counter(1);
+		if (_instructions < 0) close_counters();
+	}
+
+	~PerfCounters() { close_counters(); }
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+
+	bool available() const { return _cycles >= 0; }
+
+	void start() {
+#ifdef __linux__
+		if (available()) {
+			ioctl(_cycles, PERF_EVENT_IOC_RESET, 0);
+			ioctl(_instructions, PERF_EVENT_IOC_RESET, 0);
+			ioctl(_cycles, PERF_EVENT_IOC_ENABLE, 0);
+			ioctl(_instructions, PERF_EVENT_IOC_ENABLE, 0);
+		}
+#endif
+		_start = ClockT::now();
+	}
+
+	Sample stop() {
+		auto end = ClockT::now();
+		Sample sample{std::chrono::duration<double, std::nano>(end - _start).count(), 0, 0, available()};
+#ifdef __linux__
+		if (available()) {
+			ioctl(_cycles, PERF_EVENT_IOC_DISABLE, 0);
+			ioctl(_instructions, PERF_EVENT_IOC_DISABLE, 0);
+			sample.hardware = read(_cycles, &sample.cycles, sizeof(uint64_t)) == sizeof(uint64_t)
+			               && read(_instructions, &sample.instructions, sizeof(uint64_t)) == sizeof(uint64_t);
+		}
+#endif
+		return sample;
+	}
+
+	//! Measure a single run of the given function
+	template <typename FunctionT>
+	Sample measure(FunctionT function) {
+		start();
+		function();
+		return stop();
+	}
+
+	//! Print the given sample divided by the given number of units (e.g. lookups or nodes) of the measured region
+	static void report(const std::string& label, const Sample& sample, double units, const std::string& unit) {
+		std::cout << label << ": " << sample.nanoseconds / units << " ns/" << unit;
+		if (sample.hardware) {
+			std::cout << ", " << sample.cycles / units << " cycles/" << unit << ", " << sample.instructions / units << " instructions/" << unit;
+		} else {
+			std::cout << " (hardware counters unavailable, wall time only)";
+		}
+		std::cout << std::endl;
+	}
+
+protected:
+	//! Open a disabled counter of user-space events of the calling thread: cycles (0) or instructions (1)
+	static int open_counter(unsigned which) {
+#ifdef __linux__
+		perf_event_attr attr;
+		std::memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = which == 0 ? PERF_COUNT_HW_CPU_CYCLES : PERF_COUNT_HW_INSTRUCTIONS;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+		return -1;
+#endif
+	}
+
+	void close_counters() {
+#ifdef __linux__
+		if (_cycles >= 0) close(_cycles);
+		if (_instructions >= 0) close(_instructions);
+#endif
+		_cycles = _instructions = -1;
+	}
+};
+
+} } // namespaces
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <actions/reachability.hxx>
+#include <utils/atom_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! The number of ground actions and atoms, and the grounding time, of the full grounding and of the grounding pruned
+//! by relaxed reachability, on a problem with a schema 'move(x, y)' over a random static 'link(x, y)' relation, where
+//! a third of the locations are only linked among themselves, hence cannot be reached from the initial location.
+class ReachabilityBenchmark : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 300;
+	static const unsigned FIRST_ISOLATED = 200;
+
+	static void SetUpTestCase() {
+		ProblemInfo& info = test::set_problem_info(test::linked_locations_data(NUM_LOCATIONS));
+		info.set_extension(0, std::unique_ptr<StaticExtension>(new BinaryPredicate(test::random_links(NUM_LOCATIONS, 0.03, FIRST_ISOLATED))));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	//! move(x, y): PRE link(x, y) and at(x); EFF at(y) := 1, at(x) := 0
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::EQAtomicFormula({new fs::UserDefinedStaticTerm(0, {parameter(0), parameter(1)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(1)}), new fs::IntConstant(1), new fs::Tautology),
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(0), new fs::Tautology)
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+};
+
+TEST_F(ReachabilityBenchmark, PrunedGrounding) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+	std::vector<const ActionData*> schemas{schema.get()};
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> init(State::create(*indexer, NUM_LOCATIONS, {Atom(0, 1)}));
+
+	benchmarks::PerfCounters counters;
+	std::vector<const GroundAction*> full, reachable;
+	auto full_sample = counters.measure([&]() { full = ActionGrounder::fully_ground(schemas, info, 1); });
+
+	RelaxedReachability reachability(schemas, info);
+	auto analysis_sample = counters.measure([&]() { reachability.compute(*init); });
+	auto pruned_sample = counters.measure([&]() { reachable = ActionGrounder::fully_ground(schemas, info, reachability); });
+	ASSERT_EQ(reachability.bindings(0).size(), reachable.size());
+	ASSERT_LT(reachable.size(), full.size());
+
+	const std::size_t full_atoms = AtomIndex(info, true).size(), reachable_atoms = AtomIndex(info, true, &reachability).size();
+	std::cout << "Full grounding: " << full.size() << " actions, " << full_atoms << " atoms, " << full_sample.nanoseconds / 1e6 << " ms" << std::endl;
+	std::cout << "Pruned grounding: " << reachable.size() << " actions, " << reachable_atoms << " atoms, "
+	          << (analysis_sample.nanoseconds + pruned_sample.nanoseconds) / 1e6 << " ms (of which "
+	          << analysis_sample.nanoseconds / 1e6 << " ms of reachability analysis, " << reachability.num_iterations() << " iterations)" << std::endl;
+	benchmarks::PerfCounters::report("Full grounding", full_sample, full.size(), "action");
+	benchmarks::PerfCounters::report("Reachability analysis", analysis_sample, reachable.size(), "action");
+	benchmarks::PerfCounters::report("Pruned grounding", pruned_sample, reachable.size(), "action");
+
+	for (const GroundAction* action:full) delete action;
+	for (const GroundAction* action:reachable) delete action;
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <utils/tuple_file.hxx>
+#include <utils/static.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+
+//! The load time of a large static extension (a 1000x1000 binary function) from the line-based text file
+//! that the preprocessor emits by default and from the binary FSTUPLE1 file (see utils::TupleFile).
+class TupleFileBenchmark : public testing::Test {
+protected:
+	void SetUp() override {
+		_filename = testing::TempDir() + "/tuple_file_benchmark.bin";
+		_text_filename = testing::TempDir() + "/tuple_file_benchmark.data";
+	}
+
+	void TearDown() override {
+		std::remove(_filename.c_str());
+		std::remove(_text_filename.c_str());
+	}
+
+	std::string _filename;
+	std::string _text_filename;
+};
+
+TEST_F(TupleFileBenchmark, LoadTime) {
+	const unsigned objects = 1000;
+	std::mt19937 generator(1);
+	std::vector<ObjectIdx> points;
+	for (unsigned x = 0; x < objects; ++x) {
+		for (unsigned y = 0; y < objects; ++y) points.insert(points.end(), {(ObjectIdx) x, (ObjectIdx) y, (ObjectIdx) (generator() % 1000)});
+	}
+	const std::size_t rows = points.size() / 3;
+
+	utils::TupleFile::write(_filename, {{3, rows, points}});
+	{
+		std::ofstream out(_text_filename);
+		for (unsigned i = 0; i < points.size(); i += 3) out << points[i] << "," << points[i + 1] << "," << points[i + 2] << "\n";
+	}
+
+	benchmarks::PerfCounters counters;
+	std::unique_ptr<BinaryFunction> text;
+	auto text_sample = counters.measure([&]() {
+		text = std::unique_ptr<BinaryFunction>(new BinaryFunction(Serializer::deserializeBinaryMap(_text_filename)));
+	});
+
+	// Mapping the file and reading through its rows, without building any table
+	long mapped_sum = 0;
+	auto mapped_sample = counters.measure([&]() {
+		utils::TupleFile file(_filename);
+		const auto& section = file.section(0);
+		for (std::size_t i = 0; i < section.rows(); ++i) mapped_sum += section.row(i)[2];
+	});
+
+	std::unique_ptr<StaticExtension> binary;
+	auto binary_sample = counters.measure([&]() {
+		binary = StaticExtension::load_binary_extension(_filename, false, 2);
+	});
+
+	ASSERT_EQ(text->get_table().size(), binary->get_table().size());
+	ASSERT_EQ(text->value(500, 400), dynamic_cast<const BinaryFunction&>(*binary).value(500, 400));
+	long text_sum = 0;
+	for (std::size_t i = 0; i < points.size(); i += 3) text_sum += text->value(points[i], points[i + 1]);
+	ASSERT_EQ(text_sum, mapped_sum);
+
+	std::cout << "Loading a binary function of " << rows << " points:" << std::endl;
+	benchmarks::PerfCounters::report("\tText file into a static extension", text_sample, rows, "point");
+	benchmarks::PerfCounters::report("\tFSTUPLE1 file, mapped and read", mapped_sample, rows, "point");
+	benchmarks::PerfCounters::report("\tFSTUPLE1 file into a static extension", binary_sample, rows, "point");
+	std::cout << "\tTotal: " << text_sample.nanoseconds / 1e6 << " ms from text, " << binary_sample.nanoseconds / 1e6 << " ms from binary" << std::endl;
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <utils/tuple_table.hxx>
+
+#include "perf_counters.hxx"
+
+using namespace fs0;
+
+//! The lookup cost of a TupleTable against that of the std::map that ProblemInfo formerly used to resolve state
+//! variables, on tables shaped after nested-fluent-heavy domains: 'value(c)' over 1000 counters, as in the counters
+//! domain, 'visited(x, y)' over a 60x60 grid, as in visitall with functions, and a sparse relation over 5000 objects.
+class TupleTableBenchmark : public testing::Test {
+protected:
+	static const unsigned NUM_LOOKUPS = 5000000;
+
+	static void compare(const std::string& label, const utils::TupleTable::EntriesT& entries) {
+		std::map<ValueTuple, unsigned> map(entries.begin(), entries.end());
+		utils::TupleTable table(entries);
+
+		std::mt19937 generator(1);
+		std::vector<ValueTuple> queries;
+		for (unsigned i = 0; i < 10000; ++i) queries.push_back(entries[generator() % entries.size()].first);
+
+		benchmarks::PerfCounters counters;
+		unsigned long map_sum = 0, table_sum = 0;
+		auto map_sample = counters.measure([&]() {
+			for (unsigned i = 0; i < NUM_LOOKUPS; ++i) map_sum += map.at(queries[i % queries.size()]);
+		});
+		auto table_sample = counters.measure([&]() {
+			for (unsigned i = 0; i < NUM_LOOKUPS; ++i) table_sum += table.find(queries[i % queries.size()]);
+		});
+		ASSERT_EQ(map_sum, table_sum);
+
+		std::cout << label << " (" << entries.size() << " tuples, " << (table.is_dense() ? "dense" : "sparse") << " table):" << std::endl;
+		benchmarks::PerfCounters::report("\tstd::map", map_sample, NUM_LOOKUPS, "lookup");
+		benchmarks::PerfCounters::report("\tTupleTable", table_sample, NUM_LOOKUPS, "lookup");
+	}
+};
+
+TEST_F(TupleTableBenchmark, Counters) {
+	utils::TupleTable::EntriesT entries;
+	for (unsigned c = 0; c < 1000; ++c) entries.push_back({{(ObjectIdx) c}, c});
+	compare("value(c)", entries);
+}
+
+TEST_F(TupleTableBenchmark, Grid) {
+	utils::TupleTable::EntriesT entries;
+	for (unsigned x = 0; x < 60; ++x) {
+		for (unsigned y = 0; y < 60; ++y) entries.push_back({{(ObjectIdx) (1000 + x), (ObjectIdx) (1000 + y)}, 1000 + 60 * x + y});
+	}
+	compare("visited(x, y)", entries);
+}
+
+TEST_F(TupleTableBenchmark, SparseRelation) {
+	std::mt19937 generator(1);
+	std::map<ValueTuple, unsigned> tuples;
+	while (tuples.size() < 20000) tuples.insert({{(ObjectIdx) (generator() % 5000), (ObjectIdx) (generator() % 5000)}, tuples.size()});
+	compare("link(x, y)", utils::TupleTable::EntriesT(tuples.begin(), tuples.end()));
+}
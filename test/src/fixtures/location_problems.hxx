@@ -0,0 +1,82 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <lib/rapidjson/document.h>
+
+#include <problem_info.hxx>
+#include <utils/static.hxx>
+
+namespace fs0 { namespace test {
+
+//! The data of a problem with the given number of locations and fluent predicates 'at(x)' and 'clear(x)'.
+//! The state variable at(l_i) has ID i, and clear(l_i) has ID n + i, where n is the number of locations.
+inline std::string token_locations_data(unsigned num_locations) {
+	std::ostringstream types, objects, variables, at_vars, clear_vars;
+	types << "[[0, \"bool\", [\"0\",\"1\"]], [1, \"location\", [";
+	for (unsigned l = 0; l < num_locations; ++l) {
+		types << (l ? "," : "") << "\"" << l << "\"";
+		objects << (l ? "," : "") << "{\"id\":" << l << ",\"name\":\"l" << l << "\"}";
+		variables << (l ? "," : "") << "{\"id\":" << l << ",\"name\":\"at(l" << l << ")\",\"type\":\"bool\",\"data\":[0,[" << l << "]]}";
+		at_vars << (l ? "," : "") << "[" << l << "]";
+		clear_vars << (l ? "," : "") << "[" << num_locations + l << "]";
+	}
+	for (unsigned l = 0; l < num_locations; ++l) {
+		variables << ",{\"id\":" << num_locations + l << ",\"name\":\"clear(l" << l << ")\",\"type\":\"bool\",\"data\":[1,[" << l << "]]}";
+	}
+	types << "]]]";
+
+	std::ostringstream data;
+	data << "{\"types\": " << types.str() << ", \"objects\": [" << objects.str() << "], \"symbols\": ["
+	     << "[0, \"at\", \"predicate\", [\"location\"], \"bool\", [" << at_vars.str() << "], false, false],"
+	     << "[1, \"clear\", \"predicate\", [\"location\"], \"bool\", [" << clear_vars.str() << "], false, false]],"
+	     << "\"variables\": [" << variables.str() << "], \"problem\": {\"domain\":\"test\",\"instance\":\"test\"}}";
+	return data.str();
+}
+
+//! The data of a problem with the given number of locations, a static 'link(x, y)' relation, whose extension
+//! needs to be set separately (see 'random_links'), and a fluent predicate 'at(x)'. The state variable at(l_i) has ID i.
+inline std::string linked_locations_data(unsigned num_locations) {
+	std::ostringstream types, objects, variables, at_vars;
+	types << "[[0, \"bool\", [\"0\",\"1\"]], [1, \"location\", [";
+	for (unsigned l = 0; l < num_locations; ++l) {
+		types << (l ? "," : "") << "\"" << l << "\"";
+		objects << (l ? "," : "") << "{\"id\":" << l << ",\"name\":\"l" << l << "\"}";
+		variables << (l ? "," : "") << "{\"id\":" << l << ",\"name\":\"at(l" << l << ")\",\"type\":\"bool\",\"data\":[1,[" << l << "]]}";
+		at_vars << (l ? "," : "") << "[" << l << "]";
+	}
+	types << "]]]";
+
+	std::ostringstream data;
+	data << "{\"types\": " << types.str() << ", \"objects\": [" << objects.str() << "], \"symbols\": ["
+	     << "[0, \"link\", \"predicate\", [\"location\", \"location\"], \"bool\", [], true, false],"
+	     << "[1, \"at\", \"predicate\", [\"location\"], \"bool\", [" << at_vars.str() << "], false, false]],"
+	     << "\"variables\": [" << variables.str() << "], \"problem\": {\"domain\":\"test\",\"instance\":\"test\"}}";
+	return data.str();
+}
+
+//! A random 'link(x, y)' relation where each pair of locations is linked with the given probability.
+//! Locations from 'first_isolated' onwards are only linked among themselves.
+inline Serializer::BoostBinarySet random_links(unsigned num_locations, double density, unsigned first_isolated, unsigned seed = 1) {
+	std::mt19937 generator(seed);
+	std::bernoulli_distribution linked(density);
+	Serializer::BoostBinarySet links;
+	for (unsigned x = 0; x < num_locations; ++x) {
+		for (unsigned y = 0; y < num_locations; ++y) {
+			if ((x < first_isolated) == (y < first_isolated) && linked(generator)) links.insert(std::make_pair<int, int>(x, y));
+		}
+	}
+	return links;
+}
+
+//! Parse the given problem data and install the resulting ProblemInfo as the global instance
+inline ProblemInfo& set_problem_info(const std::string& json) {
+	rapidjson::Document data;
+	data.Parse(json.c_str());
+	return ProblemInfo::setInstance(std::unique_ptr<ProblemInfo>(new ProblemInfo(data, ".")));
+}
+
+} } // namespaces
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <thread>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A number of locations, some of them holding a token, with fluent 'at(x)' and 'clear(x)' predicates
+class AxiomCacheTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 10;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	//! Axioms of previous tests are gone, and their addresses might be reused
+	void SetUp() override { fs::AxiomCache::instance().clear(); }
+
+	static const fs::BoundVariable* variable(unsigned i) {
+		return new fs::BoundVariable(i, "?v" + std::to_string(i), 1);
+	}
+
+	static const fs::Formula* holds(unsigned symbol, unsigned var, int value) {
+		return new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(symbol, {variable(var)}), new fs::IntConstant(value)});
+	}
+
+	//! An axiom over a single location parameter
+	static fs::Axiom* axiom(const std::string& name, const fs::Formula* definition) {
+		return new fs::Axiom(name, {1}, {"?v0"}, fs::BindingUnit({"?v0"}, {variable(0)}), definition);
+	}
+};
+
+TEST_F(AxiomCacheTest, CachedValuesMatchDirectInterpretation) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	fs::AxiomCache& cache = fs::AxiomCache::instance();
+
+	// free(x) := clear(x) and not at(x); taken(x) := at(x)
+	std::unique_ptr<fs::Axiom> free(axiom("free", new fs::Conjunction({holds(1, 0, 1), holds(0, 0, 0)})));
+	std::unique_ptr<fs::Axiom> taken(axiom("taken", holds(0, 0, 1)));
+
+	std::vector<std::unique_ptr<fs::Formula>> free_atoms, taken_atoms;
+	for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+		free_atoms.emplace_back(new fs::AxiomaticAtom(free.get(), {new fs::IntConstant(l)}));
+		taken_atoms.emplace_back(new fs::AxiomaticAtom(taken.get(), {new fs::IntConstant(l)}));
+	}
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::vector<Atom> atoms;
+	for (unsigned l = 0; l < 2 * NUM_LOCATIONS; ++l) atoms.push_back(Atom(l, 0));
+	std::unique_ptr<State> state(State::create(*indexer, 2 * NUM_LOCATIONS, atoms));
+
+	// Mutate the same state in place, so that the cache must notice the change of values rather than of address
+	std::mt19937 generator(1);
+	for (unsigned s = 0; s < 200; ++s) {
+		unsigned l = generator() % NUM_LOCATIONS;
+		bool token = generator() % 2 == 0;
+		state->accumulate({Atom(l, token), Atom(NUM_LOCATIONS + l, !token && generator() % 2 == 0)});
+
+		for (unsigned repetition = 0; repetition < 2; ++repetition) {
+			for (unsigned x = 0; x < NUM_LOCATIONS; ++x) {
+				bool at = state->getValue(x) == 1, clear = state->getValue(NUM_LOCATIONS + x) == 1;
+				Binding binding;
+				ASSERT_EQ(clear && !at, free_atoms[x]->interpret(*state, binding));
+				ASSERT_EQ(at, taken_atoms[x]->interpret(*state, binding));
+			}
+		}
+	}
+	EXPECT_GT(cache.hits(), 0);
+
+	// A change in a variable that an axiom does not read leaves its cached values in place
+	VariableIdx clear_l0 = NUM_LOCATIONS;
+	state->accumulate({Atom(clear_l0, 1 - state->getValue(clear_l0))});
+	unsigned long hits = cache.hits(), invalidations = cache.invalidations();
+	for (unsigned x = 0; x < NUM_LOCATIONS; ++x) taken_atoms[x]->interpret(*state);
+	EXPECT_EQ(hits + NUM_LOCATIONS, cache.hits());
+	EXPECT_EQ(invalidations + 1, cache.invalidations());
+}
+
+TEST_F(AxiomCacheTest, StatesAreIdentifiedByTheirStamp) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	fs::AxiomCache& cache = fs::AxiomCache::instance();
+	std::unique_ptr<fs::Axiom> taken(axiom("taken", holds(0, 0, 1)));
+	std::unique_ptr<fs::Formula> taken_l0(new fs::AxiomaticAtom(taken.get(), {new fs::IntConstant(0)}));
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> state(State::create(*indexer, 2 * NUM_LOCATIONS, {Atom(0, 1)}));
+	EXPECT_TRUE(taken_l0->interpret(*state));
+
+	// A copy of the state, at a different address, holds the same values and finds them cached
+	State copy(*state);
+	EXPECT_EQ(state->stamp(), copy.stamp());
+	unsigned long hits = cache.hits(), misses = cache.misses();
+	EXPECT_TRUE(taken_l0->interpret(copy));
+	EXPECT_EQ(hits + 1, cache.hits());
+	EXPECT_EQ(misses, cache.misses());
+
+	// Overwriting the state in place with different values gives it a new stamp, even if it were to keep its hash
+	state->apply_inplace(copy, {Atom(0, 0)});
+	EXPECT_NE(copy.stamp(), state->stamp());
+	EXPECT_FALSE(taken_l0->interpret(*state));
+	EXPECT_EQ(misses + 1, cache.misses());
+}
+
+TEST_F(AxiomCacheTest, StatisticsAreAggregatedOverAllThreads) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<fs::Axiom> taken(axiom("taken", holds(0, 0, 1)));
+	std::unique_ptr<fs::Formula> taken_l0(new fs::AxiomaticAtom(taken.get(), {new fs::IntConstant(0)}));
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> state(State::create(*indexer, 2 * NUM_LOCATIONS, {Atom(0, 1)}));
+
+	fs::AxiomCache::Statistics before = fs::AxiomCache::totals();
+	std::thread worker([&]() {
+		for (unsigned i = 0; i < 10; ++i) EXPECT_TRUE(taken_l0->interpret(*state));
+	});
+	worker.join(); // The cache of the worker is gone, but not its statistics
+	fs::AxiomCache::Statistics after = fs::AxiomCache::totals();
+	EXPECT_EQ(before.hits + 9, after.hits);
+	EXPECT_EQ(before.misses + 1, after.misses);
+
+	// Clearing the caches of all threads discards the values cached on the current one
+	EXPECT_TRUE(taken_l0->interpret(*state));
+	fs::AxiomCache::clear_all();
+	unsigned long misses = fs::AxiomCache::instance().misses();
+	EXPECT_TRUE(taken_l0->interpret(*state));
+	EXPECT_EQ(misses + 1, fs::AxiomCache::instance().misses());
+}
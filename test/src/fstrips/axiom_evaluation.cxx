@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <lib/rapidjson/document.h>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/axioms.hxx>
+#include <languages/fstrips/axiom_cache.hxx>
+#include <languages/fstrips/axiom_evaluation.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A number of locations, with a fluent 'connected(x, y)' relation among them and a fluent 'marked(x)' predicate
+class AxiomEvaluationTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 6;
+
+	static unsigned connected_variable(unsigned x, unsigned y) { return x * NUM_LOCATIONS + y; }
+	static unsigned marked_variable(unsigned x) { return NUM_LOCATIONS * NUM_LOCATIONS + x; }
+
+	static std::string problem_data() {
+		std::ostringstream types, objects, variables, connected_vars, marked_vars;
+		types << "[[0, \"bool\", [\"0\",\"1\"]], [1, \"location\", [";
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			types << (l ? "," : "") << "\"" << l << "\"";
+			objects << (l ? "," : "") << "{\"id\":" << l << ",\"name\":\"l" << l << "\"}";
+			marked_vars << (l ? "," : "") << "[" << marked_variable(l) << "]";
+			for (unsigned m = 0; m < NUM_LOCATIONS; ++m) {
+				unsigned id = connected_variable(l, m);
+				variables << (id ? "," : "") << "{\"id\":" << id << ",\"name\":\"connected(l" << l << ",l" << m << ")\",\"type\":\"bool\",\"data\":[0,[" << l << "," << m << "]]}";
+				connected_vars << (id ? "," : "") << "[" << id << "]";
+			}
+		}
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			variables << ",{\"id\":" << marked_variable(l) << ",\"name\":\"marked(l" << l << ")\",\"type\":\"bool\",\"data\":[1,[" << l << "]]}";
+		}
+		types << "]]]";
+
+		std::ostringstream data;
+		data << "{\"types\": " << types.str() << ", \"objects\": [" << objects.str() << "], \"symbols\": ["
+		     << "[0, \"connected\", \"predicate\", [\"location\", \"location\"], \"bool\", [" << connected_vars.str() << "], false, false],"
+		     << "[1, \"marked\", \"predicate\", [\"location\"], \"bool\", [" << marked_vars.str() << "], false, false]],"
+		     << "\"variables\": [" << variables.str() << "], \"problem\": {\"domain\":\"test\",\"instance\":\"test\"}}";
+		return data.str();
+	}
+
+	static void SetUpTestCase() {
+		rapidjson::Document data;
+		data.Parse(problem_data().c_str());
+		ProblemInfo::setInstance(std::unique_ptr<ProblemInfo>(new ProblemInfo(data, ".")));
+	}
+
+	//! Axioms of previous tests are gone, and their addresses might be reused
+	void SetUp() override {
+		fs::AxiomCache::instance().clear();
+		fs::AxiomEvaluator::instance().clear();
+	}
+
+	static const fs::BoundVariable* variable(unsigned i) {
+		return new fs::BoundVariable(i, "?v" + std::to_string(i), 1);
+	}
+
+	static const fs::Formula* connected(const fs::Term* x, const fs::Term* y) {
+		return new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(0, {x, y}), new fs::IntConstant(1)});
+	}
+
+	//! An axiom over the given number of location parameters, to be defined afterwards
+	static fs::Axiom* axiom(const std::string& name, unsigned arity) {
+		std::vector<std::string> parameters;
+		std::vector<const fs::BoundVariable*> variables;
+		for (unsigned i = 0; i < arity; ++i) {
+			parameters.push_back("?v" + std::to_string(i));
+			variables.push_back(variable(i));
+		}
+		return new fs::Axiom(name, Signature(arity, 1), parameters, fs::BindingUnit(parameters, variables), new fs::Tautology);
+	}
+};
+
+TEST_F(AxiomEvaluationTest, RecursiveAxiomsComputeTheTransitiveClosure) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	fs::AxiomEvaluator& evaluator = fs::AxiomEvaluator::instance();
+
+	// reach(x, y) := connected(x, y) or exists z: connected(x, z) and reach(z, y)
+	std::unique_ptr<fs::Axiom> reach(axiom("reach", 2));
+	reach->define(new fs::Disjunction({
+		connected(variable(0), variable(1)),
+		new fs::ExistentiallyQuantifiedFormula({variable(2)}, new fs::Conjunction({
+			connected(variable(0), variable(2)),
+			new fs::AxiomaticAtom(reach.get(), {variable(2), variable(1)})
+		}))
+	}));
+
+	// cyclic(x) := reach(x, x), which only depends on the recursive stratum
+	std::unique_ptr<fs::Axiom> cyclic(axiom("cyclic", 1));
+	cyclic->define(new fs::AxiomaticAtom(reach.get(), {variable(0), variable(0)}));
+
+	ASSERT_TRUE(evaluator.is_recursive(reach.get()));
+	ASSERT_FALSE(evaluator.is_recursive(cyclic.get()));
+	ASSERT_LT(evaluator.stratum(reach.get()), evaluator.stratum(cyclic.get()));
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::vector<Atom> atoms;
+	for (unsigned v = 0; v < info.getNumVariables(); ++v) atoms.push_back(Atom(v, 0));
+	std::unique_ptr<State> state(State::create(*indexer, info.getNumVariables(), atoms));
+
+	std::mt19937 generator(1);
+	for (unsigned s = 0; s < 100; ++s) {
+		unsigned x = generator() % NUM_LOCATIONS, y = generator() % NUM_LOCATIONS;
+		state->accumulate({Atom(connected_variable(x, y), generator() % 3 == 0)});
+
+		// Floyd-Warshall
+		std::vector<std::vector<bool>> expected(NUM_LOCATIONS, std::vector<bool>(NUM_LOCATIONS));
+		for (unsigned i = 0; i < NUM_LOCATIONS; ++i) {
+			for (unsigned j = 0; j < NUM_LOCATIONS; ++j) expected[i][j] = state->getValue(connected_variable(i, j)) == 1;
+		}
+		for (unsigned k = 0; k < NUM_LOCATIONS; ++k) {
+			for (unsigned i = 0; i < NUM_LOCATIONS; ++i) {
+				for (unsigned j = 0; j < NUM_LOCATIONS; ++j) expected[i][j] = expected[i][j] || (expected[i][k] && expected[k][j]);
+			}
+		}
+
+		Binding binding;
+		for (unsigned i = 0; i < NUM_LOCATIONS; ++i) {
+			fs::AxiomaticAtom is_cyclic(cyclic.get(), {new fs::IntConstant(i)});
+			ASSERT_EQ(expected[i][i], is_cyclic.interpret(*state, binding));
+			for (unsigned j = 0; j < NUM_LOCATIONS; ++j) {
+				fs::AxiomaticAtom reaches(reach.get(), {new fs::IntConstant(i), new fs::IntConstant(j)});
+				ASSERT_EQ(expected[i][j], reaches.interpret(*state, binding));
+			}
+		}
+	}
+
+	// A change in a variable that the recursive stratum does not read does not require a new fixpoint
+	unsigned long fixpoints = evaluator.fixpoints();
+	state->accumulate({Atom(marked_variable(0), 1)});
+	fs::AxiomaticAtom reaches(reach.get(), {new fs::IntConstant(0), new fs::IntConstant(1)});
+	Binding binding;
+	reaches.interpret(*state, binding);
+	EXPECT_EQ(fixpoints, evaluator.fixpoints());
+}
+
+TEST_F(AxiomEvaluationTest, FixpointRoundsOnlyReevaluateCandidatesAffectedByNewTuples) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	fs::AxiomEvaluator& evaluator = fs::AxiomEvaluator::instance();
+
+	// reach(x, y) := connected(x, y) or exists z: connected(x, z) and reach(z, y)
+	std::unique_ptr<fs::Axiom> reach(axiom("reach", 2));
+	reach->define(new fs::Disjunction({
+		connected(variable(0), variable(1)),
+		new fs::ExistentiallyQuantifiedFormula({variable(2)}, new fs::Conjunction({
+			connected(variable(0), variable(2)),
+			new fs::AxiomaticAtom(reach.get(), {variable(2), variable(1)})
+		}))
+	}));
+
+	// A chain l0 -> l1 -> ... -> ln, which needs as many rounds as locations to be closed
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::vector<Atom> atoms;
+	for (unsigned v = 0; v < info.getNumVariables(); ++v) atoms.push_back(Atom(v, 0));
+	for (unsigned l = 0; l + 1 < NUM_LOCATIONS; ++l) atoms[connected_variable(l, l + 1)] = Atom(connected_variable(l, l + 1), 1);
+	std::unique_ptr<State> state(State::create(*indexer, info.getNumVariables(), atoms));
+
+	unsigned long fixpoints = evaluator.fixpoints(), rounds = evaluator.rounds(), evaluations = evaluator.evaluations();
+	Binding binding;
+	fs::AxiomaticAtom reaches(reach.get(), {new fs::IntConstant(0), new fs::IntConstant(NUM_LOCATIONS - 1)});
+	ASSERT_TRUE(reaches.interpret(*state, binding));
+	ASSERT_EQ(fixpoints + 1, evaluator.fixpoints());
+	ASSERT_GE(evaluator.rounds() - rounds, NUM_LOCATIONS - 1);
+
+	// Each candidate looks up a single tuple of 'reach' when it does not hold, hence after the first round over all
+	// candidates, each derived tuple wakes up at most one candidate, whereas naive rounds would re-evaluate all
+	// the candidates not derived yet
+	const unsigned candidates = NUM_LOCATIONS * NUM_LOCATIONS;
+	const unsigned derived = NUM_LOCATIONS * (NUM_LOCATIONS - 1) / 2;
+	EXPECT_LE(evaluator.evaluations() - evaluations, candidates + derived);
+}
+
+TEST_F(AxiomEvaluationTest, StatisticsAreAggregatedOverAllThreads) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+
+	// reach(x, y) := connected(x, y) or exists z: connected(x, z) and reach(z, y)
+	std::unique_ptr<fs::Axiom> reach(axiom("reach", 2));
+	reach->define(new fs::Disjunction({
+		connected(variable(0), variable(1)),
+		new fs::ExistentiallyQuantifiedFormula({variable(2)}, new fs::Conjunction({
+			connected(variable(0), variable(2)),
+			new fs::AxiomaticAtom(reach.get(), {variable(2), variable(1)})
+		}))
+	}));
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> state(State::create(*indexer, info.getNumVariables(), {Atom(connected_variable(0, 1), 1)}));
+	fs::AxiomaticAtom reaches(reach.get(), {new fs::IntConstant(0), new fs::IntConstant(1)});
+
+	fs::AxiomEvaluator::Statistics before = fs::AxiomEvaluator::totals();
+	std::thread worker([&]() {
+		Binding binding;
+		EXPECT_TRUE(reaches.interpret(*state, binding));
+	});
+	worker.join(); // The evaluator of the worker is gone, but not its statistics
+	fs::AxiomEvaluator::Statistics after = fs::AxiomEvaluator::totals();
+	EXPECT_EQ(before.fixpoints + 1, after.fixpoints);
+	EXPECT_GT(after.rounds, before.rounds);
+	EXPECT_GT(after.evaluations, before.evaluations);
+}
+
+TEST_F(AxiomEvaluationTest, RecursiveAxiomsAreRejectedOnPartialAssignments) {
+	// loop(x) := connected(x, x) or loop(x)
+	std::unique_ptr<fs::Axiom> loop(axiom("loop", 1));
+	loop->define(new fs::Disjunction({
+		connected(variable(0), variable(0)),
+		new fs::AxiomaticAtom(loop.get(), {variable(0)})
+	}));
+
+	fs::AxiomaticAtom atom(loop.get(), {new fs::IntConstant(0)});
+	Binding binding;
+	EXPECT_THROW(atom.interpret(PartialAssignment(), binding), std::runtime_error);
+}
+
+TEST_F(AxiomEvaluationTest, RecursionThroughNegationIsRejected) {
+	// odd(x) := connected(x, x) and not odd(x)
+	std::unique_ptr<fs::Axiom> odd(axiom("odd", 1));
+	odd->define(new fs::Conjunction({
+		connected(variable(0), variable(0)),
+		new fs::Negation(new fs::AxiomaticAtom(odd.get(), {variable(0)}))
+	}));
+	EXPECT_THROW(fs::AxiomEvaluator::instance().stratum(odd.get()), std::runtime_error);
+}
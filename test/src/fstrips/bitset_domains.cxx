@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+
+#include <lib/rapidjson/document.h>
+
+#include <problem_info.hxx>
+#include <constraints/direct/bitset_domain.hxx>
+#include <constraints/direct/builtin.hxx>
+#include <constraints/direct/compiled.hxx>
+#include <constraints/direct/csp_handler.hxx>
+
+using namespace fs0;
+
+//! A problem with two 'loc(s)' variables, whose location objects have non-contiguous IDs,
+//! and two 'num(s)' variables of a bounded integer type
+class BitsetDomainsTest : public testing::Test {
+protected:
+	static const unsigned NUM_OBJECTS = 16;
+
+	static std::string problem_data() {
+		std::ostringstream objects;
+		for (unsigned o = 0; o < NUM_OBJECTS; ++o) {
+			objects << (o ? "," : "") << "{\"id\":" << o << ",\"name\":\"o" << o << "\"}";
+		}
+
+		std::ostringstream data;
+		data << "{\"types\": [[0, \"bool\", [\"0\",\"1\"]], [1, \"location\", [\"2\",\"5\",\"7\",\"11\",\"13\"]],"
+		     << "[2, \"slot\", [\"14\",\"15\"]], [3, \"number\", \"int\", [0, 9]]],"
+		     << "\"objects\": [" << objects.str() << "], \"symbols\": ["
+		     << "[0, \"loc\", \"function\", [\"slot\"], \"location\", [[14],[15]], false, false],"
+		     << "[1, \"num\", \"function\", [\"slot\"], \"number\", [[14],[15]], false, false]],"
+		     << "\"variables\": ["
+		     << "{\"id\":0,\"name\":\"loc(o14)\",\"type\":\"location\",\"data\":[0,[14]]},"
+		     << "{\"id\":1,\"name\":\"loc(o15)\",\"type\":\"location\",\"data\":[0,[15]]},"
+		     << "{\"id\":2,\"name\":\"num(o14)\",\"type\":\"number\",\"data\":[1,[14]]},"
+		     << "{\"id\":3,\"name\":\"num(o15)\",\"type\":\"number\",\"data\":[1,[15]]}"
+		     << "], \"problem\": {\"domain\":\"test\",\"instance\":\"test\"}}";
+		return data.str();
+	}
+
+	static void SetUpTestCase() {
+		rapidjson::Document data;
+		data.Parse(problem_data().c_str());
+		ProblemInfo::setInstance(std::unique_ptr<ProblemInfo>(new ProblemInfo(data, ".")));
+	}
+
+	//! A random non-empty subset of the values of the given variable
+	static Domain random_domain(VariableIdx variable, std::mt19937& generator) {
+		const ObjectIdxVector& values = ProblemInfo::getInstance().getVariableObjects(variable);
+		Domain domain;
+		while (domain.empty()) {
+			for (ObjectIdx value:values) {
+				if (generator() % 3 == 0) domain.insert(value);
+			}
+		}
+		return domain;
+	}
+};
+
+TEST_F(BitsetDomainsTest, LayoutsMapValuesToBits) {
+	DomainLayout layout(ProblemInfo::getInstance());
+	ASSERT_EQ(4, layout.getNumVariables());
+
+	const VariableLayout& location = layout.at(0);
+	ASSERT_EQ(5, location.size());
+	EXPECT_EQ(2, location.position(7));
+	EXPECT_EQ(11, location.value(3));
+	EXPECT_EQ(location.size(), location.position(6)); // Not a location
+
+	const VariableLayout& number = layout.at(2);
+	ASSERT_EQ(10, number.size());
+	EXPECT_EQ(4, number.position(4));
+	EXPECT_EQ(number.size(), number.position(10));
+	EXPECT_EQ(number.size(), number.position(-1));
+
+	Domain domain{5, 11, 13};
+	BitsetDomain encoded = location.encode(domain);
+	EXPECT_EQ(3, encoded.count());
+	EXPECT_TRUE(encoded.test(location.position(11)));
+	EXPECT_EQ(domain, location.decode(encoded));
+	EXPECT_EQ(Domain{7}, location.decode(location.singleton(7)));
+}
+
+TEST_F(BitsetDomainsTest, BitsetRevisionMatchesSetRevision) {
+	// loc(o14) < loc(o15), num(o14) + num(o15) = 9
+	CompiledBinaryConstraint locations({0, 1}, [](ObjectIdx x, ObjectIdx y) { return x < y; });
+	CompiledBinaryConstraint numbers({2, 3}, [](ObjectIdx x, ObjectIdx y) { return x + y == 9; });
+	DomainLayout layout(ProblemInfo::getInstance());
+	std::mt19937 generator(7);
+
+	for (const CompiledBinaryConstraint* constraint:{&locations, &numbers}) {
+		const VariableIdxVector& scope = constraint->getScope();
+		for (unsigned i = 0; i < 200; ++i) {
+			DomainMap domains;
+			for (VariableIdx variable:scope) domains[variable] = std::make_shared<Domain>(random_domain(variable, generator));
+
+			for (unsigned variable = 0; variable < 2; ++variable) {
+				const VariableLayout& x = layout.at(scope[variable]);
+				const VariableLayout& y = layout.at(scope[1 - variable]);
+				BitsetDomain bits = x.encode(*domains[scope[variable]]);
+				FilteringOutput bitset_output = constraint->filter(variable, bits, y.encode(*domains[scope[1 - variable]]));
+
+				constraint->loadDomains(domains);
+				FilteringOutput set_output = constraint->filter(variable);
+				constraint->emptyDomains();
+
+				EXPECT_EQ(set_output == FilteringOutput::Failure, bitset_output == FilteringOutput::Failure);
+				if (set_output == FilteringOutput::Failure) break;
+				EXPECT_EQ(set_output, bitset_output);
+				EXPECT_EQ(*domains[scope[variable]], x.decode(bits));
+			}
+		}
+	}
+}
+
+TEST_F(BitsetDomainsTest, BitsetAC3MatchesSetAC3) {
+	// The LT and NEQX constraints are not compiled, hence the handler needs to compile them for bitset filtering
+	std::vector<DirectConstraint*> constraints{
+		new LTConstraint({0, 1}, {}),
+		new NEQXConstraint({1}, {13}),
+		new CompiledBinaryConstraint({2, 3}, [](ObjectIdx x, ObjectIdx y) { return x + y == 9; }),
+		new CompiledBinaryConstraint({1, 2}, [](ObjectIdx x, ObjectIdx y) { return x < y; }),
+	};
+	DirectCSPHandler handler(constraints);
+	ASSERT_TRUE(handler.supportsBitsets());
+
+	DomainLayout layout(ProblemInfo::getInstance());
+	const VariableIdxVector& relevant = handler.getAllRelevantVariables();
+	ASSERT_EQ(4, relevant.size());
+	std::mt19937 generator(11);
+
+	for (unsigned i = 0; i < 500; ++i) {
+		DomainMap domains;
+		std::vector<BitsetDomain> bits;
+		for (VariableIdx variable:relevant) {
+			domains[variable] = std::make_shared<Domain>(random_domain(variable, generator));
+			bits.push_back(layout.at(variable).encode(*domains[variable]));
+		}
+
+		bool set_consistent = handler.filter(domains) != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(domains);
+		bool bitset_consistent = handler.filter(bits) != FilteringOutput::Failure && DirectCSPHandler::checkConsistency(bits);
+		ASSERT_EQ(set_consistent, bitset_consistent);
+		if (!set_consistent) continue;
+
+		// Arc consistency has a unique fixpoint
+		for (unsigned j = 0; j < relevant.size(); ++j) {
+			EXPECT_EQ(*domains[relevant[j]], layout.at(relevant[j]).decode(bits[j]));
+		}
+	}
+
+	for (auto constraint:constraints) delete constraint;
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <actions/compiled_effects.hxx>
+#include <applicability/action_managers.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <utils/thread_pool.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A problem with a number of locations, some of them holding a token, with fluent 'at(x)' and 'clear(x)' predicates
+//! and a schema 'move(x, y)' that moves a token to a different, clear location, whose effects mix compiled and
+//! interpreted (conditional, or functional) effects
+class CompiledEffectsTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 30;
+	static const unsigned NUM_TOKENS = 8;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	static const fs::Term* fluent(unsigned symbol, unsigned param) {
+		return new fs::FluentHeadedNestedTerm(symbol, {parameter(param)});
+	}
+
+	//! move(x, y): PRE x != y and at(x) and clear(y);
+	//! EFF clear(y) := 0, at(y) := at(x), at(x) := 0, when at(y) = 0 then clear(x) := 1, clear(x) := 0, clear(x) := 1
+	//! The last two effects check that effects are applied in order
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+			new fs::EQAtomicFormula({fluent(0, 0), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({fluent(1, 1), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(fluent(1, 1), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(0, 1), fluent(0, 0), new fs::Tautology),
+			new fs::ActionEffect(fluent(0, 0), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(1), new fs::EQAtomicFormula({fluent(0, 1), new fs::IntConstant(0)})),
+			new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(1), new fs::Tautology)
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	static std::vector<Atom> initial_atoms(std::mt19937& generator) {
+		std::vector<unsigned> locations(NUM_LOCATIONS);
+		std::iota(locations.begin(), locations.end(), 0);
+		std::shuffle(locations.begin(), locations.end(), generator);
+		std::vector<Atom> atoms;
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			bool token = std::find(locations.begin(), locations.begin() + NUM_TOKENS, l) != locations.begin() + NUM_TOKENS;
+			atoms.push_back(Atom(l, token));
+			atoms.push_back(Atom(NUM_LOCATIONS + l, !token));
+		}
+		return atoms;
+	}
+
+	//! A random walk of the given number of steps, where states are generated by interpreting the action effects
+	static void random_walk(const StateAtomIndexer& indexer, const std::vector<const GroundAction*>& actions, unsigned steps,
+	                        std::vector<State>& states, std::vector<ActionIdx>& plan) {
+		std::mt19937 generator(1);
+		fs::Tautology constraints;
+		NaiveActionManager manager(actions, &constraints);
+		states.push_back(*std::unique_ptr<State>(State::create(indexer, 2 * NUM_LOCATIONS, initial_atoms(generator))));
+		for (unsigned step = 0; step < steps; ++step) {
+			const State& state = states.back();
+			std::vector<ActionIdx> applicable;
+			for (ActionIdx action:manager.applicable(state)) applicable.push_back(action);
+			ActionIdx action = applicable[std::uniform_int_distribution<unsigned>(0, applicable.size() - 1)(generator)];
+			plan.push_back(action);
+			states.push_back(State(state, NaiveApplicabilityManager::computeEffects(state, *actions[action])));
+		}
+	}
+
+	void check_compiled_effects(bool packed) {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		std::unique_ptr<const ActionData> schema = build_schema();
+		std::vector<const GroundAction*> actions = ActionGrounder::fully_ground({schema.get()}, info, 1);
+		std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info, packed));
+
+		std::vector<CompiledEffects> compiled;
+		for (const GroundAction* action:actions) compiled.push_back(CompiledEffects(*action));
+		ASSERT_EQ(6, compiled[0].size());
+		ASSERT_FALSE(compiled[0].is_constant());
+
+		const unsigned NUM_STEPS = 300;
+		std::vector<State> states;
+		std::vector<ActionIdx> plan;
+		random_walk(*indexer, actions, NUM_STEPS, states, plan);
+
+		// Applying the compiled effects into a preallocated buffer, or in place, yields the same states, with the same hash
+		State successor(states[0]), current(states[0]);
+		for (unsigned i = 0; i < NUM_STEPS; ++i) {
+			compiled[plan[i]].apply(states[i], successor);
+			ASSERT_EQ(states[i+1], successor);
+			ASSERT_EQ(states[i+1].hash(), successor.hash());
+
+			compiled[plan[i]].apply(current, current);
+			ASSERT_EQ(states[i+1], current);
+		}
+
+		// The same holds if successors are generated concurrently from several threads
+		utils::ThreadPool pool(4);
+		std::vector<unsigned> errors(NUM_STEPS, 0);
+		pool.parallel_for(NUM_STEPS, [&](std::size_t i) {
+			State buffer(states[0]);
+			for (unsigned j = 0; j < i; ++j) compiled[plan[j]].apply(buffer, buffer);
+			errors[i] = !(buffer == states[i]);
+		});
+		ASSERT_EQ(0, std::accumulate(errors.begin(), errors.end(), 0u));
+
+		for (const GroundAction* action:actions) delete action;
+	}
+};
+
+TEST_F(CompiledEffectsTest, CompiledEffectsMatchInterpretedEffects) {
+	check_compiled_effects(false);
+}
+
+TEST_F(CompiledEffectsTest, CompiledEffectsMatchInterpretedEffectsOnPackedStates) {
+	check_compiled_effects(true);
+}
+
+TEST_F(CompiledEffectsTest, ConstantEffectsMatchInterpretedEffects) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+
+	// The same move action, with STRIPS effects only: at(y) := 1, at(x) := 0, clear(x) := 1, clear(y) := 0
+	std::vector<const fs::ActionEffect*> effects{
+		new fs::ActionEffect(fluent(0, 1), new fs::IntConstant(1), new fs::Tautology),
+		new fs::ActionEffect(fluent(0, 0), new fs::IntConstant(0), new fs::Tautology),
+		new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(1), new fs::Tautology),
+		new fs::ActionEffect(fluent(1, 1), new fs::IntConstant(0), new fs::Tautology)
+	};
+	auto precondition = new fs::Conjunction({
+		new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+		new fs::EQAtomicFormula({fluent(0, 0), new fs::IntConstant(1)}),
+		new fs::EQAtomicFormula({fluent(1, 1), new fs::IntConstant(1)})
+	});
+	std::vector<std::string> names{"?p0", "?p1"};
+	ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+	std::unique_ptr<const ActionData> schema(ActionGrounder::process_action_data(data, info, true));
+	std::vector<const GroundAction*> actions = ActionGrounder::fully_ground({schema.get()}, info, 1);
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+
+	std::vector<CompiledEffects> compiled;
+	for (const GroundAction* action:actions) compiled.push_back(CompiledEffects(*action));
+	ASSERT_TRUE(compiled[0].is_constant());
+
+	const unsigned NUM_STEPS = 300;
+	std::vector<State> states;
+	std::vector<ActionIdx> plan;
+	random_walk(*indexer, actions, NUM_STEPS, states, plan);
+
+	State successor(states[0]);
+	for (unsigned i = 0; i < NUM_STEPS; ++i) {
+		compiled[plan[i]].apply(states[i], successor);
+		ASSERT_EQ(states[i+1], successor);
+		ASSERT_EQ(states[i+1].hash(), successor.hash());
+	}
+
+	for (const GroundAction* action:actions) delete action;
+}
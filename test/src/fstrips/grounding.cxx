@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+
+#include <problem_info.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <languages/fstrips/axioms.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A problem with a static, randomly generated 'link(x, y)' relation over a number of locations and a fluent
+//! 'at(x)' predicate, and a schema 'move(x, y, z)' that moves along two consecutive links to a different location
+class GroundingTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 40;
+
+	static void SetUpTestCase() {
+		ProblemInfo& info = test::set_problem_info(test::linked_locations_data(NUM_LOCATIONS));
+		info.set_extension(0, std::unique_ptr<StaticExtension>(new BinaryPredicate(test::random_links(NUM_LOCATIONS, 0.2, NUM_LOCATIONS))));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	//! move(x, y, z): PRE x != z and link(x, y) and link(y, z) and at(x); EFF at(z) := 1, at(x) := 0
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(2)}),
+			new fs::EQAtomicFormula({new fs::UserDefinedStaticTerm(0, {parameter(0), parameter(1)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::UserDefinedStaticTerm(0, {parameter(1), parameter(2)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(2)}), new fs::IntConstant(1), new fs::Tautology),
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(0), new fs::Tautology)
+		};
+		std::vector<std::string> names{"?p0", "?p1", "?p2"};
+		ActionData data(0, "move", {1, 1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1), parameter(2)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+};
+
+TEST_F(GroundingTest, ParallelGroundingIsDeterministic) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+
+	std::vector<const GroundAction*> sequential = ActionGrounder::fully_ground({schema.get()}, info, 1);
+	std::vector<const GroundAction*> parallel = ActionGrounder::fully_ground({schema.get()}, info, 4);
+
+	// Static atoms are kept in the grounded preconditions, hence only the groundings with x = z are pruned
+	ASSERT_EQ(NUM_LOCATIONS * NUM_LOCATIONS * (NUM_LOCATIONS - 1), sequential.size());
+	ASSERT_EQ(sequential.size(), parallel.size());
+	for (unsigned i = 0; i < sequential.size(); ++i) {
+		ASSERT_EQ(i, sequential[i]->getId());
+		ASSERT_EQ(i, parallel[i]->getId());
+		ASSERT_EQ(sequential[i]->getBinding().get_full_binding(), parallel[i]->getBinding().get_full_binding());
+		ASSERT_EQ(sequential[i]->getEffects().size(), parallel[i]->getEffects().size());
+	}
+
+	for (const GroundAction* action:sequential) delete action;
+	for (const GroundAction* action:parallel) delete action;
+}
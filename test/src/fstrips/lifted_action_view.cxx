@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/action_id.hxx>
+#include <actions/grounding.hxx>
+#include <actions/lifted_action_view.hxx>
+#include <applicability/action_managers.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A problem with a number of locations, some of them holding a token, with fluent 'at(x)' and 'clear(x)' predicates,
+//! and a schema 'move(x, y)' with a quantified precondition and a conditional effect
+class LiftedActionViewTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 12;
+	static const unsigned NUM_TOKENS = 4;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	static const fs::Term* fluent(unsigned symbol, unsigned param) {
+		return new fs::FluentHeadedNestedTerm(symbol, {parameter(param)});
+	}
+
+	//! move(x, y): PRE x != y and at(x) and clear(y) and (exists z: z != y and clear(z));
+	//! EFF clear(y) := 0, at(y) := at(x), at(x) := 0, when at(y) = 0 then clear(x) := 1
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+			new fs::EQAtomicFormula({fluent(0, 0), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({fluent(1, 1), new fs::IntConstant(1)}),
+			new fs::ExistentiallyQuantifiedFormula({parameter(2)}, new fs::Conjunction({
+				new fs::NEQAtomicFormula({parameter(2), parameter(1)}),
+				new fs::EQAtomicFormula({fluent(1, 2), new fs::IntConstant(1)})
+			}))
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(fluent(1, 1), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(0, 1), fluent(0, 0), new fs::Tautology),
+			new fs::ActionEffect(fluent(0, 0), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(1), new fs::EQAtomicFormula({fluent(0, 1), new fs::IntConstant(0)}))
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	static std::vector<Atom> random_atoms(std::mt19937& generator, unsigned num_tokens) {
+		std::vector<unsigned> locations(NUM_LOCATIONS);
+		std::iota(locations.begin(), locations.end(), 0);
+		std::shuffle(locations.begin(), locations.end(), generator);
+		std::vector<Atom> atoms;
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			bool token = std::find(locations.begin(), locations.begin() + num_tokens, l) != locations.begin() + num_tokens;
+			atoms.push_back(Atom(l, token));
+			atoms.push_back(Atom(NUM_LOCATIONS + l, !token));
+		}
+		return atoms;
+	}
+};
+
+TEST_F(LiftedActionViewTest, ViewMatchesGeneratedGroundAction) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+	std::vector<const PartiallyGroundedAction*> lifted = ActionGrounder::fully_lifted({schema.get()}, info);
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+
+	std::mt19937 generator(1);
+	LiftedActionView view;
+	std::vector<Atom> atoms;
+	unsigned num_applicable = 0;
+	for (unsigned s = 0; s < 20; ++s) {
+		// Some states have a single clear location, which makes the quantified precondition false
+		unsigned num_tokens = (s % 4 == 0) ? NUM_LOCATIONS - 1 : NUM_TOKENS;
+		std::unique_ptr<State> state(State::create(*indexer, 2 * NUM_LOCATIONS, random_atoms(generator, num_tokens)));
+
+		for (unsigned x = 0; x < NUM_LOCATIONS; ++x) {
+			for (unsigned y = 0; y < NUM_LOCATIONS; ++y) {
+				LiftedActionID action(lifted[0], Binding(std::vector<ObjectIdx>{(ObjectIdx) x, (ObjectIdx) y}));
+				std::unique_ptr<const GroundAction> ground(action.generate());
+
+				view.set(action);
+				bool applicable = ground && ground->getPrecondition()->interpret(*state);
+				ASSERT_EQ(applicable, view.applicable(*state));
+				if (!applicable) continue;
+
+				++num_applicable;
+				view.effects(*state, atoms);
+				ASSERT_EQ(NaiveApplicabilityManager::computeEffects(*state, *ground), atoms);
+			}
+		}
+	}
+	ASSERT_GT(num_applicable, 0);
+
+	for (const PartiallyGroundedAction* action:lifted) delete action;
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <applicability/action_managers.hxx>
+#include <applicability/match_tree.hxx>
+#include <utils/atom_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A problem with a number of locations, some of them holding a token, with fluent 'at(x)' and 'clear(x)' predicates
+//! and a schema 'move(x, y)' that moves a token to a different, clear location
+class MatchTreeTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 60;
+	static const unsigned NUM_TOKENS = 12;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	static fs::ActionEffect* assign(unsigned symbol, unsigned param, int value) {
+		return new fs::ActionEffect(new fs::FluentHeadedNestedTerm(symbol, {parameter(param)}), new fs::IntConstant(value), new fs::Tautology);
+	}
+
+	//! move(x, y): PRE x != y and at(x) and clear(y); EFF at(y) := 1, at(x) := 0, clear(x) := 1, clear(y) := 0
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(0, {parameter(0)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(1)}), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{assign(0, 1, 1), assign(0, 0, 0), assign(1, 0, 1), assign(1, 1, 0)};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	static std::vector<ActionIdx> applicable(const ActionManagerI& manager, const State& state) {
+		std::vector<ActionIdx> actions;
+		for (ActionIdx action:manager.applicable(state)) actions.push_back(action);
+		return actions;
+	}
+
+	static std::vector<ActionIdx> sorted(std::vector<ActionIdx> actions) {
+		std::sort(actions.begin(), actions.end());
+		return actions;
+	}
+};
+
+TEST_F(MatchTreeTest, FlatAndIncrementalTreesMatchPointerTree) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+	std::vector<const GroundAction*> actions = ActionGrounder::fully_ground({schema.get()}, info, 1);
+	ASSERT_EQ(NUM_LOCATIONS * (NUM_LOCATIONS - 1), actions.size());
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	AtomIndex tuple_idx(info);
+	fs::Tautology constraints;
+
+	MatchTreeActionManager pointer_tree(actions, &constraints, tuple_idx, false);
+	MatchTreeActionManager flat_tree(actions, &constraints, tuple_idx, true);
+	BasicApplicabilityAnalyzer analyzer(actions, tuple_idx);
+	analyzer.build();
+	SmartActionManager smart(actions, &constraints, tuple_idx, analyzer);
+	ASSERT_EQ(pointer_tree.count(), flat_tree.count());
+
+	// Place the tokens on random locations, and then move them around randomly
+	std::mt19937 generator(1);
+	std::vector<unsigned> locations(NUM_LOCATIONS);
+	std::iota(locations.begin(), locations.end(), 0);
+	std::shuffle(locations.begin(), locations.end(), generator);
+	std::vector<Atom> init;
+	for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+		bool token = std::find(locations.begin(), locations.begin() + NUM_TOKENS, l) != locations.begin() + NUM_TOKENS;
+		init.push_back(Atom(l, token));
+		init.push_back(Atom(NUM_LOCATIONS + l, !token));
+	}
+
+	const unsigned NUM_STEPS = 500;
+	std::vector<State> states{*std::unique_ptr<State>(State::create(*indexer, 2 * NUM_LOCATIONS, init))};
+	std::vector<std::vector<Atom>> effects;
+	std::vector<ActionIdx> whitelist = applicable(flat_tree, states[0]), incremental;
+	for (unsigned step = 0; step < NUM_STEPS; ++step) {
+		const State& state = states.back();
+		ASSERT_EQ(applicable(pointer_tree, state), whitelist); // Same actions in the same order
+		ASSERT_EQ(sorted(applicable(smart, state)), sorted(whitelist));
+		ASSERT_EQ(NUM_TOKENS * (NUM_LOCATIONS - NUM_TOKENS), whitelist.size());
+
+		const GroundAction& action = *actions[whitelist[std::uniform_int_distribution<unsigned>(0, whitelist.size() - 1)(generator)]];
+		effects.push_back(NaiveApplicabilityManager::computeEffects(state, action));
+		states.push_back(State(state, effects.back()));
+
+		flat_tree.compute_whitelist(states.back(), whitelist, effects.back(), incremental);
+		whitelist = applicable(flat_tree, states.back());
+		ASSERT_EQ(sorted(incremental), sorted(whitelist));
+	}
+
+	for (const GroundAction* action:actions) delete action;
+}
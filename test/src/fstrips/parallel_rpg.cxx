@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include <problem.hxx>
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <constraints/gecode/extensions.hxx>
+#include <constraints/gecode/handlers/lifted_effect_csp.hxx>
+#include <constraints/gecode/handlers/lifted_effect_unreached.hxx>
+#include <constraints/gecode/utils/csp_stats.hxx>
+#include <heuristics/relaxed_plan/smart_rpg.hxx>
+#include <heuristics/relaxed_plan/unreached_atom_rpg.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+#include <utils/config.hxx>
+#include <utils/support.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+using namespace fs0::gecode;
+namespace fs = fs0::language::fstrips;
+
+//! The heuristics that solve the CSPs of each RPG layer on a pool of threads must compute the same values, and the
+//! same relevant atoms, as when they solve them sequentially. The problem has a number of locations, some of them
+//! holding a token, a schema 'move(x, y)' that moves a token to a different, clear location, and a goal that asks
+//! for tokens on the last locations.
+class ParallelRPGTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 12;
+	static const unsigned NUM_TOKENS = 4;
+	static const unsigned NUM_STATES = 30;
+	static const int NUM_THREADS = 4;
+
+	static void SetUpTestCase() {
+		const ProblemInfo& info = test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+
+		// The CSP handlers read some of their options from the global configuration
+		std::string filename = testing::TempDir() + "/parallel_rpg_defaults.json";
+		{
+			std::ofstream out(filename);
+			out << "{\"heuristic\": \"hff\", \"novelty\": \"false\", \"plan_extraction\": \"propositional\", \"evaluation\": \"eager\","
+			    << " \"precondition_resolution\": \"full\", \"goal_resolution\": \"full\", \"goal_value_selection\": \"min_val\","
+			    << " \"action_value_selection\": \"min_val\", \"support_priority\": \"first\", \"successor_generation\": \"naive\"}";
+		}
+		Config::init("smart", {}, filename);
+		std::remove(filename.c_str());
+
+		std::vector<const fs::Formula*> goal;
+		for (unsigned l = NUM_LOCATIONS - NUM_TOKENS; l < NUM_LOCATIONS; ++l) {
+			goal.push_back(new fs::EQAtomicFormula({new fs::StateVariable(l, new fs::FluentHeadedNestedTerm(0, {new fs::IntConstant(l)})), new fs::IntConstant(1)}));
+		}
+
+		StateAtomIndexer* indexer = StateAtomIndexer::create(info);
+		State* init = State::create(*indexer, 2 * NUM_LOCATIONS, random_atoms(0));
+		std::vector<const ActionData*> schemas{build_schema()};
+		Problem* problem = new Problem(init, indexer, schemas, {}, new fs::Conjunction(goal), new fs::Tautology, AtomIndex(info));
+		problem->setPartiallyGroundedActions(ActionGrounder::fully_lifted(schemas, info));
+		Problem::setInstance(std::unique_ptr<Problem>(problem));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	static const fs::Term* fluent(unsigned symbol, unsigned param) {
+		return new fs::FluentHeadedNestedTerm(symbol, {parameter(param)});
+	}
+
+	//! move(x, y): PRE x != y and at(x) and clear(y); EFF at(y) := 1, at(x) := 0, clear(x) := 1, clear(y) := 0
+	static const ActionData* build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::NEQAtomicFormula({parameter(0), parameter(1)}),
+			new fs::EQAtomicFormula({fluent(0, 0), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({fluent(1, 1), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(fluent(0, 1), new fs::IntConstant(1), new fs::Tautology),
+			new fs::ActionEffect(fluent(0, 0), new fs::IntConstant(0), new fs::Tautology),
+			new fs::ActionEffect(fluent(1, 0), new fs::IntConstant(1), new fs::Tautology),
+			new fs::ActionEffect(fluent(1, 1), new fs::IntConstant(0), new fs::Tautology)
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return ActionGrounder::process_action_data(data, info, true);
+	}
+
+	//! The atoms of a state with the tokens on random locations
+	static std::vector<Atom> random_atoms(unsigned seed) {
+		std::mt19937 generator(seed);
+		std::vector<unsigned> locations(NUM_LOCATIONS);
+		std::iota(locations.begin(), locations.end(), 0);
+		std::shuffle(locations.begin(), locations.end(), generator);
+		std::vector<Atom> atoms;
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			bool token = std::find(locations.begin(), locations.begin() + NUM_TOKENS, l) != locations.begin() + NUM_TOKENS;
+			atoms.push_back(Atom(l, token));
+			atoms.push_back(Atom(NUM_LOCATIONS + l, !token));
+		}
+		return atoms;
+	}
+
+	static std::vector<State> random_states() {
+		const Problem& problem = Problem::getInstance();
+		std::vector<State> states;
+		for (unsigned i = 1; i <= NUM_STATES; ++i) {
+			states.push_back(*std::unique_ptr<State>(State::create(problem.getStateAtomIndexer(), 2 * NUM_LOCATIONS, random_atoms(i))));
+		}
+		return states;
+	}
+
+	static ExtensionHandler extension_handler() {
+		const Problem& problem = Problem::getInstance();
+		const auto& actions = problem.getPartiallyGroundedActions();
+		const auto managed = support::compute_managed_symbols(std::vector<const ActionBase*>(actions.begin(), actions.end()), problem.getGoalConditions(), problem.getStateConstraints());
+		return ExtensionHandler(problem.get_tuple_index(), managed);
+	}
+
+	static SmartRPG smart_rpg(int threads) {
+		const Problem& problem = Problem::getInstance();
+		auto managers = LiftedEffectCSP::create_smart(problem.getPartiallyGroundedActions(), problem.get_tuple_index(), false, false);
+		return SmartRPG(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler(), threads);
+	}
+
+	static UnreachedAtomRPG unreached_atom_rpg(int threads) {
+		const Problem& problem = Problem::getInstance();
+		auto managers = LiftedEffectUnreachedCSP::create(problem.getPartiallyGroundedActions(), problem.get_tuple_index(), false, false);
+		return UnreachedAtomRPG(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(managers), extension_handler(), threads);
+	}
+};
+
+TEST_F(ParallelRPGTest, SmartRPGValuesDoNotDependOnTheNumberOfThreads) {
+	SmartRPG sequential = smart_rpg(1), parallel = smart_rpg(NUM_THREADS);
+	for (const State& state:random_states()) {
+		std::vector<Atom> sequential_relevant, parallel_relevant;
+		long h = sequential.evaluate(state, sequential_relevant);
+		ASSERT_GE(h, 0); // i.e. the goal is reachable
+		ASSERT_EQ(h, parallel.evaluate(state, parallel_relevant));
+		ASSERT_EQ(sequential_relevant, parallel_relevant);
+	}
+}
+
+TEST_F(ParallelRPGTest, UnreachedAtomRPGValuesDoNotDependOnTheNumberOfThreads) {
+	UnreachedAtomRPG sequential = unreached_atom_rpg(1), parallel = unreached_atom_rpg(NUM_THREADS);
+	for (const State& state:random_states()) {
+		std::vector<Atom> sequential_relevant, parallel_relevant;
+		long h = sequential.evaluate(state, sequential_relevant);
+		ASSERT_GE(h, 0); // i.e. the goal is reachable
+		ASSERT_EQ(h, parallel.evaluate(state, parallel_relevant));
+		ASSERT_EQ(sequential_relevant, parallel_relevant);
+	}
+}
+
+TEST_F(ParallelRPGTest, CSPStatisticsAreCreditedToTheCallingThread) {
+	const std::vector<State> states = random_states();
+
+	// The statistics of a single thread, which does all the work
+	SmartRPG sequential = smart_rpg(1);
+	unsigned long clones_before = CSPStats::instance().clones(), propagations_before = CSPStats::instance().propagations();
+	for (const State& state:states) sequential.evaluate(state);
+	unsigned long clones = CSPStats::instance().clones() - clones_before, propagations = CSPStats::instance().propagations() - propagations_before;
+	ASSERT_GT(clones, 0);
+
+	// The work of the pool is collected from its threads and merged into the statistics of the thread that evaluates
+	// the states. The pool does at least as much work, as it only skips the effects whose tuple was reached on a previous
+	// layer, not on the current one, hence the calling thread must not be credited with its own share of the work only.
+	SmartRPG parallel = smart_rpg(NUM_THREADS);
+	clones_before = CSPStats::instance().clones();
+	propagations_before = CSPStats::instance().propagations();
+	for (const State& state:states) parallel.evaluate(state);
+	EXPECT_GE(CSPStats::instance().clones() - clones_before, clones);
+	EXPECT_GE(CSPStats::instance().propagations() - propagations_before, propagations);
+}
+
+TEST(CSPStatsTest, CollectedWorkIsTakenOutOfTheThread) {
+	CSPStats& stats = CSPStats::instance();
+	stats.clone_avoided();
+	const unsigned long avoided = stats.clones_avoided();
+
+	CSPStats work = CSPStats::collect([]() {
+		CSPStats::instance().clone_avoided();
+		CSPStats::instance().cloned(CSPStats::ClockT::now());
+	});
+	EXPECT_EQ(1, work.clones_avoided());
+	EXPECT_EQ(1, work.clones());
+	EXPECT_EQ(avoided, stats.clones_avoided());
+
+	// Work collected on another thread is handed over to this one
+	std::thread([&work]() {
+		work = CSPStats::collect([]() { CSPStats::instance().propagated(CSPStats::ClockT::now()); });
+	}).join();
+	EXPECT_EQ(0, work.clones());
+	EXPECT_EQ(1, work.propagations());
+	const unsigned long propagations = stats.propagations();
+	stats.merge(work);
+	EXPECT_EQ(propagations + 1, stats.propagations());
+	EXPECT_EQ(avoided, stats.clones_avoided());
+}
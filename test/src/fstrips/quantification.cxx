@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <utils/binding.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/quantification.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A number of locations, some of them holding a token, with fluent 'at(x)' and 'clear(x)' predicates
+class QuantificationTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 10;
+
+	static void SetUpTestCase() {
+		test::set_problem_info(test::token_locations_data(NUM_LOCATIONS));
+	}
+
+	static const fs::BoundVariable* variable(unsigned i) {
+		return new fs::BoundVariable(i, "?v" + std::to_string(i), 1);
+	}
+
+	static const fs::Formula* holds(unsigned symbol, unsigned var, int value) {
+		return new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(symbol, {variable(var)}), new fs::IntConstant(value)});
+	}
+
+	static std::vector<Atom> random_atoms(std::mt19937& generator) {
+		std::vector<Atom> atoms;
+		for (unsigned l = 0; l < NUM_LOCATIONS; ++l) {
+			bool token = generator() % 3 == 0;
+			atoms.push_back(Atom(l, token));
+			atoms.push_back(Atom(NUM_LOCATIONS + l, !token && generator() % 2 == 0));
+		}
+		return atoms;
+	}
+};
+
+TEST_F(QuantificationTest, QuantifiedFormulaeMatchBruteForce) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	const int N = NUM_LOCATIONS;
+
+	// exists z: z != l0 and z != l1 and clear(z) and not at(z)
+	std::unique_ptr<fs::Formula> free_location(new fs::ExistentiallyQuantifiedFormula({variable(0)}, new fs::Conjunction({
+		new fs::NEQAtomicFormula({variable(0), new fs::IntConstant(0)}),
+		new fs::NEQAtomicFormula({variable(0), new fs::IntConstant(1)}),
+		holds(1, 0, 1),
+		holds(0, 0, 0)
+	})));
+
+	// forall z: z = l2 or clear(z) or at(z)
+	std::unique_ptr<fs::Formula> all_used(new fs::UniversallyQuantifiedFormula({variable(0)}, new fs::Disjunction({
+		new fs::EQAtomicFormula({variable(0), new fs::IntConstant(2)}),
+		holds(1, 0, 1),
+		holds(0, 0, 1)
+	})));
+
+	// exists x: at(x) and (forall y: y = x or y < x or not clear(y))
+	std::unique_ptr<fs::Formula> nested(new fs::ExistentiallyQuantifiedFormula({variable(0)}, new fs::Conjunction({
+		holds(0, 0, 1),
+		new fs::UniversallyQuantifiedFormula({variable(1)}, new fs::Disjunction({
+			new fs::EQAtomicFormula({variable(1), variable(0)}),
+			new fs::LTAtomicFormula({variable(1), variable(0)}),
+			new fs::Negation(holds(1, 1, 1))
+		}))
+	})));
+
+	// exists x, y: x < y and y != l0 and at(x) and at(y)
+	std::unique_ptr<fs::Formula> two_tokens(new fs::ExistentiallyQuantifiedFormula({variable(0), variable(1)}, new fs::Conjunction({
+		new fs::LTAtomicFormula({variable(0), variable(1)}),
+		new fs::NEQAtomicFormula({variable(1), new fs::IntConstant(0)}),
+		holds(0, 0, 1),
+		holds(0, 1, 1)
+	})));
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::mt19937 generator(1);
+	for (unsigned s = 0; s < 200; ++s) {
+		std::vector<Atom> atoms = random_atoms(generator);
+		std::unique_ptr<State> state(State::create(*indexer, 2 * NUM_LOCATIONS, atoms));
+		PartialAssignment assignment;
+		for (const Atom& atom:atoms) assignment[atom.getVariable()] = atom.getValue();
+
+		auto at = [&](int l) { return state->getValue(l) == 1; };
+		auto clear = [&](int l) { return state->getValue(N + l) == 1; };
+
+		bool expected_free = false, expected_all_used = true, expected_nested = false, expected_two_tokens = false;
+		for (int z = 0; z < N; ++z) {
+			expected_free = expected_free || (z > 1 && clear(z) && !at(z));
+			expected_all_used = expected_all_used && (z == 2 || clear(z) || at(z));
+			bool rest_unclear = true;
+			for (int y = z + 1; y < N; ++y) rest_unclear = rest_unclear && !clear(y);
+			expected_nested = expected_nested || (at(z) && rest_unclear);
+			for (int y = z + 1; y < N; ++y) expected_two_tokens = expected_two_tokens || (y != 0 && at(z) && at(y));
+		}
+
+		// Interpret each formula twice, to check that the quantified variables are left unbound
+		for (unsigned repetition = 0; repetition < 2; ++repetition) {
+			Binding binding;
+			ASSERT_EQ(expected_free, free_location->interpret(*state, binding));
+			ASSERT_EQ(expected_all_used, all_used->interpret(*state, binding));
+			ASSERT_EQ(expected_nested, nested->interpret(*state, binding));
+			ASSERT_EQ(expected_two_tokens, two_tokens->interpret(*state, binding));
+			ASSERT_FALSE(binding.binds(0));
+			ASSERT_FALSE(binding.binds(1));
+		}
+		ASSERT_EQ(expected_nested, nested->interpret(assignment));
+		ASSERT_EQ(expected_two_tokens, two_tokens->interpret(assignment));
+	}
+}
+
+TEST_F(QuantificationTest, StaticPartsRestrictCandidates) {
+	// exists x, y: x != l0 and x != l1 and y = l4 and at(x) and at(y)
+	std::unique_ptr<fs::ExistentiallyQuantifiedFormula> formula(new fs::ExistentiallyQuantifiedFormula({variable(0), variable(1)}, new fs::Conjunction({
+		new fs::NEQAtomicFormula({variable(0), new fs::IntConstant(0)}),
+		new fs::NEQAtomicFormula({variable(0), new fs::IntConstant(1)}),
+		new fs::EQAtomicFormula({variable(1), new fs::IntConstant(4)}),
+		holds(0, 0, 1),
+		holds(0, 1, 1)
+	})));
+
+	// The most selective variable, y, is bound first
+	fs::QuantifierPlan plan(*formula, true);
+	std::vector<std::size_t> expected{1, NUM_LOCATIONS - 2};
+	ASSERT_EQ(expected, plan.num_candidates());
+
+	// A universal formula discards the candidates that satisfy a static disjunct, which cannot be counterexamples
+	// forall x: x = l3 or at(x)
+	std::unique_ptr<fs::UniversallyQuantifiedFormula> universal(new fs::UniversallyQuantifiedFormula({variable(0)}, new fs::Disjunction({
+		new fs::EQAtomicFormula({variable(0), new fs::IntConstant(3)}),
+		holds(0, 0, 1)
+	})));
+	fs::QuantifierPlan universal_plan(*universal, false);
+	ASSERT_EQ(std::vector<std::size_t>{NUM_LOCATIONS - 1}, universal_plan.num_candidates());
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+
+#include <problem_info.hxx>
+#include <state.hxx>
+#include <actions/actions.hxx>
+#include <actions/grounding.hxx>
+#include <actions/reachability.hxx>
+#include <utils/atom_index.hxx>
+#include <languages/fstrips/language.hxx>
+#include <languages/fstrips/builtin.hxx>
+
+#include <fixtures/location_problems.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! A problem with a static, randomly generated 'link(x, y)' relation over a number of locations, a fluent 'at(x)'
+//! predicate and a schema 'move(x, y)'. The last locations are only linked among themselves, hence cannot be reached
+//! from the first location, where the agent initially is.
+class ReachabilityTest : public testing::Test {
+protected:
+	static const unsigned NUM_LOCATIONS = 60;
+	static const unsigned FIRST_ISOLATED = 40;
+
+	static void SetUpTestCase() {
+		ProblemInfo& info = test::set_problem_info(test::linked_locations_data(NUM_LOCATIONS));
+		info.set_extension(0, std::unique_ptr<StaticExtension>(new BinaryPredicate(test::random_links(NUM_LOCATIONS, 0.08, FIRST_ISOLATED))));
+	}
+
+	static const fs::BoundVariable* parameter(unsigned i) {
+		return new fs::BoundVariable(i, "?p" + std::to_string(i), 1);
+	}
+
+	//! move(x, y): PRE link(x, y) and at(x); EFF at(y) := 1, at(x) := 0
+	static std::unique_ptr<const ActionData> build_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::Conjunction({
+			new fs::EQAtomicFormula({new fs::UserDefinedStaticTerm(0, {parameter(0), parameter(1)}), new fs::IntConstant(1)}),
+			new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(1)})
+		});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(1)}), new fs::IntConstant(1), new fs::Tautology),
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(0), new fs::Tautology)
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "move", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	//! jump(x, y): PRE link(x, y); EFF at(x) -> at(y) := 1
+	//! The precondition mentions no fluent symbol, hence only the condition of the effect depends on the reached atoms
+	static std::unique_ptr<const ActionData> build_conditional_schema() {
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		auto precondition = new fs::EQAtomicFormula({new fs::UserDefinedStaticTerm(0, {parameter(0), parameter(1)}), new fs::IntConstant(1)});
+		auto condition = new fs::EQAtomicFormula({new fs::FluentHeadedNestedTerm(1, {parameter(0)}), new fs::IntConstant(1)});
+		std::vector<const fs::ActionEffect*> effects{
+			new fs::ActionEffect(new fs::FluentHeadedNestedTerm(1, {parameter(1)}), new fs::IntConstant(1), condition)
+		};
+		std::vector<std::string> names{"?p0", "?p1"};
+		ActionData data(0, "jump", {1, 1}, names, fs::BindingUnit(names, {parameter(0), parameter(1)}), precondition, effects);
+		return std::unique_ptr<const ActionData>(ActionGrounder::process_action_data(data, info, true));
+	}
+
+	//! The locations reachable from the first one through the link relation
+	static std::vector<bool> reachable_locations() {
+		const auto& link = dynamic_cast<const BinaryPredicate&>(ProblemInfo::getInstance().get_extension(0));
+		std::vector<bool> reached(NUM_LOCATIONS, false);
+		std::vector<unsigned> open{0};
+		reached[0] = true;
+		while (!open.empty()) {
+			unsigned x = open.back();
+			open.pop_back();
+			for (unsigned y = 0; y < NUM_LOCATIONS; ++y) {
+				if (!reached[y] && link.value(x, y)) {
+					reached[y] = true;
+					open.push_back(y);
+				}
+			}
+		}
+		return reached;
+	}
+};
+
+TEST_F(ReachabilityTest, PrunesUnreachableAtomsAndActions) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_schema();
+	std::vector<const ActionData*> schemas{schema.get()};
+	const auto& link = dynamic_cast<const BinaryPredicate&>(info.get_extension(0));
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> init(State::create(*indexer, NUM_LOCATIONS, {Atom(0, 1)}));
+
+	RelaxedReachability reachability(schemas, info);
+	reachability.compute(*init);
+	std::vector<const GroundAction*> full = ActionGrounder::fully_ground(schemas, info, 1);
+	std::vector<const GroundAction*> reachable = ActionGrounder::fully_ground(schemas, info, reachability);
+
+	const std::vector<bool> locations = reachable_locations();
+	unsigned expected_bindings = 0;
+	for (unsigned x = 0; x < NUM_LOCATIONS; ++x) {
+		ASSERT_EQ((bool) locations[x], reachability.reachable(x, 1));
+		ASSERT_TRUE(reachability.reachable(x, 0));
+		for (unsigned y = 0; y < NUM_LOCATIONS; ++y) {
+			bool expected = locations[x] && link.value(x, y);
+			ASSERT_EQ(expected, reachability.reachable_binding(0, {(ObjectIdx) x, (ObjectIdx) y}));
+			expected_bindings += expected;
+		}
+	}
+	ASSERT_EQ(expected_bindings, reachability.bindings(0).size());
+	ASSERT_EQ(expected_bindings, reachable.size());
+
+	// Reachable actions keep the order and bindings of the full grounding
+	unsigned j = 0;
+	for (const GroundAction* action:full) {
+		if (j < reachable.size() && action->getBinding() == reachable[j]->getBinding()) {
+			ASSERT_EQ(j, reachable[j]->getId());
+			++j;
+		}
+	}
+	ASSERT_EQ(reachable.size(), j);
+
+	// The atom index only contains the reachable atoms
+	AtomIndex index(info, true, &reachability);
+	ASSERT_EQ(reachability.num_reachable_atoms(), index.size());
+	ASSERT_FALSE(index.is_indexed(NUM_LOCATIONS - 1, 1));
+	ASSERT_TRUE(index.is_indexed(0, 1));
+	ASSERT_LT(index.size(), AtomIndex(info, true).size());
+
+	for (const GroundAction* action:full) delete action;
+	for (const GroundAction* action:reachable) delete action;
+}
+
+TEST_F(ReachabilityTest, ConditionalEffectsEnabledAtLaterIterations) {
+	const ProblemInfo& info = ProblemInfo::getInstance();
+	std::unique_ptr<const ActionData> schema = build_conditional_schema();
+	std::vector<const ActionData*> schemas{schema.get()};
+
+	std::unique_ptr<StateAtomIndexer> indexer(StateAtomIndexer::create(info));
+	std::unique_ptr<State> init(State::create(*indexer, NUM_LOCATIONS, {Atom(0, 1)}));
+
+	RelaxedReachability reachability(schemas, info);
+	reachability.compute(*init);
+
+	// Locations reached only through a link to some location with a lower index get enabled after the first
+	// enumeration of the schema, which needs to be enumerated again even if its precondition is static
+	const std::vector<bool> locations = reachable_locations();
+	for (unsigned x = 0; x < NUM_LOCATIONS; ++x) {
+		ASSERT_EQ((bool) locations[x], reachability.reachable(x, 1));
+	}
+	ASSERT_GT(reachability.num_iterations(), 2);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <set>
+
+#include <heuristics/relaxed_plan/rpg_support_table.hxx>
+#include <actions/action_id.hxx>
+#include <actions/actions.hxx>
+#include <languages/fstrips/language.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! An action ID that keeps count of how many of its instances are alive
+class CountedActionID : public ActionID {
+public:
+	static int alive;
+
+	CountedActionID() { ++alive; }
+	~CountedActionID() { --alive; }
+
+	bool operator==(const ActionID& rhs) const override { return this == &rhs; }
+	std::size_t hash() const override { return 0; }
+	std::ostream& print(std::ostream& os) const override { return os << "counted"; }
+};
+
+int CountedActionID::alive = 0;
+
+TEST(RPGSupportTableTest, GraphsAreForgottenWithoutClearing) {
+	const unsigned NUM_ATOMS = 50;
+	RPGSupportTable table(NUM_ATOMS);
+	std::mt19937 generator(1);
+
+	for (unsigned graph = 0; graph < 20; ++graph) {
+		table.clear();
+		ASSERT_EQ(0, CountedActionID::alive);
+		ASSERT_TRUE(table.reached_atoms().empty());
+
+		// Reach a random subset of the atoms, each supported by the atoms reached right before it
+		std::set<AtomIdx> reached;
+		for (unsigned layer = 0; layer < 4; ++layer) {
+			for (unsigned i = 0; i < 10; ++i) {
+				AtomIdx atom = generator() % NUM_ATOMS;
+				std::vector<AtomIdx>* support = table.add(atom, layer, new CountedActionID);
+				ASSERT_EQ(reached.count(atom) == 0, support != nullptr); // Repeated atoms are rejected
+				if (!support) continue;
+				ASSERT_TRUE(support->empty());
+				support->assign(reached.begin(), reached.end());
+				reached.insert(atom);
+				ASSERT_EQ(layer, table.layer(atom));
+			}
+		}
+
+		// Rejected actions are deleted straight away, the others belong to the table
+		ASSERT_EQ((int) reached.size(), CountedActionID::alive);
+		ASSERT_EQ(reached.size(), table.reached_atoms().size());
+		for (AtomIdx atom = 0; atom < NUM_ATOMS; ++atom) {
+			ASSERT_EQ(reached.count(atom) > 0, table.reached(atom));
+		}
+		for (AtomIdx atom:table.reached_atoms()) {
+			for (AtomIdx supporter:table.support(atom)) ASSERT_TRUE(table.reached(supporter));
+		}
+
+		// Marks are independent of the graph, and cleared on request
+		table.clear_marks();
+		AtomIdx first = table.reached_atoms().front();
+		EXPECT_FALSE(table.processed(first));
+		EXPECT_TRUE(table.mark_processed(first));
+		EXPECT_FALSE(table.mark_processed(first));
+		EXPECT_TRUE(table.processed(first));
+		EXPECT_TRUE(table.mark_relevant(first));
+		table.clear_marks();
+		EXPECT_FALSE(table.processed(first));
+		EXPECT_TRUE(table.mark_relevant(first));
+	}
+
+	// Moving the table moves the ownership of the actions
+	RPGSupportTable moved(std::move(table));
+	EXPECT_GT(CountedActionID::alive, 0);
+	moved = RPGSupportTable(NUM_ATOMS);
+	EXPECT_EQ(0, CountedActionID::alive);
+}
+
+TEST(RPGSupportTableTest, GroundActionIDsAreInterned) {
+	ActionData data(0, "noop", {}, {}, fs::BindingUnit({}, {}), new fs::Tautology, {});
+	GroundAction first(0, data, Binding(), new fs::Tautology, {}), second(1, data, Binding(), new fs::Tautology, {});
+	RPGSupportTable table(10);
+
+	ASSERT_NE(nullptr, table.add(0, 0, first));
+	ASSERT_NE(nullptr, table.add(1, 0, first));
+	ASSERT_NE(nullptr, table.add(2, 1, second));
+	ASSERT_EQ(nullptr, table.add(2, 1, first)); // Repeated atoms are rejected
+	const ActionID* interned = table.action(0);
+	EXPECT_EQ(interned, table.action(1));
+	EXPECT_NE(interned, table.action(2));
+	EXPECT_EQ(PlainActionID(&first), *interned);
+
+	// Interned IDs survive the graph, and can be mixed with owned ones
+	table.clear();
+	ASSERT_NE(nullptr, table.add(3, 0, new CountedActionID));
+	ASSERT_NE(nullptr, table.add(4, 0, first));
+	EXPECT_EQ(interned, table.action(4));
+	EXPECT_EQ(1, CountedActionID::alive);
+	table.clear();
+	EXPECT_EQ(0, CountedActionID::alive);
+	EXPECT_FALSE(table.reached(4));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <lib/rapidjson/document.h>
+
+#include <problem_info.hxx>
+#include <utils/tuple_table.hxx>
+#include <utils/atom_index.hxx>
+
+using namespace fs0;
+
+//! A problem shaped after nested-fluent-heavy domains: 'value(c)' for a number of counters,
+//! as in the counters domain, and 'visited(x, y)' over a grid, as in visitall with functions
+class StateVariableResolutionTest : public testing::Test {
+protected:
+	static const unsigned NUM_COUNTERS = 1000;
+	static const unsigned GRID_SIZE = 60;
+
+	static std::string problem_data() {
+		std::ostringstream types, objects, variables, value_vars, visited_vars;
+		unsigned object = 0, variable = 0;
+
+		types << "[[0, \"bool\", [\"0\",\"1\"]], [1, \"counter\", [";
+		for (unsigned c = 0; c < NUM_COUNTERS; ++c, ++object) {
+			types << (c ? "," : "") << "\"" << object << "\"";
+			objects << (object ? "," : "") << "{\"id\":" << object << ",\"name\":\"c" << c << "\"}";
+		}
+		types << "]], [2, \"coord\", [";
+		for (unsigned x = 0; x < GRID_SIZE; ++x, ++object) {
+			types << (x ? "," : "") << "\"" << object << "\"";
+			objects << ",{\"id\":" << object << ",\"name\":\"x" << x << "\"}";
+		}
+		types << "]], [3, \"num\", \"int\", [0, 100]]]";
+
+		for (unsigned c = 0; c < NUM_COUNTERS; ++c, ++variable) {
+			variables << (variable ? "," : "") << "{\"id\":" << variable << ",\"name\":\"value(c" << c << ")\",\"type\":\"num\",\"data\":[0,[" << c << "]]}";
+			value_vars << (c ? "," : "") << "[" << variable << "]";
+		}
+		for (unsigned x = 0; x < GRID_SIZE; ++x) {
+			for (unsigned y = 0; y < GRID_SIZE; ++y, ++variable) {
+				variables << ",{\"id\":" << variable << ",\"name\":\"visited(x" << x << ",x" << y << ")\",\"type\":\"bool\",\"data\":[1,["
+				          << NUM_COUNTERS + x << "," << NUM_COUNTERS + y << "]]}";
+				visited_vars << (x || y ? "," : "") << "[" << variable << "]";
+			}
+		}
+
+		std::ostringstream data;
+		data << "{\"types\": " << types.str() << ", \"objects\": [" << objects.str() << "], \"symbols\": ["
+		     << "[0, \"value\", \"function\", [\"counter\"], \"num\", [" << value_vars.str() << "], false, false],"
+		     << "[1, \"visited\", \"predicate\", [\"coord\", \"coord\"], \"bool\", [" << visited_vars.str() << "], false, false]],"
+		     << "\"variables\": [" << variables.str() << "], \"problem\": {\"domain\":\"test\",\"instance\":\"test\"}}";
+		return data.str();
+	}
+
+	void SetUp() override {
+		rapidjson::Document data;
+		data.Parse(problem_data().c_str());
+		ASSERT_FALSE(data.HasParseError());
+		_info = std::unique_ptr<ProblemInfo>(new ProblemInfo(data, "."));
+	}
+
+	std::unique_ptr<ProblemInfo> _info;
+};
+
+TEST_F(StateVariableResolutionTest, ResolvesAllVariables) {
+	for (VariableIdx variable = 0; variable < _info->getNumVariables(); ++variable) {
+		const auto& data = _info->getVariableData(variable);
+		ASSERT_EQ(variable, _info->resolveStateVariable(data.first, data.second));
+	}
+	ASSERT_THROW(_info->resolveStateVariable(0, {NUM_COUNTERS + 1}), std::out_of_range);
+	ASSERT_THROW(_info->resolveStateVariable(1, {NUM_COUNTERS, 0}), std::out_of_range);
+	ASSERT_THROW(_info->resolveStateVariable(1, {NUM_COUNTERS}), std::out_of_range);
+}
+
+TEST_F(StateVariableResolutionTest, AtomIndexInverses) {
+	AtomIndex index(*_info);
+	for (AtomIdx idx = 0; idx < index.size(); ++idx) {
+		const Atom& atom = index.to_atom(idx);
+		ASSERT_EQ(idx, index.to_index(atom));
+		if (_info->isFunction(index.symbol(idx)) || atom.getValue() == 1) {
+			ASSERT_EQ(idx, index.to_index(index.symbol(idx), index.to_tuple(idx)));
+		}
+	}
+}
+
+TEST_F(StateVariableResolutionTest, SparseTables) {
+	utils::TupleTable table({{{0, 1000000}, 0}, {{5, 7}, 1}, {{-3, 2}, 2}});
+	ASSERT_FALSE(table.is_dense());
+	ASSERT_EQ(0, table.find({0, 1000000}));
+	ASSERT_EQ(1, table.find({5, 7}));
+	ASSERT_EQ(2, table.find({-3, 2}));
+	ASSERT_EQ(utils::TupleTable::INVALID, table.find({5, 2}));
+	ASSERT_EQ(utils::TupleTable::INVALID, table.find({6, 1000001}));
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+#include <utils/static.hxx>
+#include <utils/static_table.hxx>
+
+using namespace fs0;
+
+//! A random extension of a binary function over the given number of objects, defined on the given ratio of points
+static Serializer::BoostBinaryMap random_binary_map(unsigned objects, double density, unsigned seed) {
+	std::mt19937 generator(seed);
+	std::bernoulli_distribution defined(density);
+	Serializer::BoostBinaryMap data;
+	for (unsigned x = 0; x < objects; ++x) {
+		for (unsigned y = 0; y < objects; ++y) {
+			if (defined(generator)) data.insert(std::make_pair(std::make_pair<int, int>(x + 10, y + 10), (int) (generator() % 100)));
+		}
+	}
+	return data;
+}
+
+//! Check that the table implementing the given binary function agrees with the original extension on all points
+static void check_binary_function(const Serializer::BoostBinaryMap& data, unsigned objects, utils::StaticTable::Layout layout) {
+	BinaryFunction function{Serializer::BoostBinaryMap(data)};
+	ASSERT_EQ(layout, function.get_table().layout());
+	ASSERT_EQ(data.size(), function.get_table().size());
+
+	for (int x = 0; x < (int) objects + 20; ++x) {
+		for (int y = 0; y < (int) objects + 20; ++y) {
+			auto it = data.find(std::make_pair(x, y));
+			if (it != data.end()) {
+				ASSERT_EQ(it->second, function.value(x, y));
+				ASSERT_EQ(it->second, function.get_function()({x, y}));
+			} else {
+				ASSERT_THROW(function.value(x, y), std::out_of_range);
+			}
+		}
+	}
+}
+
+TEST(StaticTableTest, DenseFunction) {
+	check_binary_function(random_binary_map(50, 0.5, 1), 50, utils::StaticTable::Layout::Dense);
+}
+
+TEST(StaticTableTest, SortedFunction) {
+	check_binary_function(random_binary_map(200, 0.01, 2), 200, utils::StaticTable::Layout::Sorted);
+}
+
+TEST(StaticTableTest, HashedFunction) {
+	const int M = 2000000000;
+	utils::StaticTable table = utils::StaticTable::function({{{-M, -M, -M}, 4}, {{M, M, M}, 5}}, 3);
+	ASSERT_EQ(utils::StaticTable::Layout::Hashed, table.layout());
+	ASSERT_EQ(4, table.value({-M, -M, -M}));
+	ASSERT_EQ(5, table.value({M, M, M}));
+	ASSERT_THROW(table.value({0, 0, 0}), std::out_of_range);
+}
+
+TEST(StaticTableTest, Predicates) {
+	Serializer::BoostBinarySet data;
+	for (unsigned x = 0; x < 300; ++x) data.insert(std::make_pair<int, int>(x, (x * 7) % 300));
+	BinaryPredicate predicate(std::move(data));
+	// 300 tuples over a 300x300 range take a bitset of 90000 bits, i.e. 300 per tuple, hence a sorted layout
+	ASSERT_EQ(utils::StaticTable::Layout::Sorted, predicate.get_table().layout());
+	for (int x = -1; x < 301; ++x) {
+		for (int y = -1; y < 301; ++y) {
+			ASSERT_EQ(x >= 0 && x < 300 && y == (x * 7) % 300, predicate.value(x, y));
+		}
+	}
+
+	UnaryPredicate unary(Serializer::BoostUnarySet{3, 5, 8});
+	ASSERT_EQ(utils::StaticTable::Layout::Dense, unary.get_table().layout());
+	ASSERT_TRUE(unary.value(5));
+	ASSERT_FALSE(unary.value(4));
+	ASSERT_FALSE(unary.value(100));
+
+	UnaryPredicate empty(Serializer::BoostUnarySet{});
+	ASSERT_FALSE(empty.value(0));
+}
+
+TEST(StaticTableTest, ZeroaryFunction) {
+	ZeroaryFunction function(42);
+	ASSERT_EQ(42, function.value());
+	ASSERT_EQ(42, function.get_function()({}));
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <utils/tuple_file.hxx>
+#include <utils/static.hxx>
+
+using namespace fs0;
+
+class TupleFileTest : public testing::Test {
+protected:
+	void SetUp() override {
+		_filename = testing::TempDir() + "/tuple_file_test.bin";
+		_text_filename = testing::TempDir() + "/tuple_file_test.data";
+	}
+
+	void TearDown() override {
+		std::remove(_filename.c_str());
+		std::remove(_text_filename.c_str());
+	}
+
+	//! The points of a random binary function over the given number of objects, as rows [x, y, f(x, y)]
+	static std::vector<ObjectIdx> random_binary_function(unsigned objects, double density) {
+		std::mt19937 generator(1);
+		std::bernoulli_distribution defined(density);
+		std::vector<ObjectIdx> points;
+		for (unsigned x = 0; x < objects; ++x) {
+			for (unsigned y = 0; y < objects; ++y) {
+				if (!defined(generator)) continue;
+				points.insert(points.end(), {(ObjectIdx) x, (ObjectIdx) y, (ObjectIdx) (generator() % 1000)});
+			}
+		}
+		return points;
+	}
+
+	std::string _filename;
+	std::string _text_filename;
+};
+
+TEST_F(TupleFileTest, RoundTrip) {
+	utils::TupleFile::write(_filename, {{3, 2, {1, 2, 3, -4, 5, 6}}, {0, 4, {}}, {2, 0, {}}});
+
+	utils::TupleFile file(_filename);
+	ASSERT_EQ(3, file.num_sections());
+
+	const auto& first = file.section(0);
+	ASSERT_EQ(3, first.width());
+	ASSERT_EQ(2, first.rows());
+	ASSERT_EQ(ValueTuple({-4, 5, 6}), ValueTuple(first.row(1), first.row(1) + first.width()));
+
+	// Sections with no columns still keep their number of rows, as e.g. the single grounding of a nullary action schema
+	ASSERT_EQ(0, file.section(1).width());
+	ASSERT_EQ(4, file.section(1).rows());
+	ASSERT_EQ(0, file.section(2).rows());
+}
+
+TEST_F(TupleFileTest, InvalidFiles) {
+	ASSERT_FALSE(utils::TupleFile::exists(_filename));
+	ASSERT_THROW(utils::TupleFile file(_filename), std::runtime_error);
+
+	std::ofstream(_filename) << "1,2,3\n4,5,6\n";
+	ASSERT_THROW(utils::TupleFile file(_filename), std::runtime_error);
+
+	// A file whose data does not fit in it
+	utils::TupleFile::write(_filename, {{2, 3, {1, 2, 3, 4, 5, 6}}});
+	std::vector<char> contents;
+	{
+		std::ifstream in(_filename, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	std::ofstream(_filename, std::ios::binary).write(contents.data(), contents.size() - 4);
+	ASSERT_THROW(utils::TupleFile file(_filename), std::runtime_error);
+}
+
+TEST_F(TupleFileTest, BinaryExtensions) {
+	const std::vector<ObjectIdx> points = random_binary_function(40, 0.3);
+	utils::TupleFile::write(_filename, {{3, points.size() / 3, points}});
+
+	std::unique_ptr<StaticExtension> extension = StaticExtension::load_binary_extension(_filename, false, 2);
+	const BinaryFunction* function = dynamic_cast<const BinaryFunction*>(extension.get());
+	ASSERT_TRUE(function != nullptr);
+	ASSERT_EQ(points.size() / 3, function->get_table().size());
+	for (unsigned i = 0; i < points.size(); i += 3) {
+		ASSERT_EQ(points[i + 2], function->value(points[i], points[i + 1]));
+	}
+
+	// Predicates are stored as their tuples, and nullary symbols as their only value
+	utils::TupleFile::write(_filename, {{2, 2, {3, 4, 5, 6}}});
+	std::unique_ptr<StaticExtension> predicate = StaticExtension::load_binary_extension(_filename, true, 2);
+	ASSERT_TRUE(dynamic_cast<const BinaryPredicate&>(*predicate).value(5, 6));
+	ASSERT_FALSE(dynamic_cast<const BinaryPredicate&>(*predicate).value(4, 5));
+
+	utils::TupleFile::write(_filename, {{1, 1, {7}}});
+	ASSERT_EQ(7, dynamic_cast<const ZeroaryFunction&>(*StaticExtension::load_binary_extension(_filename, false, 0)).value());
+
+	// The arity of the symbol needs to match the contents of the file
+	ASSERT_THROW(StaticExtension::load_binary_extension(_filename, false, 2), std::runtime_error);
+}
+
+//! A large static extension loaded from a text and from a binary file yields the same table
+TEST_F(TupleFileTest, TextAndBinaryExtensionsAgree) {
+	const std::vector<ObjectIdx> points = random_binary_function(1000, 1.0);
+	utils::TupleFile::write(_filename, {{3, points.size() / 3, points}});
+	{
+		std::ofstream out(_text_filename);
+		for (unsigned i = 0; i < points.size(); i += 3) out << points[i] << "," << points[i + 1] << "," << points[i + 2] << "\n";
+	}
+
+	BinaryFunction text(Serializer::deserializeBinaryMap(_text_filename));
+	std::unique_ptr<StaticExtension> binary = StaticExtension::load_binary_extension(_filename, false, 2);
+
+	ASSERT_EQ(text.get_table().size(), binary->get_table().size());
+	ASSERT_EQ(text.value(500, 400), dynamic_cast<const BinaryFunction&>(*binary).value(500, 400));
+}